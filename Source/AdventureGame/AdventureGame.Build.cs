@@ -10,7 +10,7 @@ public class AdventureGame : ModuleRules
 	
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "Paper2D", "UMG" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] { "AIModule", "GameplayTags" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "AIModule", "AssetRegistry", "EngineSettings", "GameplayTags", "NavigationSystem" });
 		
 	    PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });  // , "UnrealEd", "PropertyEditor"
 		
@@ -0,0 +1,272 @@
+// (c) 2025 Sarah Smith
+
+
+#include "RoomGraphCommandlet.h"
+
+#include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/Gameplay/AdventureGameInstance.h"
+#include "AdventureGame/Gameplay/RoomGraph.h"
+#include "AdventureGame/Gameplay/WalkToValidator.h"
+#include "AdventureGame/HotSpots/Door.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "GameMapsSettings.h"
+#include "Misc/DateTime.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/SavePackage.h"
+
+const TCHAR* URoomGraphCommandlet::DefaultLevelsPath = TEXT("/Game/PointAndClick/Levels");
+static const TCHAR* DefaultOutputPath = TEXT("/Game/PointAndClick/Data/RoomGraph");
+
+/// Components of a level that is not in a world are not registered, so their world
+/// transforms have not been worked out. Combine the relative transforms instead.
+static FTransform GetLevelTransform(const USceneComponent* Component)
+{
+	FTransform Transform = FTransform::Identity;
+	for (; Component; Component = Component->GetAttachParent())
+	{
+		Transform = Transform * Component->GetRelativeTransform();
+	}
+	return Transform;
+}
+
+URoomGraphCommandlet::URoomGraphCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 URoomGraphCommandlet::Main(const FString& Params)
+{
+	FString LevelsPath = DefaultLevelsPath;
+	// Save where the game looks for it, unless told otherwise
+	const FString ConfiguredPath = GetDefault<UAdventureGameInstance>()->RoomGraphAsset.ToSoftObjectPath().GetLongPackageName();
+	FString OutputPath = ConfiguredPath.IsEmpty() ? DefaultOutputPath : ConfiguredPath;
+	FString StartingLevel = GetDefault<UAdventureGameInstance>()->StartingLevelName.ToString();
+	FParse::Value(*Params, TEXT("Path="), LevelsPath);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("Start="), StartingLevel);
+	const bool bIncludeTests = FParse::Param(*Params, TEXT("IncludeTests"));
+	const bool bSave = !FParse::Param(*Params, TEXT("NoSave"));
+	const bool bCheckWalkTo = FParse::Param(*Params, TEXT("CheckWalkTo"));
+
+	UPackage* Package = FPackageName::DoesPackageExist(OutputPath) ? LoadPackage(nullptr, *OutputPath, LOAD_None)
+		: CreatePackage(*OutputPath);
+	if (!Package)
+	{
+		UE_LOG(LogAdventureGame, Error, TEXT("URoomGraphCommandlet - could not create %s"), *OutputPath);
+		return 1;
+	}
+	const FString AssetName = FPackageName::GetShortName(OutputPath);
+	URoomGraph* Graph = FindObject<URoomGraph>(Package, *AssetName);
+	if (!Graph)
+	{
+		Graph = NewObject<URoomGraph>(Package, *AssetName, RF_Public | RF_Standalone);
+	}
+	Graph->AddToRoot();
+	Graph->Doors.Reset();
+
+	TArray<FString> Levels;
+	FindLevels(LevelsPath, bIncludeTests, Levels);
+	UE_LOG(LogAdventureGame, Display, TEXT("URoomGraphCommandlet - %d levels in %s"), Levels.Num(), *LevelsPath);
+
+	TArray<FString> Errors;
+	TArray<FString> Warnings;
+	FWalkToValidator WalkToValidator;
+	if (bCheckWalkTo)
+	{
+		WalkToValidator.LoadNavigation(GetPersistentLevel());
+	}
+	TArray<FWalkToReport> WalkToReports;
+	for (const FString& Level : Levels)
+	{
+		AddDoorsInLevel(Level, Graph, Errors);
+		if (bCheckWalkTo)
+		{
+			FWalkToReport& Report = WalkToReports.AddDefaulted_GetRef();
+			WalkToValidator.ValidateLevel(Level, Report);
+			Errors.Append(Report.Errors);
+			Warnings.Append(Report.Warnings);
+		}
+		// Only the doors are kept, so let each level go before loading the next
+		CollectGarbage(RF_NoFlags);
+	}
+	Graph->Build(FName(StartingLevel), Errors, Warnings);
+	AddRoomAssets(Levels, Graph);
+
+	for (const FRoomGraphRoom& Room : Graph->Rooms)
+	{
+		UE_LOG(LogAdventureGame, Display, TEXT("    %s: %d doors to %s, %d assets%s"), *Room.LevelName.ToString(), Room.Doors.Num(),
+			*FString::JoinBy(Room.Neighbours, TEXT(", "), [](const FName& Name) { return Name.ToString(); }), Room.Assets.Num(),
+			Room.bReachable ? TEXT("") : TEXT(" (unreachable)"));
+	}
+	for (const FString& Warning : Warnings)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("URoomGraphCommandlet - %s"), *Warning);
+	}
+	for (const FString& Error : Errors)
+	{
+		UE_LOG(LogAdventureGame, Error, TEXT("URoomGraphCommandlet - %s"), *Error);
+	}
+
+	if (bCheckWalkTo)
+	{
+		FWalkToValidator::SaveCsv(WalkToReports, FPaths::Combine(FPaths::ProfilingDir(),
+			FString::Printf(TEXT("WalkTo-%s.csv"), *FDateTime::Now().ToString())));
+	}
+
+	const bool bSaved = !bSave || SaveGraph(Graph);
+	Graph->RemoveFromRoot();
+	UE_LOG(LogAdventureGame, Display, TEXT("URoomGraphCommandlet - %d rooms, %d doors, %d errors, %d warnings"),
+		Graph->Rooms.Num(), Graph->Doors.Num(), Errors.Num(), Warnings.Num());
+	return Errors.IsEmpty() && bSaved ? 0 : 1;
+}
+
+FString URoomGraphCommandlet::GetPersistentLevel()
+{
+	return FPackageName::ObjectPathToPackageName(UGameMapsSettings::GetGameDefaultMap());
+}
+
+void URoomGraphCommandlet::FindLevels(const FString& Path, bool bIncludeTests, TArray<FString>& OutLevels)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(FName(Path));
+	Filter.bRecursivePaths = true;
+	Filter.ClassPaths.Add(UWorld::StaticClass()->GetClassPathName());
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	const FString PersistentLevel = GetPersistentLevel();
+	for (const FAssetData& Asset : Assets)
+	{
+		const FString PackageName = Asset.PackageName.ToString();
+		if (PackageName == PersistentLevel) continue;
+		if (bIncludeTests || !PackageName.Contains(TEXT("/TestLevels/")))
+		{
+			OutLevels.Add(PackageName);
+		}
+	}
+	OutLevels.Sort();
+}
+
+void URoomGraphCommandlet::AddDoorsInLevel(const FString& LevelPackageName, URoomGraph* Graph, TArray<FString>& OutErrors)
+{
+	const UPackage* Package = LoadPackage(nullptr, *LevelPackageName, LOAD_None);
+	const UWorld* World = Package ? UWorld::FindWorldInPackage(const_cast<UPackage*>(Package)) : nullptr;
+	if (!World || !World->PersistentLevel)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("URoomGraphCommandlet - could not load %s"), *LevelPackageName);
+		return;
+	}
+
+	// Doors name their level the way streaming does, by the short package name
+	const FName LevelName(FPackageName::GetShortName(LevelPackageName));
+	for (const AActor* Actor : World->PersistentLevel->Actors)
+	{
+		const ADoor* Door = Cast<ADoor>(Actor);
+		if (!Door) continue;
+
+		FRoomGraphDoor& Entry = Graph->Doors.AddDefaulted_GetRef();
+		Entry.DoorLabel = Door->DoorLabel;
+		Entry.LevelName = LevelName;
+		Entry.LevelToLoad = Door->LevelToLoad;
+		Entry.ActorName = FName(Door->GetActorNameOrLabel());
+		Entry.EntryTransform = GetLevelTransform(Door->WalkToPoint);
+		Entry.FacingDirection = Door->FacingDirection;
+
+		if (Door->CurrentLevel != LevelName)
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s: door %s has CurrentLevel set to %s"), *LevelName.ToString(),
+				*Entry.ActorName.ToString(), *Door->CurrentLevel.ToString()));
+		}
+	}
+}
+
+void URoomGraphCommandlet::AddRoomAssets(const TArray<FString>& Levels, URoomGraph* Graph)
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TMap<FName, FName> LevelPackages;
+	for (const FString& Level : Levels)
+	{
+		LevelPackages.Add(FName(FPackageName::GetShortName(Level)), FName(Level));
+	}
+	for (FRoomGraphRoom& Room : Graph->Rooms)
+	{
+		Room.Assets.Reset();
+		const FName* LevelPackage = LevelPackages.Find(Room.LevelName);
+		if (!LevelPackage) continue;
+
+		TSet<FName> Packages;
+		GatherDependencies(*LevelPackage, AssetRegistry, Packages);
+		for (const FName& Package : Packages)
+		{
+			TArray<FAssetData> Assets;
+			AssetRegistry.GetAssetsByPackageName(Package, Assets, true);
+			for (const FAssetData& Asset : Assets)
+			{
+				Room.Assets.Add(Asset.GetSoftObjectPath());
+			}
+		}
+		Room.Assets.Sort([](const FSoftObjectPath& A, const FSoftObjectPath& B) { return A.ToString() < B.ToString(); });
+	}
+}
+
+void URoomGraphCommandlet::GatherDependencies(FName PackageName, const IAssetRegistry& AssetRegistry, TSet<FName>& OutPackages)
+{
+	TArray<FName> Dependencies;
+	AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package,
+		UE::AssetRegistry::EDependencyQuery::Game);
+	for (const FName& Dependency : Dependencies)
+	{
+		const FString Name = Dependency.ToString();
+		// Script and engine packages are always loaded, external actors are part of
+		// the level, and levels, with their built data, are streamed by the level
+		// loading itself.
+		if (!Name.StartsWith(TEXT("/Game/")) || Name.StartsWith(TEXT("/Game/__External"))
+			|| Name.EndsWith(TEXT("_BuiltData")) || OutPackages.Contains(Dependency))
+		{
+			continue;
+		}
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(Dependency, Assets, true);
+		if (Assets.ContainsByPredicate([](const FAssetData& Asset)
+		{
+			return Asset.AssetClassPath == UWorld::StaticClass()->GetClassPathName();
+		}))
+		{
+			continue;
+		}
+		OutPackages.Add(Dependency);
+		GatherDependencies(Dependency, AssetRegistry, OutPackages);
+	}
+}
+
+bool URoomGraphCommandlet::SaveGraph(URoomGraph* Graph)
+{
+#if WITH_EDITOR
+	UPackage* Package = Graph->GetPackage();
+	Package->MarkPackageDirty();
+	const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(),
+		FPackageName::GetAssetPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	if (!UPackage::SavePackage(Package, Graph, *Filename, SaveArgs))
+	{
+		UE_LOG(LogAdventureGame, Error, TEXT("URoomGraphCommandlet - could not save %s"), *Filename);
+		return false;
+	}
+	UE_LOG(LogAdventureGame, Display, TEXT("URoomGraphCommandlet - saved %s"), *Filename);
+	return true;
+#else
+	UE_LOG(LogAdventureGame, Error, TEXT("URoomGraphCommandlet - the room graph can only be saved from the editor"));
+	return false;
+#endif
+}
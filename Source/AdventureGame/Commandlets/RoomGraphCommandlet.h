@@ -0,0 +1,59 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "RoomGraphCommandlet.generated.h"
+
+class IAssetRegistry;
+class URoomGraph;
+
+/**
+ * Loads every room level headlessly, that is every level but the persistent one,
+ * extracts the doors in each one and saves them as
+ * a URoomGraph asset. Reports doors with no matching door in their destination,
+ * duplicate door labels within a room, and rooms that cannot be reached from the
+ * starting room. Fills in each room's asset manifest from the asset registry.
+ * With -CheckWalkTo it also checks every hotspot in each room can be walked to,
+ * see FWalkToValidator, and writes a report to the Saved/Profiling folder.
+ *
+ * <code>UnrealEditor-Cmd AdventureGame.uproject -run=RoomGraph [-Path=/Game/PointAndClick/Levels]
+ * [-Output=/Game/PointAndClick/Data/RoomGraph] [-Start=TowerExterior] [-IncludeTests] [-NoSave] [-CheckWalkTo]</code>
+ *
+ * The graph is saved where UAdventureGameInstance::RoomGraphAsset says, and the game
+ * will not start without it, so run this before cooking, after changing any door.
+ * Returns non zero if any errors were found, so it can gate a build.
+ */
+UCLASS()
+class ADVENTUREGAME_API URoomGraphCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	URoomGraphCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/// Long package names of the room levels under the path, leaving out the persistent level.
+	static void FindLevels(const FString& Path, bool bIncludeTests, TArray<FString>& OutLevels);
+
+	/// Long package name of the persistent level the rooms are streamed into.
+	static FString GetPersistentLevel();
+
+	static const TCHAR* DefaultLevelsPath;
+
+private:
+
+	/// Add the doors in the level to the graph.
+	static void AddDoorsInLevel(const FString& LevelPackageName, URoomGraph* Graph, TArray<FString>& OutErrors);
+
+	/// Fill in each room's manifest from the dependencies of its level package.
+	static void AddRoomAssets(const TArray<FString>& Levels, URoomGraph* Graph);
+
+	/// Add the packages the package depends on, hard or soft, to OutPackages,
+	/// without going into other levels or engine and script packages.
+	static void GatherDependencies(FName PackageName, const IAssetRegistry& AssetRegistry, TSet<FName>& OutPackages);
+
+	static bool SaveGraph(URoomGraph* Graph);
+};
@@ -72,4 +72,13 @@ constexpr int32 GMax_Number_Of_Prompts = 5;
 #define G_MAX_BARK_LINES 3
 #define BARK_LINE_DELAY 2.0f
 #define BARK_LINE_WIDTH 30
-#define INVALID_BARK_DELAY -99.0f
\ No newline at end of file
+#define INVALID_BARK_DELAY -99.0f
+
+/// Lines a bark request holds without allocating, after wrapping
+#define BARK_INLINE_LINES 6
+
+/// Requests the bark text widget queues before its overflow policy applies
+#define BARK_QUEUE_CAPACITY 8
+
+/// Wrapped and measured texts kept for barks, prompts and interaction text
+#define TEXT_LAYOUT_CACHE_SIZE 512
\ No newline at end of file
@@ -2,3 +2,24 @@
 
 
 #include "BarkLine.h"
+
+#include "AdventureGame/HUD/TextLayoutCache.h"
+
+void UBarkLine::ShowLine(const FText& NewText, const FColor& Color)
+{
+    if (Text)
+    {
+        FTextLayoutCache::Get().SetText(Text, NewText);
+        Text->SetColorAndOpacity(FSlateColor(Color));
+    }
+    SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+}
+
+void UBarkLine::Recycle()
+{
+    if (Text)
+    {
+        Text->SetText(FText::GetEmpty());
+    }
+    SetVisibility(ESlateVisibility::Collapsed);
+}
@@ -17,4 +17,10 @@ class ADVENTUREGAME_API UBarkLine : public UUserWidget
 public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (BindWidget))
     UTextBlock *Text;
+
+    /// Show the text in the color, making the line visible again if it was recycled.
+    void ShowLine(const FText& NewText, const FColor& Color);
+
+    /// Blank and hide the line, so it can wait in the pool for the next one.
+    void Recycle();
 };
@@ -0,0 +1,96 @@
+// (c) 2025 Sarah Smith
+
+
+#include "BarkLinePool.h"
+
+#include "BarkLine.h"
+#include "AdventureGame/AdventureGame.h"
+#include "Blueprint/UserWidget.h"
+
+FString FBarkLinePoolStats::ToString() const
+{
+    return FString::Printf(TEXT("%d lines acquired, %d made (%d prewarmed, %d grown), %d allocations avoided, at most %d in use"),
+        Acquired, GetMade(), Prewarmed, Grown, GetAllocationsAvoided(), HighWater);
+}
+
+void UBarkLinePool::Init(UWidget* OwningWidget, TSubclassOf<UBarkLine> LineClass, int32 PrewarmCount)
+{
+    OwnerWidget = OwningWidget;
+    OwnerWorld = nullptr;
+    Prewarm(LineClass, PrewarmCount);
+}
+
+void UBarkLinePool::Init(UWorld* OwningWorld, TSubclassOf<UBarkLine> LineClass, int32 PrewarmCount)
+{
+    OwnerWidget = nullptr;
+    OwnerWorld = OwningWorld;
+    Prewarm(LineClass, PrewarmCount);
+}
+
+void UBarkLinePool::Prewarm(TSubclassOf<UBarkLine> LineClass, int32 PrewarmCount)
+{
+    BarkLineClass = LineClass;
+    FreeLines.Reset(PrewarmCount);
+    InUse = 0;
+    Stats = FBarkLinePoolStats();
+    if (!BarkLineClass)
+    {
+        UE_LOG(LogAdventureGame, Warning, TEXT("BarkLinePool - no bark line class, nothing prewarmed"));
+        return;
+    }
+    for (int32 Index = 0; Index < PrewarmCount; ++Index)
+    {
+        if (UBarkLine* Line = MakeLine())
+        {
+            Line->Recycle();
+            FreeLines.Add(Line);
+        }
+    }
+    Stats.Prewarmed = FreeLines.Num();
+}
+
+UBarkLine* UBarkLinePool::MakeLine() const
+{
+    if (OwnerWidget)
+    {
+        return CreateWidget<UBarkLine>(OwnerWidget, BarkLineClass);
+    }
+    if (OwnerWorld)
+    {
+        return CreateWidget<UBarkLine>(OwnerWorld, BarkLineClass);
+    }
+    return nullptr;
+}
+
+UBarkLine* UBarkLinePool::Acquire()
+{
+    UBarkLine* Line = nullptr;
+    if (!FreeLines.IsEmpty())
+    {
+        Line = FreeLines.Pop(EAllowShrinking::No);
+    }
+    else if (BarkLineClass)
+    {
+        Line = MakeLine();
+        if (!Line) return nullptr;
+        ++Stats.Grown;
+        UE_LOG(LogAdventureGame, Verbose, TEXT("BarkLinePool - all %d lines in use, made another"), InUse);
+    }
+    else
+    {
+        return nullptr;
+    }
+    ++InUse;
+    ++Stats.Acquired;
+    Stats.HighWater = FMath::Max(Stats.HighWater, InUse);
+    return Line;
+}
+
+void UBarkLinePool::Release(UBarkLine* Line)
+{
+    if (!IsValid(Line) || FreeLines.Contains(Line)) return;
+    Line->RemoveFromParent();
+    Line->Recycle();
+    FreeLines.Add(Line);
+    InUse = FMath::Max(InUse - 1, 0);
+}
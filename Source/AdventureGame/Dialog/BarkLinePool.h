@@ -0,0 +1,83 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+#include "BarkLinePool.generated.h"
+
+class UBarkLine;
+class UWidget;
+
+struct ADVENTUREGAME_API FBarkLinePoolStats
+{
+    /// Lines made up front, when the pool was initialized.
+    int32 Prewarmed = 0;
+
+    /// Lines made later because every one was in use.
+    int32 Grown = 0;
+
+    /// Lines handed out, each of which was a CreateWidget before the pool.
+    int32 Acquired = 0;
+
+    /// Most lines in use at once.
+    int32 HighWater = 0;
+
+    int32 GetMade() const { return Prewarmed + Grown; }
+
+    /// Widgets that did not have to be made, or collected, because a line was reused.
+    int32 GetAllocationsAvoided() const { return FMath::Max(Acquired - GetMade(), 0); }
+
+    FString ToString() const;
+};
+
+/**
+ * Bark line widgets, made once and recycled. Lines are taken for each line of a bark
+ * and given back when it is cleared, blanked and hidden, instead of being made for every
+ * line and left for the garbage collector. The pool only grows when every line is in use.
+ */
+UCLASS()
+class ADVENTUREGAME_API UBarkLinePool : public UObject
+{
+    GENERATED_BODY()
+public:
+    /// Make the lines up front, owned by the widget that shows them.
+    void Init(UWidget* OwningWidget, TSubclassOf<UBarkLine> LineClass, int32 PrewarmCount);
+
+    /// Make the lines up front, owned by the world, for lines with no owning widget.
+    void Init(UWorld* OwningWorld, TSubclassOf<UBarkLine> LineClass, int32 PrewarmCount);
+
+    /// A blank line to show, made only if all of the pool's lines are in use.
+    UBarkLine* Acquire();
+
+    /// Take back a line, removing it from its container.
+    void Release(UBarkLine* Line);
+
+    int32 NumFree() const { return FreeLines.Num(); }
+
+    int32 NumInUse() const { return InUse; }
+
+    const FBarkLinePoolStats& GetStats() const { return Stats; }
+
+private:
+    void Prewarm(TSubclassOf<UBarkLine> LineClass, int32 PrewarmCount);
+
+    UBarkLine* MakeLine() const;
+
+    UPROPERTY()
+    TSubclassOf<UBarkLine> BarkLineClass;
+
+    UPROPERTY()
+    UWidget* OwnerWidget = nullptr;
+
+    UPROPERTY()
+    UWorld* OwnerWorld = nullptr;
+
+    UPROPERTY()
+    TArray<UBarkLine*> FreeLines;
+
+    int32 InUse = 0;
+
+    FBarkLinePoolStats Stats;
+};
@@ -0,0 +1,76 @@
+// (c) 2025 Sarah Smith
+
+
+#include "BarkQueue.h"
+
+FString FBarkQueueStats::ToString() const
+{
+    return FString::Printf(TEXT("%d queued, %d dropped, %d merged, %d rejected, at most %d waiting"),
+        Queued, Dropped, Merged, Rejected, HighWater);
+}
+
+void FBarkQueue::Init(int32 Capacity)
+{
+    Slots.Empty(FMath::Max(Capacity, 1));
+    Slots.SetNum(FMath::Max(Capacity, 1));
+    Head = 0;
+    Count = 0;
+}
+
+bool FBarkQueue::Push(FBarkRequest&& Request, EBarkOverflowPolicy Policy, FBarkRequest& OutUnbarked)
+{
+    if (IsFull())
+    {
+        if (Policy == EBarkOverflowPolicy::Reject)
+        {
+            ++Stats.Rejected;
+            OutUnbarked = MoveTemp(Request);
+            return false;
+        }
+        FBarkRequest& Last = Slot(Count - 1);
+        if (Policy == EBarkOverflowPolicy::Merge && Last.HasSameSpeaker(Request))
+        {
+            ++Stats.Merged;
+            Last.Merge(MoveTemp(Request));
+            return true;
+        }
+        ++Stats.Dropped;
+        Pop(OutUnbarked);
+    }
+    Slot(Count) = MoveTemp(Request);
+    ++Count;
+    ++Stats.Queued;
+    Stats.HighWater = FMath::Max(Stats.HighWater, Count);
+    return true;
+}
+
+bool FBarkQueue::Pop(FBarkRequest& OutRequest)
+{
+    if (IsEmpty()) return false;
+    OutRequest = MoveTemp(Slot(0));
+    // Leave the slot empty, rather than holding the moved from lines
+    Slot(0) = FBarkRequest();
+    Head = (Head + 1) % Slots.Num();
+    --Count;
+    return true;
+}
+
+void FBarkQueue::Reset()
+{
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        Slot(Index) = FBarkRequest();
+    }
+    Head = 0;
+    Count = 0;
+}
+
+SIZE_T FBarkQueue::GetAllocatedSize() const
+{
+    SIZE_T Size = Slots.GetAllocatedSize();
+    for (const FBarkRequest& Request : Slots)
+    {
+        Size += Request.GetAllocatedSize();
+    }
+    return Size;
+}
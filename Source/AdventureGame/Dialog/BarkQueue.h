@@ -0,0 +1,76 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "BarkRequest.h"
+#include "AdventureGame/Enums/BarkOverflowPolicy.h"
+
+struct ADVENTUREGAME_API FBarkQueueStats
+{
+    int32 Queued = 0;
+
+    /// Requests dropped to make room for newer ones.
+    int32 Dropped = 0;
+
+    /// Requests added to the lines of the last queued one.
+    int32 Merged = 0;
+
+    /// Requests turned away because the queue was full.
+    int32 Rejected = 0;
+
+    /// Most requests waiting at once.
+    int32 HighWater = 0;
+
+    FString ToString() const;
+};
+
+///
+/// Fixed size ring buffer of the bark requests waiting to be shown. The slots are
+/// made once, up front, and requests are moved in and out of them, so queueing a
+/// bark allocates nothing. When it is full, the overflow policy says what gives.
+class ADVENTUREGAME_API FBarkQueue
+{
+public:
+    explicit FBarkQueue(int32 Capacity = BARK_QUEUE_CAPACITY) { Init(Capacity); }
+
+    /// Make the slots, dropping anything queued.
+    void Init(int32 Capacity);
+
+    /// Queue a request, or if the queue is full do what the policy says. A request
+    /// that will not now be barked, either one dropped or this one turned away, is
+    /// moved to OutUnbarked, so its UIDs can be reported. False if this one was turned away.
+    bool Push(FBarkRequest&& Request, EBarkOverflowPolicy Policy, FBarkRequest& OutUnbarked);
+
+    /// Take the request that has waited longest. False if there is none.
+    bool Pop(FBarkRequest& OutRequest);
+
+    /// Drop everything queued.
+    void Reset();
+
+    bool IsEmpty() const { return Count == 0; }
+
+    bool IsFull() const { return Count == Slots.Num(); }
+
+    int32 Num() const { return Count; }
+
+    int32 GetCapacity() const { return Slots.Num(); }
+
+    /// Heap bytes held by the slots, and by any requests with more lines than fit inline.
+    SIZE_T GetAllocatedSize() const;
+
+    const FBarkQueueStats& GetStats() const { return Stats; }
+
+private:
+    FBarkRequest& Slot(int32 Index) { return Slots[(Head + Index) % Slots.Num()]; }
+
+    TArray<FBarkRequest> Slots;
+
+    /// Slot of the request that has waited longest.
+    int32 Head = 0;
+
+    int32 Count = 0;
+
+    FBarkQueueStats Stats;
+};
@@ -4,29 +4,30 @@
 #include "AdventureGame/AdventureGame.h"
 #include "AdventureGame/Gameplay/AdvBlueprintFunctionLibrary.h"
 #include "AdventureGame/HUD/AdvGameUtils.h"
+#include "AdventureGame/HUD/TextLayoutCache.h"
 
-FBarkRequest::FBarkRequest(const TArray<FText>& NewBarkLines, const int32 UID,
+FBarkRequest::FBarkRequest(TConstArrayView<FText> NewBarkLines, const int32 UID,
                            const FColor Color, USphereComponent* Position,
                            const float Duration, const bool IsPlayer)
-    : NextRequest(nullptr)
+    : BarkLines(NewBarkLines)
       , RequestUID(UID)
       , RequestColor(Color)
       , RequestPosition(Position)
       , RequestDuration(Duration)
       , IsPlayerRequest(IsPlayer)
 {
-    Algo::Copy(NewBarkLines, BarkLines);
+    //
 }
 
 FBarkRequest::FBarkRequest(const FText& NewBarkLine, const int32 UID,
                            const FColor Color, USphereComponent* Position,
                            const float Duration, const bool IsPlayer)
-    : FBarkRequest(TArray({NewBarkLine}), UID, Color, Position, Duration, IsPlayer)
+    : FBarkRequest(MakeArrayView(&NewBarkLine, 1), UID, Color, Position, Duration, IsPlayer)
 {
     //
 }
 
-FBarkRequest* FBarkRequest::CreatePlayerMultilineRequest(const TArray<FText>& NewBarkLines, float Duration, int32 UID)
+FBarkRequest FBarkRequest::CreatePlayerMultilineRequest(TConstArrayView<FText> NewBarkLines, float Duration, int32 UID)
 {
     if (UID == BARK_UID_NONE)
     {
@@ -37,7 +38,7 @@ FBarkRequest* FBarkRequest::CreatePlayerMultilineRequest(const TArray<FText>& Ne
     if (NewBarkLines.IsEmpty())
     {
         UE_LOG(LogAdventureGame, Warning, TEXT("Created player bark with blank text"));
-        return new FBarkRequest(NewBarkLines, UID, Color, nullptr, Duration);
+        return FBarkRequest(NewBarkLines, UID, Color, nullptr, Duration);
     }
 #endif
     if (Duration == 0.0f)
@@ -47,43 +48,68 @@ FBarkRequest* FBarkRequest::CreatePlayerMultilineRequest(const TArray<FText>& Ne
             Duration += UAdvBlueprintFunctionLibrary::GetBarkTime(Text.ToString());
         }
     }
-    if (HasLongLines(NewBarkLines))
+    if (!HasLongLines(NewBarkLines))
     {
-        TArray<FText> ShortTexts;
-        uint32 Index = 0;
-        TSet<uint32> IsContinuation;
-        for (const FText& Text : NewBarkLines)
+        return FBarkRequest(NewBarkLines, UID, Color, nullptr, Duration);
+    }
+    FBarkRequest Request(TConstArrayView<FText>(), UID, Color, nullptr, Duration);
+    for (const FText& Text : NewBarkLines)
+    {
+        if (Text.ToString().Len() > BARK_LINE_WIDTH)
         {
-            if (Text.ToString().Len() > BARK_LINE_WIDTH)
-            {
-                TArray<FText> Wrapped = AdvGameUtils::WrapTextLinesToMaxCharacters(Text, BARK_LINE_WIDTH);
-                ShortTexts.Append(Wrapped);
-                for (int W = 1; W < Wrapped.Num(); W++)
-                {
-                    IsContinuation.Add(W + Index);
-                }
-            }
-            else
+            const int32 First = Request.BarkLines.Num();
+            // Lines said again are wrapped once, and their texts shared
+            Request.BarkLines.Append(FTextLayoutCache::Get().GetLayout(Text, BARK_LINE_WIDTH).Lines);
+            for (int32 Line = First + 1; Line < FMath::Min(Request.BarkLines.Num(), 64); ++Line)
             {
-                ShortTexts.Add(Text);
-                ++Index;
+                Request.ContinuationMask |= 1ull << Line;
             }
         }
-        FBarkRequest *Request = new FBarkRequest(ShortTexts, UID, Color, nullptr, Duration);
-        Request->IsContinuation = IsContinuation;
+        else
+        {
+            Request.BarkLines.Add(Text);
+        }
     }
-    return new FBarkRequest(NewBarkLines, UID, Color, nullptr, Duration);
+    return Request;
 }
 
 float FBarkRequest::GetDurationForLine(const int32 LineIndex) const
 {
-    if (IsContinuation.Contains(LineIndex)) return 0.0f;
+    if (IsContinuation(LineIndex)) return 0.0f;
     if (LineIndex < BarkLines.Num() - 1) return BARK_LINE_DELAY;
-    const uint32 DiscreteLineCount = BarkLines.Num() - IsContinuation.Num();
+    const uint32 DiscreteLineCount = BarkLines.Num() - FMath::CountBits(ContinuationMask);
     return BARK_LINE_DELAY * DiscreteLineCount;
 }
 
-FBarkRequest* FBarkRequest::CreatePlayerRequest(const FText& NewBarkLine, const float Duration, const int32 UID)
+bool FBarkRequest::IsContinuation(const int32 LineIndex) const
+{
+    return LineIndex >= 0 && LineIndex < 64 && (ContinuationMask & (1ull << LineIndex)) != 0;
+}
+
+bool FBarkRequest::HasSameSpeaker(const FBarkRequest& Other) const
+{
+    return IsPlayerRequest == Other.IsPlayerRequest && RequestPosition == Other.RequestPosition
+        && RequestColor == Other.RequestColor;
+}
+
+void FBarkRequest::Merge(FBarkRequest&& Other)
+{
+    const int32 First = BarkLines.Num();
+    for (int32 Line = 0; Line < Other.BarkLines.Num(); ++Line)
+    {
+        BarkLines.Add(MoveTemp(Other.BarkLines[Line]));
+        if (Other.IsContinuation(Line) && First + Line < 64)
+        {
+            ContinuationMask |= 1ull << (First + Line);
+        }
+    }
+    RequestDuration += Other.RequestDuration;
+    if (Other.RequestUID != BARK_UID_NONE) MergedUIDs.Add(Other.RequestUID);
+    MergedUIDs.Append(Other.MergedUIDs);
+    Other = FBarkRequest();
+}
+
+FBarkRequest FBarkRequest::CreatePlayerRequest(const FText& NewBarkLine, const float Duration, const int32 UID)
 {
     if (NewBarkLine.ToString().Contains(NEW_LINE_SEPARATOR))
     {
@@ -92,45 +118,45 @@ FBarkRequest* FBarkRequest::CreatePlayerRequest(const FText& NewBarkLine, const
     }
     else
     {
-        return CreatePlayerMultilineRequest({NewBarkLine}, Duration, UID);
+        return CreatePlayerMultilineRequest(MakeArrayView(&NewBarkLine, 1), Duration, UID);
     }
 }
 
-FBarkRequest* FBarkRequest::CreateNPCRequest(const FText& NewBarkLine, const float Duration, USphereComponent* Position,
-                                             const FColor Color,
-                                             const int32 UID)
+FBarkRequest FBarkRequest::CreateNPCRequest(const FText& NewBarkLine, const float Duration, USphereComponent* Position,
+                                            const FColor Color,
+                                            const int32 UID)
 {
-    FBarkRequest* NPCRequest = CreatePlayerRequest(NewBarkLine, Duration, UID);
-    NPCRequest->IsPlayerRequest = false;
-    NPCRequest->RequestPosition = Position;
-    NPCRequest->RequestColor = Color;
+    FBarkRequest NPCRequest = CreatePlayerRequest(NewBarkLine, Duration, UID);
+    NPCRequest.IsPlayerRequest = false;
+    NPCRequest.RequestPosition = Position;
+    NPCRequest.RequestColor = Color;
     return NPCRequest;
 }
 
-FBarkRequest* FBarkRequest::CreateNPCMultilineRequest(const TArray<FText>& NewBarkLines, float Duration,
-                                                      USphereComponent* Position, FColor Color,
-                                                      int32 UID)
+FBarkRequest FBarkRequest::CreateNPCMultilineRequest(TConstArrayView<FText> NewBarkLines, float Duration,
+                                                     USphereComponent* Position, FColor Color,
+                                                     int32 UID)
 {
-    FBarkRequest* NPCRequest = CreatePlayerMultilineRequest(NewBarkLines, Duration, UID);
-    NPCRequest->IsPlayerRequest = false;
-    NPCRequest->RequestPosition = Position;
-    NPCRequest->RequestColor = Color;
+    FBarkRequest NPCRequest = CreatePlayerMultilineRequest(NewBarkLines, Duration, UID);
+    NPCRequest.IsPlayerRequest = false;
+    NPCRequest.RequestPosition = Position;
+    NPCRequest.RequestColor = Color;
     return NPCRequest;
 }
 
-void FBarkRequest::Dump(const FBarkRequest* Request)
+void FBarkRequest::Dump(const FBarkRequest& Request)
 {
     UE_LOG(LogAdventureGame, Warning, TEXT("Bark request ==================="));
     UE_LOG(LogAdventureGame, Warning, TEXT("UID: %d - Color: %s - IsPlayer: %hs"),
-           Request->RequestUID, *Request->RequestColor.ToHex(), Request->IsPlayerRequest ? "true" : "false");
-    for (const FText& Line : Request->BarkLines)
+           Request.RequestUID, *Request.RequestColor.ToHex(), Request.IsPlayerRequest ? "true" : "false");
+    for (const FText& Line : Request.BarkLines)
     {
         UE_LOG(LogAdventureGame, Warning, TEXT("%s"), *Line.ToString());
     }
     UE_LOG(LogAdventureGame, Warning, TEXT("Bark request ==================="));
 }
 
-bool FBarkRequest::HasLongLines(const TArray<FText>& NewBarkLines)
+bool FBarkRequest::HasLongLines(TConstArrayView<FText> NewBarkLines)
 {
     const auto Result = Algo::FindBy(NewBarkLines, true, [](const FText& Text) { return Text.ToString().Len() > BARK_LINE_WIDTH; });
     return Result != nullptr;
@@ -3,10 +3,20 @@
 
 class USphereComponent;
 
-class FBarkRequest
+/// Lines of a bark, held inline up to BARK_INLINE_LINES.
+typedef TArray<FText, TInlineAllocator<BARK_INLINE_LINES>> FBarkLines;
+
+/**
+ * A request to bark some lines of text, with who says it, in what color and for how long.
+ * Requests are values, moved from where they are made into the bark queue and out of it
+ * to be shown, and never copied, so nothing is allocated for them on the way.
+ */
+class ADVENTUREGAME_API FBarkRequest
 {
 public:
-    explicit FBarkRequest(const TArray<FText>& NewBarkLines, int32 UID = BARK_UID_NONE,
+    FBarkRequest() = default;
+
+    explicit FBarkRequest(TConstArrayView<FText> NewBarkLines, int32 UID = BARK_UID_NONE,
                           FColor Color = G_NPC_Default_Text_Colour.ToFColor(true),
                           USphereComponent* Position = nullptr, float Duration = 0.0f, bool IsPlayer = true);
 
@@ -14,7 +24,12 @@ public:
                           FColor Color = G_NPC_Default_Text_Colour.ToFColor(true),
                           USphereComponent* Position = nullptr, float Duration = 0.0f, bool IsPlayer = true);
 
-    void GetBarkLines(TArray<FText>&OutBarkLines) const { Algo::Copy(BarkLines, OutBarkLines); }
+    FBarkRequest(FBarkRequest&&) = default;
+    FBarkRequest& operator=(FBarkRequest&&) = default;
+    FBarkRequest(const FBarkRequest&) = delete;
+    FBarkRequest& operator=(const FBarkRequest&) = delete;
+
+    TConstArrayView<FText> GetBarkLines() const { return BarkLines; }
 
     int32 GetLineCount() const { return BarkLines.Num(); }
 
@@ -30,7 +45,21 @@ public:
 
     float GetDurationForLine(int32 LineIndex) const;
 
-    FBarkRequest *NextRequest;
+    /// Is the line the rest of a longer one, wrapped to fit.
+    bool IsContinuation(int32 LineIndex) const;
+
+    /// Said by the same speaker, in the same place and color, so the lines of one can follow the other's.
+    bool HasSameSpeaker(const FBarkRequest& Other) const;
+
+    /// Add the lines of a request by the same speaker after these ones. Its UID is kept
+    /// with this request's, to be reported when this one finishes.
+    void Merge(FBarkRequest&& Other);
+
+    /// UIDs of requests merged into this one.
+    TConstArrayView<int32> GetMergedUIDs() const { return MergedUIDs; }
+
+    /// Heap bytes held, which is none unless there are more lines or merged requests than fit inline.
+    SIZE_T GetAllocatedSize() const { return BarkLines.GetAllocatedSize() + MergedUIDs.GetAllocatedSize(); }
 
     /**
      * Create a bark text request for the Player. Use this for lines which may have newline
@@ -44,7 +73,7 @@ public:
      * @param UID Identifier for this request, or leave as <code>BARK_UID_NONE</code> ( -1 ) to have one assigned
      * @return Complete request ready to bark
      */
-    static FBarkRequest* CreatePlayerRequest(const FText& NewBarkLine, float Duration = 0.0f, int32 UID = BARK_UID_NONE);
+    static FBarkRequest CreatePlayerRequest(const FText& NewBarkLine, float Duration = 0.0f, int32 UID = BARK_UID_NONE);
 
     /**
      * Create a bark text request for the Player. Use this for data table
@@ -58,8 +87,8 @@ public:
      * @param UID Identifier for this request, or leave as <code>BARK_UID_NONE</code> ( -1 ) to have one assigned
      * @return Complete request ready to bark
      */
-    static FBarkRequest* CreatePlayerMultilineRequest(const TArray<FText>& NewBarkLines, float Duration = 0.0f,
-                                                      int32 UID = BARK_UID_NONE);
+    static FBarkRequest CreatePlayerMultilineRequest(TConstArrayView<FText> NewBarkLines, float Duration = 0.0f,
+                                                     int32 UID = BARK_UID_NONE);
 
     /**
      * Create a bark text request for an NPC. Use this for lines which may have newline
@@ -73,10 +102,10 @@ public:
      * @param UID Identifier for this request, or leave as BARK_UID_NONE to have one assigned
      * @return Complete request ready to bark
      */
-    static FBarkRequest* CreateNPCRequest(const FText& NewBarkLine, float Duration,
-                                          USphereComponent* Position,
-                                          FColor Color = G_NPC_Default_Text_Colour.ToFColor(true),
-                                          int32 UID = BARK_UID_NONE);
+    static FBarkRequest CreateNPCRequest(const FText& NewBarkLine, float Duration,
+                                         USphereComponent* Position,
+                                         FColor Color = G_NPC_Default_Text_Colour.ToFColor(true),
+                                         int32 UID = BARK_UID_NONE);
 
     /**
      * Create a bark text request for the Player. Use this for data table
@@ -90,23 +119,23 @@ public:
      * @param UID Identifier for this request, or leave as BARK_UID_NONE to have one assigned
      * @return Complete request ready to bark
      */
-    static FBarkRequest* CreateNPCMultilineRequest(const TArray<FText>& NewBarkLines, float Duration = 0.0f,
-                                                   USphereComponent* Position = nullptr,
-                                                   FColor Color = G_NPC_Default_Text_Colour.ToFColor(true),
-                                                   int32 UID = BARK_UID_NONE);
+    static FBarkRequest CreateNPCMultilineRequest(TConstArrayView<FText> NewBarkLines, float Duration = 0.0f,
+                                                  USphereComponent* Position = nullptr,
+                                                  FColor Color = G_NPC_Default_Text_Colour.ToFColor(true),
+                                                  int32 UID = BARK_UID_NONE);
 
-    static void Dump(const FBarkRequest* Request);
+    static void Dump(const FBarkRequest& Request);
 
-    static bool HasLongLines(const TArray<FText>& NewBarkLines);
+    static bool HasLongLines(TConstArrayView<FText> NewBarkLines);
 
 private:
-    TSet<unsigned int> IsContinuation;
-    TArray<FText> BarkLines;
-    int32 RequestUID = 0.0;
+    FBarkLines BarkLines;
+    /// Bit for each line that is a continuation, for the first 64 lines
+    uint64 ContinuationMask = 0;
+    TArray<int32, TInlineAllocator<2>> MergedUIDs;
+    int32 RequestUID = BARK_UID_NONE;
     FColor RequestColor;
     USphereComponent* RequestPosition = nullptr;
     float RequestDuration = 0.0f;
     bool IsPlayerRequest = false;
-    mutable int TotalLineCount = 0;
-    mutable int TotalCharacterCount = 0;
 };
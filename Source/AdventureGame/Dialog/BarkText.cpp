@@ -4,7 +4,9 @@
 #include "BarkText.h"
 
 #include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/Gameplay/SimulationClock.h"
 #include "BarkLine.h"
+#include "BarkLinePool.h"
 #include "BarkRequest.h"
 #include "AdventureGame/Player/AdventureCharacter.h"
 #include "AdventureGame/Player/AdventurePlayerController.h"
@@ -19,6 +21,9 @@ void UBarkText::NativeOnInitialized()
     HideContainer();
     bIsBarking = false;
     ViewTarget = nullptr;
+    RequestQueue.Init(BarkQueueCapacity);
+    BarkLinePool = NewObject<UBarkLinePool>(this);
+    BarkLinePool->Init(this, BarkLineClass, BarkLinePoolSize);
 }
 
 void UBarkText::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
@@ -46,7 +51,7 @@ void UBarkText::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
         }
     }
 
-    if (bIsBarking)
+    if (bIsBarking && !FSimulationClock::IsFastForward())
     {
         BarkLineTimer -= InDeltaTime;
         if (BarkLineTimer <= 0.f)
@@ -58,6 +63,7 @@ void UBarkText::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 
 void UBarkText::NativeDestruct()
 {
+    ClearBarkLineTimer();
     ClearBarkQueue();
     Super::NativeDestruct();
 }
@@ -71,24 +77,55 @@ void UBarkText::OnUserInteracted()
     }
 }
 
-void UBarkText::AddBarkRequest(const FBarkRequest *BarkRequest)
+void UBarkText::AddBarkRequest(FBarkRequest&& BarkRequest)
 {
     // UE_LOG(LogAdventureGame, Warning, TEXT("AddBarkRequest"));
-    // FBarkRequest::Dump(const_cast<FBarkRequest *>(BarkRequest));
-    AddToLinkedList(BarkRequest);
+    // FBarkRequest::Dump(BarkRequest);
+    FBarkRequest Unbarked;
+    RequestQueue.Push(MoveTemp(BarkRequest), BarkOverflowPolicy, Unbarked);
+    if (Unbarked.GetUID() != BARK_UID_NONE || !Unbarked.GetMergedUIDs().IsEmpty())
+    {
+        UE_LOG(LogAdventureGame, Verbose, TEXT("AddBarkRequest - queue full, UID %d not barked"), Unbarked.GetUID());
+        BroadcastFinished(Unbarked, EBarkRequestFinishedReason::Interruption);
+    }
     if (!bIsBarking)
     {
-        LoadNextBarkRequest();
-        bIsBarking = true;
-        BarkLineTimer = 0.1f;
+        StartNextBarkRequest();
+    }
+}
+
+void UBarkText::StartNextBarkRequest()
+{
+    LoadNextBarkRequest();
+    bIsBarking = true;
+    BarkLineTimer = 0.1f;
+    StartFastForwardTimer();
+}
+
+void UBarkText::BroadcastFinished(const FBarkRequest& BarkRequest, EBarkRequestFinishedReason Reason)
+{
+    auto Broadcast = [this, Reason](int32 UID)
+    {
+        switch (Reason)
+        {
+        case EBarkRequestFinishedReason::Timeout:
+            BarkRequestCompleteDelegate.Broadcast(UID);
+            break;
+        case EBarkRequestFinishedReason::Interruption:
+            BarkRequestInterruptedDelegate.Broadcast(UID);
+            break;
+        }
+    };
+    Broadcast(BarkRequest.GetUID());
+    for (const int32 UID : BarkRequest.GetMergedUIDs())
+    {
+        Broadcast(UID);
     }
 }
 
 void UBarkText::SetText(const FText &NewText)
 {
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT(">> ============== SetText ================"));
-    APlayerController* PlayerController = GetOwningPlayer();
-    check(PlayerController);
     check(BarkLineClass);
     DumpBarkText();
     if (BarkContainer->GetChildrenCount() >= G_MAX_BARK_LINES)
@@ -96,15 +133,13 @@ void UBarkText::SetText(const FText &NewText)
         UWidget *OldChild = BarkContainer->GetChildAt(0);
         BarkContainer->ShiftChild(2, OldChild);
         UBarkLine *BarkLine = Cast<UBarkLine>(OldChild);
-        BarkLine->Text->SetText(NewText);
+        BarkLine->ShowLine(NewText, BarkTextColor);
         return;
     }
-    UUserWidget* Widget = CreateWidget(PlayerController, BarkLineClass);
-    if (UBarkLine* BarkLine = Cast<UBarkLine>(Widget))
+    if (UBarkLine* BarkLine = BarkLinePool->Acquire())
     {
-        BarkLine->Text->SetText(NewText);
-        BarkLine->Text->SetColorAndOpacity(BarkTextColor);
-        BarkContainer->AddChildToVerticalBox(Widget);
+        BarkLine->ShowLine(NewText, BarkTextColor);
+        BarkContainer->AddChildToVerticalBox(BarkLine);
     }
     IsOneLineAtMinimumSet = true;
     DumpBarkText();
@@ -114,11 +149,15 @@ void UBarkText::SetText(const FText &NewText)
 void UBarkText::ClearText()
 {
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("ClearText"));
-    HideContainer();
     ClearBarkQueue();
+    ClearLines();
+}
+
+void UBarkText::ClearLines()
+{
+    HideContainer();
     ClearBarkLineTimer();
-    BarkContainer->ClearChildren();
-    BarkLines.Empty();
+    ReleaseLines();
     bWarningShown = false;
     CurrentUID = BARK_UID_NONE;
     CurrentBarkLine = 0;
@@ -126,6 +165,19 @@ void UBarkText::ClearText()
     IsOneLineAtMinimumSet = false;
 }
 
+void UBarkText::ReleaseLines()
+{
+    for (int32 Index = BarkContainer->GetChildrenCount() - 1; Index >= 0; --Index)
+    {
+        if (UBarkLine* BarkLine = Cast<UBarkLine>(BarkContainer->GetChildAt(Index)); BarkLine && BarkLinePool)
+        {
+            BarkLinePool->Release(BarkLine);
+        }
+    }
+    // Anything not from the pool
+    BarkContainer->ClearChildren();
+}
+
 void UBarkText::HideContainer()
 {
     if (IsHidden) return;
@@ -142,36 +194,19 @@ void UBarkText::ShowContainer()
     IsHidden = false;
 }
 
-void UBarkText::SetBarkLines(const TArray<FText>& NewBarkLines)
-{
-    ClearText();
-    if (NewBarkLines.Num() == 0) return;
-    SetText(NewBarkLines[0]);
-    if (NewBarkLines.Num() > 1)
-    {
-        auto It = NewBarkLines.begin();
-        for (++It; It != NewBarkLines.end(); ++It)
-        {
-            const FText& Line = *It;
-            BarkLines.Add(*It);
-        }
-        SetBarkLineTimer();
-    }
-}
-
 void UBarkText::LoadNextBarkRequest()
 {
-    CurrentBarkRequest = PopBarkRequest();
-    if (!CurrentBarkRequest)
+    bHasCurrentRequest = RequestQueue.Pop(CurrentBarkRequest);
+    if (!bHasCurrentRequest)
     {
         UE_LOG(LogAdventureGame, Warning, TEXT("Bark Request Loading Failed"));
         return;
     }
-    BarkLines.Empty();
-    CurrentBarkRequest->GetBarkLines(BarkLines);
-    CurrentUID = CurrentBarkRequest->GetUID();
-    UE_LOG(LogAdventureGame, Verbose, TEXT("LoadNextBarkRequest: %d - %s"), CurrentUID, *BarkLines[0].ToString());
-    BarkPosition = CurrentBarkRequest->GetPosition();
+    CurrentBarkLine = 0;
+    CurrentUID = CurrentBarkRequest.GetUID();
+    UE_LOG(LogAdventureGame, Verbose, TEXT("LoadNextBarkRequest: %d - %s"), CurrentUID,
+        CurrentBarkRequest.GetLineCount() > 0 ? *CurrentBarkRequest.GetBarkLines()[0].ToString() : TEXT(""));
+    BarkPosition = CurrentBarkRequest.GetPosition();
     if (!IsValid(BarkPosition))
     {
         UE_LOG(LogAdventureGame, Verbose, TEXT("BarkPosition Invalid - GetAdventureCharacter"));
@@ -180,15 +215,16 @@ void UBarkText::LoadNextBarkRequest()
             BarkPosition = AdventureCharacter->Sphere;
         }
     }
-    BarkLineDisplayTime = CurrentBarkRequest->GetDuration();
+    BarkLineDisplayTime = CurrentBarkRequest.GetDuration();
     if (OverrideDisplayTime != INVALID_BARK_DELAY) BarkLineDisplayTime = OverrideDisplayTime;
-    BarkTextColor = CurrentBarkRequest->GetColor();
+    BarkTextColor = CurrentBarkRequest.GetColor();
 }
 
 void UBarkText::AddQueuedBarkLine(EBarkRequestFinishedReason Reason)
 {
+    const TConstArrayView<FText> BarkLines = CurrentBarkRequest.GetBarkLines();
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("AddQueuedBarkLine - count: %d - current: %d"), BarkLines.Num(), CurrentBarkLine);
-    if (CurrentBarkLine < BarkLines.Num())
+    if (bHasCurrentRequest && CurrentBarkLine < BarkLines.Num())
     {
         HideContainer();
         IsRenderTransitionSet = false;
@@ -201,25 +237,21 @@ void UBarkText::AddQueuedBarkLine(EBarkRequestFinishedReason Reason)
     else
     {
         UE_LOG(LogAdventureGame, VeryVerbose, TEXT("AddQueuedBarkLine - no more lines - doing clean up"));
-        if (CurrentBarkRequest)
-        delete CurrentBarkRequest;
-        CurrentBarkRequest = nullptr;
+        // Moved out first, as the listeners may queue another request
+        const FBarkRequest Finished = MoveTemp(CurrentBarkRequest);
+        CurrentBarkRequest = FBarkRequest();
+        const bool bHadRequest = bHasCurrentRequest;
+        bHasCurrentRequest = false;
         UE_LOG(LogAdventureGame, VeryVerbose, TEXT("AddQueuedBarkLine - UID %d, broadcasting - doing clean up"), CurrentUID);
-        switch (Reason)
+        if (bHadRequest)
         {
-        case EBarkRequestFinishedReason::Timeout:
-            BarkRequestCompleteDelegate.Broadcast(CurrentUID);
-            break;
-        case EBarkRequestFinishedReason::Interruption:
-            BarkRequestInterruptedDelegate.Broadcast(CurrentUID);
-            break;
+            BroadcastFinished(Finished, Reason);
         }
         HideContainer();
-        ClearText();
-        if (RequestQueue)
+        ClearLines();
+        if (!RequestQueue.IsEmpty())
         {
-            LoadNextBarkRequest();
-            SetBarkLineTimer();
+            StartNextBarkRequest();
         }
         else
         {
@@ -231,15 +263,46 @@ void UBarkText::AddQueuedBarkLine(EBarkRequestFinishedReason Reason)
 
 void UBarkText::SetBarkLineTimer()
 {
-    BarkLineTimer = CurrentBarkRequest ? CurrentBarkRequest->GetDurationForLine(CurrentBarkLine) : BarkLineDisplayTime;
+    BarkLineTimer = bHasCurrentRequest ? CurrentBarkRequest.GetDurationForLine(CurrentBarkLine) : BarkLineDisplayTime;
     bIsBarking = true;
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("#### SetBarkLineTimer: %f"), BarkLineTimer);
+    StartFastForwardTimer();
 }
 
 void UBarkText::ClearBarkLineTimer()
 {
     BarkLineTimer = 0;
     bIsBarking = false;
+    if (const UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(FastForwardTimerHandle);
+    }
+}
+
+void UBarkText::StartFastForwardTimer()
+{
+    if (!FSimulationClock::IsFastForward()) return;
+    GetWorld()->GetTimerManager().SetTimer(
+        FastForwardTimerHandle, this,
+        &UBarkText::OnFastForwardTimeout,
+        FSimulationClock::GetWait(FMath::Max(BarkLineTimer, 0.1f)), false);
+}
+
+void UBarkText::OnFastForwardTimeout()
+{
+    if (bIsBarking)
+    {
+        BarkLineTimer = 0.0f;
+        AddQueuedBarkLine(EBarkRequestFinishedReason::Timeout);
+    }
+}
+
+void UBarkText::ClearBarkQueue()
+{
+    bIsBarking = false;
+    RequestQueue.Reset();
+    CurrentBarkRequest = FBarkRequest();
+    bHasCurrentRequest = false;
 }
 
 void UBarkText::DumpBarkText()
@@ -256,7 +319,7 @@ void UBarkText::DumpBarkText()
         i++;
     }
 
-    for (FText Text : BarkLines)
+    for (const FText& Text : CurrentBarkRequest.GetBarkLines())
     {
         UE_LOG(LogAdventureGame, VeryVerbose, TEXT("Queued Barkline: %d - %s"), i, *(Text.ToString()));
     }
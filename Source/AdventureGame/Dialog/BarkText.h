@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 
+#include "BarkQueue.h"
 #include "BarkRequest.h"
 #include "Blueprint/UserWidget.h"
 #include "AdventureGame/Constants.h"
@@ -14,6 +15,7 @@
 
 class FBarkRequest;
 class UBarkLine;
+class UBarkLinePool;
 class UVerticalBox;
 class USphereComponent;
 
@@ -50,6 +52,10 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TSubclassOf<UBarkLine> BarkLineClass;
+
+	/// Bark lines made when the widget is initialized, and recycled after that.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 BarkLinePoolSize = G_MAX_BARK_LINES;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (BindWidget))
 	UVerticalBox *BarkContainer;
@@ -66,17 +72,30 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	USphereComponent* BarkPosition;
 
+	/// Requests that can wait to be barked, made when the widget is initialized.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 BarkQueueCapacity = BARK_QUEUE_CAPACITY;
+
+	/// What happens to a request when the queue is full. Requests that are not
+	/// barked because of it are reported to BarkRequestInterruptedDelegate.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EBarkOverflowPolicy BarkOverflowPolicy = EBarkOverflowPolicy::DropOldest;
+
 	FBarkRequestComplete BarkRequestCompleteDelegate;
 	FBarkRequestInterrupted BarkRequestInterruptedDelegate;
 	
-	void AddBarkRequest(const FBarkRequest *BarkRequest);
+	void AddBarkRequest(FBarkRequest&& BarkRequest);
 	
-	/// Clear all the lines of text from the widget
+	/// Clear all the lines of text from the widget, and the queued requests
 	void ClearText();
 
 	bool IsBarking() const { return bIsBarking; }
 
-	bool IsPlayerRequest() const { return CurrentBarkRequest && CurrentBarkRequest->IsPlayer(); }
+	bool IsPlayerRequest() const { return bHasCurrentRequest && CurrentBarkRequest.IsPlayer(); }
+
+	const FBarkQueue& GetBarkQueue() const { return RequestQueue; }
+
+	const UBarkLinePool* GetBarkLinePool() const { return BarkLinePool; }
 
 	float OverrideDisplayTime = INVALID_BARK_DELAY;
 	
@@ -101,6 +120,12 @@ private:
 
 	UPROPERTY()
 	AActor *ViewTarget = nullptr;
+
+	UPROPERTY()
+	UBarkLinePool *BarkLinePool = nullptr;
+
+	/// Give the lines in the container back to the pool
+	void ReleaseLines();
 		
 	//////////////////////////////////
 	///
@@ -110,19 +135,22 @@ private:
 	/// Cheap timer updated by the tick function, since we already need tick
 	float BarkLineTimer;
 
+	/// In fast forward the widget may not tick at all, eg under -nullrhi, so
+	/// the line times out on a world timer instead.
+	FTimerHandle FastForwardTimerHandle;
+
+	void StartFastForwardTimer();
+
+	void OnFastForwardTimeout();
+
 	/// True when the timer is running and barks are displaying
 	bool bIsBarking = false;
-	
-	/// Set an array of lines of text into the bark container. First the bark container
-	/// is cleared, the timer reset, and the first line pushed into the container.
-	/// Then after every timeout another line is added.
-	void SetBarkLines(const TArray<FText> &NewBarkLines);
 
-	/// Which line in the BarkLines array is being shown
-	int CurrentBarkLine = 0;
+	/// Clear the lines of text from the widget, leaving the queued requests
+	void ClearLines();
 
-	/// A set of lines that is being scrolled into view in the container
-	TArray<FText> BarkLines;
+	/// Which line of the current request is being shown
+	int CurrentBarkLine = 0;
 	
 	void SetBarkLineTimer();
 
@@ -138,13 +166,18 @@ private:
 	
 	void LoadNextBarkRequest();
 
-	void AddToLinkedList(const FBarkRequest *BarkRequest);
+	/// Load the next request and show its first line shortly.
+	void StartNextBarkRequest();
 
-	FBarkRequest *PopBarkRequest();
+	/// Tell the listeners a request, and any merged into it, finished.
+	void BroadcastFinished(const FBarkRequest& BarkRequest, EBarkRequestFinishedReason Reason);
 
-	FBarkRequest *RequestQueue;
+	FBarkQueue RequestQueue;
 
-	const FBarkRequest *CurrentBarkRequest;
+	/// The request whose lines are being shown, moved out of the queue.
+	FBarkRequest CurrentBarkRequest;
+
+	bool bHasCurrentRequest = false;
 	
 	int32 CurrentUID = -1;
 
@@ -152,8 +185,8 @@ private:
 
 	bool IsOneLineAtMinimumSet = false;
 	
-	/// Called when the BarkLineTimer times out. Keeps feeding the current multiline
-	/// message <code>BarkLines</code> into the bark container; or if that is complete
+	/// Called when the BarkLineTimer times out. Keeps feeding the lines of the current
+	/// request into the bark container; or if that is complete
 	/// then loads a BarkRequest if one is queued.
 	void AddQueuedBarkLine(EBarkRequestFinishedReason Reason);
 
@@ -162,48 +195,3 @@ public:
 	void ClearBarkQueue();
 
 };
-
-inline FBarkRequest *UBarkText::PopBarkRequest()
-{
-	if (RequestQueue)
-	{
-		FBarkRequest *BarkRequest = RequestQueue;
-		RequestQueue = RequestQueue->NextRequest;
-		return BarkRequest;
-	}
-	return nullptr;
-}
-
-inline void UBarkText::ClearBarkQueue()
-{
-	bIsBarking = false;
-	while (RequestQueue)
-	{
-		const FBarkRequest *Request = RequestQueue;
-		RequestQueue = RequestQueue->NextRequest;
-		if (Request == CurrentBarkRequest)
-		{
-			CurrentBarkRequest = nullptr;
-		}
-		delete Request;
-	}
-	if (CurrentBarkRequest != nullptr)
-	{
-		delete CurrentBarkRequest;
-		CurrentBarkRequest = nullptr;
-	}
-}
-
-inline void UBarkText::AddToLinkedList(const FBarkRequest *BarkRequest)
-{
-	if (RequestQueue)
-	{
-		FBarkRequest *Tail = RequestQueue;
-		for ( ; Tail->NextRequest; Tail = Tail->NextRequest ) {}
-		Tail->NextRequest = const_cast<FBarkRequest*>(BarkRequest);
-	}
-	else
-	{
-		RequestQueue = const_cast<FBarkRequest*>(BarkRequest);
-	}
-}
\ No newline at end of file
@@ -4,29 +4,28 @@
 #include "AdventureGame/Constants.h"
 #include "Algo/Count.h"
 
+void FConversationData::Compile()
+{
+    PromptGraph.Build(ConversationPromptArray);
+}
+
+const FPromptGraph& FConversationData::GetPromptGraph() const
+{
+    if (!PromptGraph.IsBuiltFor(ConversationPromptArray.Num()))
+    {
+        PromptGraph.Build(ConversationPromptArray);
+    }
+    return PromptGraph;
+}
+
 void FConversationData::DisplayPrompts(TArray<FPromptData>& OutPromptData) const
 {
     OutPromptData.Empty();
-    const int MaxPromptIndex = GetMaxPromptIndex();
-    int PromptIndex = 0;
-    int PromptSubindex = 0;
-    int PromptCount = 0;
-    while (PromptCount < GMax_Number_Of_Prompts && PromptIndex <= MaxPromptIndex)
+    TArray<int32, TInlineAllocator<8>> Rows;
+    GetPromptGraph().GetRowsToShow(GMax_Number_Of_Prompts, Rows);
+    for (const int32 Row : Rows)
     {
-        if (const FPromptData* Prompt = FindPromptAtIndex(PromptIndex, PromptSubindex))
-        {
-            while (Prompt && Prompt->SingleUse && Prompt->HasBeenSelected)
-            {
-                Prompt = FindPromptAtIndex(PromptIndex, ++PromptSubindex);
-            }
-            if (Prompt)
-            {
-                OutPromptData.Add(*Prompt);
-                ++PromptCount;
-            }
-        }
-        PromptIndex++;
-        PromptSubindex = 0;
+        OutPromptData.Add(ConversationPromptArray[Row]);
     }
     if (OutPromptData.Num() == 0)
     {
@@ -36,31 +35,24 @@ void FConversationData::DisplayPrompts(TArray<FPromptData>& OutPromptData) const
 
 void FConversationData::MarkPromptSelected(int PromptIndex, int SubIndex)
 {
-    FPromptData* FoundResult = ConversationPromptArray.FindByPredicate(
-        [PromptIndex, SubIndex](const FPromptData& PromptData)
-        {
-            return PromptData.IsIndex(PromptIndex, SubIndex);
-        });
-    FoundResult->HasBeenSelected = true;
-    if (FoundResult->SingleUse)
+    const int32 Row = GetPromptGraph().FindRow(PromptIndex, SubIndex);
+    if (Row == INDEX_NONE)
+    {
+        UE_LOG(LogAdventureGame, Warning, TEXT("MarkPromptSelected - no prompt %d / %d"), PromptIndex, SubIndex);
+        return;
+    }
+    PromptGraph.MarkSelected(Row);
+    FPromptData& Prompt = ConversationPromptArray[Row];
+    Prompt.HasBeenSelected = true;
+    if (Prompt.SingleUse)
     {
-        FoundResult->Visible = false;
+        Prompt.Visible = false;
     }
 }
 
 int FConversationData::PromptsAvailableCount() const
 {
-    int Count = 0;
-    TSet<int32> PromptIndexes;
-    for (FPromptData Prompt : ConversationPromptArray)
-    {
-        if (Prompt.CanBeShown() && !PromptIndexes.Contains(Prompt.PromptNumber))
-        {
-            PromptIndexes.Add(Prompt.PromptNumber);
-            ++Count;
-        }
-    }
-    return Count;
+    return GetPromptGraph().CountAvailable();
 }
 
 bool FConversationData::Validate(FString &ErrorMessage)
@@ -102,22 +94,3 @@ bool FConversationData::Validate(FString &ErrorMessage)
     }
     return true;
 }
-
-const FPromptData* FConversationData::FindPromptAtIndex(int32 PromptIndex, int32 SubIndex) const
-{
-    return ConversationPromptArray.FindByPredicate(
-        [PromptIndex, SubIndex](const FPromptData& PromptData)
-        {
-            return PromptData.PromptNumber == PromptIndex && PromptData.PromptSubNumber == SubIndex;
-        });
-}
-
-int FConversationData::GetMaxPromptIndex() const
-{
-    int MaxPromptIndex = -1;
-    for (FPromptData PromptData : ConversationPromptArray)
-    {
-        MaxPromptIndex = std::max(PromptData.PromptNumber, MaxPromptIndex);
-    }
-    return MaxPromptIndex;
-}
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 
 #include "PromptData.h"
+#include "PromptGraph.h"
 
 #include "ConversationData.generated.h"
 
@@ -21,6 +22,12 @@ struct ADVENTUREGAME_API FConversationData: public FTableRowBase
 
     TArray<FPromptData> ConversationPromptArray;
 
+    /**
+     * Index the prompts for showing them. Call this once the prompt array is filled;
+     * if it is not, the prompts are indexed when they are first shown.
+     */
+    void Compile();
+
     /**
      * Get the prompts to display from this array. The number of prompts
      * will be n: 0 <= n <= GMax_Number_Of_Prompts. The indexes of prompts
@@ -46,7 +53,9 @@ struct ADVENTUREGAME_API FConversationData: public FTableRowBase
     bool Validate(FString &ErrorMessage);
     
 private:
-    const FPromptData *FindPromptAtIndex(int32 PromptIndex, int32 SubIndex) const;
-    int GetMaxPromptIndex() const;
-    
+    const FPromptGraph& GetPromptGraph() const;
+
+    /// Built from the prompt array, which is not changed once filled
+    mutable FPromptGraph PromptGraph;
+
 };
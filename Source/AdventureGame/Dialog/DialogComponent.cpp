@@ -60,8 +60,11 @@ void UDialogComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 void UDialogComponent::FillConversationData()
 {
     if (ConversationData.Num() > 0) return; // already filled
+    TopicIndexes.Reset();
     for (const auto TopicTable : TopicList)
     {
+        // Of a table listed twice, the first is the one used
+        TopicIndexes.FindOrAdd(TopicTable, ConversationData.Num());
         TArray<FPromptData> PromptsForTopic;
         TArray<FPromptData*> PromptPtrs;
         TopicTable->GetAllRows<FPromptData>("FillConversationData", PromptPtrs);
@@ -73,8 +76,8 @@ void UDialogComponent::FillConversationData()
             }
         }
         FConversationData TopicConversationData;
-        TopicConversationData.ConversationPromptArray = PromptsForTopic;
-        ConversationData.Add(TopicConversationData);
+        TopicConversationData.ConversationPromptArray = MoveTemp(PromptsForTopic);
+        TopicConversationData.Compile();
 #if WITH_EDITOR
         FString ErrorMessage;
         bool IsOK = TopicConversationData.Validate(ErrorMessage);
@@ -85,13 +88,15 @@ void UDialogComponent::FillConversationData()
             UE_LOG(LogAdventureGame, Error, TEXT("Error in Conversation: check tables: %s"), *ErrorMessage);
         }
 #endif
+        ConversationData.Add(MoveTemp(TopicConversationData));
     }
 }
 
 void UDialogComponent::UpdatePromptAtIndex(int32 ATopicIndex, int32 APromptIndex)
 {
-    const int PromptSubIndex = PromptsToShow[APromptIndex].PromptSubNumber;
-    ConversationData[ATopicIndex].MarkPromptSelected(APromptIndex, PromptSubIndex);
+    // The row on screen, which is not the prompt number once a prompt is used up
+    const FPromptData& Prompt = PromptsToShow[APromptIndex];
+    ConversationData[ATopicIndex].MarkPromptSelected(Prompt.PromptNumber, Prompt.PromptSubNumber);
 }
 
 void UDialogComponent::LoadPrompts(TArray<FPromptData>& TPromptsToShow)
@@ -112,7 +117,7 @@ void UDialogComponent::LoadPrompts(TArray<FPromptData>& TPromptsToShow)
 int UDialogComponent::ConversationCount() const
 {
     int Count = 0;
-    for (FConversationData Element : ConversationData)
+    for (const FConversationData& Element : ConversationData)
     {
         if (Element.PromptsAvailableCount() > 0)
         {
@@ -143,17 +148,12 @@ void UDialogComponent::StopMonitoringConversations()
 
 void UDialogComponent::AssignNewTopic(const UDataTable* NewTopic)
 {
-    int IndexToSet = 0;
     if (!IsValid(NewTopic)) return;
-    for (const UDataTable* Topic : TopicList)
+    if (const int32* IndexToSet = TopicIndexes.Find(NewTopic))
     {
-        if (Topic == NewTopic)
-        {
-            TopicIndex = IndexToSet;
-            UE_LOG(LogAdventureGame, Warning, TEXT("Assigning new conversation topic - %d"), TopicIndex);
-            return;
-        }
-        ++IndexToSet;
+        TopicIndex = *IndexToSet;
+        UE_LOG(LogAdventureGame, Warning, TEXT("Assigning new conversation topic - %d"), TopicIndex);
+        return;
     }
     UE_LOG(LogAdventureGame, Error, TEXT("UDialogComponent::AssignNewTopic - Got bad topic"));
 }
@@ -189,10 +189,10 @@ void UDialogComponent::DisplayPrompts()
 void UDialogComponent::ShowPlayerBark()
 {
     DialogState = EDialogState::Player;
-    const FBarkRequest* PlayerRequest = FBarkRequest::CreatePlayerMultilineRequest(
+    FBarkRequest PlayerRequest = FBarkRequest::CreatePlayerMultilineRequest(
         PromptsToShow[CurrentPromptIndex].PromptText);
-    BarkUID = PlayerRequest->GetUID();
-    Bark->AddBarkRequest(PlayerRequest);
+    BarkUID = PlayerRequest.GetUID();
+    Bark->AddBarkRequest(MoveTemp(PlayerRequest));
     UE_LOG(LogAdventureGame, Warning, TEXT("UDialogComponent::ShowPlayerBark - UID: %d - %s"), BarkUID,
         *(PromptsToShow[CurrentPromptIndex].PromptText[0].ToString()));
 }
@@ -203,11 +203,11 @@ void UDialogComponent::ShowNPCResponse()
     DialogState = EDialogState::NPC;
     const AHotSpotNPC* ANPC = Cast<AHotSpotNPC>(GetOwner());
     check(ANPC);
-    const FBarkRequest* NPCRequest = FBarkRequest::CreateNPCMultilineRequest(
+    FBarkRequest NPCRequest = FBarkRequest::CreateNPCMultilineRequest(
         PromptsToShow[CurrentPromptIndex].NPCResponse, 0,
         ANPC->BarkPosition, TextColor.ToFColor(true));
-    BarkUID = NPCRequest->GetUID();
-    Bark->AddBarkRequest(NPCRequest);
+    BarkUID = NPCRequest.GetUID();
+    Bark->AddBarkRequest(MoveTemp(NPCRequest));
 }
 
 void UDialogComponent::ShowNextDialogPrompts()
@@ -97,6 +97,9 @@ private:
 
     TArray<int> Stack;
 
+    /// Index in the TopicList of each topic table, for switching topics
+    TMap<const UDataTable*, int32> TopicIndexes;
+
     void DisplayPrompts();
     void ShowPlayerBark();
     void ShowNPCResponse();
@@ -20,6 +20,8 @@ AHotSpotNPC::AHotSpotNPC()
     BarkPosition = CreateDefaultSubobject<USphereComponent>(TEXT("BarkPosition"));
     BarkPosition->SetupAttachment(RootComponent);
     BarkPosition->SetSphereRadius(4.0f);
+    BarkPosition->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    BarkPosition->SetGenerateOverlapEvents(false);
 
     FlipbookComponent = CreateDefaultSubobject<UPaperFlipbookComponent>("FlipbookComponent");
     FlipbookComponent->SetupAttachment(RootComponent);
@@ -79,6 +81,12 @@ void AHotSpotNPC::OnTalkTo_Implementation()
     Execute_OnConverseWith(this);
 }
 
+bool AHotSpotNPC::PredictBarkText(EVerbType Verb, const UInventoryItem* SourceItem, FText& OutText) const
+{
+    if (Verb == EVerbType::TalkTo) return false;
+    return Super::PredictBarkText(Verb, SourceItem, OutText);
+}
+
 void AHotSpotNPC::OnConversationComplete()
 {
     UE_LOG(LogTemp, Warning, TEXT("OnConversationComplete"));
@@ -40,6 +40,9 @@ public:
 
     virtual void OnTalkTo_Implementation() override;
 
+    /// Talking to an NPC starts a conversation rather than barking.
+    virtual bool PredictBarkText(EVerbType Verb, const UInventoryItem* SourceItem, FText& OutText) const override;
+
     UFUNCTION()
     void OnConversationComplete();
 
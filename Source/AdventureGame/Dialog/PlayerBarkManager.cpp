@@ -6,6 +6,7 @@
 #include "BarkRequest.h"
 #include "AdventureGame/AdventureGame.h"
 #include "AdventureGame/Enums/BarkAction.h"
+#include "AdventureGame/Gameplay/AdvBlueprintFunctionLibrary.h"
 #include "AdventureGame/HUD/AdventureGameHUD.h"
 #include "AdventureGame/Player/CommandManager.h"
 #include "Kismet/GameplayStatics.h"
@@ -15,11 +16,9 @@
 UPlayerBarkManager::UPlayerBarkManager()
     : AdventureHUDWidget(nullptr)
 {
-    // Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-    // off to improve performance if you don't need them.
-    PrimaryComponentTick.bCanEverTick = true;
-
-    // ...
+    // Barks are timed by the bark widget, and finish with its delegates, so
+    // there is nothing to do each frame.
+    PrimaryComponentTick.bCanEverTick = false;
 }
 
 
@@ -32,41 +31,39 @@ void UPlayerBarkManager::BeginPlay()
     
 }
 
-// Called every frame
-void UPlayerBarkManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-    // ...
-}
-
 void UPlayerBarkManager::PlayerBarkAndEnd(const FText &BarkText)
 {
     IsBarking = true;
-    const FBarkRequest* Request = FBarkRequest::CreatePlayerRequest(BarkText);
-    AdventureHUDWidget->Bark->AddBarkRequest(Request);
-    CurrentBarkTasks.Add(Request->GetUID());
-    if (ACommandManager *CommandManager = GetCommandManager())
+    ACommandManager *CommandManager = GetCommandManager();
+    // The bark for a click's verb is made while the cursor rests on the hotspot
+    FBarkRequest Request;
+    if (!CommandManager || !CommandManager->GetHoverPrefetch().TakeBarkRequest(BarkText, Request))
     {
-        CommandManager->bShouldInterruptCurrentActionOnNextTick = true;
+        Request = FBarkRequest::CreatePlayerRequest(BarkText);
+    }
+    CurrentBarkTasks.Add(Request.GetUID());
+    AdventureHUDWidget->Bark->AddBarkRequest(MoveTemp(Request));
+    if (CommandManager)
+    {
+        CommandManager->ScheduleInterruptCurrentAction();
     }
 }
 
 void UPlayerBarkManager::PlayerBark(const FText& BarkText, int32 BarkTaskUid)
 {
     IsBarking = true;
-    FBarkRequest* Request = FBarkRequest::CreatePlayerRequest(BarkText, 0.0f, BarkTaskUid);
-    CurrentBarkTasks.Add(Request->GetUID());
-    AdventureHUDWidget->Bark->AddBarkRequest(Request);
+    FBarkRequest Request = FBarkRequest::CreatePlayerRequest(BarkText, 0.0f, BarkTaskUid);
+    CurrentBarkTasks.Add(Request.GetUID());
+    AdventureHUDWidget->Bark->AddBarkRequest(MoveTemp(Request));
 }
 
 void UPlayerBarkManager::PlayerBarkLines(const TArray<FText>& BarkTextArray, int32 BarkTaskUid)
 {
     if (BarkTextArray.IsEmpty()) return;
     IsBarking = true;
-    const FBarkRequest* Request = FBarkRequest::CreatePlayerMultilineRequest(BarkTextArray);
-    CurrentBarkTasks.Add(Request->GetUID());
-    AdventureHUDWidget->Bark->AddBarkRequest(Request);
+    FBarkRequest Request = FBarkRequest::CreatePlayerMultilineRequest(BarkTextArray);
+    CurrentBarkTasks.Add(Request.GetUID());
+    AdventureHUDWidget->Bark->AddBarkRequest(MoveTemp(Request));
 }
 
 ACommandManager* UPlayerBarkManager::GetCommandManager()
@@ -78,7 +75,7 @@ ACommandManager* UPlayerBarkManager::GetCommandManager()
         return CommandManager;
     }
     if (ACommandManager* CommandManager = CachedCommandManager.Get()) return CommandManager;
-    if (ACommandManager* CommandManager = Cast<ACommandManager>(UGameplayStatics::GetActorOfClass(this, ACommandManager::StaticClass())))
+    if (ACommandManager* CommandManager = UAdvBlueprintFunctionLibrary::GetCommandManager(this))
     {
         CachedCommandManager = CommandManager;
         return CommandManager;
@@ -101,6 +98,16 @@ void UPlayerBarkManager::ClearBark()
         IsBarking = false;
     }
     AdventureHUDWidget->Bark->ClearText();
+    WakeCommandManager();
+}
+
+void UPlayerBarkManager::WakeCommandManager()
+{
+    // An interrupt may have been waiting for the player to stop barking
+    if (ACommandManager *CommandManager = Cast<ACommandManager>(GetOwner()))
+    {
+        CommandManager->WakeForPendingWork();
+    }
 }
 
 EBarkAction UPlayerBarkManager::IsPlayerBarking() const
@@ -134,6 +141,7 @@ void UPlayerBarkManager::OnTimeoutBark(int32 BarkTaskId)
         EndPlayerBark.Broadcast(BarkTaskId, EBarkRequestFinishedReason::Timeout);
     }
     IsBarking = AdventureHUDWidget->Bark->IsBarking();
+    WakeCommandManager();
 }
 
 void UPlayerBarkManager::OnInterruptBark(int32 BarkTaskId)
@@ -144,5 +152,6 @@ void UPlayerBarkManager::OnInterruptBark(int32 BarkTaskId)
         EndPlayerBark.Broadcast(BarkTaskId, EBarkRequestFinishedReason::Interruption);
     }
     IsBarking = AdventureHUDWidget->Bark->IsBarking();
+    WakeCommandManager();
 }
 
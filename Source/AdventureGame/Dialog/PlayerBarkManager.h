@@ -61,12 +61,9 @@ private:
 
     ACommandManager *GetCommandManager();
 
+    void WakeCommandManager();
+
 protected:
     // Called when the game starts
     virtual void BeginPlay() override;
-
-public:
-    // Called every frame
-    virtual void TickComponent(float DeltaTime, ELevelTick TickType,
-                               FActorComponentTickFunction* ThisTickFunction) override;
 };
@@ -0,0 +1,109 @@
+// (c) 2025 Sarah Smith
+
+
+#include "PromptGraph.h"
+
+#include "PromptData.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
+
+void FPromptGraph::Build(TConstArrayView<FPromptData> Prompts)
+{
+    const int32 Count = Prompts.Num();
+    SortedRows.SetNumUninitialized(Count);
+    for (int32 Row = 0; Row < Count; ++Row)
+    {
+        SortedRows[Row] = Row;
+    }
+    Algo::StableSortBy(SortedRows, [&Prompts](const int32 Row)
+    {
+        return TTuple<int32, int32>(Prompts[Row].PromptNumber, Prompts[Row].PromptSubNumber);
+    });
+
+    PromptNumbers.Reset();
+    GroupStarts.Reset();
+    SortedSubNumbers.SetNumUninitialized(Count);
+    Visible.Init(false, Count);
+    Selected.Init(false, Count);
+    SingleUse.Init(false, Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const FPromptData& Prompt = Prompts[SortedRows[Index]];
+        if (PromptNumbers.IsEmpty() || PromptNumbers.Last() != Prompt.PromptNumber)
+        {
+            PromptNumbers.Add(Prompt.PromptNumber);
+            GroupStarts.Add(Index);
+        }
+        SortedSubNumbers[Index] = Prompt.PromptSubNumber;
+    }
+    GroupStarts.Add(Count);
+    for (int32 Row = 0; Row < Count; ++Row)
+    {
+        Visible[Row] = Prompts[Row].Visible;
+        Selected[Row] = Prompts[Row].HasBeenSelected;
+        SingleUse[Row] = Prompts[Row].SingleUse;
+    }
+    bBuilt = true;
+}
+
+int32 FPromptGraph::FindRow(const int32 PromptNumber, const int32 SubNumber) const
+{
+    const int32 Group = Algo::BinarySearch(PromptNumbers, PromptNumber);
+    if (Group == INDEX_NONE) return INDEX_NONE;
+    for (int32 Index = GroupStarts[Group]; Index < GroupStarts[Group + 1]; ++Index)
+    {
+        if (SortedSubNumbers[Index] == SubNumber) return SortedRows[Index];
+    }
+    return INDEX_NONE;
+}
+
+void FPromptGraph::MarkSelected(const int32 Row)
+{
+    Selected[Row] = true;
+    if (SingleUse[Row])
+    {
+        Visible[Row] = false;
+    }
+}
+
+void FPromptGraph::GetRowsToShow(const int32 MaxCount, TArray<int32, TInlineAllocator<8>>& OutRows) const
+{
+    OutRows.Reset();
+    for (int32 Group = 0; Group < PromptNumbers.Num() && OutRows.Num() < MaxCount; ++Group)
+    {
+        // Prompts numbered below zero are never shown
+        if (PromptNumbers[Group] < 0) continue;
+        // Sub-prompts follow on from 0, so a missing one ends the group's prompts,
+        // and of two with the same sub-number the first in the table is used
+        int32 NextSubNumber = 0;
+        for (int32 Index = GroupStarts[Group]; Index < GroupStarts[Group + 1]; ++Index)
+        {
+            const int32 SubNumber = SortedSubNumbers[Index];
+            if (SubNumber < NextSubNumber) continue;
+            if (SubNumber > NextSubNumber) break;
+            if (!IsUsedUp(SortedRows[Index]))
+            {
+                OutRows.Add(SortedRows[Index]);
+                break;
+            }
+            ++NextSubNumber;
+        }
+    }
+}
+
+int32 FPromptGraph::CountAvailable() const
+{
+    int32 Count = 0;
+    for (int32 Group = 0; Group < PromptNumbers.Num(); ++Group)
+    {
+        for (int32 Index = GroupStarts[Group]; Index < GroupStarts[Group + 1]; ++Index)
+        {
+            if (CanBeShown(SortedRows[Index]))
+            {
+                ++Count;
+                break;
+            }
+        }
+    }
+    return Count;
+}
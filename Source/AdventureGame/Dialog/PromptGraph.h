@@ -0,0 +1,68 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FPromptData;
+
+/**
+ * The prompts of a topic, indexed for showing them. Each prompt row is a dense index into
+ * the topic's prompt array. Rows are grouped by prompt number, in the order they are shown,
+ * and each group's rows are sorted by sub-number, so the prompt shown for a number is the
+ * first of its rows not used up. Whether each row is visible, selected and single use is kept
+ * in bit arrays alongside, so the prompts to show are found by walking the groups in order.
+ */
+struct ADVENTUREGAME_API FPromptGraph
+{
+    /// Index the prompts, in the order they are in the topic's table.
+    void Build(TConstArrayView<FPromptData> Prompts);
+
+    /// Built for this many prompts. The prompt array is not changed once it is filled,
+    /// so a different number means it has not been built for them yet.
+    bool IsBuiltFor(int32 PromptCount) const { return bBuilt && Visible.Num() == PromptCount; }
+
+    /// Row of the prompt with the number and sub-number, or INDEX_NONE.
+    int32 FindRow(int32 PromptNumber, int32 SubNumber) const;
+
+    void MarkSelected(int32 Row);
+
+    bool CanBeShown(int32 Row) const { return Visible[Row] && !IsUsedUp(Row); }
+
+    /// Single use and already selected, so the next sub-prompt is shown instead.
+    bool IsUsedUp(int32 Row) const { return SingleUse[Row] && Selected[Row]; }
+
+    /**
+     * Find the rows to show: for each prompt number in order, its first sub-prompt that
+     * is not used up, until there are MaxCount of them.
+     * @param MaxCount Most rows to find
+     * @param OutRows Rows found, in the order to show them
+     */
+    void GetRowsToShow(int32 MaxCount, TArray<int32, TInlineAllocator<8>>& OutRows) const;
+
+    /// Prompt numbers with any row that can be shown.
+    int32 CountAvailable() const;
+
+    int32 NumPromptNumbers() const { return PromptNumbers.Num(); }
+
+private:
+    /// Distinct prompt numbers, ascending.
+    TArray<int32> PromptNumbers;
+
+    /// Rows sorted by prompt number then sub-number, duplicates in table order.
+    TArray<int32> SortedRows;
+
+    /// Sub-number of each of the sorted rows.
+    TArray<int32> SortedSubNumbers;
+
+    /// Start of each prompt number's rows in SortedRows, and one past the end.
+    TArray<int32> GroupStarts;
+
+    TBitArray<> Visible;
+
+    TBitArray<> Selected;
+
+    TBitArray<> SingleUse;
+
+    bool bBuilt = false;
+};
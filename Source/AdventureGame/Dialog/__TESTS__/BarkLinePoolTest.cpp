@@ -0,0 +1,81 @@
+#include "AdventureGame/Constants.h"
+#include "AdventureGame/Dialog/BarkLine.h"
+#include "AdventureGame/Dialog/BarkLinePool.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+#include "UObject/StrongObjectPtr.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(BarkLinePoolTest, "AdventureGame.Dialog.BarkLinePoolTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// Lines in a long conversation, and a few more.
+constexpr int32 GBarkLines = 3000;
+
+bool BarkLinePoolTest::RunTest(const FString& Parameters)
+{
+    // This will get cleaned up when it leaves scope
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+
+    if (!World) return false;
+    WorldWrapper.BeginPlayInTestWorld();
+
+    const FText LineText = FText::FromString(TEXT("Fascinating."));
+
+    // A released line is hidden and is the next one handed out, however many times it was released
+    {
+        TStrongObjectPtr<UBarkLinePool> Single(NewObject<UBarkLinePool>(World));
+        Single->Init(World, UBarkLine::StaticClass(), 1);
+        UBarkLine* Line = Single->Acquire();
+        TestEqual(TEXT("Prewarmed line starts hidden"), Line->GetVisibility(), ESlateVisibility::Collapsed);
+        Line->ShowLine(LineText, FColor::White);
+        TestEqual(TEXT("Shown"), Line->GetVisibility(), ESlateVisibility::SelfHitTestInvisible);
+        Single->Release(Line);
+        Single->Release(Line);
+        TestEqual(TEXT("Given back once"), Single->NumFree(), 1);
+        TestEqual(TEXT("Hidden again"), Line->GetVisibility(), ESlateVisibility::Collapsed);
+        TestTrue(TEXT("Reused"), Single->Acquire() == Line);
+        TestEqual(TEXT("Nothing grown"), Single->GetStats().Grown, 0);
+    }
+
+    // Barks show up to G_MAX_BARK_LINES lines, which are all cleared when the request is done
+    TStrongObjectPtr<UBarkLinePool> Pool(NewObject<UBarkLinePool>(World));
+    Pool->Init(World, UBarkLine::StaticClass(), G_MAX_BARK_LINES);
+    TestEqual(TEXT("Prewarmed"), Pool->NumFree(), G_MAX_BARK_LINES);
+
+    TArray<UBarkLine*> Showing;
+    for (int32 Line = 0; Line < GBarkLines; ++Line)
+    {
+        UBarkLine* BarkLine = Pool->Acquire();
+        BarkLine->ShowLine(LineText, FColor::White);
+        Showing.Add(BarkLine);
+        if (Showing.Num() == G_MAX_BARK_LINES)
+        {
+            for (UBarkLine* Shown : Showing)
+            {
+                Pool->Release(Shown);
+            }
+            Showing.Reset();
+        }
+    }
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+    const FBarkLinePoolStats& Stats = Pool->GetStats();
+    TestEqual(TEXT("Every line acquired"), Stats.Acquired, GBarkLines);
+    TestEqual(TEXT("No more made than prewarmed"), Stats.GetMade(), G_MAX_BARK_LINES);
+    TestEqual(TEXT("Lines reused rather than made"), Stats.GetAllocationsAvoided(), GBarkLines - G_MAX_BARK_LINES);
+    TestTrue(TEXT("Recycled lines survive collection"), IsValid(Pool->Acquire()));
+
+    // Under pressure, with every line in use, the pool grows by the one it needs
+    for (int32 Line = Pool->NumFree(); Line > 0; --Line)
+    {
+        Pool->Acquire();
+    }
+    TestNotNull(TEXT("Made when all are in use"), Pool->Acquire());
+    TestEqual(TEXT("grown by one"), Pool->GetStats().Grown, 1);
+
+    return true;
+}
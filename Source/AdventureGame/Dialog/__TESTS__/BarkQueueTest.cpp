@@ -0,0 +1,113 @@
+#include "AdventureGame/Dialog/BarkQueue.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(BarkQueueTest, "AdventureGame.Dialog.BarkQueueTest",
+                                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// Far more barks than a play through has, pushed faster than they are shown.
+constexpr int32 GBarks = 6000;
+
+bool BarkQueueTest::RunTest(const FString& Parameters)
+{
+    // Long lines are wrapped, and the wrapped request is the one returned
+    const FBarkRequest Wrapped = FBarkRequest::CreatePlayerRequest(
+        FText::FromString(TEXT("This line is far too long to fit in one bark line")));
+    TestTrue(TEXT("Long line wrapped"), Wrapped.GetLineCount() > 1);
+    TestFalse(TEXT("First line is not a continuation"), Wrapped.IsContinuation(0));
+    TestTrue(TEXT("Second line is"), Wrapped.IsContinuation(1));
+    TestEqual(TEXT("Continuation shows with the line before it"), Wrapped.GetDurationForLine(1), 0.0f);
+
+    TArray<FText> Lines;
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        Lines.Add(FText::FromString(FString::Printf(TEXT("Line %d"), Index)));
+    }
+    const FColor Player = FColor::White;
+    const FColor NPC = FColor::Orange;
+
+    // Each policy on a full queue of two
+    {
+        FBarkQueue Small(2);
+        FBarkRequest Unbarked;
+        Small.Push(FBarkRequest(Lines[0], 1, Player), EBarkOverflowPolicy::DropOldest, Unbarked);
+        Small.Push(FBarkRequest(Lines[1], 2, Player), EBarkOverflowPolicy::DropOldest, Unbarked);
+        TestTrue(TEXT("Full"), Small.IsFull());
+
+        TestFalse(TEXT("Reject turns the new one away"),
+            Small.Push(FBarkRequest(Lines[2], 3, Player), EBarkOverflowPolicy::Reject, Unbarked));
+        TestEqual(TEXT("and hands it back"), Unbarked.GetUID(), 3);
+
+        TestTrue(TEXT("Merge with the same speaker"),
+            Small.Push(FBarkRequest(Lines[2], 4, Player), EBarkOverflowPolicy::Merge, Unbarked));
+        TestEqual(TEXT("is still two requests"), Small.Num(), 2);
+
+        Small.Push(FBarkRequest(Lines[2], 5, NPC), EBarkOverflowPolicy::Merge, Unbarked);
+        TestEqual(TEXT("Merge with another speaker drops the oldest"), Unbarked.GetUID(), 1);
+
+        FBarkRequest Next;
+        Small.Pop(Next);
+        TestEqual(TEXT("The merged request is next"), Next.GetUID(), 2);
+        TestEqual(TEXT("with the lines of both"), Next.GetLineCount(), 2);
+        TestTrue(TEXT("and the UID of the one merged in"), Next.GetMergedUIDs().Contains(4));
+        Small.Pop(Next);
+        TestEqual(TEXT("Then the last pushed"), Next.GetUID(), 5);
+    }
+
+    FBarkQueue Queue;
+    const SIZE_T EmptySize = Queue.GetAllocatedSize();
+    int32 MostWaiting = 0;
+    int32 LinesIn = 0;
+    int32 LinesOut = 0;
+    TMap<int32, int32> TimesOut;
+    auto CountOut = [&](const FBarkRequest& Request)
+    {
+        if (Request.GetUID() != BARK_UID_NONE) ++TimesOut.FindOrAdd(Request.GetUID());
+        for (const int32 UID : Request.GetMergedUIDs())
+        {
+            ++TimesOut.FindOrAdd(UID);
+        }
+        LinesOut += Request.GetLineCount();
+    };
+
+    int32 Rejections = 0;
+    FBarkRequest Out;
+    for (int32 Bark = 0; Bark < GBarks; ++Bark)
+    {
+        // A third of the barks under each policy, the speaker changing every few barks
+        const EBarkOverflowPolicy Policy = static_cast<EBarkOverflowPolicy>(Bark * 3 / GBarks);
+        const int32 LineCount = 1 + Bark % 3;
+        FBarkRequest Request(MakeArrayView(Lines.GetData(), LineCount), Bark, Bark / 4 % 2 ? NPC : Player);
+        LinesIn += LineCount;
+
+        FBarkRequest Unbarked;
+        Rejections += !Queue.Push(MoveTemp(Request), Policy, Unbarked);
+        CountOut(Unbarked);
+        MostWaiting = FMath::Max(MostWaiting, Queue.Num());
+
+        // Shown at half the rate they come in, so the queue is full most of the time
+        if (Bark % 2 && Queue.Pop(Out))
+        {
+            CountOut(Out);
+        }
+    }
+    while (Queue.Pop(Out))
+    {
+        CountOut(Out);
+    }
+
+    const FBarkQueueStats& Stats = Queue.GetStats();
+    TestTrue(TEXT("Never more than its capacity"), MostWaiting <= Queue.GetCapacity());
+    TestEqual(TEXT("Every bark came out"), TimesOut.Num(), GBarks);
+    int32 Duplicates = 0;
+    for (const TPair<int32, int32>& Pair : TimesOut)
+    {
+        Duplicates += Pair.Value != 1;
+    }
+    TestEqual(TEXT("each of them once"), Duplicates, 0);
+    TestEqual(TEXT("with all its lines"), LinesOut, LinesIn);
+    TestEqual(TEXT("Rejections counted"), Stats.Rejected, Rejections);
+    TestTrue(TEXT("Every policy used"), Stats.Dropped > 0 && Stats.Merged > 0 && Stats.Rejected > 0);
+    TestEqual(TEXT("Memory back to what it was empty"), Queue.GetAllocatedSize(), EmptySize);
+
+    return true;
+}
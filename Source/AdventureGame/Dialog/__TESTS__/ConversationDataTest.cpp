@@ -6,6 +6,47 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(ConversationDataTest, "AdventureGame.Dialog.Con
 
 #include "ConversationTestUtils.h"
 
+/// Prompt numbers in a topic far bigger than any written by hand.
+constexpr int32 GLargeTopicPrompts = 1000;
+
+/// Sub-prompts of each prompt number.
+constexpr int32 GLargeTopicSubPrompts = 3;
+
+/// Prompt numbers, at the end of the topic, that are not used up.
+constexpr int32 GLargeTopicOpenPrompts = 100;
+
+/// The prompts to show found by scanning the prompt array for each number and sub-number,
+/// as they were before the prompts were indexed, to check the index against.
+static void DisplayPromptsByScanning(const TArray<FPromptData>& Prompts, TArray<FPromptData>& OutPromptData)
+{
+    auto Find = [&Prompts](const int32 Number, const int32 SubNumber)
+    {
+        return Prompts.FindByPredicate([Number, SubNumber](const FPromptData& Prompt)
+        {
+            return Prompt.IsIndex(Number, SubNumber);
+        });
+    };
+    OutPromptData.Empty();
+    int32 MaxPromptIndex = -1;
+    for (const FPromptData& Prompt : Prompts)
+    {
+        MaxPromptIndex = FMath::Max(MaxPromptIndex, Prompt.PromptNumber);
+    }
+    for (int32 Number = 0; Number <= MaxPromptIndex && OutPromptData.Num() < GMax_Number_Of_Prompts; ++Number)
+    {
+        int32 SubNumber = 0;
+        const FPromptData* Prompt = Find(Number, SubNumber);
+        while (Prompt && Prompt->SingleUse && Prompt->HasBeenSelected)
+        {
+            Prompt = Find(Number, ++SubNumber);
+        }
+        if (Prompt)
+        {
+            OutPromptData.Add(*Prompt);
+        }
+    }
+}
+
 bool ConversationDataTest::RunTest(const FString& Parameters)
 {
     FConversationData ConversationData = FConversationTestUtils::CreateData();
@@ -29,5 +70,72 @@ bool ConversationDataTest::RunTest(const FString& Parameters)
     TestEqual(TEXT("Query members second number"), PromptsToDisplay[1].PromptNumber, 1);
     TestEqual(TEXT("Query members second txt"), PromptsToDisplay[1].PromptNumber, 1);
 
+    // Prompts numbered below zero are never shown
+    const TCHAR* HiddenText[] = { TEXT("Not to be asked") };
+    FConversationData HiddenTopic;
+    HiddenTopic.ConversationPromptArray.Add(FConversationTestUtils::CreatePromptData(
+        -1, 0, true, false, false, HiddenText, 1, HiddenText, 1, nullptr, false, TEXT("")));
+    HiddenTopic.ConversationPromptArray.Add(FConversationTestUtils::CreatePromptData(
+        0, 0, true, false, false, HiddenText, 1, HiddenText, 1, nullptr, false, TEXT("")));
+    HiddenTopic.Compile();
+    HiddenTopic.DisplayPrompts(PromptsToDisplay);
+    TestEqual(TEXT("Only the prompt numbered zero shown"), PromptsToDisplay.Num(), 1);
+
+    // A large topic where all but the last few prompts have been used up, so showing the
+    // prompts has to go past nearly all of them
+    const TCHAR* LargeText[] = { TEXT("What else can you tell me?") };
+    FConversationData LargeTopic;
+    for (int32 Number = 0; Number < GLargeTopicPrompts; ++Number)
+    {
+        const bool Open = Number >= GLargeTopicPrompts - GLargeTopicOpenPrompts;
+        for (int32 SubNumber = 0; SubNumber < GLargeTopicSubPrompts; ++SubNumber)
+        {
+            const bool SingleUse = !Open || SubNumber < GLargeTopicSubPrompts - 1;
+            LargeTopic.ConversationPromptArray.Add(FConversationTestUtils::CreatePromptData(
+                Number, SubNumber, true, false, SingleUse, LargeText, 1, LargeText, 1, nullptr, false, TEXT("")));
+        }
+    }
+    FString ErrorMessage;
+    TestTrue(TEXT("Large topic is valid"), LargeTopic.Validate(ErrorMessage));
+    LargeTopic.Compile();
+
+    for (int32 Number = 0; Number < GLargeTopicPrompts - GLargeTopicOpenPrompts; ++Number)
+    {
+        for (int32 SubNumber = 0; SubNumber < GLargeTopicSubPrompts; ++SubNumber)
+        {
+            LargeTopic.MarkPromptSelected(Number, SubNumber);
+        }
+    }
+    TestEqual(TEXT("Large topic count"), LargeTopic.PromptsAvailableCount(), GLargeTopicOpenPrompts);
+
+    double Start = FPlatformTime::Seconds();
+    LargeTopic.DisplayPrompts(PromptsToDisplay);
+    const double IndexedSeconds = FPlatformTime::Seconds() - Start;
+
+    TArray<FPromptData> ScannedPrompts;
+    Start = FPlatformTime::Seconds();
+    DisplayPromptsByScanning(LargeTopic.ConversationPromptArray, ScannedPrompts);
+    const double ScannedSeconds = FPlatformTime::Seconds() - Start;
+
+    TestEqual(TEXT("Large topic shows as many prompts"), PromptsToDisplay.Num(), GMax_Number_Of_Prompts);
+    TestEqual(TEXT("as the scan"), PromptsToDisplay.Num(), ScannedPrompts.Num());
+    for (int32 Index = 0; Index < FMath::Min(PromptsToDisplay.Num(), ScannedPrompts.Num()); ++Index)
+    {
+        TestTrue(TEXT("and the same ones"), PromptsToDisplay[Index].IsIndex(
+            ScannedPrompts[Index].PromptNumber, ScannedPrompts[Index].PromptSubNumber));
+    }
+    TestEqual(TEXT("First open prompt shown first"), PromptsToDisplay[0].PromptNumber,
+        GLargeTopicPrompts - GLargeTopicOpenPrompts);
+    // Scanning goes over the whole prompt array for each number, so even on a loaded
+    // machine it is far slower than the index
+    TestTrue(TEXT("Indexed prompts found faster than scanning"), IndexedSeconds < ScannedSeconds);
+
+    // Using up the first open prompt's first sub-prompt moves it on to the next one
+    LargeTopic.MarkPromptSelected(GLargeTopicPrompts - GLargeTopicOpenPrompts, 0);
+    LargeTopic.DisplayPrompts(PromptsToDisplay);
+    DisplayPromptsByScanning(LargeTopic.ConversationPromptArray, ScannedPrompts);
+    TestEqual(TEXT("Next sub-prompt shown"), PromptsToDisplay[0].PromptSubNumber, 1);
+    TestEqual(TEXT("as the scan finds"), ScannedPrompts[0].PromptSubNumber, 1);
+
     return true;
 }
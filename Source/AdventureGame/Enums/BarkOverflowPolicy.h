@@ -0,0 +1,22 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "BarkOverflowPolicy.generated.h"
+
+/// What the bark queue does with a request when it is full.
+UENUM(BlueprintType)
+enum class EBarkOverflowPolicy: uint8
+{
+    /// Make room by dropping the request that has waited longest
+    DropOldest UMETA(DisplayName = "Drop Oldest"),
+
+    /// Add the lines to the last queued request if it has the same speaker,
+    /// otherwise drop the oldest
+    Merge UMETA(DisplayName = "Merge"),
+
+    /// Turn the new request away
+    Reject UMETA(DisplayName = "Reject"),
+};
@@ -28,6 +28,6 @@ enum class ERoomTransitionPhase: uint8
     /// The room that was unloading has finished being removed from memory
     RoomUnloaded UMETA(DisplayName = "RoomUnloaded"),
 
-    /// Everything is nearly done, there's a short delay being processed to allow settling
+    /// Everything is nearly done, waiting for the new room to signal it is ready to play
     DelayProcessing UMETA(DisplayName = "DelayProcessing"),
 };
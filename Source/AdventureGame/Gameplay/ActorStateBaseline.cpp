@@ -0,0 +1,107 @@
+// (c) 2025 Sarah Smith
+
+
+#include "ActorStateBaseline.h"
+
+#include "DataSaveRecord.h"
+#include "AdventureGame/AdventureGame.h"
+
+FActorStateBaseline::FActorStateBaseline(const AActor* Actor)
+    : Class(Actor->GetClass())
+    , Transform(Actor->GetActorTransform())
+{
+    for (TFieldIterator<FProperty> It(Actor->GetClass()); It; ++It)
+    {
+        if (It->HasAnyPropertyFlags(CPF_SaveGame))
+        {
+            SaveGameProperties.Add(*It);
+            for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+            {
+                Values.Add(ExportValue(*It, Actor, Index));
+            }
+        }
+    }
+}
+
+FString FActorStateBaseline::GetValueKey(const FProperty* Property, int32 Index)
+{
+    return Property->ArrayDim > 1
+        ? FString::Printf(TEXT("%s[%d]"), *Property->GetName(), Index)
+        : Property->GetName();
+}
+
+FString FActorStateBaseline::ExportValue(const FProperty* Property, const AActor* Actor, int32 Index)
+{
+    FString Value;
+    Property->ExportText_Direct(Value, Property->ContainerPtrToValuePtr<void>(Actor, Index), nullptr,
+        const_cast<AActor*>(Actor), PPF_None);
+    return Value;
+}
+
+bool FActorStateBaseline::CaptureDelta(AActor* Actor, FDataSaveRecord& Record) const
+{
+    const bool bSameClass = Actor->GetClass() == Class.Get();
+    if (!bSameClass)
+    {
+        UE_LOG(LogAdventureGame, Warning, TEXT("FActorStateBaseline::CaptureDelta - %s changed class, saving all properties"),
+            *Actor->GetName());
+    }
+
+    Record.PropertyValues.Reset();
+    if (bSameClass)
+    {
+        int32 ValueIndex = 0;
+        for (const FProperty* Property : SaveGameProperties)
+        {
+            for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+            {
+                FString Value = ExportValue(Property, Actor, Index);
+                if (Value != Values[ValueIndex++])
+                {
+                    Record.PropertyValues.Add(GetValueKey(Property, Index), MoveTemp(Value));
+                }
+            }
+        }
+    }
+    else
+    {
+        for (TFieldIterator<FProperty> It(Actor->GetClass()); It; ++It)
+        {
+            if (!It->HasAnyPropertyFlags(CPF_SaveGame)) continue;
+            for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+            {
+                Record.PropertyValues.Add(GetValueKey(*It, Index), ExportValue(*It, Actor, Index));
+            }
+        }
+    }
+
+    const FTransform CurrentTransform = Actor->GetActorTransform();
+    Record.bTransformChanged = !CurrentTransform.Equals(Transform);
+    Record.Transform = Record.bTransformChanged ? CurrentTransform : FTransform::Identity;
+
+    return Record.bTransformChanged || !Record.PropertyValues.IsEmpty();
+}
+
+void FActorStateBaseline::RestoreDelta(AActor* Actor, const FDataSaveRecord& Record)
+{
+    if (!Record.PropertyValues.IsEmpty())
+    {
+        for (TFieldIterator<FProperty> It(Actor->GetClass()); It; ++It)
+        {
+            if (!It->HasAnyPropertyFlags(CPF_SaveGame)) continue;
+            for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+            {
+                const FString* Value = Record.PropertyValues.Find(GetValueKey(*It, Index));
+                if (Value && !It->ImportText_Direct(**Value, It->ContainerPtrToValuePtr<void>(Actor, Index), Actor, PPF_None))
+                {
+                    UE_LOG(LogAdventureGame, Warning, TEXT("FActorStateBaseline::RestoreDelta - could not restore %s on %s from \"%s\""),
+                        *GetValueKey(*It, Index), *Actor->GetName(), **Value);
+                }
+            }
+        }
+    }
+    if (Record.bTransformChanged)
+    {
+        Actor->SetActorTransform(Record.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+    }
+}
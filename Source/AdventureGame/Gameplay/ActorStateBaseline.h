@@ -0,0 +1,58 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FDataSaveRecord;
+
+/**
+ * The <code>SaveGame</code> flagged property values, and the transform, that an
+ * actor had when its room was streamed in - that is its level defaults, before any
+ * saved state was restored onto it.
+ *
+ * Values are held as exported text, so a save record only holds the values that
+ * gameplay has actually changed, and object references are kept as path names that
+ * stay valid after the room has been unloaded. Anything a blueprint marks as
+ * <code>SaveGame</code> (flipbook frame, custom variables and so on) is persisted
+ * without the hotspot having to encode it into gameplay tags.
+ */
+class ADVENTUREGAME_API FActorStateBaseline
+{
+public:
+    explicit FActorStateBaseline(const AActor* Actor);
+
+    /**
+     * Write into the record the properties and transform of the actor that differ
+     * from this baseline. If nothing differs the record's data is left empty.
+     * @param Actor Actor to capture, normally the same one the baseline was made from
+     * @param Record Save record to write the delta into
+     * @return true if any property or the transform differed from the baseline
+     */
+    bool CaptureDelta(AActor* Actor, FDataSaveRecord& Record) const;
+
+    /**
+     * Apply a delta captured by <code>CaptureDelta</code> onto an actor that is at its
+     * level defaults, ie freshly streamed in.
+     * @param Actor Actor to restore into
+     * @param Record Save record previously written by <code>CaptureDelta</code>
+     */
+    static void RestoreDelta(AActor* Actor, const FDataSaveRecord& Record);
+
+private:
+    /// Key of a property element in a save record, the property name with the
+    /// element index for static arrays.
+    static FString GetValueKey(const FProperty* Property, int32 Index);
+
+    static FString ExportValue(const FProperty* Property, const AActor* Actor, int32 Index);
+
+    TWeakObjectPtr<UClass> Class;
+
+    /// Properties of Class that are flagged SaveGame, found once at construction.
+    TArray<const FProperty*> SaveGameProperties;
+
+    /// Exported value of each element of each SaveGame property, in order.
+    TArray<FString> Values;
+
+    FTransform Transform;
+};
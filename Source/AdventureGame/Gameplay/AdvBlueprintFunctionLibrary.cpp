@@ -5,6 +5,7 @@
 
 #include "AdventureGameInstance.h"
 #include "AdventureGameModeBase.h"
+#include "AdventureWorldRegistry.h"
 #include "AdventureGame/Player/AdventurePlayerController.h"
 #include "AdventureGame/Enums/ItemKind.h"
 #include "AdventureGame/Constants.h"
@@ -41,10 +42,12 @@ AAdventurePlayerController* UAdvBlueprintFunctionLibrary::GetAdventureController
 
 ACommandManager* UAdvBlueprintFunctionLibrary::GetCommandManager(const UObject* WorldContextObject)
 {
-    AActor* Actor = UGameplayStatics::GetActorOfClass(WorldContextObject, ACommandManager::StaticClass());
-    if (ACommandManager* CommandManager = Cast<ACommandManager>(Actor))
+    if (const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(WorldContextObject))
     {
-        return CommandManager;
+        if (ACommandManager* CommandManager = Registry->GetCommandManager())
+        {
+            return CommandManager;
+        }
     }
     // Could happen if the level is being torn down or a loading of a save game is in progress
     UE_LOG(LogAdventureGame, Display, TEXT("%hs - %s Command manager not available in"),
@@ -4,26 +4,39 @@
 #include "AdventureGameInstance.h"
 
 #include "AdventureSave.h"
+#include "AdventureWorldRegistry.h"
+#include "RoomGraph.h"
+#include "RoomStreamingManager.h"
+#include "SimulationClock.h"
+#include "WalkPathManager.h"
 #include "AdventureGame/Constants.h"
 #include "AdventureGame/AdventureGame.h"
 #include "AdventureGame/Player/AdventureCharacter.h"
 #include "AdventureGame/Player/AdventurePlayerController.h"
+#include "AdventureGame/Player/CommandManager.h"
 #include "AdventureGame/HUD/AdventureGameHUD.h"
 #include "AdventureGame/HUD/AdvGameUtils.h"
 #include "AdventureGame/HotSpots/Door.h"
 #include "AdventureGame/Items/ItemList.h"
 
 #include "GameFramework/SaveGame.h"
-#include "Blueprint/WidgetBlueprintLibrary.h"
 #include "Components/CapsuleComponent.h"
+#include "Engine/LevelStreaming.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/PackageName.h"
+#include "NavigationSystem.h"
 #include "Kismet/GameplayStatics.h"
 
 void UAdventureGameInstance::Init()
 {
 	Super::Init();
 
+	FSimulationClock::Initialize();
 	CreateInventory();
 	BindInventoryChangedHandlers();
+	CreateRoomStreaming();
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &UAdventureGameInstance::OnPreGarbageCollect);
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UAdventureGameInstance::OnPostGarbageCollect);
 	
 	if (ShouldCheckForSaveGameOnLoad && UGameplayStatics::DoesSaveGameExist(SAVE_GAME_NAME, 0))
 	{
@@ -35,37 +48,105 @@ void UAdventureGameInstance::Init()
 	}
 }
 
+void UAdventureGameInstance::Shutdown()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().RemoveAll(this);
+	FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
+	FSimulationClock::ReportThroughput(TEXT("UAdventureGameInstance::Shutdown"));
+	Super::Shutdown();
+}
+
 void UAdventureGameInstance::OnSaveHotSpot(AHotSpot* HotSpot)
 {
-	FDataSaveRecord SaveRecord;
-	SaveRecord.LevelName = CurrentLevelName.ToString();
-	SaveRecord.ObjectName = HotSpot->GetName();
-	SaveRecord.Tags = HotSpot->GetTags();
-	bool RecordFound = false;
-	for (FDataSaveRecord& Record : AdventureSaves)
+	CaptureHotSpot(HotSpot);
+}
+
+void UAdventureGameInstance::OnLoadHotSpot(AHotSpot* HotSpot)
+{
+	const FString Key = SaveRecordKey(GetSaveLevelName(HotSpot), HotSpot->GetName());
+
+	// The first time the hotspot streams in it is at its level defaults. Snapshot
+	// those before anything saved is restored over the top of them. If its room
+	// was only hidden the snapshot from when it was loaded is still good.
+	if (!HotSpotBaselines.Contains(Key))
+	{
+		HotSpotBaselines.Add(Key, MakeUnique<FActorStateBaseline>(HotSpot));
+	}
+	
+	if (const FDataSaveRecord* Record = FindSaveRecord(Key))
+	{
+		FActorStateBaseline::RestoreDelta(HotSpot, *Record);
+		HotSpot->SetTags(Record->Tags);
+	}
+}
+
+void UAdventureGameInstance::CaptureHotSpot(AHotSpot* HotSpot)
+{
+	const FString LevelName = GetSaveLevelName(HotSpot);
+	const FString ObjectName = HotSpot->GetName();
+	const FString Key = SaveRecordKey(LevelName, ObjectName);
+	FDataSaveRecord* Record = FindSaveRecord(Key);
+	if (!Record)
+	{
+		AdventureSaveIndex.Add(Key, AdventureSaves.Num());
+		Record = &AdventureSaves.AddDefaulted_GetRef();
+		Record->LevelName = LevelName;
+		Record->ObjectName = ObjectName;
+	}
+	Record->Tags = HotSpot->GetTags();
+	
+	if (const TUniquePtr<FActorStateBaseline>* Baseline = HotSpotBaselines.Find(Key))
 	{
-		if (Record.LevelName == SaveRecord.LevelName && Record.ObjectName == SaveRecord.ObjectName)
+		(*Baseline)->CaptureDelta(HotSpot, *Record);
+	}
+}
+
+void UAdventureGameInstance::ReleaseRoomBaselines(FName LevelName)
+{
+	const FString Prefix = SaveRecordKey(LevelName.ToString(), FString());
+	for (auto It = HotSpotBaselines.CreateIterator(); It; ++It)
+	{
+		if (It.Key().StartsWith(Prefix))
 		{
-			Record.Tags = SaveRecord.Tags;
-			RecordFound = true;
-			break;
+			It.RemoveCurrent();
 		}
 	}
-	if (!RecordFound)
+}
+
+FString UAdventureGameInstance::SaveRecordKey(const FString& LevelName, const FString& ObjectName)
+{
+	return LevelName + TEXT(":") + ObjectName;
+}
+
+FString UAdventureGameInstance::GetSaveLevelName(const AActor* Actor)
+{
+	const FName LevelName = UAdventureWorldRegistry::GetActorLevelName(Actor);
+	return LevelName.IsNone() ? FString() : LevelName.ToString();
+}
+
+FDataSaveRecord* UAdventureGameInstance::FindSaveRecord(const FString& Key)
+{
+	if (const int32* Index = AdventureSaveIndex.Find(Key))
 	{
-		AdventureSaves.Add(SaveRecord);
+		return &AdventureSaves[*Index];
 	}
+	return nullptr;
 }
 
-void UAdventureGameInstance::OnLoadHotSpot(AHotSpot* HotSpot)
+void UAdventureGameInstance::RebuildSaveRecordIndex()
 {
-	for (const FDataSaveRecord& Record : AdventureSaves)
+	AdventureSaveIndex.Reset();
+	AdventureSaveIndex.Reserve(AdventureSaves.Num());
+	for (int32 Index = 0; Index < AdventureSaves.Num(); ++Index)
 	{
-		if (Record.LevelName == CurrentLevelName && Record.ObjectName == HotSpot->GetName())
+		// Older saves hold the level name the room was loaded with, which may be its
+		// long package name. Key them by the short name the loaded hotspots use.
+		FDataSaveRecord& Record = AdventureSaves[Index];
+		if (FPackageName::IsValidLongPackageName(Record.LevelName))
 		{
-			HotSpot->SetTags(Record.Tags);
-			break;
+			Record.LevelName = FPackageName::GetShortName(Record.LevelName);
 		}
+		AdventureSaveIndex.Add(SaveRecordKey(Record.LevelName, Record.ObjectName), Index);
 	}
 }
 
@@ -146,10 +227,22 @@ void UAdventureGameInstance::LoadStartingRoom()
 	UE_LOG(LogAdventureGame, Log, TEXT("UAdventureGameInstance::LoadStartingRoom - %s"),
 		*StartingLevelName.ToString());
 	RoomTransitionPhase = ERoomTransitionPhase::LoadStartingRoom;
-
-	FLatentActionInfo LatentActionInfo = GetLatentActionForHandler(OnRoomLoadedName);
+	bNewRoomLevelPending = true;
+	bNewRoomAssetsPending = true;
+	if (!RoomStreaming || !RoomStreaming->LoadRoomAssets(StartingLevelName, FStreamableManager::AsyncLoadHighPriority,
+		FStreamableDelegate::CreateUObject(this, &UAdventureGameInstance::OnNewRoomAssetsLoaded)))
+	{
+		bNewRoomLevelPending = false;
+		bNewRoomAssetsPending = false;
+		FLatentActionInfo LatentActionInfo = GetLatentActionForHandler(OnRoomLoadedName);
+		UGameplayStatics::LoadStreamLevel(this, StartingLevelName,
+		                                  true, FSimulationClock::IsFastForward(), LatentActionInfo);
+		return;
+	}
+	// Its manifest is batch loaded alongside, as for a door, see LoadNewRoom
+	FLatentActionInfo LatentActionInfo = GetLatentActionForHandler(OnNewRoomLevelLoadedName);
 	UGameplayStatics::LoadStreamLevel(this, StartingLevelName,
-	                                  true, false, LatentActionInfo);
+	                                  false, FSimulationClock::IsFastForward(), LatentActionInfo);
 }
 
 void UAdventureGameInstance::OnRoomLoaded()
@@ -161,34 +254,129 @@ void UAdventureGameInstance::OnRoomLoaded()
 		CurrentLevelName = StartingLevelName;
 		CurrentDoorLabel = StartingDoorLabel;
 		RoomTransitionPhase = ERoomTransitionPhase::NewRoomLoaded;
-		NewRoomDelay();
+		WaitForRoomReady();
 		break;
 	case ERoomTransitionPhase::LoadNewRoom:
 		UE_LOG(LogAdventureGame, Log, TEXT("UAdventureGameInstance::OnRoomLoaded - LoadNewRoom"));
-		RoomTransitionPhase = ERoomTransitionPhase::NewRoomLoaded;
-		UnloadRoom();
+		SetRoomTransitionPhase(ERoomTransitionPhase::NewRoomLoaded);
+		SampleTransitionMemory();
+		WaitForRoomReady();
+		break;
 	default:
 		UE_LOG(LogAdventureGame, Warning, TEXT("Unexpected state during OnRoomLoaded"));
 		break;
 	}
 }
 
-void UAdventureGameInstance::NewRoomDelay()
+void UAdventureGameInstance::WaitForRoomReady()
 {
-	RoomTransitionPhase = ERoomTransitionPhase::DelayProcessing;
-	
-	GetWorld()->GetTimerManager().SetTimer(
-		RoomLoadTimer, this,
-		&UAdventureGameInstance::OnRoomLoadTimerTimeout, RoomLoadDelay, false);
+	SetRoomTransitionPhase(ERoomTransitionPhase::DelayProcessing);
+	RoomReadiness.Reset(FPlatformTime::Seconds());
+	PendingHotSpots.Reset();
+	bPendingHotSpotsGathered = false;
+	CheckRoomReadiness();
 }
 
-void UAdventureGameInstance::OnRoomLoadTimerTimeout()
+void UAdventureGameInstance::CheckRoomReadiness()
 {
-	SetupRoom();
+	const double Now = FPlatformTime::Seconds();
+	SampleTransitionMemory();
+
+	// A room that is not streamed, eg the persistent level in a test map, is always visible
+	const ULevelStreaming* StreamingLevel = UGameplayStatics::GetStreamingLevel(this, CurrentLevelName);
+	const ULevel* Level = StreamingLevel ? StreamingLevel->GetLoadedLevel() : GetWorld()->PersistentLevel.Get();
+	RoomReadiness.Mark(ERoomReadySignal::LevelVisible, !StreamingLevel || StreamingLevel->IsLevelVisible(), Now);
+	if (RoomReadiness.LevelVisible >= 0.0)
+	{
+		if (!bPendingHotSpotsGathered)
+		{
+			GatherPendingHotSpots(Level);
+		}
+		RoomReadiness.Mark(ERoomReadySignal::HotSpotsLoaded, AreHotSpotsLoaded(), Now);
+	}
+	if (!RoomReadiness.bRoomSetUp && RoomReadiness.CanSetupRoom())
+	{
+		SetupRoom();
+		RoomReadiness.bRoomSetUp = true;
+	}
+	if (RoomReadiness.bRoomSetUp)
+	{
+		RoomReadiness.Mark(ERoomReadySignal::NavigationReady, IsNavigationReady(), Now);
+		RoomReadiness.Mark(ERoomReadySignal::CharacterGrounded, IsCharacterGrounded(), Now);
+	}
+
+	const bool bTimedOut = Now - RoomReadiness.StartTime > RoomReadyTimeout;
+	if (!RoomReadiness.CanStartPlay() && !bTimedOut)
+	{
+		RoomReadyTimer = GetWorld()->GetTimerManager().SetTimerForNextTick(
+			this, &UAdventureGameInstance::CheckRoomReadiness);
+		return;
+	}
+
+	if (bTimedOut)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UAdventureGameInstance::CheckRoomReadiness - %s timed out after %.1f s: %s"),
+			*CurrentLevelName.ToString(), RoomReadyTimeout, *RoomReadiness.ToString());
+	}
+	else
+	{
+		UE_LOG(LogAdventureGame, Display, TEXT("UAdventureGameInstance::CheckRoomReadiness - %s ready: %s"),
+			*CurrentLevelName.ToString(), *RoomReadiness.ToString());
+	}
+	if (!RoomReadiness.bRoomSetUp)
+	{
+		SetupRoom();
+		RoomReadiness.bRoomSetUp = true;
+	}
+	StartNewRoom();
+}
+
+void UAdventureGameInstance::GatherPendingHotSpots(const ULevel* Level)
+{
+	if (!Level) return;
+	for (AActor* Actor : Level->Actors)
+	{
+		// Hotspots restore their saved state during BeginPlay
+		AHotSpot* HotSpot = Cast<AHotSpot>(Actor);
+		if (HotSpot && !HotSpot->HasActorBegunPlay())
+		{
+			PendingHotSpots.Add(HotSpot);
+		}
+	}
+	bPendingHotSpotsGathered = true;
+}
+
+bool UAdventureGameInstance::AreHotSpotsLoaded()
+{
+	if (!bPendingHotSpotsGathered) return false;
+	PendingHotSpots.RemoveAllSwap([](const TWeakObjectPtr<AHotSpot>& HotSpot)
+	{
+		return !HotSpot.IsValid() || HotSpot->HasActorBegunPlay();
+	});
+	return PendingHotSpots.IsEmpty();
+}
+
+bool UAdventureGameInstance::IsNavigationReady() const
+{
+	// Rooms with a walk area do not walk on the navigation
+	const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+	if (Registry && Registry->FindWalkArea(CurrentLevelName)) return true;
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavigationSystem) return true;
+	return !NavigationSystem->IsNavigationBuildInProgress() && NavigationSystem->GetDefaultNavDataInstance();
+}
+
+bool UAdventureGameInstance::IsCharacterGrounded()
+{
+	const AAdventureCharacter* AdventureCharacter = GetAdventureCharacter();
+	if (!AdventureCharacter) return true;
+	const UCharacterMovementComponent* Movement = AdventureCharacter->GetCharacterMovement();
+	return !Movement || !Movement->IsFalling();
 }
 
 void UAdventureGameInstance::SetupRoom()
 {
+	FScopedRoomTransitionStep Step(GetTimedTransition(), SetupRoomStepName);
 	auto f = UGameplayStatics::GetCurrentLevelName(GetWorld());
 	UE_LOG(LogAdventureGame, Display, TEXT("UAdventureGameInstance::SetupRoom - %s"), *f);
 
@@ -198,7 +386,20 @@ void UAdventureGameInstance::SetupRoom()
 	const ADoor* Door = FindDoor(CurrentDoorLabel);
 	LoadDoor(Door);
 	CurrentDoor = const_cast<ADoor*>(Door);
-	
+}
+
+void UAdventureGameInstance::GetOwnedGameplayTags(FGameplayTagContainer& TagContainer) const
+{
+	TagContainer.AppendTags(GameplayTags);
+}
+
+void UAdventureGameInstance::StartNewRoom()
+{
+	if (FRoomTransitionStats* Stats = GetTimedTransition())
+	{
+		Stats->BeginStep(StartNewRoomStepName);
+	}
+
 	if (UAdventureGameHUD* HUD = GetHUD())
 	{
 		HUD->HideBlackScreen();
@@ -207,30 +408,156 @@ void UAdventureGameInstance::SetupRoom()
 	if (ACommandManager *Command = GetCommandManager())
 	{
 		Command->InterruptCurrentAction();
+		Command->SetInputLocked(false);
+	}
+
+	// The old room was only hidden while the new one loaded, so release it now
+	// that the player can see the new room.
+	if (!RetiringLevelName.IsNone() && TransitionStats.bOverlapped && !bRetiringRoomWarm)
+	{
+		UnloadRoom();
+	}
+	RetiringLevelName = NAME_None;
+
+	if (RoomStreaming)
+	{
+		RoomStreaming->OnRoomEntered(CurrentLevelName);
+	}
+	if (UWalkPathManager* WalkPaths = UWalkPathManager::Get(this))
+	{
+		WalkPaths->BuildWalkGraph(CurrentLevelName);
+	}
+	RoomTransitionPhase = ERoomTransitionPhase::RoomCurrent;
+
+	if (TransitionStartTime > 0.0)
+	{
+		TransitionStats.EndStep();
+		TransitionStats.DoorLatency = FPlatformTime::Seconds() - TransitionStartTime;
+		TransitionStats.PlayMemory = GetRoomMemory();
+		if (const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(GetWorld()))
+		{
+			TArray<AHotSpot*> HotSpots;
+			Registry->GetHotSpotsInLevel(CurrentLevelName, HotSpots);
+			TransitionStats.HotSpotCount = HotSpots.Num();
+		}
+		if (RoomStreaming)
+		{
+			RoomStreaming->ReportTransition(TransitionStats);
+		}
+		TransitionStartTime = 0.0;
+
+		// Stays open for the garbage collection of the old room, if it is being unloaded
+		if (!UnloadingLevels.ContainsByPredicate([this](const TPair<FName, double>& Unloading)
+		{
+			return Unloading.Key == TransitionStats.FromLevelName;
+		}))
+		{
+			CloseTransitionRecord();
+		}
 	}
 }
 
-void UAdventureGameInstance::GetOwnedGameplayTags(FGameplayTagContainer& TagContainer) const
+void UAdventureGameInstance::OnRoomUnloaded()
 {
-	TagContainer.AppendTags(GameplayTags);
+	// Deferred unloads of earlier transitions may complete in any order
+	for (int32 Index = UnloadingLevels.Num() - 1; Index >= 0; --Index)
+	{
+		const FName LevelName = UnloadingLevels[Index].Key;
+		const ULevelStreaming* StreamingLevel = UGameplayStatics::GetStreamingLevel(this, LevelName);
+		if (!StreamingLevel || !StreamingLevel->IsLevelLoaded())
+		{
+			UE_LOG(LogAdventureGame, Log, TEXT("UAdventureGameInstance::OnRoomUnloaded - %s was resident for %.3f s after the door was used"),
+				*LevelName.ToString(), FPlatformTime::Seconds() - UnloadingLevels[Index].Value);
+			if (bTransitionRecordOpen && LevelName == TransitionStats.FromLevelName)
+			{
+				TransitionStats.OldRoomResidentSeconds = FPlatformTime::Seconds() - TransitionStats.StartTime;
+				if (TransitionStartTime <= 0.0)
+				{
+					CloseTransitionRecord();
+				}
+			}
+			UnloadingLevels.RemoveAt(Index);
+			if (RoomStreaming)
+			{
+				RoomStreaming->OnRoomUnloaded(LevelName);
+			}
+		}
+	}
+	if (RoomTransitionPhase == ERoomTransitionPhase::UnloadOldRoom)
+	{
+		SetRoomTransitionPhase(ERoomTransitionPhase::RoomUnloaded);
+		LoadNewRoom();
+	}
 }
 
-void UAdventureGameInstance::StartNewRoom()
+void UAdventureGameInstance::OnOldRoomHidden()
 {
-	if (ACommandManager *Command = GetCommandManager())
+	UE_LOG(LogAdventureGame, Verbose, TEXT("UAdventureGameInstance::OnOldRoomHidden"));
+	SampleTransitionMemory();
+}
+
+uint64 UAdventureGameInstance::GetRoomMemory() const
+{
+	return RoomStreaming ? RoomStreaming->MeasureLoadedRoomsBytes() : 0;
+}
+
+void UAdventureGameInstance::SampleTransitionMemory()
+{
+	if (TransitionStartTime <= 0.0) return;
+	TransitionStats.PeakMemory = FMath::Max(TransitionStats.PeakMemory, GetRoomMemory());
+}
+
+void UAdventureGameInstance::SetRoomTransitionPhase(ERoomTransitionPhase Phase)
+{
+	RoomTransitionPhase = Phase;
+	if (FRoomTransitionStats* Stats = GetTimedTransition())
 	{
-		Command->SetInputLocked(false);
+		Stats->BeginStep(FName(StaticEnum<ERoomTransitionPhase>()->GetNameStringByValue(static_cast<int64>(Phase))));
 	}
-	RoomTransitionPhase = ERoomTransitionPhase::RoomCurrent;
 }
 
-void UAdventureGameInstance::OnRoomUnloaded()
+FRoomTransitionStats* UAdventureGameInstance::GetTimedTransition()
+{
+	return TransitionStartTime > 0.0 ? &TransitionStats : nullptr;
+}
+
+void UAdventureGameInstance::CloseTransitionRecord()
+{
+	if (!bTransitionRecordOpen) return;
+	bTransitionRecordOpen = false;
+	TransitionStats.EndMemory = GetRoomMemory();
+	TransitionLog.Add(TransitionStats);
+
+	UE_LOG(LogAdventureGame, Verbose, TEXT("UAdventureGameInstance::CloseTransitionRecord - %s to %s, %d hotspots, %d GCs in %.3f ms"),
+		*TransitionStats.FromLevelName.ToString(), *TransitionStats.ToLevelName.ToString(), TransitionStats.HotSpotCount,
+		TransitionStats.GCCount, TransitionStats.GCSeconds * 1000.0);
+	for (const FRoomTransitionStep& Step : TransitionStats.Steps)
+	{
+		UE_LOG(LogAdventureGame, Verbose, TEXT("    %s: %.3f ms at %.3f ms"), *Step.Name.ToString(),
+			Step.Seconds * 1000.0, Step.StartSeconds * 1000.0);
+	}
+}
+
+void UAdventureGameInstance::OnPreGarbageCollect()
+{
+	GarbageCollectStartTime = FPlatformTime::Seconds();
+}
+
+void UAdventureGameInstance::OnPostGarbageCollect()
 {
-	NewRoomDelay();
+	if (!bTransitionRecordOpen || GarbageCollectStartTime <= 0.0) return;
+	++TransitionStats.GCCount;
+	TransitionStats.GCSeconds += FPlatformTime::Seconds() - GarbageCollectStartTime;
+	GarbageCollectStartTime = 0.0;
 }
 
 void UAdventureGameInstance::TriggerRoomTransition()
 {
+	if (RoomGraph && !RoomGraph->FindDoor(CurrentLevelName, CurrentDoorLabel))
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UAdventureGameInstance::TriggerRoomTransition - room graph has no door %s in %s"),
+			*CurrentDoorLabel.ToString(), *CurrentLevelName.ToString());
+	}
 	RoomTransitionPhase = ERoomTransitionPhase::RoomCurrent;
 	OnLoadRoom();
 }
@@ -255,6 +582,18 @@ void UAdventureGameInstance::SaveGame()
 
 	CurrentSaveGame->AdventureTags = GameplayTags;
 
+	// Hotspots in the current room are normally only captured when their room
+	// unloads, so bring their records up to date before copying them out.
+	if (const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(GetWorld()))
+	{
+		TArray<AHotSpot*> HotSpots;
+		Registry->GetAllHotSpots(HotSpots);
+		for (AHotSpot* HotSpot : HotSpots)
+		{
+			CaptureHotSpot(HotSpot);
+		}
+	}
+
 	CurrentSaveGame->AdventureSaves.Empty();
 	CurrentSaveGame->AdventureSaves.Append(AdventureSaves);
 	
@@ -291,6 +630,7 @@ void UAdventureGameInstance::LoadGame()
 
 	AdventureSaves.Empty();
 	AdventureSaves.Append(CurrentSaveGame->AdventureSaves);
+	RebuildSaveRecordIndex();
 	
 	CurrentSaveGame->OnAdventureLoad(this);
 }
@@ -298,41 +638,213 @@ void UAdventureGameInstance::LoadGame()
 void UAdventureGameInstance::RegisterHotSpotForSaveAndLoad(AHotSpot* HotSpot)
 {
 	HotSpot->DataLoad.BindDynamic(this, &UAdventureGameInstance::OnLoadHotSpot);
-	RegisteredHotSpots.Add(HotSpot);
+	HotSpot->DataSave.BindDynamic(this, &UAdventureGameInstance::OnSaveHotSpot);
 }
 
 void UAdventureGameInstance::LoadRoom()
 {
 	// Load the room whose level name is in CurrentLevelName, then call OnRoomLoaded.
 	// This is done when there is a scene, and a player controller, we must blank the screen,
-	// stop player input, and unload that previous level (that unload is done in OnRoomLoaded). 
-	RoomTransitionPhase = ERoomTransitionPhase::LoadNewRoom;
+	// stop player input, and retire the previous level. Normally the previous level is
+	// hidden, which saves its hotspots, at the same time as the new one starts loading,
+	// and is only unloaded once the new room is playing, in StartNewRoom.
+	// The previous transition's old room may still be unloading
+	CloseTransitionRecord();
+	TransitionStartTime = FPlatformTime::Seconds();
+	TransitionStats = FRoomTransitionStats();
+	TransitionStats.StartTime = TransitionStartTime;
+	bTransitionRecordOpen = true;
+	FScopedRoomTransitionStep Step(GetTimedTransition(), LoadRoomStepName);
+	TransitionStats.ToLevelName = CurrentLevelName;
+	TransitionStats.StartMemory = GetRoomMemory();
+	TransitionStats.PeakMemory = TransitionStats.StartMemory;
+	TransitionStats.bWasPreloaded = RoomStreaming && RoomStreaming->IsRoomPreloaded(CurrentLevelName);
+
+	RetiringLevelName = CurrentDoor && CurrentDoor->CurrentLevel != CurrentLevelName ? CurrentDoor->CurrentLevel : NAME_None;
+	TransitionStats.FromLevelName = RetiringLevelName;
+	bRetiringRoomWarm = false;
+	if (RoomStreaming)
+	{
+		RoomStreaming->OnTransitionStarted(CurrentLevelName);
+		if (!RetiringLevelName.IsNone())
+		{
+			bRetiringRoomWarm = RoomStreaming->RetireRoom(RetiringLevelName, CurrentLevelName);
+		}
+	}
+	TransitionStats.bOverlapped = !RoomStreaming || RoomStreaming->CanOverlapTransition(RetiringLevelName, CurrentLevelName);
+
+	if (Inventory)
+	{
+		if (UAdventureGameHUD *Hud = GetHUD())
+		{
+			Inventory->OnInventoryChanged.Remove(OnInventoryChangedHandle);
+		}
+	}
 	if (ACommandManager *Command = GetCommandManager())
 	{
 		Command->SetInputLocked(true);
 		Command->InterruptCurrentAction();
 	}
-	GetHUD()->ShowBlackScreen();
+	if (UAdventureGameHUD *Hud = GetHUD())
+	{
+		Hud->ShowBlackScreen();
+	}
 
 	UE_LOG(LogAdventureGame, Display, TEXT("UAdventureGameInstance::LoadRoom - %s"), *CurrentLevelName.ToString());
 
-	FLatentActionInfo LatentActionInfo = GetLatentActionForHandler(OnRoomLoadedName);
+	if (RetiringLevelName.IsNone())
+	{
+		LoadNewRoom();
+	}
+	else if (TransitionStats.bOverlapped)
+	{
+		HideOldRoom();
+		LoadNewRoom();
+	}
+	else
+	{
+		// Both rooms at once would go over the memory policy, so unload first
+		SetRoomTransitionPhase(ERoomTransitionPhase::UnloadOldRoom);
+		UnloadRoom();
+	}
+}
+
+void UAdventureGameInstance::LoadNewRoom()
+{
+	SetRoomTransitionPhase(ERoomTransitionPhase::LoadNewRoom);
+	bNewRoomLevelPending = true;
+	bNewRoomAssetsPending = true;
+	if (!RoomStreaming || !RoomStreaming->LoadRoomAssets(CurrentLevelName, FStreamableManager::AsyncLoadHighPriority,
+		FStreamableDelegate::CreateUObject(this, &UAdventureGameInstance::OnNewRoomAssetsLoaded)))
+	{
+		// No manifest, or its assets already came in with a preload, so just load the level
+		bNewRoomLevelPending = false;
+		bNewRoomAssetsPending = false;
+		FLatentActionInfo LatentActionInfo = GetLatentActionForHandler(OnRoomLoadedName);
+		UGameplayStatics::LoadStreamLevel(GetWorld(), CurrentLevelName,
+		                                  true, FSimulationClock::IsFastForward(), LatentActionInfo);
+		return;
+	}
+	// Loaded hidden, then shown by ShowNewRoomWhenReady once the assets are in too.
+	// In fast forward the load blocks, as there is no frame rate to keep up.
+	FLatentActionInfo LatentActionInfo = GetLatentActionForHandler(OnNewRoomLevelLoadedName);
 	UGameplayStatics::LoadStreamLevel(GetWorld(), CurrentLevelName,
-	                                  true, false, LatentActionInfo);
+	                                  false, FSimulationClock::IsFastForward(), LatentActionInfo);
+}
+
+void UAdventureGameInstance::OnNewRoomLevelLoaded()
+{
+	UE_LOG(LogAdventureGame, Verbose, TEXT("UAdventureGameInstance::OnNewRoomLevelLoaded - %s"), *CurrentLevelName.ToString());
+	bNewRoomLevelPending = false;
+	ShowNewRoomWhenReady();
+}
+
+void UAdventureGameInstance::OnNewRoomAssetsLoaded()
+{
+	UE_LOG(LogAdventureGame, Verbose, TEXT("UAdventureGameInstance::OnNewRoomAssetsLoaded - %s"), *CurrentLevelName.ToString());
+	bNewRoomAssetsPending = false;
+	ShowNewRoomWhenReady();
+}
+
+void UAdventureGameInstance::ShowNewRoomWhenReady()
+{
+	const bool bStartingRoom = RoomTransitionPhase == ERoomTransitionPhase::LoadStartingRoom;
+	if (bNewRoomLevelPending || bNewRoomAssetsPending
+		|| (RoomTransitionPhase != ERoomTransitionPhase::LoadNewRoom && !bStartingRoom))
+	{
+		return;
+	}
+	SampleTransitionMemory();
+	FLatentActionInfo LatentActionInfo = GetLatentActionForHandler(OnRoomLoadedName);
+	UGameplayStatics::LoadStreamLevel(GetWorld(), bStartingRoom ? StartingLevelName : CurrentLevelName,
+	                                  true, FSimulationClock::IsFastForward(), LatentActionInfo);
+}
+
+void UAdventureGameInstance::HideOldRoom()
+{
+	// Making it invisible takes its actors out of the world, so the hotspots save
+	// their state now, while the new room is loading.
+	UE_LOG(LogAdventureGame, Log, TEXT("UAdventureGameInstance::HideOldRoom - %s%s"),
+		*RetiringLevelName.ToString(), bRetiringRoomWarm ? TEXT(", keeping it warm") : TEXT(""));
+	HideRoomLevel(RetiringLevelName, OnOldRoomHiddenName);
 }
 
 void UAdventureGameInstance::UnloadRoom()
 {
-	if (Inventory)
+	if (bRetiringRoomWarm)
 	{
-		if (UAdventureGameHUD *Hud = GetHUD())
+		// Neighbour of the new room, so keep it loaded and just hide it
+		UE_LOG(LogAdventureGame, Log, TEXT("UAdventureGameInstance::UnloadRoom - keeping %s warm"),
+			*RetiringLevelName.ToString());
+		HideRoomLevel(RetiringLevelName, OnRoomUnloadedName);
+		return;
+	}
+	FLatentActionInfo LatentActionInfo = GetLatentActionForHandler(OnRoomUnloadedName);
+	UE_LOG(LogAdventureGame, Log, TEXT("UAdventureGameInstance::UnloadRoom - %s"), *RetiringLevelName.ToString());
+	UnloadingLevels.Emplace(RetiringLevelName, TransitionStartTime);
+	UGameplayStatics::UnloadStreamLevel(GetWorld(), RetiringLevelName, LatentActionInfo, false);
+}
+
+void UAdventureGameInstance::HideRoomLevel(FName LevelName, FName HandlerName)
+{
+	if (HidingLevel)
+	{
+		// Only one room is left at a time, so finish with the last one first
+		OnHidingLevelHidden();
+	}
+	ULevelStreaming* StreamingLevel = UGameplayStatics::GetStreamingLevel(this, LevelName);
+	if (!StreamingLevel)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UAdventureGameInstance::HideRoomLevel - no streaming level %s"), *LevelName.ToString());
+		ProcessEvent(FindFunctionChecked(HandlerName), nullptr);
+		return;
+	}
+	StreamingLevel->SetShouldBeVisible(false);
+	HidingLevel = StreamingLevel;
+	HidingLevelHandlerName = HandlerName;
+	if (!StreamingLevel->IsLevelVisible())
+	{
+		OnHidingLevelHidden();
+		return;
+	}
+	StreamingLevel->OnLevelHidden.AddUniqueDynamic(this, &UAdventureGameInstance::OnHidingLevelHidden);
+}
+
+void UAdventureGameInstance::OnHidingLevelHidden()
+{
+	ULevelStreaming* StreamingLevel = HidingLevel;
+	const FName HandlerName = HidingLevelHandlerName;
+	HidingLevel = nullptr;
+	HidingLevelHandlerName = NAME_None;
+	if (!StreamingLevel) return;
+	StreamingLevel->OnLevelHidden.RemoveDynamic(this, &UAdventureGameInstance::OnHidingLevelHidden);
+	UE_LOG(LogAdventureGame, Verbose, TEXT("UAdventureGameInstance::OnHidingLevelHidden - %s"),
+		*StreamingLevel->GetWorldAssetPackageFName().ToString());
+	ProcessEvent(FindFunctionChecked(HandlerName), nullptr);
+}
+
+void UAdventureGameInstance::CreateRoomStreaming()
+{
+	if (!RoomStreaming)
+	{
+		if (RoomStreamingClass)
 		{
-			Inventory->OnInventoryChanged.Remove(OnInventoryChangedHandle);
+			RoomStreaming = NewObject<URoomStreamingManager>(this, RoomStreamingClass);
 		}
+		else
+		{
+			RoomStreaming = NewObject<URoomStreamingManager>(this);
+			UE_LOG(LogAdventureGame, Log, TEXT("Created default URoomStreamingManager. Set RoomStreamingClass property in AdventureGameInstance to customise this."));
+		}
+		RoomStreaming->RoomEvicted.AddUObject(this, &UAdventureGameInstance::ReleaseRoomBaselines);
+		if (!RoomGraph)
+		{
+			RoomGraph = RoomGraphAsset.LoadSynchronous();
+		}
+		checkf(RoomGraph, TEXT("No room graph at %s. Run UnrealEditor-Cmd AdventureGame.uproject -run=RoomGraph to build it."),
+			*RoomGraphAsset.ToString());
+		RoomStreaming->SetRoomGraph(RoomGraph);
 	}
-	RoomTransitionPhase = ERoomTransitionPhase::UnloadOldRoom;
-	FLatentActionInfo LatentActionInfo = GetLatentActionForHandler(OnRoomUnloadedName);
-	UGameplayStatics::UnloadStreamLevel(GetWorld(), CurrentDoor->CurrentLevel, LatentActionInfo, false);
 }
 
 FLatentActionInfo UAdventureGameInstance::GetLatentActionForHandler(FName EventName)
@@ -366,18 +878,14 @@ void UAdventureGameInstance::SetLoadTarget(FName LevelName, FName DoorLabel)
 
 ADoor* UAdventureGameInstance::FindDoor(FName DoorLabel)
 {
-	TArray<AActor*> Doors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ADoor::StaticClass(), Doors);
-	if (AActor** FoundDoor = Doors.FindByPredicate([DoorLabel](auto Element)
-	{
-		return Cast<ADoor>(Element)->DoorLabel == DoorLabel;
-	}))
+	const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(GetWorld());
+	if (ADoor* FoundDoor = Registry ? Registry->FindDoor(CurrentLevelName, DoorLabel) : nullptr)
 	{
 #if WITH_EDITOR
 		UE_LOG(LogAdventureGame, Display, TEXT("UAdventureGameInstance::FindDoor - got: %s"),
-		       *(Cast<ADoor>(*FoundDoor)->ShortDescription.ToString()));
+		       *(FoundDoor->ShortDescription.ToString()));
 #endif
-		return Cast<ADoor>(*FoundDoor);
+		return FoundDoor;
 	}
 	UE_LOG(LogAdventureGame, Error, TEXT("UAdventureGameInstance::FindDoor failed to find %s"),
 	       *(DoorLabel.ToString()));
@@ -456,7 +964,6 @@ void UAdventureGameInstance::LoadRoom(ADoor* FromDoor)
 
 UAdventureGameHUD* UAdventureGameInstance::GetHUD()
 {
-	TArray<UUserWidget*> FoundWidgets;
-	UWidgetBlueprintLibrary::GetAllWidgetsOfClass(this, FoundWidgets, UAdventureGameHUD::StaticClass(), true);
-	return FoundWidgets.IsEmpty() ? nullptr : Cast<UAdventureGameHUD>(FoundWidgets[0]);
+	const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(GetWorld());
+	return Registry ? Registry->GetHUD() : nullptr;
 }
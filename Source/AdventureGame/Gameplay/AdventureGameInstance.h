@@ -3,7 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ActorStateBaseline.h"
 #include "DataSaveRecord.h"
+#include "RoomReadiness.h"
+#include "RoomTransitionStats.h"
 #include "GameplayTagAssetInterface.h"
 #include "GameplayTagContainer.h"
 
@@ -27,6 +30,9 @@ class UItemList;
 class UAdventureSave;
 class ADoor;
 class UAdventureGameHUD;
+class URoomGraph;
+class URoomStreamingManager;
+class ULevelStreaming;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPlayerInventoryChanged, EItemKind, ItemKind, EItemDisposition, ItemDisposition);
 
@@ -34,7 +40,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPlayerInventoryChanged, EItemKind,
 /**
  * 
  */
-UCLASS()
+UCLASS(Config=Game)
 class ADVENTUREGAME_API UAdventureGameInstance : public UGameInstance, public IGameplayTagAssetInterface,
 												 public IItemManagerProvider, public IAdventureControllerProvider
 {
@@ -47,6 +53,8 @@ public:
 
 	virtual void Init() override;
 
+	virtual void Shutdown() override;
+
 	UFUNCTION()
 	void OnSaveHotSpot(AHotSpot* HotSpot);
 
@@ -162,9 +170,107 @@ public:
 	UFUNCTION()
 	void OnRoomUnloaded();
 
+	/// Event for when the room being left has been hidden
+	UFUNCTION()
+	void OnOldRoomHidden();
+
+	/// Event for when the new room's level has loaded, still hidden, while its
+	/// manifest assets may still be loading
+	UFUNCTION()
+	void OnNewRoomLevelLoaded();
+
+	/// Event for when a level hidden by HideRoomLevel is no longer visible
+	UFUNCTION()
+	void OnHidingLevelHidden();
+
 	/// Run the OnLoadRoom event to load a new level, and unload the current level.
 	void TriggerRoomTransition();
 
+	/// Create a blueprint of URoomStreamingManager and set it here to change
+	/// how many neighbouring rooms are kept preloaded.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Room")
+	TSubclassOf<URoomStreamingManager> RoomStreamingClass;
+
+	URoomStreamingManager* GetRoomStreaming() const { return RoomStreaming; }
+
+	/// Door network of the game, built by the RoomGraph commandlet. Lets the
+	/// neighbours of rooms not visited yet be preloaded, door targets be checked
+	/// before loading, and each room's asset manifest be loaded with it. Loaded
+	/// from RoomGraphAsset when the game starts if it is not set here.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Room")
+	URoomGraph* RoomGraph;
+
+	/// Where the RoomGraph commandlet saves the graph, set in DefaultGame.ini. The
+	/// game will not start without it, so run the commandlet before cooking.
+	UPROPERTY(Config, EditDefaultsOnly, Category="Room")
+	TSoftObjectPtr<URoomGraph> RoomGraphAsset;
+
+	ERoomTransitionPhase GetRoomTransitionPhase() const { return RoomTransitionPhase; }
+
+	/// Every door transition since the game started, with per phase timings.
+	const FRoomTransitionLog& GetRoomTransitionLog() const { return TransitionLog; }
+
+private:
+	/// Preloads the neighbours of the current room so doors only flip visibility.
+	UPROPERTY()
+	URoomStreamingManager* RoomStreaming;
+
+	void CreateRoomStreaming();
+
+	/// Time the current door transition started, or zero if none is in progress.
+	double TransitionStartTime = 0.0;
+
+	/// Measurements of the current, or last, door transition.
+	FRoomTransitionStats TransitionStats;
+
+	/// TransitionStats has not been added to TransitionLog yet. It stays open after
+	/// play starts until the old room has been unloaded.
+	bool bTransitionRecordOpen = false;
+
+	FRoomTransitionLog TransitionLog;
+
+	double GarbageCollectStartTime = 0.0;
+
+	const FName LoadRoomStepName = "LoadRoom";
+	const FName SetupRoomStepName = "SetupRoom";
+	const FName StartNewRoomStepName = "StartNewRoom";
+
+	/// Change phase, and start timing the new phase if a door transition is in progress.
+	void SetRoomTransitionPhase(ERoomTransitionPhase Phase);
+
+	/// The transition being timed, or null if play has started in the new room.
+	FRoomTransitionStats* GetTimedTransition();
+
+	/// Add TransitionStats to the log, if it is still open.
+	void CloseTransitionRecord();
+
+	void OnPreGarbageCollect();
+
+	void OnPostGarbageCollect();
+
+	/// Room the player is leaving in the current transition, or None.
+	FName RetiringLevelName;
+
+	/// The room being left is a neighbour of the new one, so is hidden but not unloaded.
+	bool bRetiringRoomWarm = false;
+
+	/// Rooms being fully unloaded, rather than hidden, with the time their transition
+	/// started. More than one if the player goes through doors quickly.
+	TArray<TPair<FName, double>> UnloadingLevels;
+
+	/// The new room's level, and the assets in its manifest, are still loading.
+	/// It is shown once both are in.
+	bool bNewRoomLevelPending = false;
+	bool bNewRoomAssetsPending = false;
+
+	/// Resource size of the loaded rooms and their manifest assets, in bytes.
+	uint64 GetRoomMemory() const;
+
+	/// Take the peak room memory of the transition so far.
+	void SampleTransitionMemory();
+
+public:
+
 	
 	//////////////////////////////////
 	///
@@ -196,10 +302,33 @@ public:
 	
 private:
 	
-	TArray< TWeakObjectPtr< AHotSpot >> RegisteredHotSpots;
-
 	UPROPERTY()
 	TArray<FDataSaveRecord> AdventureSaves;
+
+	/// Index into AdventureSaves by level and object name, see SaveRecordKey.
+	TMap<FString, int32> AdventureSaveIndex;
+
+	/// Level defaults of each hotspot in the loaded rooms, captured the first time
+	/// the hotspot streams in. Kept while its room is loaded, including when the
+	/// room is only hidden, as hidden actors keep their changed state.
+	TMap<FString, TUniquePtr<FActorStateBaseline>> HotSpotBaselines;
+
+	/// Write the tags and changed SaveGame properties of the hotspot into its save record.
+	void CaptureHotSpot(AHotSpot *HotSpot);
+
+	static FString SaveRecordKey(const FString &LevelName, const FString &ObjectName);
+
+	/// Name of the streamed level the actor was loaded with. This is used rather than
+	/// CurrentLevelName as the old room's actors are saved after that has moved on.
+	static FString GetSaveLevelName(const AActor *Actor);
+
+	FDataSaveRecord* FindSaveRecord(const FString &Key);
+
+	void RebuildSaveRecordIndex();
+
+	/// Drop the level default snapshots of a room's hotspots once the room has been
+	/// unloaded. They are taken again when it next streams in.
+	void ReleaseRoomBaselines(FName LevelName);
 	
 	//////////////////////////////////
 	///
@@ -209,6 +338,8 @@ private:
 	const FName OnLoadRoomName = "OnLoadRoom";
 	const FName OnRoomLoadedName = "OnRoomLoaded";
 	const FName OnRoomUnloadedName = "OnRoomUnloaded";
+	const FName OnOldRoomHiddenName = "OnOldRoomHidden";
+	const FName OnNewRoomLevelLoadedName = "OnNewRoomLevelLoaded";
 	
 	ERoomTransitionPhase RoomTransitionPhase = ERoomTransitionPhase::GameNotStarted;
 
@@ -217,9 +348,12 @@ private:
 	//     ------------                  ------------------
 	//     OnLoadRoom()                  GameNotStarted
 	//     LoadStartingRoom()            LoadStartingRoom
+	//     OnNewRoomLevelLoaded()        (as below, if the room has a manifest)
+	//     OnNewRoomAssetsLoaded()
+	//     ShowNewRoomWhenReady()
 	//     OnRoomLoaded()                NewRoomLoaded
-	//     NewRoomDelay()                DelayProcessing
-	//     OnRoomLoadTimerTimeout()
+	//     WaitForRoomReady()            DelayProcessing
+	//     CheckRoomReadiness()          (each tick until ready)
 	//     SetupRoom()
 	//     StartNewRoom()                RoomCurrent
 	//
@@ -227,14 +361,28 @@ private:
 	//  Member function called           State 
 	//     ------------                  ------------------
 	//     OnLoadRoom()                  RoomCurrent
-	//     LoadRoom()                    LoadNewRoom
+	//     LoadRoom()
+	//     HideOldRoom()                 (old room hidden while the new one loads)
+	//     LoadNewRoom()                 LoadNewRoom
+	//     OnNewRoomLevelLoaded()        (level hidden, if the room has a manifest)
+	//     OnNewRoomAssetsLoaded()       (manifest assets, in either order)
+	//     ShowNewRoomWhenReady()
 	//     OnRoomLoaded()                NewRoomLoaded
-	//     UnloadRoom()                  UnloadOldRoom
-	//     OnRoomUnloaded()
-	//     NewRoomDelay()                DelayProcessing
-	//     OnRoomLoadTimerTimeout()      
+	//     WaitForRoomReady()            DelayProcessing
+	//     CheckRoomReadiness()          (each tick until ready)
 	//     SetupRoom()
 	//     StartNewRoom()                RoomCurrent
+	//     UnloadRoom()                  (deferred, unless kept warm)
+	//     OnRoomUnloaded()
+	//
+	// If both rooms together would go over the streaming manager's
+	// TransitionPeakMemoryMB, LoadRoom unloads the old room first:
+	//     LoadRoom()
+	//     UnloadRoom()                  UnloadOldRoom
+	//     OnRoomUnloaded()              RoomUnloaded
+	//     LoadNewRoom()                 LoadNewRoom
+	//     OnRoomLoaded()                NewRoomLoaded
+	//     ...as above
 	//
 	// On Init() calling LoadGame() the StartingDoorLabel
 	// and StartingLevelName will be set to values from the save
@@ -256,30 +404,78 @@ private:
 	/// Load up the room specified by the starting door
 	void LoadStartingRoom();
 
-	/// Unload the room specified by the current door
+	/// Start the async load of the room in CurrentLevelName, made visible when loaded.
+	/// If the room graph has a manifest for the room its assets are loaded in one
+	/// high priority batch at the same time, and the room is only made visible once
+	/// they are all in, so nothing in it has to be loaded synchronously.
+	void LoadNewRoom();
+
+	void OnNewRoomAssetsLoaded();
+
+	/// Make the new room visible once its level and its manifest assets have loaded.
+	void ShowNewRoomWhenReady();
+
+	/// Hide the room being left, keeping it loaded until the new room is playing
+	void HideOldRoom();
+
+	/// Unload the room being left, or just hide it if it is being kept warm
 	void UnloadRoom();
 
-	/// Run a short delay to allow scene to complete, and any geometry
-	/// to be placed, spawned and stabilise.
-	void NewRoomDelay();
+	/// Hide a room's level, keeping it loaded, and call the handler once the level reports
+	/// it is no longer visible and its actors have left the world. Loading a streaming level
+	/// with visibility off does not hide one that is already visible.
+	void HideRoomLevel(FName LevelName, FName HandlerName);
+
+	/// Level being hidden by HideRoomLevel, and the handler to call when it is.
+	UPROPERTY()
+	ULevelStreaming* HidingLevel = nullptr;
+
+	FName HidingLevelHandlerName;
+
+	/// Wait for the new room to signal it is ready to play, rather than for a
+	/// fixed delay. See FRoomReadiness for the signals.
+	void WaitForRoomReady();
+
+	/// Check the readiness signals, set up the room once it is visible with its
+	/// hotspots loaded, and start play once the character has landed and
+	/// navigation is ready, or RoomReadyTimeout has passed.
+	void CheckRoomReadiness();
+
+	/// Gather the hotspots in the new room's level that have not begun play yet,
+	/// once, when the level is first visible.
+	void GatherPendingHotSpots(const ULevel *Level);
+
+	/// Have all the hotspots gathered by GatherPendingHotSpots begun play.
+	bool AreHotSpotsLoaded();
+
+	bool IsNavigationReady() const;
+
+	bool IsCharacterGrounded();
 	
 	/// Setup the current room, find & load the door (move the player
-	/// character to the relevant door). Hide the transition effect.
-	/// Call this only after the delay to ensure the player character
-	/// and all geometry is stable from any collisions.
+	/// character to the relevant door). Call this only once the room's
+	/// level is visible and its hotspots have restored their state.
 	void SetupRoom();
 
-	/// Restart play in the new room allowing input from the player.
+	/// Hide the transition effect and restart play in the new room allowing
+	/// input from the player.
 	void StartNewRoom();
 
-	void OnRoomLoadTimerTimeout();
-
 	FLatentActionInfo GetLatentActionForHandler(FName EventName);
 	
-	FTimerHandle RoomLoadTimer;
+	FTimerHandle RoomReadyTimer;
+
+	FRoomReadiness RoomReadiness;
+
+	/// Hotspots in the new room still to begin play, and restore their saved state.
+	TArray<TWeakObjectPtr<AHotSpot>> PendingHotSpots;
+
+	bool bPendingHotSpotsGathered = false;
 
+	/// Safety limit on how long to wait for a new room's readiness signals,
+	/// after which play starts anyway and the missing signals are logged.
 	UPROPERTY(EditDefaultsOnly, Category="Room")
-	float RoomLoadDelay = 0.5;
+	float RoomReadyTimeout = 2.0;
 	
 	//////////////////////////////////
 	///
@@ -0,0 +1,286 @@
+// (c) 2025 Sarah Smith
+
+
+#include "AdventureWorldRegistry.h"
+#include "WalkAreaComponent.h"
+
+#include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/HotSpots/Door.h"
+#include "AdventureGame/HotSpots/HotSpot.h"
+#include "AdventureGame/HUD/AdventureGameHUD.h"
+#include "AdventureGame/Player/CommandManager.h"
+#include "AdventureGame/Player/FollowCamera.h"
+
+#include "Engine/Engine.h"
+#include "Misc/PackageName.h"
+
+UAdventureWorldRegistry* UAdventureWorldRegistry::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UAdventureWorldRegistry>() : nullptr;
+}
+
+FName UAdventureWorldRegistry::GetActorLevelName(const AActor* Actor)
+{
+	const ULevel* Level = Actor ? Actor->GetLevel() : nullptr;
+	if (!Level) return NAME_None;
+	const FString PackageName = UWorld::RemovePIEPrefix(Level->GetPackage()->GetName());
+	return FName(FPackageName::GetShortName(PackageName));
+}
+
+void UAdventureWorldRegistry::RegisterActor(AActor* Actor)
+{
+	if (!IsValid(Actor)) return;
+	for (const UClass* Class = Actor->GetClass(); Class && Class != AActor::StaticClass(); Class = Class->GetSuperClass())
+	{
+		ActorsByClass.FindOrAdd(Class).Add(Actor);
+	}
+}
+
+void UAdventureWorldRegistry::UnregisterActor(AActor* Actor)
+{
+	if (!Actor) return;
+	for (const UClass* Class = Actor->GetClass(); Class && Class != AActor::StaticClass(); Class = Class->GetSuperClass())
+	{
+		if (TSet<TWeakObjectPtr<AActor>>* Actors = ActorsByClass.Find(Class))
+		{
+			Actors->Remove(Actor);
+		}
+	}
+}
+
+void UAdventureWorldRegistry::RegisterHotSpot(AHotSpot* HotSpot)
+{
+	if (!IsValid(HotSpot)) return;
+	RegisterActor(HotSpot);
+	bool bAlreadyRegistered = false;
+	HotSpotsByLevel.FindOrAdd(GetActorLevelName(HotSpot)).Add(HotSpot, &bAlreadyRegistered);
+	if (!bAlreadyRegistered)
+	{
+		++HotSpotCount;
+	}
+	HotSpotIndices.FindOrAdd(GetActorLevelName(HotSpot)).Add(HotSpot->GetHitTestComponent(), HotSpot->HitPriority);
+	HotSpot->RegisterProximityTrigger(this);
+	if (ADoor* Door = Cast<ADoor>(HotSpot))
+	{
+		if (Door->DoorLabel.IsNone()) return;
+		TMap<FName, TWeakObjectPtr<ADoor>>& LevelDoors = DoorsByLevel.FindOrAdd(GetActorLevelName(Door));
+		const TWeakObjectPtr<ADoor>* Existing = LevelDoors.Find(Door->DoorLabel);
+		if (Existing && Existing->IsValid() && Existing->Get() != Door)
+		{
+			UE_LOG(LogAdventureGame, Warning, TEXT("UAdventureWorldRegistry - door label %s used by %s and %s"),
+				*Door->DoorLabel.ToString(), *Existing->Get()->GetName(), *Door->GetName());
+		}
+		LevelDoors.Add(Door->DoorLabel, Door);
+	}
+}
+
+void UAdventureWorldRegistry::UnregisterHotSpot(AHotSpot* HotSpot)
+{
+	if (!HotSpot) return;
+	UnregisterActor(HotSpot);
+	if (TSet<TWeakObjectPtr<AHotSpot>>* LevelHotSpots = HotSpotsByLevel.Find(GetActorLevelName(HotSpot)))
+	{
+		HotSpotCount -= LevelHotSpots->Remove(HotSpot);
+	}
+	if (FHotSpotSpatialIndex* Index = HotSpotIndices.Find(GetActorLevelName(HotSpot)))
+	{
+		Index->Remove(HotSpot->GetHitTestComponent());
+	}
+	UnregisterProximityTriggers(HotSpot);
+	if (const ADoor* Door = Cast<ADoor>(HotSpot))
+	{
+		if (TMap<FName, TWeakObjectPtr<ADoor>>* LevelDoors = DoorsByLevel.Find(GetActorLevelName(Door)))
+		{
+			const TWeakObjectPtr<ADoor>* Existing = LevelDoors->Find(Door->DoorLabel);
+			if (Existing && Existing->Get() == Door)
+			{
+				LevelDoors->Remove(Door->DoorLabel);
+			}
+		}
+	}
+}
+
+void UAdventureWorldRegistry::RegisterHUD(UAdventureGameHUD* InHUD)
+{
+	HUD = InHUD;
+}
+
+void UAdventureWorldRegistry::RegisterWalkArea(UWalkAreaComponent* WalkArea)
+{
+	if (!IsValid(WalkArea)) return;
+	const FName LevelName = GetActorLevelName(WalkArea->GetOwner());
+	const TWeakObjectPtr<UWalkAreaComponent>* Existing = WalkAreasByLevel.Find(LevelName);
+	if (Existing && Existing->IsValid() && Existing->Get() != WalkArea)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UAdventureWorldRegistry - %s has walk areas %s and %s, using the last"),
+			*LevelName.ToString(), *Existing->Get()->GetPathName(), *WalkArea->GetPathName());
+	}
+	WalkAreasByLevel.Add(LevelName, WalkArea);
+}
+
+void UAdventureWorldRegistry::UnregisterWalkArea(UWalkAreaComponent* WalkArea)
+{
+	if (!WalkArea) return;
+	const FName LevelName = GetActorLevelName(WalkArea->GetOwner());
+	const TWeakObjectPtr<UWalkAreaComponent>* Existing = WalkAreasByLevel.Find(LevelName);
+	if (Existing && Existing->Get() == WalkArea)
+	{
+		WalkAreasByLevel.Remove(LevelName);
+	}
+}
+
+int32 UAdventureWorldRegistry::RegisterProximityCircle(AActor* Owner, const FVector2D& Center, double Radius)
+{
+	if (!IsValid(Owner)) return INDEX_NONE;
+	return ProximityGrids.FindOrAdd(GetActorLevelName(Owner)).AddCircle(Owner, Center, Radius);
+}
+
+int32 UAdventureWorldRegistry::RegisterProximityRegion(AActor* Owner, const FBox2D& Region)
+{
+	if (!IsValid(Owner) || !Region.bIsValid) return INDEX_NONE;
+	return ProximityGrids.FindOrAdd(GetActorLevelName(Owner)).AddRegion(Owner, Region);
+}
+
+void UAdventureWorldRegistry::UnregisterProximityTriggers(AActor* Owner)
+{
+	if (!Owner) return;
+	if (FProximityGrid* Grid = ProximityGrids.Find(GetActorLevelName(Owner)))
+	{
+		Grid->RemoveAll(Owner);
+	}
+}
+
+void UAdventureWorldRegistry::UpdateProximity(const FVector& PlayerLocation)
+{
+	const FVector2D Position(PlayerLocation);
+	for (TPair<FName, FProximityGrid>& Pair : ProximityGrids)
+	{
+		FProximityGrid& Grid = Pair.Value;
+		ProximityEntered.Reset();
+		ProximityExited.Reset();
+		Grid.Update(Position, ProximityEntered, ProximityExited);
+
+		// Exits first, so walking from one trigger straight into another reads in order
+		for (const int32 Handle : ProximityExited)
+		{
+			AActor* Owner = Grid.Find(Handle)->Owner.Get();
+			if (!Owner) continue;
+			if (AHotSpot* HotSpot = Cast<AHotSpot>(Owner)) HotSpot->OnPlayerProximity(false);
+			ProximityChanged.Broadcast(Owner, false);
+		}
+		for (const int32 Handle : ProximityEntered)
+		{
+			AActor* Owner = Grid.Find(Handle)->Owner.Get();
+			if (!Owner) continue;
+			if (AHotSpot* HotSpot = Cast<AHotSpot>(Owner)) HotSpot->OnPlayerProximity(true);
+			ProximityChanged.Broadcast(Owner, true);
+		}
+	}
+}
+
+UWalkAreaComponent* UAdventureWorldRegistry::FindWalkArea(FName LevelName) const
+{
+	const TWeakObjectPtr<UWalkAreaComponent>* WalkArea = WalkAreasByLevel.Find(LevelName);
+	return WalkArea ? WalkArea->Get() : nullptr;
+}
+
+ACommandManager* UAdventureWorldRegistry::GetCommandManager() const
+{
+	return GetActor<ACommandManager>();
+}
+
+AFollowCamera* UAdventureWorldRegistry::GetFollowCamera() const
+{
+	return GetActor<AFollowCamera>();
+}
+
+ADoor* UAdventureWorldRegistry::FindDoor(FName LevelName, FName DoorLabel) const
+{
+	const TMap<FName, TWeakObjectPtr<ADoor>>* LevelDoors = DoorsByLevel.Find(LevelName);
+	if (LevelDoors && !LevelDoors->IsEmpty())
+	{
+		const TWeakObjectPtr<ADoor>* Door = LevelDoors->Find(DoorLabel);
+		return Door ? Door->Get() : nullptr;
+	}
+	for (const TPair<FName, TMap<FName, TWeakObjectPtr<ADoor>>>& Level : DoorsByLevel)
+	{
+		if (const TWeakObjectPtr<ADoor>* Door = Level.Value.Find(DoorLabel))
+		{
+			if (Door->IsValid()) return Door->Get();
+		}
+	}
+	return nullptr;
+}
+
+void UAdventureWorldRegistry::GetHotSpotsInLevel(FName LevelName, TArray<AHotSpot*>& OutHotSpots) const
+{
+	if (const TSet<TWeakObjectPtr<AHotSpot>>* LevelHotSpots = HotSpotsByLevel.Find(LevelName))
+	{
+		for (const TWeakObjectPtr<AHotSpot>& HotSpot : *LevelHotSpots)
+		{
+			if (AHotSpot* Valid = HotSpot.Get()) OutHotSpots.Add(Valid);
+		}
+	}
+}
+
+AHotSpot* UAdventureWorldRegistry::FindHotSpot(FName LevelName, FName HotSpotName) const
+{
+	if (const TSet<TWeakObjectPtr<AHotSpot>>* LevelHotSpots = HotSpotsByLevel.Find(LevelName))
+	{
+		for (const TWeakObjectPtr<AHotSpot>& HotSpot : *LevelHotSpots)
+		{
+			if (HotSpot.IsValid() && HotSpot->GetFName() == HotSpotName) return HotSpot.Get();
+		}
+	}
+	return nullptr;
+}
+
+void UAdventureWorldRegistry::GetDoorsInLevel(FName LevelName, TArray<ADoor*>& OutDoors) const
+{
+	if (const TSet<TWeakObjectPtr<AHotSpot>>* LevelHotSpots = HotSpotsByLevel.Find(LevelName))
+	{
+		for (const TWeakObjectPtr<AHotSpot>& HotSpot : *LevelHotSpots)
+		{
+			if (ADoor* Door = Cast<ADoor>(HotSpot.Get())) OutDoors.Add(Door);
+		}
+	}
+}
+
+void UAdventureWorldRegistry::GetAllHotSpots(TArray<AHotSpot*>& OutHotSpots) const
+{
+	OutHotSpots.Reserve(OutHotSpots.Num() + HotSpotCount);
+	for (const TPair<FName, TSet<TWeakObjectPtr<AHotSpot>>>& Level : HotSpotsByLevel)
+	{
+		for (const TWeakObjectPtr<AHotSpot>& HotSpot : Level.Value)
+		{
+			if (AHotSpot* Valid = HotSpot.Get()) OutHotSpots.Add(Valid);
+		}
+	}
+}
+
+AHotSpot* UAdventureWorldRegistry::FindHotSpotAt(const FVector2D& Point) const
+{
+	auto Accept = [&Point](UPrimitiveComponent* Component)
+	{
+		const AHotSpot* HotSpot = Cast<AHotSpot>(Component->GetOwner());
+		const ULevel* Level = HotSpot ? HotSpot->GetLevel() : nullptr;
+		return Level && Level->bIsVisible && HotSpot->HitTestMask(Point);
+	};
+
+	FHotSpotHit Best;
+	for (const TPair<FName, FHotSpotSpatialIndex>& Index : HotSpotIndices)
+	{
+		FHotSpotHit Hit;
+		if (Index.Value.FindAt(Point, Accept, Hit) && Hit.IsBetterThan(Best))
+		{
+			Best = Hit;
+		}
+	}
+	return Best.Component ? Cast<AHotSpot>(Best.Component->GetOwner()) : nullptr;
+}
+
+bool UAdventureWorldRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,174 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HotSpotSpatialIndex.h"
+#include "ProximityGrid.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "AdventureWorldRegistry.generated.h"
+
+class ACommandManager;
+class ADoor;
+class AFollowCamera;
+class AHotSpot;
+class UAdventureGameHUD;
+class UWalkAreaComponent;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnProximityChanged, AActor* /* Owner */, bool /* bIsNear */);
+
+/**
+ * Per world index of the actors and widgets the game needs to find, so that
+ * finding them never walks the whole actor or widget list.
+ *
+ * Actors register themselves on <code>BeginPlay</code>, or on
+ * <code>PostInitializeComponents</code> if others look for them as they begin
+ * play, and unregister on <code>EndPlay</code>, so only actors in visible
+ * rooms are ever found. Actors are indexed under their class and each of its
+ * super classes, hotspots under the level they are in, and doors under their
+ * level and door label.
+ * Each level also has a spatial index of its hotspots for hit testing clicks
+ * and the cursor, may have a walk area for the player's paths, and has a
+ * proximity grid of the triggers that fire as the player walks near things.
+ */
+UCLASS()
+class ADVENTUREGAME_API UAdventureWorldRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	/// Get the registry for the world the context object is in, or null if there is none.
+	static UAdventureWorldRegistry* Get(const UObject* WorldContextObject);
+
+	/// Short name of the level the actor is in, eg "TowerExterior", with any
+	/// play in editor prefix removed. Matches the names used for streaming.
+	static FName GetActorLevelName(const AActor* Actor);
+
+	//////////////////////////////////
+	///
+	/// REGISTRATION
+	///
+
+	void RegisterActor(AActor* Actor);
+
+	void UnregisterActor(AActor* Actor);
+
+	/// Register under its class, its level and if it is a door, its door label,
+	/// and add it to its level's spatial index.
+	void RegisterHotSpot(AHotSpot* HotSpot);
+
+	void UnregisterHotSpot(AHotSpot* HotSpot);
+
+	void RegisterHUD(UAdventureGameHUD* InHUD);
+
+	/// Register under the level of the actor it is on. One per level.
+	void RegisterWalkArea(UWalkAreaComponent* WalkArea);
+
+	void UnregisterWalkArea(UWalkAreaComponent* WalkArea);
+
+	//////////////////////////////////
+	///
+	/// PROXIMITY
+	///
+
+	/// Add a trigger to the owner's level, a circle in the XY plane. Returns its handle
+	/// in that level's grid.
+	int32 RegisterProximityCircle(AActor* Owner, const FVector2D& Center, double Radius);
+
+	/// Add a trigger to the owner's level, a box in the XY plane.
+	int32 RegisterProximityRegion(AActor* Owner, const FBox2D& Region);
+
+	/// Remove all the owner's triggers, without them reporting the player leaving.
+	void UnregisterProximityTriggers(AActor* Owner);
+
+	/// Move the player through the proximity grids of every level, firing enter
+	/// and exit for the triggers whose edge the player crossed. Call when the
+	/// player has moved, it returns straight away if they have not.
+	void UpdateProximity(const FVector& PlayerLocation);
+
+	/// The proximity grid of the given level, or null if nothing there has a trigger.
+	const FProximityGrid* FindProximityGrid(FName LevelName) const { return ProximityGrids.Find(LevelName); }
+
+	/// Broadcast with the owner of a trigger when the player enters or leaves it.
+	/// Hotspots are also told through <code>AHotSpot::OnPlayerProximity</code>.
+	FOnProximityChanged ProximityChanged;
+
+	//////////////////////////////////
+	///
+	/// LOOKUP
+	///
+
+	/// First registered actor that is of class T or a subclass of it.
+	template <class T>
+	T* GetActor() const
+	{
+		if (const TSet<TWeakObjectPtr<AActor>>* Actors = ActorsByClass.Find(T::StaticClass()))
+		{
+			for (const TWeakObjectPtr<AActor>& Actor : *Actors)
+			{
+				if (T* Found = Cast<T>(Actor.Get())) return Found;
+			}
+		}
+		return nullptr;
+	}
+
+	ACommandManager* GetCommandManager() const;
+
+	AFollowCamera* GetFollowCamera() const;
+
+	UAdventureGameHUD* GetHUD() const { return HUD.Get(); }
+
+	/// The door with the label in the given level. If no doors have registered in
+	/// that level, for example in a test map that is not streamed, any door with the label.
+	ADoor* FindDoor(FName LevelName, FName DoorLabel) const;
+
+	/// All the hotspots that have begun play in the given level.
+	void GetHotSpotsInLevel(FName LevelName, TArray<AHotSpot*>& OutHotSpots) const;
+
+	/// The hotspot with the actor name in the given level, or null if it has not begun play.
+	AHotSpot* FindHotSpot(FName LevelName, FName HotSpotName) const;
+
+	/// All the doors that have begun play in the given level.
+	void GetDoorsInLevel(FName LevelName, TArray<ADoor*>& OutDoors) const;
+
+	/// All the hotspots that have begun play, in every level.
+	void GetAllHotSpots(TArray<AHotSpot*>& OutHotSpots) const;
+
+	int32 GetHotSpotCount() const { return HotSpotCount; }
+
+	/// The hotspot on top at a point in the XY plane, in any visible room, or null.
+	/// Uses the spatial index and each hotspot's hit mask, not the physics scene.
+	AHotSpot* FindHotSpotAt(const FVector2D& Point) const;
+
+	/// The walk area of the given level, or null if it uses the navigation mesh.
+	UWalkAreaComponent* FindWalkArea(FName LevelName) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/// Sets, so registering and unregistering each actor as a room streams in or out
+	/// does not search the actors already there.
+	TMap<const UClass*, TSet<TWeakObjectPtr<AActor>>> ActorsByClass;
+
+	TMap<FName, TSet<TWeakObjectPtr<AHotSpot>>> HotSpotsByLevel;
+
+	TMap<FName, FHotSpotSpatialIndex> HotSpotIndices;
+
+	/// Doors by level, then by door label. Doors in different rooms share a label
+	/// when they lead to each other.
+	TMap<FName, TMap<FName, TWeakObjectPtr<ADoor>>> DoorsByLevel;
+
+	TMap<FName, TWeakObjectPtr<UWalkAreaComponent>> WalkAreasByLevel;
+
+	TMap<FName, FProximityGrid> ProximityGrids;
+
+	/// Scratch for UpdateProximity, kept to not allocate each frame.
+	TArray<int32> ProximityEntered;
+
+	TArray<int32> ProximityExited;
+
+	TWeakObjectPtr<UAdventureGameHUD> HUD;
+
+	int32 HotSpotCount = 0;
+};
@@ -0,0 +1,358 @@
+// (c) 2025 Sarah Smith
+
+
+#include "CommandRecorder.h"
+
+#include "AdventureGameInstance.h"
+#include "AdventureSave.h"
+#include "AdventureWorldRegistry.h"
+#include "SimulationClock.h"
+
+#include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/Player/AdventureCharacter.h"
+#include "AdventureGame/Player/CommandManager.h"
+
+#include "Engine/Engine.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+
+UCommandRecorder* UCommandRecorder::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UCommandRecorder>() : nullptr;
+}
+
+bool UCommandRecorder::StartRecording()
+{
+	if (State != ERecorderState::Idle)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UCommandRecorder::StartRecording - already recording or replaying"));
+		return false;
+	}
+	Recording = NewObject<UCommandRecording>(this);
+	State = ERecorderState::WaitingToRecord;
+	UE_LOG(LogAdventureGame, Display, TEXT("UCommandRecorder::StartRecording - recording from the next frame of play"));
+	return true;
+}
+
+bool UCommandRecorder::StopRecording(const FString& SlotName)
+{
+	if (!IsRecording())
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UCommandRecorder::StopRecording - not recording"));
+		return false;
+	}
+	const bool bStarted = State == ERecorderState::Recording;
+	State = ERecorderState::Idle;
+	UCommandRecording* Finished = Recording;
+	Recording = nullptr;
+	if (!bStarted)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UCommandRecorder::StopRecording - stopped before play started"));
+		return false;
+	}
+	if (!UGameplayStatics::SaveGameToSlot(Finished, SlotName, 0))
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UCommandRecorder::StopRecording - could not write slot %s"), *SlotName);
+		return false;
+	}
+	UE_LOG(LogAdventureGame, Display, TEXT("UCommandRecorder::StopRecording - %d commands over %d frames written to slot %s"),
+		Finished->Commands.Num(), Finished->GetFrameCount(), *SlotName);
+	return true;
+}
+
+bool UCommandRecorder::StartReplay(const FString& SlotName)
+{
+	if (State != ERecorderState::Idle)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UCommandRecorder::StartReplay - already recording or replaying"));
+		return false;
+	}
+	UAdventureGameInstance* AdventureGameInstance = GetAdventureGameInstance();
+	UCommandRecording* Loaded = Cast<UCommandRecording>(UGameplayStatics::LoadGameFromSlot(SlotName, 0));
+	UAdventureSave* StartingSave = Loaded
+		? Cast<UAdventureSave>(UGameplayStatics::LoadGameFromMemory(Loaded->StartingSave))
+		: nullptr;
+	if (!AdventureGameInstance || !StartingSave)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UCommandRecorder::StartReplay - no recording in slot %s"), *SlotName);
+		return false;
+	}
+	if (AdventureGameInstance->GetRoomTransitionPhase() != ERoomTransitionPhase::GameNotStarted
+		&& AdventureGameInstance->CurrentLevelName == Loaded->StartingLevel)
+	{
+		// The room is not loaded again, so its hotspots keep the state they have now
+		UE_LOG(LogAdventureGame, Warning, TEXT("UCommandRecorder::StartReplay - already in %s, start from the command line for an exact replay"),
+			*Loaded->StartingLevel.ToString());
+	}
+
+	Recording = Loaded;
+	AdventureGameInstance->CurrentSaveGame = StartingSave;
+	AdventureGameInstance->LoadGame();
+	State = ERecorderState::WaitingToReplay;
+	UE_LOG(LogAdventureGame, Display, TEXT("UCommandRecorder::StartReplay - %d commands over %d frames from slot %s, starting in %s"),
+		Recording->Commands.Num(), Recording->GetFrameCount(), *SlotName, *Recording->StartingLevel.ToString());
+	return true;
+}
+
+void UCommandRecorder::StopReplay()
+{
+	if (State == ERecorderState::Replaying)
+	{
+		EndReplay();
+	}
+	else if (State == ERecorderState::WaitingToReplay)
+	{
+		State = ERecorderState::Idle;
+		Recording = nullptr;
+	}
+}
+
+void UCommandRecorder::Record(const FRecordedCommand& Command)
+{
+	if (State != ERecorderState::Recording) return;
+	FRecordedCommand& Recorded = Recording->Commands.Add_GetRef(Command);
+	Recorded.Frame = Frame;
+	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("UCommandRecorder::Record - %s"), *Recorded.ToString());
+}
+
+void UCommandRecorder::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Before any actor begins play, so a replay's save game picks the starting room
+	FString SlotName;
+	if (FParse::Value(FCommandLine::Get(), TEXT("ReplayCommands="), SlotName))
+	{
+		bExitAfterReplay = FParse::Param(FCommandLine::Get(), TEXT("ReplayExit"));
+		StartReplay(SlotName);
+	}
+	else if (FParse::Value(FCommandLine::Get(), TEXT("RecordCommands="), AutoRecordSlotName))
+	{
+		StartRecording();
+	}
+}
+
+void UCommandRecorder::Deinitialize()
+{
+	if (IsRecording() && !AutoRecordSlotName.IsEmpty())
+	{
+		StopRecording(AutoRecordSlotName);
+	}
+	StopReplay();
+	Super::Deinitialize();
+}
+
+void UCommandRecorder::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	switch (State)
+	{
+	case ERecorderState::WaitingToRecord:
+		if (IsInPlay()) BeginRecording();
+		break;
+	case ERecorderState::Recording:
+		if (!IsInPlay()) break;
+		Recording->FrameDeltas.Add(DeltaTime);
+		++Frame;
+		break;
+	case ERecorderState::WaitingToReplay:
+		if (IsInPlay() && GetAdventureGameInstance()->CurrentLevelName == Recording->StartingLevel) BeginReplay();
+		break;
+	case ERecorderState::Replaying:
+		{
+			const double Now = FPlatformTime::Seconds();
+			if (!IsInPlay())
+			{
+				LastFrameTime = Now;
+				break;
+			}
+			if (FSimulationClock::IsFastForward())
+			{
+				++Frame;
+				ReplayWhenReady();
+				break;
+			}
+			const double FrameSeconds = Now - LastFrameTime;
+			LastFrameTime = Now;
+			LongestFrameSeconds = FMath::Max(LongestFrameSeconds, FrameSeconds);
+			if (FrameSeconds > 2.0 * Recording->FrameDeltas[Frame]) ++HitchCount;
+
+			++Frame;
+			if (Frame >= Recording->GetFrameCount())
+			{
+				EndReplay();
+				break;
+			}
+			FApp::SetFixedDeltaTime(Recording->FrameDeltas[Frame]);
+			ReplayDueCommands();
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+TStatId UCommandRecorder::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCommandRecorder, STATGROUP_Tickables);
+}
+
+bool UCommandRecorder::IsTickable() const
+{
+	return State != ERecorderState::Idle;
+}
+
+bool UCommandRecorder::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UCommandRecorder::IsInPlay() const
+{
+	const UAdventureGameInstance* AdventureGameInstance = GetAdventureGameInstance();
+	return AdventureGameInstance && AdventureGameInstance->CurrentDoor && GetCommandManager()
+		&& AdventureGameInstance->GetRoomTransitionPhase() == ERoomTransitionPhase::RoomCurrent;
+}
+
+void UCommandRecorder::BeginRecording()
+{
+	UAdventureGameInstance* AdventureGameInstance = GetAdventureGameInstance();
+	AdventureGameInstance->SaveGame();
+	UGameplayStatics::SaveGameToMemory(AdventureGameInstance->CurrentSaveGame, Recording->StartingSave);
+	Recording->StartingLevel = AdventureGameInstance->CurrentLevelName;
+	if (const AAdventureCharacter* PlayerCharacter = GetCommandManager()->PlayerCharacter)
+	{
+		Recording->StartingLocation = PlayerCharacter->GetActorLocation();
+	}
+	Recording->RandomSeed = static_cast<int32>(FPlatformTime::Cycles());
+	FMath::RandInit(Recording->RandomSeed);
+	FMath::SRandInit(Recording->RandomSeed);
+	Frame = 0;
+	State = ERecorderState::Recording;
+}
+
+void UCommandRecorder::BeginReplay()
+{
+	if (Recording->GetFrameCount() == 0)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UCommandRecorder::BeginReplay - the recording has no frames"));
+		StopReplay();
+		return;
+	}
+	ACommandManager* CommandManager = GetCommandManager();
+	CommandManager->CancelAllCommands();
+	if (AAdventureCharacter* PlayerCharacter = CommandManager->PlayerCharacter)
+	{
+		PlayerCharacter->TeleportToLocation(Recording->StartingLocation);
+	}
+	FMath::RandInit(Recording->RandomSeed);
+	FMath::SRandInit(Recording->RandomSeed);
+
+	Frame = 0;
+	NextCommand = 0;
+	ReplayStartTime = FPlatformTime::Seconds();
+	LastFrameTime = ReplayStartTime;
+	LongestFrameSeconds = 0.0;
+	HitchCount = 0;
+	FramesWaiting = 0;
+	State = ERecorderState::Replaying;
+
+	// Fast forward keeps its own time step, and paces the commands by the game
+	if (FSimulationClock::IsFastForward()) return;
+
+	bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+	SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(Recording->FrameDeltas[0]);
+
+	// Input in a frame comes before its tick, so frame 0's commands go in now
+	ReplayDueCommands();
+}
+
+void UCommandRecorder::ReplayDueCommands()
+{
+	ACommandManager* CommandManager = GetCommandManager();
+	while (NextCommand < Recording->Commands.Num() && Recording->Commands[NextCommand].Frame <= Frame)
+	{
+		if (CommandManager) CommandManager->ReplayCommand(Recording->Commands[NextCommand]);
+		++NextCommand;
+	}
+}
+
+void UCommandRecorder::ReplayWhenReady()
+{
+	// A game that has gone a different way, eg stuck in a conversation, should
+	// not hold the replay up for ever.
+	const int32 MaxFramesWaiting = FMath::CeilToInt32(10.0f / FSimulationClock::GetFixedStep());
+	if (!IsReadyForNextCommand() && ++FramesWaiting < MaxFramesWaiting) return;
+	if (FramesWaiting >= MaxFramesWaiting)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UCommandRecorder::ReplayWhenReady - gave up waiting for the game to be ready for command %d"), NextCommand);
+	}
+	FramesWaiting = 0;
+
+	if (NextCommand >= Recording->Commands.Num())
+	{
+		EndReplay();
+		return;
+	}
+	ACommandManager* CommandManager = GetCommandManager();
+	const int32 GroupFrame = Recording->Commands[NextCommand].Frame;
+	while (NextCommand < Recording->Commands.Num() && Recording->Commands[NextCommand].Frame == GroupFrame)
+	{
+		CommandManager->ReplayCommand(Recording->Commands[NextCommand]);
+		++NextCommand;
+	}
+}
+
+bool UCommandRecorder::IsReadyForNextCommand() const
+{
+	const ACommandManager* CommandManager = GetCommandManager();
+	if (!CommandManager || CommandManager->IsBusy() || CommandManager->HasPendingWork()
+		|| CommandManager->bIsPlayerBarking || CommandManager->bIsNPCBarking)
+	{
+		return false;
+	}
+	// Prompts are chosen while a conversation has the input locked
+	return NextCommand >= Recording->Commands.Num()
+		|| Recording->Commands[NextCommand].Type == ERecordedCommandType::ChoosePrompt
+		|| !CommandManager->IsInputLocked();
+}
+
+void UCommandRecorder::EndReplay()
+{
+	const double Seconds = FPlatformTime::Seconds() - ReplayStartTime;
+	if (FSimulationClock::IsFastForward())
+	{
+		FSimulationClock::ReportThroughput(TEXT("UCommandRecorder::EndReplay"));
+	}
+	else
+	{
+		FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+		FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+	}
+	UE_LOG(LogAdventureGame, Display, TEXT("UCommandRecorder::EndReplay - %d of %d commands, %d frames in %.3f s, average %.3f ms, longest %.3f ms, %d hitches"),
+		NextCommand, Recording->Commands.Num(), Frame, Seconds, Frame > 0 ? Seconds * 1000.0 / Frame : 0.0,
+		LongestFrameSeconds * 1000.0, HitchCount);
+	State = ERecorderState::Idle;
+	Recording = nullptr;
+
+	if (bExitAfterReplay)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("UCommandRecorder::EndReplay"));
+	}
+}
+
+UAdventureGameInstance* UCommandRecorder::GetAdventureGameInstance() const
+{
+	return Cast<UAdventureGameInstance>(GetWorld()->GetGameInstance());
+}
+
+ACommandManager* UCommandRecorder::GetCommandManager() const
+{
+	const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+	return Registry ? Registry->GetCommandManager() : nullptr;
+}
@@ -0,0 +1,143 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "AdventureGame/Player/CommandRecording.h"
+
+#include "CommandRecorder.generated.h"
+
+class ACommandManager;
+class UAdventureGameInstance;
+
+/**
+ * Records the commands the player issues through the command manager, and
+ * plays them back into the same entry points, so that a session can be run
+ * again exactly, eg to compare timings in CI or to reproduce a hitch.
+ *
+ * A replay starts from the save game and player position captured when the
+ * recording started, with the same random seed, and runs at a fixed time step
+ * of the recorded frame lengths. Commands are stamped with frames of play,
+ * which do not count room transitions, so a room that loads faster or slower
+ * than it did when recorded does not put the replay out of step.
+ *
+ * Start from the console with RecordCommands, StopRecordingCommands and
+ * ReplayCommands, or from the command line with -RecordCommands=Slot or
+ * -ReplayCommands=Slot. Add -ReplayExit to quit when the replay is done, for
+ * headless runs with -nullrhi.
+ *
+ * With -FastForward the game gets through its waits in far fewer frames than
+ * were recorded, so the frame stamps are not kept to. Instead each group of
+ * commands stamped with the same frame goes in as soon as the one before has
+ * played out, in the order they were recorded. See FSimulationClock.
+ */
+UCLASS()
+class ADVENTUREGAME_API UCommandRecorder : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	static UCommandRecorder* Get(const UObject* WorldContextObject);
+
+	/// Saves the game to memory to start from, and reseeds the random numbers.
+	/// The recording begins on the next frame of play.
+	bool StartRecording();
+
+	/// Write the recording to a save game slot. Returns false if there was no
+	/// recording, or it could not be written.
+	bool StopRecording(const FString& SlotName);
+
+	/// Load a recording from a save game slot, load the game it started from,
+	/// and play it back once the player is in its starting room.
+	bool StartReplay(const FString& SlotName);
+
+	void StopReplay();
+
+	bool IsRecording() const { return State == ERecorderState::Recording || State == ERecorderState::WaitingToRecord; }
+
+	bool IsReplaying() const { return State == ERecorderState::Replaying || State == ERecorderState::WaitingToReplay; }
+
+	/// Called by the command manager for each command as it comes in. Ignored
+	/// unless recording.
+	void Record(const FRecordedCommand& Command);
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/// Only ticks while recording or replaying.
+	virtual bool IsTickable() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum class ERecorderState : uint8
+	{
+		Idle,
+		WaitingToRecord,
+		Recording,
+		WaitingToReplay,
+		Replaying
+	};
+
+	/// Is the player in a room, as opposed to in a room transition.
+	bool IsInPlay() const;
+
+	void BeginRecording();
+
+	void BeginReplay();
+
+	/// Put back the commands stamped with the current frame.
+	void ReplayDueCommands();
+
+	/// Fast forward pacing, put back the next group of commands once the
+	/// command manager is idle and nobody is barking.
+	void ReplayWhenReady();
+
+	bool IsReadyForNextCommand() const;
+
+	void EndReplay();
+
+	UAdventureGameInstance* GetAdventureGameInstance() const;
+
+	ACommandManager* GetCommandManager() const;
+
+	ERecorderState State = ERecorderState::Idle;
+
+	UPROPERTY()
+	TObjectPtr<UCommandRecording> Recording;
+
+	/// Frames of play since the recording or replay began.
+	int32 Frame = 0;
+
+	/// Index of the next command to replay.
+	int32 NextCommand = 0;
+
+	/// Slot to write a recording started from the command line to, at the end of play.
+	FString AutoRecordSlotName;
+
+	bool bExitAfterReplay = false;
+
+	/// Time step settings from before the replay, put back after it.
+	bool bSavedUseFixedTimeStep = false;
+
+	double SavedFixedDeltaTime = 0.0;
+
+	/// Measured on the replay, to compare one run against another.
+	double ReplayStartTime = 0.0;
+
+	double LastFrameTime = 0.0;
+
+	double LongestFrameSeconds = 0.0;
+
+	int32 HitchCount = 0;
+
+	/// Frames the next group of commands has waited in fast forward.
+	int32 FramesWaiting = 0;
+};
@@ -17,4 +17,16 @@ struct FDataSaveRecord
 
     UPROPERTY()
     FGameplayTagContainer Tags;
+
+    /// SaveGame property values that differ from the level defaults, as exported
+    /// text keyed by property name. Empty if nothing has changed. See FActorStateBaseline.
+    UPROPERTY()
+    TMap<FString, FString> PropertyValues;
+
+    /// True if the actor has been moved from where the level placed it.
+    UPROPERTY()
+    bool bTransformChanged = false;
+
+    UPROPERTY()
+    FTransform Transform;
 };
@@ -0,0 +1,146 @@
+// (c) 2025 Sarah Smith
+
+
+#include "HotSpotSpatialIndex.h"
+
+#include "Components/PrimitiveComponent.h"
+
+static FBox2D GetPlaneBounds(const UPrimitiveComponent* Component, double& OutTop)
+{
+	const FBox Box = Component->Bounds.GetBox();
+	OutTop = Box.Max.Z;
+	return FBox2D(FVector2D(Box.Min), FVector2D(Box.Max));
+}
+
+void FHotSpotSpatialIndex::Add(UPrimitiveComponent* Component, int32 Priority)
+{
+	if (!Component || EntryIndices.Contains(Component)) return;
+
+	FEntry Entry;
+	Entry.Component = Component;
+	Entry.Priority = Priority;
+	Entry.bMovable = Component->Mobility == EComponentMobility::Movable;
+	Entry.Bounds = GetPlaneBounds(Component, Entry.Top);
+	const int32 EntryIndex = Entries.Add(MoveTemp(Entry));
+	EntryIndices.Add(Component, EntryIndex);
+
+	if (Entries[EntryIndex].bMovable)
+	{
+		MovableEntries.Add(EntryIndex);
+	}
+	else
+	{
+		AddToCells(EntryIndex);
+	}
+}
+
+void FHotSpotSpatialIndex::Remove(TObjectKey<UPrimitiveComponent> Component)
+{
+	int32 EntryIndex;
+	if (!EntryIndices.RemoveAndCopyValue(Component, EntryIndex)) return;
+
+	if (Entries[EntryIndex].bMovable)
+	{
+		MovableEntries.RemoveSwap(EntryIndex);
+	}
+	else
+	{
+		RemoveFromCells(EntryIndex);
+	}
+	Entries.RemoveAt(EntryIndex);
+}
+
+void FHotSpotSpatialIndex::Update(UPrimitiveComponent* Component)
+{
+	const int32* EntryIndex = EntryIndices.Find(Component);
+	if (!EntryIndex || Entries[*EntryIndex].bMovable) return;
+
+	RemoveFromCells(*EntryIndex);
+	FEntry& Entry = Entries[*EntryIndex];
+	Entry.Bounds = GetPlaneBounds(Component, Entry.Top);
+	AddToCells(*EntryIndex);
+}
+
+bool FHotSpotSpatialIndex::FindAt(const FVector2D& Point, TFunctionRef<bool(UPrimitiveComponent*)> Accept,
+	FHotSpotHit& OutHit) const
+{
+	FHotSpotHit Best;
+	if (const TArray<int32>* Cell = Cells.Find(GetCell(Point)))
+	{
+		for (const int32 EntryIndex : *Cell)
+		{
+			TestEntry(Entries[EntryIndex], Point, Accept, Best);
+		}
+	}
+	for (const int32 EntryIndex : MovableEntries)
+	{
+		TestEntry(Entries[EntryIndex], Point, Accept, Best);
+	}
+	if (!Best.Component) return false;
+	OutHit = Best;
+	return true;
+}
+
+bool FHotSpotSpatialIndex::IsHitTestable(const UPrimitiveComponent* Component)
+{
+	return Component->IsQueryCollisionEnabled()
+		&& Component->GetCollisionResponseToChannel(ECC_Visibility) == ECR_Block;
+}
+
+FIntPoint FHotSpotSpatialIndex::GetCell(const FVector2D& Point) const
+{
+	return FIntPoint(FMath::FloorToInt32(Point.X / CellSize), FMath::FloorToInt32(Point.Y / CellSize));
+}
+
+void FHotSpotSpatialIndex::AddToCells(int32 EntryIndex)
+{
+	const FBox2D& Bounds = Entries[EntryIndex].Bounds;
+	const FIntPoint Min = GetCell(Bounds.Min);
+	const FIntPoint Max = GetCell(Bounds.Max);
+	for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+	{
+		for (int32 X = Min.X; X <= Max.X; ++X)
+		{
+			Cells.FindOrAdd(FIntPoint(X, Y)).Add(EntryIndex);
+		}
+	}
+}
+
+void FHotSpotSpatialIndex::RemoveFromCells(int32 EntryIndex)
+{
+	const FBox2D& Bounds = Entries[EntryIndex].Bounds;
+	const FIntPoint Min = GetCell(Bounds.Min);
+	const FIntPoint Max = GetCell(Bounds.Max);
+	for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+	{
+		for (int32 X = Min.X; X <= Max.X; ++X)
+		{
+			const FIntPoint CellKey(X, Y);
+			if (TArray<int32>* Cell = Cells.Find(CellKey))
+			{
+				Cell->RemoveSwap(EntryIndex);
+				if (Cell->IsEmpty()) Cells.Remove(CellKey);
+			}
+		}
+	}
+}
+
+void FHotSpotSpatialIndex::TestEntry(const FEntry& Entry, const FVector2D& Point,
+	TFunctionRef<bool(UPrimitiveComponent*)> Accept, FHotSpotHit& Best) const
+{
+	UPrimitiveComponent* Component = Entry.Component.Get();
+	if (!Component) return;
+
+	FHotSpotHit Hit;
+	Hit.Component = Component;
+	Hit.Priority = Entry.Priority;
+	Hit.Top = Entry.Top;
+	FBox2D Bounds = Entry.Bounds;
+	if (Entry.bMovable)
+	{
+		Bounds = GetPlaneBounds(Component, Hit.Top);
+	}
+	if (!Bounds.IsInside(Point) || !Hit.IsBetterThan(Best)) return;
+	if (!IsHitTestable(Component) || !Accept(Component)) return;
+	Best = Hit;
+}
@@ -0,0 +1,93 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UPrimitiveComponent;
+
+/// A component found under a point, and what it is ranked by against any others.
+struct FHotSpotHit
+{
+	UPrimitiveComponent* Component = nullptr;
+
+	int32 Priority = 0;
+
+	/// Highest Z of its bounds. Rooms are laid out in the XY plane and seen from
+	/// above, so of two hotspots with the same priority the higher is on top.
+	double Top = 0.0;
+
+	bool IsBetterThan(const FHotSpotHit& Other) const
+	{
+		if (!Other.Component) return true;
+		return Priority != Other.Priority ? Priority > Other.Priority : Top > Other.Top;
+	}
+};
+
+/**
+ * Uniform grid over the XY bounds of the clickable components of a room's
+ * hotspots, so the hotspot under the cursor is found without a trace against
+ * the physics scene. Components that can move are kept out of the grid and
+ * have their bounds checked on each query instead.
+ *
+ * Only components that would block a visibility trace are found, so hotspots
+ * that have turned their collision off are not clickable, as before.
+ */
+class ADVENTUREGAME_API FHotSpotSpatialIndex
+{
+public:
+	explicit FHotSpotSpatialIndex(double InCellSize = 128.0) : CellSize(InCellSize) {}
+
+	void Add(UPrimitiveComponent* Component, int32 Priority = 0);
+
+	/// Remove a component, which may already have been destroyed.
+	void Remove(TObjectKey<UPrimitiveComponent> Component);
+
+	/// Take up a change to the bounds of a component that is not movable.
+	void Update(UPrimitiveComponent* Component);
+
+	/// Find the best component whose bounds contain the point, and that Accept
+	/// returns true for. Accept is only called for components that would beat
+	/// the best found so far, so it can do a more exact test such as a hit mask.
+	/// Returns false if there is none.
+	bool FindAt(const FVector2D& Point, TFunctionRef<bool(UPrimitiveComponent*)> Accept, FHotSpotHit& OutHit) const;
+
+	int32 Num() const { return Entries.Num(); }
+
+	bool IsEmpty() const { return Entries.IsEmpty(); }
+
+	/// Would a visibility trace have stopped at the component.
+	static bool IsHitTestable(const UPrimitiveComponent* Component);
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+		FBox2D Bounds;
+		double Top = 0.0;
+		int32 Priority = 0;
+		bool bMovable = false;
+	};
+
+	FIntPoint GetCell(const FVector2D& Point) const;
+
+	void AddToCells(int32 EntryIndex);
+
+	void RemoveFromCells(int32 EntryIndex);
+
+	void TestEntry(const FEntry& Entry, const FVector2D& Point, TFunctionRef<bool(UPrimitiveComponent*)> Accept,
+		FHotSpotHit& Best) const;
+
+	double CellSize;
+
+	TSparseArray<FEntry> Entries;
+
+	/// Keyed so a destroyed component is not mistaken for a new one at its address.
+	TMap<TObjectKey<UPrimitiveComponent>, int32> EntryIndices;
+
+	/// Indices of the entries whose bounds overlap each cell.
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	TArray<int32> MovableEntries;
+};
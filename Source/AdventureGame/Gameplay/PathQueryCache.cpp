@@ -0,0 +1,208 @@
+// (c) 2025 Sarah Smith
+
+
+#include "PathQueryCache.h"
+
+#include "Algo/Reverse.h"
+#include "Misc/ScopeExit.h"
+
+FString FPathQueryStats::ToString() const
+{
+	return FString::Printf(TEXT("%d queries, %.1f%% hit (%d graph, %d cache), %d misses, %d failed, %d evicted, %d invalidated, average %.3f ms, graphs built in %.3f ms"),
+		Queries, GetHitRate() * 100.0f, GraphHits, CacheHits, Misses, Failures, Evictions, Invalidations,
+		GetAverageQueryMs(), GraphBuildSeconds * 1000.0);
+}
+
+void FPathQueryCache::BuildGraph(FName LevelName, const TArray<FVector>& Nodes, FSolver Solver)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	FWalkGraph& Graph = Graphs.Add(LevelName);
+
+	// Two hotspots can share a walk-to position, eg a door and the sign on it
+	TArray<FVector> UniqueNodes;
+	for (const FVector& Node : Nodes)
+	{
+		bool bAlreadyInSet = false;
+		Graph.Nodes.Add(GetCell(Node), &bAlreadyInSet);
+		if (!bAlreadyInSet) UniqueNodes.Add(Node);
+	}
+
+	TArray<FVector> Points;
+	for (int32 i = 0; i < UniqueNodes.Num(); ++i)
+	{
+		for (int32 j = i + 1; j < UniqueNodes.Num(); ++j)
+		{
+			Points.Reset();
+			if (!Solver(UniqueNodes[i], UniqueNodes[j], Points) || Points.IsEmpty()) continue;
+			TArray<FVector> Reversed(Points);
+			Algo::Reverse(Reversed);
+			Graph.Paths.Add(MakeKey(LevelName, UniqueNodes[i], UniqueNodes[j]), MakeCachedPath(MoveTemp(Points)));
+			Graph.Paths.Add(MakeKey(LevelName, UniqueNodes[j], UniqueNodes[i]), MakeCachedPath(MoveTemp(Reversed)));
+		}
+	}
+	Stats.GraphBuildSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+bool FPathQueryCache::FindPath(FName LevelName, const FVector& Start, const FVector& End, FSolver Solver,
+	TArray<FVector>& OutPoints)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT { Stats.QuerySeconds += FPlatformTime::Seconds() - StartTime; };
+	++Stats.Queries;
+
+	const FKey Key = MakeKey(LevelName, Start, End);
+	FWalkGraph* Graph = Graphs.Find(LevelName);
+	const bool bGraphQuery = Graph && Graph->Nodes.Contains(Key.Start) && Graph->Nodes.Contains(Key.End);
+	if (bGraphQuery)
+	{
+		if (const FCachedPath* Path = Graph->Paths.Find(Key))
+		{
+			++Stats.GraphHits;
+			CopyPath(*Path, Start, End, OutPoints);
+			return true;
+		}
+	}
+	else if (FCachedPath* Path = Paths.Find(Key))
+	{
+		++Stats.CacheHits;
+		Path->LastUsed = ++UseCounter;
+		CopyPath(*Path, Start, End, OutPoints);
+		return true;
+	}
+
+	++Stats.Misses;
+	TArray<FVector> Points;
+	if (!Solver(Start, End, Points) || Points.IsEmpty())
+	{
+		++Stats.Failures;
+		return false;
+	}
+	OutPoints = Points;
+	if (bGraphQuery)
+	{
+		// Found again after an invalidation
+		Graph->Paths.Add(Key, MakeCachedPath(MoveTemp(Points)));
+	}
+	else
+	{
+		AddToCache(Key, MoveTemp(Points));
+	}
+	return true;
+}
+
+void FPathQueryCache::Invalidate(const FBox& Bounds)
+{
+	const FBox2D Dirty(FVector2D(Bounds.Min), FVector2D(Bounds.Max));
+	auto RemoveDirty = [this, &Dirty](TMap<FKey, FCachedPath>& InPaths)
+	{
+		for (auto It = InPaths.CreateIterator(); It; ++It)
+		{
+			if (It.Value().Bounds.Intersect(Dirty))
+			{
+				It.RemoveCurrent();
+				++Stats.Invalidations;
+			}
+		}
+	};
+	RemoveDirty(Paths);
+	for (TPair<FName, FWalkGraph>& Graph : Graphs)
+	{
+		RemoveDirty(Graph.Value.Paths);
+	}
+}
+
+void FPathQueryCache::ReleaseGraph(FName LevelName)
+{
+	if (const FWalkGraph* Graph = Graphs.Find(LevelName))
+	{
+		Stats.Invalidations += Graph->Paths.Num();
+		Graphs.Remove(LevelName);
+	}
+	for (auto It = Paths.CreateIterator(); It; ++It)
+	{
+		if (It.Key().LevelName == LevelName)
+		{
+			It.RemoveCurrent();
+			++Stats.Invalidations;
+		}
+	}
+}
+
+void FPathQueryCache::Reset()
+{
+	Stats.Invalidations += Paths.Num();
+	for (const TPair<FName, FWalkGraph>& Graph : Graphs)
+	{
+		Stats.Invalidations += Graph.Value.Paths.Num();
+	}
+	Paths.Reset();
+	Graphs.Reset();
+}
+
+int32 FPathQueryCache::GetGraphPathCount(FName LevelName) const
+{
+	const FWalkGraph* Graph = Graphs.Find(LevelName);
+	return Graph ? Graph->Paths.Num() : 0;
+}
+
+FIntPoint FPathQueryCache::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+FPathQueryCache::FKey FPathQueryCache::MakeKey(FName LevelName, const FVector& Start, const FVector& End) const
+{
+	return FKey{ LevelName, GetCell(Start), GetCell(End) };
+}
+
+FPathQueryCache::FCachedPath FPathQueryCache::MakeCachedPath(TArray<FVector>&& Points) const
+{
+	FCachedPath Path;
+	Path.Bounds = FBox2D(ForceInit);
+	for (const FVector& Point : Points)
+	{
+		Path.Bounds += FVector2D(Point);
+	}
+	// Near enough to the path that the character's capsule would touch it
+	Path.Bounds = Path.Bounds.ExpandBy(CellSize);
+	Path.Points = MoveTemp(Points);
+	return Path;
+}
+
+void FPathQueryCache::AddToCache(const FKey& Key, TArray<FVector>&& Points)
+{
+	if (MaxEntries <= 0) return;
+	if (Paths.Num() >= MaxEntries)
+	{
+		// Only on a miss, which has just cost a path find, so a scan is cheap by comparison
+		const FKey* Oldest = nullptr;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<FKey, FCachedPath>& Entry : Paths)
+		{
+			if (Entry.Value.LastUsed < OldestUse)
+			{
+				OldestUse = Entry.Value.LastUsed;
+				Oldest = &Entry.Key;
+			}
+		}
+		if (Oldest)
+		{
+			Paths.Remove(FKey(*Oldest));
+			++Stats.Evictions;
+		}
+	}
+	FCachedPath& Path = Paths.Add(Key, MakeCachedPath(MoveTemp(Points)));
+	Path.LastUsed = ++UseCounter;
+}
+
+void FPathQueryCache::CopyPath(const FCachedPath& Path, const FVector& Start, const FVector& End,
+	TArray<FVector>& OutPoints) const
+{
+	OutPoints = Path.Points;
+	OutPoints[0] = Start;
+	// A partial path stops short of the end, and should still stop there
+	if (OutPoints.Num() > 1 && FVector::DistSquaredXY(OutPoints.Last(), End) <= FMath::Square(CellSize * 2.0))
+	{
+		OutPoints.Last() = End;
+	}
+}
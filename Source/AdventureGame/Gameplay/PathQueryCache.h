@@ -0,0 +1,151 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// Counters for the path query cache, from the start of play or the last reset.
+struct FPathQueryStats
+{
+	int32 Queries = 0;
+
+	/// Found in a room's walk graph, between two walk-to positions.
+	int32 GraphHits = 0;
+
+	/// Found in the cache of other recent queries.
+	int32 CacheHits = 0;
+
+	/// Passed on to the solver.
+	int32 Misses = 0;
+
+	/// Misses the solver found no path for. These are not cached.
+	int32 Failures = 0;
+
+	/// Least recently used paths dropped to make room.
+	int32 Evictions = 0;
+
+	/// Paths dropped because the navigation under them changed.
+	int32 Invalidations = 0;
+
+	/// Time spent in queries, including the solver on a miss.
+	double QuerySeconds = 0.0;
+
+	/// Time spent building walk graphs when rooms start.
+	double GraphBuildSeconds = 0.0;
+
+	float GetHitRate() const { return Queries > 0 ? static_cast<float>(GraphHits + CacheHits) / Queries : 0.0f; }
+
+	double GetAverageQueryMs() const { return Queries > 0 ? QuerySeconds * 1000.0 / Queries : 0.0; }
+
+	FString ToString() const;
+};
+
+/**
+ * Paths for walks in the rooms, so a walk between the same two spots is only
+ * found once. Rooms are flat and their walkable areas do not change unless
+ * something on the navigation mesh does, so a path stays good until then.
+ *
+ * Each room has a walk graph of paths between every pair of its hotspots'
+ * walk-to positions, doors included, found when the room starts. Any other
+ * query, eg a click on the floor, goes in a least recently used cache. Both
+ * are keyed on the room and the start and end positions rounded to a grid of
+ * CellSize, and a path from either has its ends moved to the exact positions
+ * asked for.
+ *
+ * The solver does the actual path finding, so the cache can be tested, and
+ * benchmarked, without a navigation mesh.
+ */
+class ADVENTUREGAME_API FPathQueryCache
+{
+public:
+	/// Find a path from Start to End, returning false if there is none.
+	using FSolver = TFunctionRef<bool(const FVector& Start, const FVector& End, TArray<FVector>& OutPoints)>;
+
+	explicit FPathQueryCache(int32 InMaxEntries = 128, double InCellSize = 16.0)
+		: MaxEntries(InMaxEntries), CellSize(InCellSize) {}
+
+	/// Find the paths between every pair of nodes up front, replacing any graph
+	/// the room had. Paths are taken to be the same both ways.
+	void BuildGraph(FName LevelName, const TArray<FVector>& Nodes, FSolver Solver);
+
+	/// The path from the graph or the cache, or else from the solver, which is
+	/// then kept. Returns false if there is no path.
+	bool FindPath(FName LevelName, const FVector& Start, const FVector& End, FSolver Solver, TArray<FVector>& OutPoints);
+
+	/// Drop the paths that go through the bounds in the XY plane. The walk
+	/// graph keeps its nodes, and finds those paths again when next asked.
+	void Invalidate(const FBox& Bounds);
+
+	/// Drop a room's walk graph and the cached paths in it, when it is unloaded.
+	void ReleaseGraph(FName LevelName);
+
+	/// Drop every path and walk graph.
+	void Reset();
+
+	int32 Num() const { return Paths.Num(); }
+
+	int32 GetGraphPathCount(FName LevelName) const;
+
+	const FPathQueryStats& GetStats() const { return Stats; }
+
+	void ResetStats() { Stats = FPathQueryStats(); }
+
+private:
+	struct FKey
+	{
+		FName LevelName;
+		FIntPoint Start;
+		FIntPoint End;
+
+		bool operator==(const FKey& Other) const
+		{
+			return LevelName == Other.LevelName && Start == Other.Start && End == Other.End;
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.LevelName), HashCombine(GetTypeHash(Key.Start), GetTypeHash(Key.End)));
+		}
+	};
+
+	struct FCachedPath
+	{
+		TArray<FVector> Points;
+
+		/// XY bounds of the points, for invalidation.
+		FBox2D Bounds;
+
+		/// Use counter value when last found, for eviction.
+		uint64 LastUsed = 0;
+	};
+
+	struct FWalkGraph
+	{
+		TSet<FIntPoint> Nodes;
+
+		TMap<FKey, FCachedPath> Paths;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	FKey MakeKey(FName LevelName, const FVector& Start, const FVector& End) const;
+
+	FCachedPath MakeCachedPath(TArray<FVector>&& Points) const;
+
+	/// Add to the least recently used cache, evicting the oldest if it is full.
+	void AddToCache(const FKey& Key, TArray<FVector>&& Points);
+
+	void CopyPath(const FCachedPath& Path, const FVector& Start, const FVector& End, TArray<FVector>& OutPoints) const;
+
+	int32 MaxEntries;
+
+	double CellSize;
+
+	TMap<FName, FWalkGraph> Graphs;
+
+	TMap<FKey, FCachedPath> Paths;
+
+	uint64 UseCounter = 0;
+
+	FPathQueryStats Stats;
+};
@@ -0,0 +1,132 @@
+// (c) 2025 Sarah Smith
+
+
+#include "ProximityGrid.h"
+
+int32 FProximityGrid::AddCircle(AActor* Owner, const FVector2D& Center, double Radius)
+{
+	FProximityTrigger Trigger;
+	Trigger.Owner = Owner;
+	Trigger.Center = Center;
+	Trigger.Radius = FMath::Max(Radius, UE_KINDA_SMALL_NUMBER);
+	return Add(MoveTemp(Trigger));
+}
+
+int32 FProximityGrid::AddRegion(AActor* Owner, const FBox2D& Region)
+{
+	FProximityTrigger Trigger;
+	Trigger.Owner = Owner;
+	Trigger.Region = Region;
+	return Add(MoveTemp(Trigger));
+}
+
+int32 FProximityGrid::Add(FProximityTrigger&& Trigger)
+{
+	const FBox2D Bounds = Trigger.GetBounds();
+	const int32 Handle = Triggers.Add(MoveTemp(Trigger));
+	if (Bounds.bIsValid)
+	{
+		const FIntPoint Min = GetCell(Bounds.Min);
+		const FIntPoint Max = GetCell(Bounds.Max);
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 X = Min.X; X <= Max.X; ++X)
+			{
+				Cells.FindOrAdd(FIntPoint(X, Y)).Add(Handle);
+			}
+		}
+	}
+	bCandidatesValid = false;
+	return Handle;
+}
+
+void FProximityGrid::Remove(int32 Handle)
+{
+	if (!Triggers.IsValidIndex(Handle)) return;
+
+	const FBox2D Bounds = Triggers[Handle].GetBounds();
+	if (Bounds.bIsValid)
+	{
+		const FIntPoint Min = GetCell(Bounds.Min);
+		const FIntPoint Max = GetCell(Bounds.Max);
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 X = Min.X; X <= Max.X; ++X)
+			{
+				const FIntPoint Cell(X, Y);
+				if (TArray<int32>* CellTriggers = Cells.Find(Cell))
+				{
+					CellTriggers->RemoveSwap(Handle);
+					if (CellTriggers->IsEmpty()) Cells.Remove(Cell);
+				}
+			}
+		}
+	}
+	Triggers.RemoveAt(Handle);
+	Inside.RemoveSwap(Handle);
+	bCandidatesValid = false;
+}
+
+void FProximityGrid::RemoveAll(const AActor* Owner)
+{
+	TArray<int32, TInlineAllocator<4>> Handles;
+	for (auto It = Triggers.CreateConstIterator(); It; ++It)
+	{
+		if (It->Owner.Get() == Owner) Handles.Add(It.GetIndex());
+	}
+	for (const int32 Handle : Handles)
+	{
+		Remove(Handle);
+	}
+}
+
+void FProximityGrid::Update(const FVector2D& InPosition, TArray<int32>& OutEntered, TArray<int32>& OutExited)
+{
+	if (bHasPosition && bCandidatesValid && InPosition.Equals(Position)) return;
+	bHasPosition = true;
+	Position = InPosition;
+	++Updates;
+
+	const FIntPoint Cell = GetCell(Position);
+	if (!bCandidatesValid || Cell != CurrentCell)
+	{
+		++CellChanges;
+		CurrentCell = Cell;
+		const TArray<int32>* CellTriggers = Cells.Find(Cell);
+		Candidates = CellTriggers ? *CellTriggers : TArray<int32>();
+		bCandidatesValid = true;
+	}
+
+	// A trigger the point is in that is not in this cell does not reach it, so
+	// the point has left it without needing a test
+	for (int32 Index = Inside.Num() - 1; Index >= 0; --Index)
+	{
+		const int32 Handle = Inside[Index];
+		if (Candidates.Contains(Handle) && Triggers[Handle].Contains(Position)) continue;
+		Inside.RemoveAtSwap(Index);
+		OutExited.Add(Handle);
+	}
+	for (const int32 Handle : Candidates)
+	{
+		++Tests;
+		if (!Inside.Contains(Handle) && Triggers[Handle].Contains(Position))
+		{
+			Inside.Add(Handle);
+			OutEntered.Add(Handle);
+		}
+	}
+}
+
+void FProximityGrid::Reset(TArray<int32>& OutExited)
+{
+	OutExited.Append(Inside);
+	Inside.Reset();
+	Candidates.Reset();
+	bCandidatesValid = false;
+	bHasPosition = false;
+}
+
+FIntPoint FProximityGrid::GetCell(const FVector2D& Point) const
+{
+	return FIntPoint(FMath::FloorToInt32(Point.X / CellSize), FMath::FloorToInt32(Point.Y / CellSize));
+}
@@ -0,0 +1,111 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// A trigger in a room's XY plane, a circle around a point or a region.
+struct FProximityTrigger
+{
+	TWeakObjectPtr<AActor> Owner;
+
+	FVector2D Center = FVector2D::ZeroVector;
+
+	/// Greater than zero for a circle, otherwise the region is used.
+	double Radius = 0.0;
+
+	FBox2D Region = FBox2D(ForceInit);
+
+	bool Contains(const FVector2D& Point) const
+	{
+		return Radius > 0.0 ? FVector2D::DistSquared(Point, Center) <= Radius * Radius : Region.IsInside(Point);
+	}
+
+	FBox2D GetBounds() const
+	{
+		return Radius > 0.0 ? FBox2D(Center - FVector2D(Radius), Center + FVector2D(Radius)) : Region;
+	}
+};
+
+/**
+ * Uniform grid over the proximity triggers of a room, tracking one point, the
+ * player, against them without physics overlaps. The triggers whose bounds
+ * overlap the cell the point is in are only fetched when the point moves into
+ * another cell, and only those are tested when it moves within a cell. Enter and
+ * exit are reported when the point crosses a trigger's edge, not every frame.
+ */
+class ADVENTUREGAME_API FProximityGrid
+{
+public:
+	explicit FProximityGrid(double InCellSize = 128.0) : CellSize(InCellSize) {}
+
+	/// Add a circle trigger. Returns its handle.
+	int32 AddCircle(AActor* Owner, const FVector2D& Center, double Radius);
+
+	/// Add a region trigger. Returns its handle.
+	int32 AddRegion(AActor* Owner, const FBox2D& Region);
+
+	/// Remove a trigger, without reporting an exit from it.
+	void Remove(int32 Handle);
+
+	/// Remove the triggers of an actor, without reporting exits from them.
+	void RemoveAll(const AActor* Owner);
+
+	/// Move the tracked point. The handles of triggers it has entered and left
+	/// since the last update are added to the arrays.
+	void Update(const FVector2D& Position, TArray<int32>& OutEntered, TArray<int32>& OutExited);
+
+	/// Forget the tracked point, leaving every trigger it is in.
+	void Reset(TArray<int32>& OutExited);
+
+	const FProximityTrigger* Find(int32 Handle) const
+	{
+		return Triggers.IsValidIndex(Handle) ? &Triggers[Handle] : nullptr;
+	}
+
+	/// Is the tracked point in the trigger.
+	bool IsInside(int32 Handle) const { return Inside.Contains(Handle); }
+
+	int32 Num() const { return Triggers.Num(); }
+
+	/// Updates where the point moved, and of those, how many changed cell.
+	int64 GetUpdateCount() const { return Updates; }
+
+	int64 GetCellChangeCount() const { return CellChanges; }
+
+	/// Triggers tested against the point, over all updates.
+	int64 GetTestCount() const { return Tests; }
+
+private:
+	int32 Add(FProximityTrigger&& Trigger);
+
+	FIntPoint GetCell(const FVector2D& Point) const;
+
+	double CellSize;
+
+	TSparseArray<FProximityTrigger> Triggers;
+
+	/// Handles of the triggers whose bounds overlap each cell.
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	bool bHasPosition = false;
+
+	FVector2D Position = FVector2D::ZeroVector;
+
+	FIntPoint CurrentCell = FIntPoint::ZeroValue;
+
+	/// Triggers in the current cell, fetched when the point changes cell. Cleared
+	/// when triggers are added or removed, to be fetched again.
+	TArray<int32> Candidates;
+
+	bool bCandidatesValid = false;
+
+	/// Triggers the point is in.
+	TArray<int32> Inside;
+
+	int64 Updates = 0;
+
+	int64 CellChanges = 0;
+
+	int64 Tests = 0;
+};
@@ -0,0 +1,129 @@
+// (c) 2025 Sarah Smith
+
+
+#include "RoomGraph.h"
+
+void URoomGraph::PostLoad()
+{
+	Super::PostLoad();
+	RebuildRoomIndex();
+}
+
+const FRoomGraphRoom* URoomGraph::FindRoom(FName LevelName) const
+{
+	const int32* Index = RoomIndex.Find(LevelName);
+	return Index ? &Rooms[*Index] : nullptr;
+}
+
+const FRoomGraphDoor* URoomGraph::FindDoor(FName LevelName, FName DoorLabel) const
+{
+	if (const FRoomGraphRoom* Room = FindRoom(LevelName))
+	{
+		for (const int32 DoorIndex : Room->Doors)
+		{
+			if (Doors[DoorIndex].DoorLabel == DoorLabel) return &Doors[DoorIndex];
+		}
+	}
+	return nullptr;
+}
+
+void URoomGraph::Build(FName InStartingLevelName, TArray<FString>& OutErrors, TArray<FString>& OutWarnings)
+{
+	StartingLevelName = InStartingLevelName;
+	Rooms.Reset();
+	RoomIndex.Reset();
+
+	auto FindOrAddRoom = [this](FName LevelName) -> FRoomGraphRoom&
+	{
+		if (const int32* Index = RoomIndex.Find(LevelName)) return Rooms[*Index];
+		RoomIndex.Add(LevelName, Rooms.Num());
+		FRoomGraphRoom& Room = Rooms.AddDefaulted_GetRef();
+		Room.LevelName = LevelName;
+		return Room;
+	};
+
+	for (int32 DoorIndex = 0; DoorIndex < Doors.Num(); ++DoorIndex)
+	{
+		const FRoomGraphDoor& Door = Doors[DoorIndex];
+		FRoomGraphRoom& Room = FindOrAddRoom(Door.LevelName);
+		for (const int32 Other : Room.Doors)
+		{
+			if (Doors[Other].DoorLabel == Door.DoorLabel)
+			{
+				OutErrors.Add(FString::Printf(TEXT("%s: doors %s and %s both have label %s"), *Door.LevelName.ToString(),
+					*Doors[Other].ActorName.ToString(), *Door.ActorName.ToString(), *Door.DoorLabel.ToString()));
+			}
+		}
+		Room.Doors.Add(DoorIndex);
+		if (!Door.LevelToLoad.IsNone())
+		{
+			Room.Neighbours.AddUnique(Door.LevelToLoad);
+		}
+	}
+
+	for (const FRoomGraphDoor& Door : Doors)
+	{
+		if (Door.DoorLabel.IsNone())
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s: door %s has no label"), *Door.LevelName.ToString(), *Door.ActorName.ToString()));
+		}
+		else if (Door.LevelToLoad.IsNone())
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s: door %s has no level to load"), *Door.LevelName.ToString(), *Door.ActorName.ToString()));
+		}
+		else if (!FindRoom(Door.LevelToLoad))
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s: door %s leads to %s, which has no doors or does not exist"),
+				*Door.LevelName.ToString(), *Door.ActorName.ToString(), *Door.LevelToLoad.ToString()));
+		}
+		else if (!FindDestination(Door))
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s: door %s leads to %s, which has no door labelled %s"),
+				*Door.LevelName.ToString(), *Door.ActorName.ToString(), *Door.LevelToLoad.ToString(), *Door.DoorLabel.ToString()));
+		}
+	}
+
+	// Breadth first from the starting room
+	TArray<FName> Frontier;
+	if (FRoomGraphRoom* Start = RoomIndex.Contains(StartingLevelName) ? &Rooms[RoomIndex[StartingLevelName]] : nullptr)
+	{
+		Start->bReachable = true;
+		Frontier.Add(StartingLevelName);
+	}
+	else
+	{
+		OutErrors.Add(FString::Printf(TEXT("Starting room %s has no doors or does not exist"), *StartingLevelName.ToString()));
+	}
+	while (!Frontier.IsEmpty())
+	{
+		const FName LevelName = Frontier.Pop(EAllowShrinking::No);
+		for (const FName& Neighbour : Rooms[RoomIndex[LevelName]].Neighbours)
+		{
+			if (const int32* Index = RoomIndex.Find(Neighbour))
+			{
+				if (!Rooms[*Index].bReachable)
+				{
+					Rooms[*Index].bReachable = true;
+					Frontier.Add(Neighbour);
+				}
+			}
+		}
+	}
+	for (const FRoomGraphRoom& Room : Rooms)
+	{
+		if (!Room.bReachable)
+		{
+			OutWarnings.Add(FString::Printf(TEXT("%s cannot be reached from %s"),
+				*Room.LevelName.ToString(), *StartingLevelName.ToString()));
+		}
+	}
+}
+
+void URoomGraph::RebuildRoomIndex()
+{
+	RoomIndex.Reset();
+	for (int32 Index = 0; Index < Rooms.Num(); ++Index)
+	{
+		RoomIndex.Add(Rooms[Index].LevelName, Index);
+	}
+}
@@ -0,0 +1,113 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "AdventureGame/Enums/WalkDirection.h"
+
+#include "RoomGraph.generated.h"
+
+/// A door as placed in a room's level.
+USTRUCT(BlueprintType)
+struct FRoomGraphDoor
+{
+	GENERATED_BODY()
+
+	/// Label of the door. The player arrives at the door with the same label in LevelToLoad.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	FName DoorLabel;
+
+	/// Level the door is placed in.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	FName LevelName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	FName LevelToLoad;
+
+	/// Name of the door actor in its level, for reports.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	FName ActorName;
+
+	/// Where the player is placed when arriving through this door, ie its walk to point.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	FTransform EntryTransform;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	EWalkDirection FacingDirection = EWalkDirection::Down;
+};
+
+/// A room, ie a streamed level, and the doors in it.
+USTRUCT(BlueprintType)
+struct FRoomGraphRoom
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	FName LevelName;
+
+	/// Indices into URoomGraph::Doors of the doors in this room.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	TArray<int32> Doors;
+
+	/// Rooms the doors in this room lead to.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	TArray<FName> Neighbours;
+
+	/// Can be reached through doors from the starting room.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	bool bReachable = false;
+
+	/// Manifest of every asset the room's actors depend on, hard or soft, including
+	/// those referenced by rows of the data tables they use. Loaded as one batch
+	/// with the room by URoomStreamingManager::LoadRoomAssets.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	TArray<FSoftObjectPath> Assets;
+};
+
+/**
+ * The door network of the whole game, extracted from the levels by the
+ * RoomGraph commandlet, so that doors can be resolved and preloads planned
+ * without loading a level to ask it what is in it. Each room also has a
+ * manifest of the assets it uses, so they can be streamed in with it.
+ *
+ * Rebuild it after changing any door with:
+ * <code>UnrealEditor-Cmd AdventureGame.uproject -run=RoomGraph</code>
+ */
+UCLASS(BlueprintType)
+class ADVENTUREGAME_API URoomGraph : public UDataAsset
+{
+	GENERATED_BODY()
+public:
+	/// Room the reachability was worked out from.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	FName StartingLevelName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	TArray<FRoomGraphDoor> Doors;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Room Graph")
+	TArray<FRoomGraphRoom> Rooms;
+
+	virtual void PostLoad() override;
+
+	const FRoomGraphRoom* FindRoom(FName LevelName) const;
+
+	/// The door with the given label in the given level, or null if there is none.
+	const FRoomGraphDoor* FindDoor(FName LevelName, FName DoorLabel) const;
+
+	/// The door the player arrives at after going through the given door.
+	const FRoomGraphDoor* FindDestination(const FRoomGraphDoor& Door) const { return FindDoor(Door.LevelToLoad, Door.DoorLabel); }
+
+	/// Work out the rooms, their neighbours and reachability from Doors, and check
+	/// the network. Problems that would stop a door working, such as a door with no
+	/// matching door in its destination, or two doors with the same label in one
+	/// room, are added to OutErrors. Rooms that cannot be reached are added to
+	/// OutWarnings.
+	void Build(FName InStartingLevelName, TArray<FString>& OutErrors, TArray<FString>& OutWarnings);
+
+private:
+	void RebuildRoomIndex();
+
+	TMap<FName, int32> RoomIndex;
+};
@@ -0,0 +1,39 @@
+// (c) 2025 Sarah Smith
+
+
+#include "RoomReadiness.h"
+
+static FString SignalToString(const TCHAR* Name, double Signal)
+{
+	return Signal < 0.0
+		? FString::Printf(TEXT("%s not ready"), Name)
+		: FString::Printf(TEXT("%s %.3f s"), Name, Signal);
+}
+
+void FRoomReadiness::Reset(double Now)
+{
+	*this = FRoomReadiness();
+	StartTime = Now;
+}
+
+void FRoomReadiness::Mark(ERoomReadySignal Signal, bool bReady, double Now)
+{
+	double* Time = nullptr;
+	switch (Signal)
+	{
+	case ERoomReadySignal::LevelVisible: Time = &LevelVisible; break;
+	case ERoomReadySignal::HotSpotsLoaded: Time = &HotSpotsLoaded; break;
+	case ERoomReadySignal::NavigationReady: Time = &NavigationReady; break;
+	case ERoomReadySignal::CharacterGrounded: Time = &CharacterGrounded; break;
+	}
+	if (Time && bReady && *Time < 0.0) *Time = Now - StartTime;
+}
+
+FString FRoomReadiness::ToString() const
+{
+	return FString::Join(TArray<FString>{
+		SignalToString(TEXT("visible"), LevelVisible),
+		SignalToString(TEXT("hotspots"), HotSpotsLoaded),
+		SignalToString(TEXT("navigation"), NavigationReady),
+		SignalToString(TEXT("grounded"), CharacterGrounded) }, TEXT(", "));
+}
@@ -0,0 +1,51 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// A signal that a newly loaded room is ready, see FRoomReadiness.
+enum class ERoomReadySignal : uint8
+{
+	LevelVisible,
+	HotSpotsLoaded,
+	NavigationReady,
+	CharacterGrounded
+};
+
+/**
+ * The signals that a newly loaded room is ready to play, and when each was first
+ * seen, in seconds after the room finished loading. A value below zero means that
+ * signal has not been seen yet.
+ *
+ * The room can be set up (player moved to the door) once the level is visible
+ * and its hotspots have begun play and restored their saved state. Play can
+ * start once navigation data is registered and the player character has landed.
+ */
+struct FRoomReadiness
+{
+	double StartTime = 0.0;
+
+	double LevelVisible = -1.0;
+
+	double HotSpotsLoaded = -1.0;
+
+	double NavigationReady = -1.0;
+
+	double CharacterGrounded = -1.0;
+
+	/// The room has been set up and the character placed at the door.
+	bool bRoomSetUp = false;
+
+	void Reset(double Now);
+
+	/// Record the time of a signal the first time it is ready.
+	void Mark(ERoomReadySignal Signal, bool bReady, double Now);
+
+	bool CanSetupRoom() const { return LevelVisible >= 0.0 && HotSpotsLoaded >= 0.0; }
+
+	bool CanStartPlay() const { return bRoomSetUp && NavigationReady >= 0.0 && CharacterGrounded >= 0.0; }
+
+	/// Per signal times for the log, eg "visible 0.021 s, hotspots 0.021 s, ..."
+	FString ToString() const;
+};
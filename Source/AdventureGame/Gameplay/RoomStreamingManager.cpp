@@ -0,0 +1,444 @@
+// (c) 2025 Sarah Smith
+
+
+#include "RoomStreamingManager.h"
+
+#include "AdventureWorldRegistry.h"
+#include "RoomGraph.h"
+#include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/HotSpots/Door.h"
+#include "AdventureGame/HUD/AdvGameUtils.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/LevelStreaming.h"
+#include "Kismet/GameplayStatics.h"
+#include "UObject/UObjectHash.h"
+
+void URoomStreamingManager::SetRoomGraph(const URoomGraph* Graph)
+{
+	RoomGraphAsset = Graph;
+	if (!Graph) return;
+	for (const FRoomGraphRoom& Room : Graph->Rooms)
+	{
+		RoomGraph.FindOrAdd(Room.LevelName).Append(Room.Neighbours);
+	}
+}
+
+bool URoomStreamingManager::LoadRoomAssets(FName LevelName, TAsyncLoadPriority Priority, FStreamableDelegate Loaded)
+{
+	const FRoomGraphRoom* Room = RoomGraphAsset ? RoomGraphAsset->FindRoom(LevelName) : nullptr;
+	if (!Room)
+	{
+		UE_LOG(LogAdventureGame, Error, TEXT("URoomStreamingManager::LoadRoomAssets - %s has no manifest, rebuild the room graph with -run=RoomGraph"),
+			*LevelName.ToString());
+		return false;
+	}
+	if (Room->Assets.IsEmpty()) return false;
+	if (const TSharedPtr<FStreamableHandle>* Existing = RoomAssets.Find(LevelName))
+	{
+		// A preload that is still in flight: wait for it rather than load a second
+		// batch, moving it up to this load's priority
+		if (!Existing->IsValid() || !(*Existing)->IsLoadingInProgress()) return false;
+		UE_LOG(LogAdventureGame, Verbose, TEXT("URoomStreamingManager::LoadRoomAssets - %s, waiting for preload"),
+			*LevelName.ToString());
+		(*Existing)->SetPriority(Priority);
+		return (*Existing)->BindCompleteDelegate(MoveTemp(Loaded));
+	}
+
+	UE_LOG(LogAdventureGame, Verbose, TEXT("URoomStreamingManager::LoadRoomAssets - %s, %d assets"),
+		*LevelName.ToString(), Room->Assets.Num());
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		Room->Assets, MoveTemp(Loaded), Priority, true, false, FString::Printf(TEXT("RoomAssets %s"), *LevelName.ToString()));
+	if (!Handle.IsValid()) return false;
+	RoomAssets.Add(LevelName, Handle);
+	return true;
+}
+
+void URoomStreamingManager::ReleaseRoomAssets(FName LevelName)
+{
+	TSharedPtr<FStreamableHandle> Handle;
+	if (RoomAssets.RemoveAndCopyValue(LevelName, Handle) && Handle.IsValid())
+	{
+		Handle->ReleaseHandle();
+	}
+}
+
+void URoomStreamingManager::OnRoomEntered(FName LevelName)
+{
+	CurrentRoom = LevelName;
+	TransitionRoom = NAME_None;
+	FRoomResidency& Current = Rooms.FindOrAdd(LevelName);
+	Current.LastUsedTime = GetTime();
+	Current.bPreloaded = false;
+	Current.ResidentBytes = MeasureRoomBytes(LevelName);
+
+	AddDoorsInRoom(LevelName);
+	if (!bEnablePreloading) return;
+
+	// Anything still queued was for the previous room's neighbours
+	PreloadQueue.Reset();
+	if (const TSet<FName>* Neighbours = RoomGraph.Find(LevelName))
+	{
+		for (const FName& Neighbour : *Neighbours)
+		{
+			FRoomResidency& Room = Rooms.FindOrAdd(Neighbour);
+			Room.LastUsedTime = GetTime();
+			if (!Room.bPreloaded)
+			{
+				QueuePreload(Neighbour);
+			}
+		}
+	}
+	EvictRooms();
+	StartNextPreload();
+}
+
+bool URoomStreamingManager::ShouldKeepRoomWarm(FName LevelName) const
+{
+	if (!bEnablePreloading || LevelName == CurrentRoom) return false;
+	const TSet<FName>* Neighbours = RoomGraph.Find(CurrentRoom);
+	const TSet<FName>* Reverse = RoomGraph.Find(LevelName);
+	return (Neighbours && Neighbours->Contains(LevelName)) || (Reverse && Reverse->Contains(CurrentRoom));
+}
+
+bool URoomStreamingManager::RetireRoom(FName OldLevelName, FName NewLevelName)
+{
+	CurrentRoom = NewLevelName;
+	if (!ShouldKeepRoomWarm(OldLevelName)) return false;
+
+	FRoomResidency& Room = Rooms.FindOrAdd(OldLevelName);
+	Room.bPreloaded = true;
+	Room.LastUsedTime = GetTime();
+	return true;
+}
+
+bool URoomStreamingManager::CanOverlapTransition(FName OldLevelName, FName NewLevelName) const
+{
+	if (OldLevelName.IsNone() || IsRoomPreloaded(OldLevelName) || IsRoomPreloaded(NewLevelName)) return true;
+
+	int32 PreloadedCount = 0;
+	const int64 PeakBytes = GetPreloadedBytes(PreloadedCount) + GetRoomBytes(OldLevelName) + GetRoomBytes(NewLevelName);
+	const int64 BudgetBytes = static_cast<int64>(TransitionPeakMemoryMB * 1024.0f * 1024.0f);
+	if (PeakBytes <= BudgetBytes) return true;
+
+	UE_LOG(LogAdventureGame, Log, TEXT("URoomStreamingManager::CanOverlapTransition - %s and %s need %.1f MB, unloading first"),
+		*OldLevelName.ToString(), *NewLevelName.ToString(), PeakBytes / (1024.0 * 1024.0));
+	return false;
+}
+
+void URoomStreamingManager::BeginIntentPreload(FName LevelName)
+{
+	if (!bEnableIntentPreloading || LevelName.IsNone() || LevelName == CurrentRoom) return;
+
+	IntentRoom = LevelName;
+	FRoomResidency& Room = Rooms.FindOrAdd(LevelName);
+	Room.LastUsedTime = GetTime();
+	PreloadQueue.Remove(LevelName);
+	if (Room.bPreloaded || LevelName == PreloadingRoom || LevelName == IntentLoadingRoom) return;
+
+	UE_LOG(LogAdventureGame, Log, TEXT("URoomStreamingManager::BeginIntentPreload - %s"), *LevelName.ToString());
+
+	IntentLoadingRoom = LevelName;
+	LoadRoomAssets(LevelName, FStreamableManager::AsyncLoadHighPriority);
+	FLatentActionInfo LatentActionInfo;
+	LatentActionInfo.Linkage = 0;
+	LatentActionInfo.CallbackTarget = this;
+	LatentActionInfo.ExecutionFunction = OnIntentPreloadCompleteName;
+	LatentActionInfo.UUID = AdvGameUtils::GetUUID();
+	UGameplayStatics::LoadStreamLevel(this, LevelName, false, false, LatentActionInfo);
+}
+
+void URoomStreamingManager::EndIntentPreload()
+{
+	if (IntentRoom.IsNone()) return;
+
+	UE_LOG(LogAdventureGame, Log, TEXT("URoomStreamingManager::EndIntentPreload - %s"), *IntentRoom.ToString());
+
+	// Unless it is still a neighbour, make it the first to go if over budget
+	const TSet<FName>* Neighbours = RoomGraph.Find(CurrentRoom);
+	if (!Neighbours || !Neighbours->Contains(IntentRoom))
+	{
+		Rooms.FindOrAdd(IntentRoom).LastUsedTime = 0.0;
+	}
+	IntentRoom = NAME_None;
+	EvictRooms();
+}
+
+void URoomStreamingManager::OnTransitionStarted(FName LevelName)
+{
+	TransitionRoom = LevelName;
+	IntentRoom = NAME_None;
+
+	// A preload of the room that is still in flight is what the player is now waiting on
+	if (const TSharedPtr<FStreamableHandle>* Handle = RoomAssets.Find(LevelName))
+	{
+		if (Handle->IsValid() && (*Handle)->IsLoadingInProgress())
+		{
+			(*Handle)->SetPriority(FStreamableManager::AsyncLoadHighPriority);
+		}
+	}
+	if (ULevelStreaming* StreamingLevel = UGameplayStatics::GetStreamingLevel(this, LevelName))
+	{
+		if (!StreamingLevel->IsLevelLoaded())
+		{
+			StreamingLevel->SetPriority(TransitionStreamingPriority);
+		}
+	}
+}
+
+void URoomStreamingManager::OnIntentPreloadComplete()
+{
+	const FName LevelName = IntentLoadingRoom;
+	IntentLoadingRoom = NAME_None;
+	if (LevelName.IsNone()) return;
+
+	UE_LOG(LogAdventureGame, Log, TEXT("URoomStreamingManager::OnIntentPreloadComplete - %s"), *LevelName.ToString());
+	FRoomResidency& Room = Rooms.FindOrAdd(LevelName);
+	Room.bPreloaded = LevelName != CurrentRoom && LevelName != TransitionRoom;
+	Room.ResidentBytes = MeasureRoomBytes(LevelName);
+	EvictRooms();
+}
+
+bool URoomStreamingManager::IsRoomPreloaded(FName LevelName) const
+{
+	const FRoomResidency* Room = Rooms.Find(LevelName);
+	return Room && Room->bPreloaded;
+}
+
+void URoomStreamingManager::OnRoomUnloaded(FName LevelName)
+{
+	if (FRoomResidency* Room = Rooms.Find(LevelName))
+	{
+		Room->bPreloaded = false;
+	}
+	ReleaseRoomAssets(LevelName);
+	RoomEvicted.Broadcast(LevelName);
+}
+
+void URoomStreamingManager::ReportTransition(const FRoomTransitionStats& Stats) const
+{
+	int32 PreloadedCount = 0;
+	const int64 PreloadedBytes = GetPreloadedBytes(PreloadedCount);
+	const uint64 PeakOverStart = Stats.PeakMemory > Stats.StartMemory ? Stats.PeakMemory - Stats.StartMemory : 0;
+	UE_LOG(LogAdventureGame, Display,
+		TEXT("URoomStreamingManager - transition %s to %s took %.3f s (%s, %s), peak +%.1f MB, %d rooms preloaded using %.1f MB"),
+		*Stats.FromLevelName.ToString(), *Stats.ToLevelName.ToString(), Stats.DoorLatency,
+		Stats.bWasPreloaded ? TEXT("preloaded") : TEXT("cold"), Stats.bOverlapped ? TEXT("overlapped") : TEXT("sequential"),
+		PeakOverStart / (1024.0 * 1024.0), PreloadedCount, PreloadedBytes / (1024.0 * 1024.0));
+	for (const TPair<FName, FRoomResidency>& Room : Rooms)
+	{
+		UE_LOG(LogAdventureGame, Verbose, TEXT("    %s: %s %.1f MB"), *Room.Key.ToString(),
+			Room.Key == CurrentRoom ? TEXT("current") : Room.Value.bPreloaded ? TEXT("preloaded") : TEXT("unloaded"),
+			Room.Value.ResidentBytes / (1024.0 * 1024.0));
+	}
+}
+
+void URoomStreamingManager::AddDoorsInRoom(FName LevelName)
+{
+	const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+	if (!Registry) return;
+
+	TSet<FName>& Neighbours = RoomGraph.FindOrAdd(LevelName);
+	TArray<ADoor*> Doors;
+	Registry->GetDoorsInLevel(LevelName, Doors);
+	for (const ADoor* Door : Doors)
+	{
+		if (Door->CurrentLevel == LevelName && !Door->LevelToLoad.IsNone() && Door->LevelToLoad != LevelName)
+		{
+			Neighbours.Add(Door->LevelToLoad);
+		}
+	}
+}
+
+void URoomStreamingManager::QueuePreload(FName LevelName)
+{
+	if (LevelName != PreloadingRoom)
+	{
+		PreloadQueue.AddUnique(LevelName);
+	}
+}
+
+void URoomStreamingManager::StartNextPreload()
+{
+	while (PreloadingRoom.IsNone() && !PreloadQueue.IsEmpty())
+	{
+		const FName LevelName = PreloadQueue[0];
+		PreloadQueue.RemoveAt(0);
+		if (LevelName == CurrentRoom || IsRoomPreloaded(LevelName)) continue;
+
+		UE_LOG(LogAdventureGame, Log, TEXT("URoomStreamingManager::StartNextPreload - %s"), *LevelName.ToString());
+		PreloadingRoom = LevelName;
+		PreloadStartTime = GetTime();
+		LoadRoomAssets(LevelName, FStreamableManager::DefaultAsyncLoadPriority);
+
+		FLatentActionInfo LatentActionInfo;
+		LatentActionInfo.Linkage = 0;
+		LatentActionInfo.CallbackTarget = this;
+		LatentActionInfo.ExecutionFunction = OnPreloadCompleteName;
+		LatentActionInfo.UUID = AdvGameUtils::GetUUID();
+		UGameplayStatics::LoadStreamLevel(this, LevelName, false, false, LatentActionInfo);
+	}
+}
+
+void URoomStreamingManager::OnPreloadComplete()
+{
+	const FName LevelName = PreloadingRoom;
+	PreloadingRoom = NAME_None;
+
+	// The player may have gone through a door into this room while it was loading.
+	FRoomResidency& Room = Rooms.FindOrAdd(LevelName);
+	Room.bPreloaded = LevelName != CurrentRoom && LevelName != TransitionRoom;
+	Room.ResidentBytes = MeasureRoomBytes(LevelName);
+
+	UE_LOG(LogAdventureGame, Log, TEXT("URoomStreamingManager::OnPreloadComplete - %s in %.3f s, %.1f MB"),
+		*LevelName.ToString(), GetTime() - PreloadStartTime, Room.ResidentBytes / (1024.0 * 1024.0));
+
+	EvictRooms();
+	StartNextPreload();
+}
+
+void URoomStreamingManager::EvictRooms()
+{
+	const int64 BudgetBytes = static_cast<int64>(MemoryBudgetMB * 1024.0f * 1024.0f);
+	int32 PreloadedCount = 0;
+	while (GetPreloadedBytes(PreloadedCount) > BudgetBytes || PreloadedCount > MaxPreloadedRooms)
+	{
+		FName Oldest = NAME_None;
+		double OldestTime = TNumericLimits<double>::Max();
+		for (const TPair<FName, FRoomResidency>& Room : Rooms)
+		{
+			if (Room.Value.bPreloaded && Room.Key != CurrentRoom && Room.Key != TransitionRoom
+				&& Room.Key != IntentRoom && Room.Value.LastUsedTime < OldestTime)
+			{
+				Oldest = Room.Key;
+				OldestTime = Room.Value.LastUsedTime;
+			}
+		}
+		if (Oldest.IsNone()) break;
+
+		UE_LOG(LogAdventureGame, Log, TEXT("URoomStreamingManager::EvictRooms - %s"), *Oldest.ToString());
+		Rooms[Oldest].bPreloaded = false;
+
+		FLatentActionInfo LatentActionInfo;
+		LatentActionInfo.Linkage = 0;
+		LatentActionInfo.CallbackTarget = this;
+		LatentActionInfo.ExecutionFunction = OnEvictCompleteName;
+		LatentActionInfo.UUID = AdvGameUtils::GetUUID();
+		UGameplayStatics::UnloadStreamLevel(this, Oldest, LatentActionInfo, false);
+		EvictingRooms.AddUnique(Oldest);
+	}
+}
+
+void URoomStreamingManager::OnEvictComplete()
+{
+	for (int32 Index = EvictingRooms.Num() - 1; Index >= 0; --Index)
+	{
+		const FName LevelName = EvictingRooms[Index];
+		const ULevelStreaming* StreamingLevel = UGameplayStatics::GetStreamingLevel(this, LevelName);
+		if (!StreamingLevel || !StreamingLevel->IsLevelLoaded())
+		{
+			UE_LOG(LogAdventureGame, Verbose, TEXT("URoomStreamingManager::OnEvictComplete - %s"), *LevelName.ToString());
+			EvictingRooms.RemoveAt(Index);
+			ReleaseRoomAssets(LevelName);
+			RoomEvicted.Broadcast(LevelName);
+		}
+	}
+}
+
+double URoomStreamingManager::GetTime() const
+{
+	return FPlatformTime::Seconds();
+}
+
+int64 URoomStreamingManager::MeasureRoomBytes(FName LevelName) const
+{
+	const ULevelStreaming* StreamingLevel = UGameplayStatics::GetStreamingLevel(this, LevelName);
+	const ULevel* Level = StreamingLevel ? StreamingLevel->GetLoadedLevel() : nullptr;
+	if (!Level) return 0;
+	const TSharedPtr<FStreamableHandle>* Assets = RoomAssets.Find(LevelName);
+	return MeasureLevelBytes(Level) + (Assets ? MeasureAssetBytes(*Assets) : 0);
+}
+
+int64 URoomStreamingManager::MeasureLoadedRoomsBytes() const
+{
+	int64 Bytes = 0;
+	if (const UWorld* World = GetWorld())
+	{
+		for (const ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+		{
+			if (const ULevel* Level = StreamingLevel ? StreamingLevel->GetLoadedLevel() : nullptr)
+			{
+				Bytes += MeasureLevelBytes(Level);
+			}
+		}
+	}
+	for (const TPair<FName, TSharedPtr<FStreamableHandle>>& Assets : RoomAssets)
+	{
+		Bytes += MeasureAssetBytes(Assets.Value);
+	}
+	return Bytes;
+}
+
+int64 URoomStreamingManager::MeasureLevelBytes(const ULevel* Level)
+{
+	int64 Bytes = 0;
+	ForEachObjectWithPackage(Level->GetPackage(), [&Bytes](UObject* Object)
+	{
+		Bytes += Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		return true;
+	});
+	return Bytes;
+}
+
+int64 URoomStreamingManager::MeasureAssetBytes(const TSharedPtr<FStreamableHandle>& Handle)
+{
+	if (!Handle.IsValid()) return 0;
+	TArray<UObject*> Assets;
+	Handle->GetLoadedAssets(Assets);
+	int64 Bytes = 0;
+	for (UObject* Asset : Assets)
+	{
+		if (Asset) Bytes += Asset->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+	return Bytes;
+}
+
+int64 URoomStreamingManager::GetPreloadedBytes(int32& PreloadedCount) const
+{
+	// Rooms that were loaded by a door rather than a preload were never measured,
+	// so count those as the average of the ones that were.
+	const int64 AverageBytes = GetAverageRoomBytes();
+
+	int64 Total = 0;
+	PreloadedCount = 0;
+	for (const TPair<FName, FRoomResidency>& Room : Rooms)
+	{
+		if (Room.Value.bPreloaded && Room.Key != CurrentRoom)
+		{
+			Total += Room.Value.ResidentBytes > 0 ? Room.Value.ResidentBytes : AverageBytes;
+			++PreloadedCount;
+		}
+	}
+	return Total;
+}
+
+int64 URoomStreamingManager::GetRoomBytes(FName LevelName) const
+{
+	const FRoomResidency* Room = Rooms.Find(LevelName);
+	return Room && Room->ResidentBytes > 0 ? Room->ResidentBytes : GetAverageRoomBytes();
+}
+
+int64 URoomStreamingManager::GetAverageRoomBytes() const
+{
+	int64 MeasuredBytes = 0;
+	int32 MeasuredCount = 0;
+	for (const TPair<FName, FRoomResidency>& Room : Rooms)
+	{
+		if (Room.Value.ResidentBytes > 0)
+		{
+			MeasuredBytes += Room.Value.ResidentBytes;
+			++MeasuredCount;
+		}
+	}
+	return MeasuredCount > 0 ? MeasuredBytes / MeasuredCount : 0;
+}
@@ -0,0 +1,224 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RoomTransitionStats.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/Object.h"
+
+#include "RoomStreamingManager.generated.h"
+
+class ADoor;
+class ULevel;
+class URoomGraph;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FRoomEvicted, FName);
+
+/// What the streaming manager knows about one room (streamed level).
+struct FRoomResidency
+{
+	/// Time in seconds when the room was last current, or was a neighbour
+	/// of the current room. Used to pick the least recently used room to evict.
+	double LastUsedTime = 0.0;
+
+	/// Resource size of the room's level objects and manifest assets, measured when
+	/// it was last loaded. Zero until the room has been loaded once by this manager.
+	int64 ResidentBytes = 0;
+
+	/// The room is loaded but hidden, ready for a door to make it visible.
+	bool bPreloaded = false;
+};
+
+/**
+ * Keeps the rooms next to the current room loaded but hidden, so that using a door
+ * only has to make the next room visible rather than load it off disk.
+ *
+ * The room graph is learned from the doors: each <code>ADoor</code> in a room is an
+ * edge from its <code>CurrentLevel</code> to its <code>LevelToLoad</code>. Edges
+ * are added each time a room becomes current, so the graph grows as the player
+ * explores. The Game Instance's <code>URoomGraph</code> asset has the whole
+ * graph, so it is known from the start.
+ *
+ * Preloads are issued one at a time so that the memory a room takes can be measured.
+ * When the preloaded rooms go over <code>MemoryBudgetMB</code> or
+ * <code>MaxPreloadedRooms</code> the least recently used ones are unloaded.
+ *
+ * Rooms in the room graph asset have a manifest of the assets their actors use,
+ * including soft references that the level load alone would not bring in. The
+ * manifest is loaded as one async batch alongside the level, and kept loaded
+ * until the room is unloaded.
+ *
+ * Create a blueprint of this class and set <code>RoomStreamingClass</code> on the
+ * Game Instance to change the budget.
+ */
+UCLASS(Blueprintable)
+class ADVENTUREGAME_API URoomStreamingManager : public UObject
+{
+	GENERATED_BODY()
+public:
+	/// Set to false to turn off preloading, and load every room on demand.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Room Streaming")
+	bool bEnablePreloading = true;
+
+	/// Memory that preloaded but hidden rooms may use between them, in megabytes.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Room Streaming")
+	float MemoryBudgetMB = 256.0f;
+
+	/// Upper limit on preloaded rooms whatever their measured size.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Room Streaming")
+	int32 MaxPreloadedRooms = 4;
+
+	/// Memory all the resident rooms may use together while a transition has both the
+	/// old and new rooms loaded, in megabytes. Transitions that would go over this
+	/// unload the old room before loading the new one.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Room Streaming")
+	float TransitionPeakMemoryMB = 512.0f;
+
+	/// Start loading the room behind a door as soon as the player commits to using
+	/// it, so the load overlaps the walk to the door.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Room Streaming")
+	bool bEnableIntentPreloading = true;
+
+	/// Streaming priority given to a preloading level once the player goes through
+	/// its door, so it loads ahead of the other preloads. Preloads have priority 0.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Room Streaming")
+	int32 TransitionStreamingPriority = 100;
+
+	/// Seed the room graph with every room's neighbours from the room graph asset.
+	void SetRoomGraph(const URoomGraph* Graph);
+
+	/// Start one batched async load of everything in the room's manifest from the
+	/// room graph. Returns false, without calling Loaded, if the room has no manifest,
+	/// which is logged as an error, or its assets are already loaded. If a preload of
+	/// them is still in flight, it is moved up to Priority and Loaded is bound to it.
+	/// Otherwise Loaded is called once they are all in, which may be before this returns.
+	bool LoadRoomAssets(FName LevelName, TAsyncLoadPriority Priority, FStreamableDelegate Loaded = FStreamableDelegate());
+
+	/// Let the assets of an unloaded room go.
+	void ReleaseRoomAssets(FName LevelName);
+
+	/// Call when a room has become current, after its doors have begun play. Learns
+	/// the doors of the room, then preloads its neighbours and evicts as needed.
+	void OnRoomEntered(FName LevelName);
+
+	/// Should this room stay loaded but hidden, instead of being unloaded, when the
+	/// player leaves it? True if it is a neighbour of the current room.
+	bool ShouldKeepRoomWarm(FName LevelName) const;
+
+	/// The player is leaving OldLevelName for NewLevelName. Returns true if the old
+	/// room should only be hidden, in which case it is counted as preloaded from now.
+	/// Returns false if the caller should unload it.
+	bool RetireRoom(FName OldLevelName, FName NewLevelName);
+
+	/// Can the new room be loaded while the old room is only hidden, with the old room
+	/// unloaded once the new one is playing? Call after RetireRoom. True if it adds no
+	/// memory because one of the rooms is staying loaded anyway, or if the estimated
+	/// size of both rooms and the preloaded rooms fits in TransitionPeakMemoryMB.
+	bool CanOverlapTransition(FName OldLevelName, FName NewLevelName) const;
+
+	/// The player has issued a command to use a door leading to LevelName. Start
+	/// loading it hidden straight away, ahead of anything else queued.
+	void BeginIntentPreload(FName LevelName);
+
+	/// The door command was interrupted or did not lead to a transition. The room
+	/// is kept warm if it fits in the budget, otherwise it is evicted first.
+	void EndIntentPreload();
+
+	/// The Game Instance has started a transition into LevelName. The room is
+	/// never evicted while it is being made visible, and if it is still being
+	/// preloaded its level and assets are moved up to high priority.
+	void OnTransitionStarted(FName LevelName);
+
+	/// Is the room loaded and waiting to be made visible.
+	bool IsRoomPreloaded(FName LevelName) const;
+
+	/// The room has been fully unloaded by the Game Instance, and its actors
+	/// have had EndPlay.
+	void OnRoomUnloaded(FName LevelName);
+
+	/// Log the time a door transition took, and the memory of the rooms now resident.
+	void ReportTransition(const FRoomTransitionStats& Stats) const;
+
+	/// Resource size, in bytes, of the objects in the room's loaded level and of the
+	/// assets in its manifest that are loaded. Zero if the room is not loaded.
+	int64 MeasureRoomBytes(FName LevelName) const;
+
+	/// Resource size of every loaded room, and the manifest assets they hold, in bytes.
+	int64 MeasureLoadedRoomsBytes() const;
+
+	/// Broadcast when a room is unloaded, so that anything cached about its
+	/// actors can be released.
+	FRoomEvicted RoomEvicted;
+
+	/// Levels the doors in the given room lead to.
+	const TSet<FName>* GetNeighbours(FName LevelName) const { return RoomGraph.Find(LevelName); }
+
+private:
+	void AddDoorsInRoom(FName LevelName);
+
+	void QueuePreload(FName LevelName);
+
+	void StartNextPreload();
+
+	void EvictRooms();
+
+	UFUNCTION()
+	void OnPreloadComplete();
+
+	UFUNCTION()
+	void OnEvictComplete();
+
+	UFUNCTION()
+	void OnIntentPreloadComplete();
+
+	double GetTime() const;
+
+	int64 GetPreloadedBytes(int32 &PreloadedCount) const;
+
+	/// Measured size of the room, or the average of the measured rooms if it never was.
+	int64 GetRoomBytes(FName LevelName) const;
+
+	int64 GetAverageRoomBytes() const;
+
+	static int64 MeasureLevelBytes(const ULevel* Level);
+
+	static int64 MeasureAssetBytes(const TSharedPtr<FStreamableHandle>& Handle);
+
+	const FName OnPreloadCompleteName = "OnPreloadComplete";
+	const FName OnEvictCompleteName = "OnEvictComplete";
+	const FName OnIntentPreloadCompleteName = "OnIntentPreloadComplete";
+
+	/// Room the player is in now. Never evicted.
+	FName CurrentRoom;
+
+	/// Room being preloaded right now, or None.
+	FName PreloadingRoom;
+
+	/// Room behind the door the player is walking to, or None.
+	FName IntentRoom;
+
+	/// Room being loaded for an intent that has not completed yet, or None.
+	FName IntentLoadingRoom;
+
+	/// Room a transition is moving into, until it becomes current.
+	FName TransitionRoom;
+
+	double PreloadStartTime = 0.0;
+
+	TArray<FName> PreloadQueue;
+
+	/// Rooms asked to unload, waiting for the unload to finish.
+	TArray<FName> EvictingRooms;
+
+	/// Edges from a level to all the levels its doors lead to.
+	TMap<FName, TSet<FName>> RoomGraph;
+
+	UPROPERTY()
+	const URoomGraph* RoomGraphAsset;
+
+	/// Keeps each loaded room's manifest assets in memory.
+	TMap<FName, TSharedPtr<FStreamableHandle>> RoomAssets;
+
+	TMap<FName, FRoomResidency> Rooms;
+};
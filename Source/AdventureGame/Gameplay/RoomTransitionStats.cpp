@@ -0,0 +1,116 @@
+// (c) 2025 Sarah Smith
+
+
+#include "RoomTransitionStats.h"
+
+#include "AdventureGame/AdventureGame.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+
+void FRoomTransitionStats::BeginStep(FName StepName)
+{
+	EndStep();
+	FRoomTransitionStep& Step = Steps.AddDefaulted_GetRef();
+	Step.Name = StepName;
+	Step.StartSeconds = FPlatformTime::Seconds() - StartTime;
+	OpenStep = Steps.Num() - 1;
+}
+
+void FRoomTransitionStats::EndStep()
+{
+	if (Steps.IsValidIndex(OpenStep))
+	{
+		FRoomTransitionStep& Step = Steps[OpenStep];
+		Step.Seconds = FPlatformTime::Seconds() - StartTime - Step.StartSeconds;
+	}
+	OpenStep = INDEX_NONE;
+}
+
+double FRoomTransitionStats::GetStepSeconds(FName StepName) const
+{
+	double Seconds = 0.0;
+	for (const FRoomTransitionStep& Step : Steps)
+	{
+		if (Step.Name == StepName) Seconds += Step.Seconds;
+	}
+	return Seconds;
+}
+
+FScopedRoomTransitionStep::FScopedRoomTransitionStep(FRoomTransitionStats* InStats, FName StepName)
+	: Stats(InStats)
+{
+	if (!Stats || Stats->StartTime <= 0.0) return;
+	FRoomTransitionStep& NewStep = Stats->Steps.AddDefaulted_GetRef();
+	NewStep.Name = StepName;
+	NewStep.StartSeconds = FPlatformTime::Seconds() - Stats->StartTime;
+	Step = Stats->Steps.Num() - 1;
+}
+
+FScopedRoomTransitionStep::~FScopedRoomTransitionStep()
+{
+	if (Stats && Stats->Steps.IsValidIndex(Step))
+	{
+		FRoomTransitionStep& Ended = Stats->Steps[Step];
+		Ended.Seconds = FPlatformTime::Seconds() - Stats->StartTime - Ended.StartSeconds;
+	}
+}
+
+static double ToMB(uint64 Bytes)
+{
+	return Bytes / (1024.0 * 1024.0);
+}
+
+static double DeltaMB(uint64 From, uint64 To)
+{
+	return (static_cast<double>(To) - static_cast<double>(From)) / (1024.0 * 1024.0);
+}
+
+FString FRoomTransitionLog::ToCsv() const
+{
+	TArray<FName> StepNames;
+	for (const FRoomTransitionStats& Stats : Transitions)
+	{
+		for (const FRoomTransitionStep& Step : Stats.Steps)
+		{
+			StepNames.AddUnique(Step.Name);
+		}
+	}
+
+	FString Csv = TEXT("Index,From,To,Preloaded,Overlapped,DoorLatencyMs,OldRoomResidentMs");
+	for (const FName& StepName : StepNames)
+	{
+		Csv += FString::Printf(TEXT(",%sMs"), *StepName.ToString());
+	}
+	Csv += TEXT(",HotSpots,GCCount,GCMs,StartMB,PeakDeltaMB,PlayDeltaMB,EndDeltaMB\n");
+
+	for (int32 Index = 0; Index < Transitions.Num(); ++Index)
+	{
+		const FRoomTransitionStats& Stats = Transitions[Index];
+		Csv += FString::Printf(TEXT("%d,%s,%s,%d,%d,%.3f,%.3f"), Index,
+			*Stats.FromLevelName.ToString(), *Stats.ToLevelName.ToString(),
+			Stats.bWasPreloaded ? 1 : 0, Stats.bOverlapped ? 1 : 0,
+			Stats.DoorLatency * 1000.0, Stats.OldRoomResidentSeconds * 1000.0);
+		for (const FName& StepName : StepNames)
+		{
+			Csv += FString::Printf(TEXT(",%.3f"), Stats.GetStepSeconds(StepName) * 1000.0);
+		}
+		Csv += FString::Printf(TEXT(",%d,%d,%.3f,%.1f,%.1f,%.1f,%.1f\n"),
+			Stats.HotSpotCount, Stats.GCCount, Stats.GCSeconds * 1000.0, ToMB(Stats.StartMemory),
+			DeltaMB(Stats.StartMemory, Stats.PeakMemory), DeltaMB(Stats.StartMemory, Stats.PlayMemory),
+			DeltaMB(Stats.StartMemory, Stats.EndMemory));
+	}
+	return Csv;
+}
+
+bool FRoomTransitionLog::SaveCsv(const FString& FilePath) const
+{
+	if (!FFileHelper::SaveStringToFile(ToCsv(), *FilePath))
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("FRoomTransitionLog::SaveCsv - could not write %s"), *FilePath);
+		return false;
+	}
+	UE_LOG(LogAdventureGame, Display, TEXT("FRoomTransitionLog::SaveCsv - %d transitions written to %s"),
+		Transitions.Num(), *FilePath);
+	return true;
+}
@@ -0,0 +1,117 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// One timed step of a door transition, either a phase of the transition's state
+/// machine, or a synchronous call such as SetupRoom.
+struct FRoomTransitionStep
+{
+	FName Name;
+
+	/// Seconds after the door was used that the step started.
+	double StartSeconds = 0.0;
+
+	double Seconds = 0.0;
+};
+
+/// Measurements of one door transition, recorded by the Game Instance.
+struct ADVENTUREGAME_API FRoomTransitionStats
+{
+	FName FromLevelName;
+
+	FName ToLevelName;
+
+	/// FPlatformTime::Seconds when the door was used.
+	double StartTime = 0.0;
+
+	/// Seconds from the door being used to the player having control in the new room.
+	double DoorLatency = 0.0;
+
+	/// Seconds from the door being used to the old room being unloaded, or zero if
+	/// the old room was kept loaded.
+	double OldRoomResidentSeconds = 0.0;
+
+	/// The new room was already loaded, so only had to be made visible.
+	bool bWasPreloaded = false;
+
+	/// The new room loaded while the old room was still resident, see CanOverlapTransition.
+	bool bOverlapped = false;
+
+	/// Hotspots that began play in the new room.
+	int32 HotSpotCount = 0;
+
+	/// Garbage collections that ran between the door being used and the record closing.
+	int32 GCCount = 0;
+
+	double GCSeconds = 0.0;
+
+	/// Resource size of the loaded rooms when the door was used, see
+	/// URoomStreamingManager::MeasureLoadedRoomsBytes.
+	uint64 StartMemory = 0;
+
+	/// Largest resource size of the loaded rooms seen during the transition.
+	uint64 PeakMemory = 0;
+
+	/// Resource size of the loaded rooms when the player got control in the new room.
+	uint64 PlayMemory = 0;
+
+	/// Resource size of the loaded rooms when the record closed, after any unload of
+	/// the old room.
+	uint64 EndMemory = 0;
+
+	TArray<FRoomTransitionStep> Steps;
+
+	/// End the step in progress, if any, and start a new one.
+	void BeginStep(FName StepName);
+
+	/// End the step in progress, if any.
+	void EndStep();
+
+	/// Total seconds spent in steps with this name, or zero if there were none.
+	double GetStepSeconds(FName StepName) const;
+
+private:
+	int32 OpenStep = INDEX_NONE;
+};
+
+/// Times a synchronous step of a transition, for the length of a scope. Nests
+/// inside the phase that is in progress rather than ending it.
+struct ADVENTUREGAME_API FScopedRoomTransitionStep
+{
+	FScopedRoomTransitionStep(FRoomTransitionStats* InStats, FName StepName);
+
+	~FScopedRoomTransitionStep();
+
+private:
+	FRoomTransitionStats* Stats;
+
+	int32 Step = INDEX_NONE;
+};
+
+/**
+ * All the door transitions since the game started, in order. Kept in memory so
+ * it costs nothing during play, and written out as CSV on request.
+ */
+class ADVENTUREGAME_API FRoomTransitionLog
+{
+public:
+	void Add(const FRoomTransitionStats& Stats) { Transitions.Add(Stats); }
+
+	void Reset() { Transitions.Reset(); }
+
+	int32 Num() const { return Transitions.Num(); }
+
+	const TArray<FRoomTransitionStats>& GetTransitions() const { return Transitions; }
+
+	/// One row per transition, with a column for each step name seen in any
+	/// transition, in milliseconds.
+	FString ToCsv() const;
+
+	/// Write ToCsv to a file. Returns false if it could not be written.
+	bool SaveCsv(const FString& FilePath) const;
+
+private:
+	TArray<FRoomTransitionStats> Transitions;
+};
@@ -0,0 +1,87 @@
+// (c) 2025 Sarah Smith
+
+
+#include "SimulationClock.h"
+
+#include "AdventureGame/AdventureGame.h"
+
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+
+/// Waits are scaled by this in fast forward. Even a long wait then comes to well
+/// under a frame, while a shorter one still ends first.
+static constexpr float FastForwardWaitScale = 1.0e-4f;
+
+/// Least a scaled wait can be, so it is never zero. Under the scaled length of any wait
+/// that matters, 1e-8 s for 0.1 ms, so short waits keep their order, yet still hundreds
+/// of times the precision of the timer manager's clock after hours of game time.
+static constexpr float MinFastForwardWait = 1.0e-10f;
+
+bool FSimulationClock::bFastForward = false;
+float FSimulationClock::FixedStep = 1.0f / 30.0f;
+uint64 FSimulationClock::StartFrame = 0;
+double FSimulationClock::StartTime = 0.0;
+int32 FSimulationClock::Commands = 0;
+int32 FSimulationClock::WaitsShortened = 0;
+double FSimulationClock::SecondsSkipped = 0.0;
+bool FSimulationClock::bSavedUseFixedTimeStep = false;
+double FSimulationClock::SavedFixedDeltaTime = 0.0;
+
+void FSimulationClock::Initialize()
+{
+	float Step = 0.0f;
+	if (FParse::Value(FCommandLine::Get(), TEXT("FastForwardStep="), Step) && Step > 0.0f)
+	{
+		FixedStep = Step;
+	}
+	if (FParse::Param(FCommandLine::Get(), TEXT("FastForward")))
+	{
+		SetFastForward(true);
+	}
+}
+
+void FSimulationClock::SetFastForward(bool bEnable)
+{
+	if (bEnable == bFastForward) return;
+	bFastForward = bEnable;
+	if (bEnable)
+	{
+		bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+		SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(FixedStep);
+		StartFrame = GFrameCounter;
+		StartTime = FPlatformTime::Seconds();
+		Commands = 0;
+		WaitsShortened = 0;
+		SecondsSkipped = 0.0;
+		UE_LOG(LogAdventureGame, Display, TEXT("FSimulationClock::SetFastForward - on, %.4f s per frame"), FixedStep);
+	}
+	else
+	{
+		ReportThroughput(TEXT("FSimulationClock::SetFastForward"));
+		FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+		FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+	}
+}
+
+float FSimulationClock::GetWait(float Seconds)
+{
+	if (!bFastForward || Seconds <= 0.0f) return Seconds;
+	const float Wait = FMath::Max(Seconds * FastForwardWaitScale, MinFastForwardWait);
+	++WaitsShortened;
+	SecondsSkipped += Seconds - Wait;
+	return Wait;
+}
+
+void FSimulationClock::ReportThroughput(const TCHAR* Context)
+{
+	if (!bFastForward) return;
+	const uint64 Frames = GFrameCounter - StartFrame;
+	const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+	const double GameSeconds = Frames * FixedStep + SecondsSkipped;
+	UE_LOG(LogAdventureGame, Display, TEXT("%s - fast forward: %llu frames, %d commands, %.1f s of game time (%d waits, %.1f s, cut short) in %.2f s, %.0fx real time, %.0f frames per second"),
+		Context, Frames, Commands, GameSeconds, WaitsShortened, SecondsSkipped, WallSeconds,
+		WallSeconds > 0.0 ? GameSeconds / WallSeconds : 0.0,
+		WallSeconds > 0.0 ? Frames / WallSeconds : 0.0);
+}
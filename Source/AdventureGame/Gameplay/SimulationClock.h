@@ -0,0 +1,64 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fast forward mode, for running scripted playthroughs headless at many times
+ * real time. Turned on with -FastForward, normally alongside -nullrhi and
+ * -ReplayCommands=Slot -ReplayExit.
+ *
+ * The engine runs at a fixed time step with no frame rate cap, so each frame
+ * is as long as -FastForwardStep= seconds of game time (1/30 by default) but
+ * takes only as long as it takes to compute. Timed waits, like a bark line on
+ * screen or an interaction timeout, ask GetWait for how long to wait, which in
+ * fast forward scales them down so far that they are all over by the next
+ * frame, while still ending in the order they would have. The player teleports
+ * instead of walking, and rooms load blocking.
+ */
+struct ADVENTUREGAME_API FSimulationClock
+{
+	/// Read the command line. Called when the game instance starts.
+	static void Initialize();
+
+	static bool IsFastForward() { return bFastForward; }
+
+	/// Turn fast forward on or off, eg from a test, setting the engine time step to match.
+	static void SetFastForward(bool bEnable);
+
+	/// How long to wait for something that takes Seconds in normal play. Never
+	/// zero for a positive wait, as setting a timer for zero clears it instead.
+	static float GetWait(float Seconds);
+
+	/// Game seconds per frame in fast forward.
+	static float GetFixedStep() { return FixedStep; }
+
+	/// Count a command from the player, or a replay, for the throughput report, once
+	/// when it is dispatched.
+	static void CountCommand() { ++Commands; }
+
+	/// Log the frames, commands and game time simulated since fast forward was
+	/// turned on, against the wall clock time that took.
+	static void ReportThroughput(const TCHAR* Context);
+
+private:
+	static bool bFastForward;
+
+	static float FixedStep;
+
+	static uint64 StartFrame;
+
+	static double StartTime;
+
+	static int32 Commands;
+
+	static int32 WaitsShortened;
+
+	/// Game seconds of waits that GetWait cut short.
+	static double SecondsSkipped;
+
+	static bool bSavedUseFixedTimeStep;
+
+	static double SavedFixedDeltaTime;
+};
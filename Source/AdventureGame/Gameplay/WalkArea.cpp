@@ -0,0 +1,252 @@
+// (c) 2025 Sarah Smith
+
+
+#include "WalkArea.h"
+
+#include "Algo/Reverse.h"
+
+/// Twice the signed area, positive if the points go anticlockwise.
+static double SignedArea(const TArray<FVector2D>& Polygon)
+{
+	double Area = 0.0;
+	for (int32 i = 0, j = Polygon.Num() - 1; i < Polygon.Num(); j = i++)
+	{
+		Area += Polygon[j] ^ Polygon[i];
+	}
+	return Area;
+}
+
+/// Positive if B is to the left of the line from O through A.
+static double Turn(const FVector2D& O, const FVector2D& A, const FVector2D& B)
+{
+	return (A - O) ^ (B - O);
+}
+
+/// Do the segments cross, not counting touching at an end.
+static bool SegmentsCross(const FVector2D& A, const FVector2D& B, const FVector2D& P, const FVector2D& Q)
+{
+	const double D1 = Turn(A, B, P);
+	const double D2 = Turn(A, B, Q);
+	const double D3 = Turn(P, Q, A);
+	const double D4 = Turn(P, Q, B);
+	return ((D1 > 0.0 && D2 < 0.0) || (D1 < 0.0 && D2 > 0.0))
+		&& ((D3 > 0.0 && D4 < 0.0) || (D3 < 0.0 && D4 > 0.0));
+}
+
+static FVector2D LeftNormal(const FVector2D& From, const FVector2D& To)
+{
+	const FVector2D Direction = (To - From).GetSafeNormal();
+	return FVector2D(-Direction.Y, Direction.X);
+}
+
+void FWalkArea::Build(const TArray<FVector2D>& Outline, const TArray<TArray<FVector2D>>& Holes, double InNodeOffset)
+{
+	Polygons.Reset();
+	Nodes.Reset();
+	Links.Reset();
+	NodeOffset = InNodeOffset;
+	if (Outline.Num() < 3) return;
+
+	// Walkable on the left: the outline anticlockwise, the holes clockwise
+	Polygons.Add(Outline);
+	if (SignedArea(Polygons[0]) < 0.0) Algo::Reverse(Polygons[0]);
+	for (const TArray<FVector2D>& Hole : Holes)
+	{
+		if (Hole.Num() < 3) continue;
+		TArray<FVector2D>& Added = Polygons.Add_GetRef(Hole);
+		if (SignedArea(Added) > 0.0) Algo::Reverse(Added);
+	}
+
+	// A shortest path only bends round corners that stick out into the walkable
+	// area, which with it on the left are those where the boundary turns right
+	for (const TArray<FVector2D>& Polygon : Polygons)
+	{
+		for (int32 i = 0; i < Polygon.Num(); ++i)
+		{
+			const FVector2D& Previous = Polygon[(i + Polygon.Num() - 1) % Polygon.Num()];
+			const FVector2D& Corner = Polygon[i];
+			const FVector2D& Next = Polygon[(i + 1) % Polygon.Num()];
+			if (Turn(Previous, Corner, Next) >= 0.0) continue;
+			const FVector2D Outwards = (LeftNormal(Previous, Corner) + LeftNormal(Corner, Next)).GetSafeNormal();
+			const FVector2D Node = Corner + Outwards * NodeOffset;
+			if (Contains(Node)) Nodes.Add(Node);
+		}
+	}
+
+	Links.SetNum(Nodes.Num());
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		for (int32 j = i + 1; j < Nodes.Num(); ++j)
+		{
+			if (!IsVisible(Nodes[i], Nodes[j])) continue;
+			const double Cost = FVector2D::Distance(Nodes[i], Nodes[j]);
+			Links[i].Add({ j, Cost });
+			Links[j].Add({ i, Cost });
+		}
+	}
+}
+
+bool FWalkArea::Contains(const FVector2D& Point) const
+{
+	if (Polygons.IsEmpty() || !IsInPolygon(Polygons[0], Point)) return false;
+	for (int32 i = 1; i < Polygons.Num(); ++i)
+	{
+		if (IsInPolygon(Polygons[i], Point)) return false;
+	}
+	return true;
+}
+
+FVector2D FWalkArea::ClampToArea(const FVector2D& Point) const
+{
+	if (Polygons.IsEmpty() || Contains(Point)) return Point;
+
+	FVector2D Nearest = Point;
+	FVector2D Inwards = FVector2D::ZeroVector;
+	double NearestDistanceSquared = TNumericLimits<double>::Max();
+	for (const TArray<FVector2D>& Polygon : Polygons)
+	{
+		for (int32 i = 0, j = Polygon.Num() - 1; i < Polygon.Num(); j = i++)
+		{
+			const FVector2D OnEdge = FMath::ClosestPointOnSegment2D(Point, Polygon[j], Polygon[i]);
+			const double DistanceSquared = FVector2D::DistSquared(Point, OnEdge);
+			if (DistanceSquared < NearestDistanceSquared)
+			{
+				NearestDistanceSquared = DistanceSquared;
+				Nearest = OnEdge;
+				Inwards = LeftNormal(Polygon[j], Polygon[i]);
+			}
+		}
+	}
+	const FVector2D Clamped = Nearest + Inwards * NodeOffset;
+	return Contains(Clamped) ? Clamped : Nearest;
+}
+
+bool FWalkArea::IsVisible(const FVector2D& A, const FVector2D& B) const
+{
+	for (const TArray<FVector2D>& Polygon : Polygons)
+	{
+		for (int32 i = 0, j = Polygon.Num() - 1; i < Polygon.Num(); j = i++)
+		{
+			if (SegmentsCross(A, B, Polygon[j], Polygon[i])) return false;
+		}
+	}
+	// A line exactly through a corner crosses neither of its edges, so check it
+	// has not gone through a hole or out of the area that way
+	return Contains((A + B) * 0.5);
+}
+
+bool FWalkArea::FindPath(const FVector2D& Start, const FVector2D& End, TArray<FVector2D>& OutPoints) const
+{
+	OutPoints.Reset();
+	if (Polygons.IsEmpty()) return false;
+
+	const FVector2D From = ClampToArea(Start);
+	const FVector2D To = ClampToArea(End);
+	if (IsVisible(From, To))
+	{
+		OutPoints.Add(From);
+		OutPoints.Add(To);
+		return true;
+	}
+
+	// The start and end go in after the corners
+	const int32 StartNode = Nodes.Num();
+	const int32 EndNode = Nodes.Num() + 1;
+	TArray<double> Costs;
+	Costs.Init(TNumericLimits<double>::Max(), Nodes.Num() + 2);
+	TArray<int32> CameFrom;
+	CameFrom.Init(INDEX_NONE, Nodes.Num() + 2);
+	TArray<bool> Closed;
+	Closed.Init(false, Nodes.Num() + 2);
+	TArray<double> CostsToEnd;
+	CostsToEnd.Init(-1.0, Nodes.Num());
+
+	struct FOpen
+	{
+		int32 Node;
+		double Estimate;
+	};
+	auto Cheaper = [](const FOpen& A, const FOpen& B) { return A.Estimate < B.Estimate; };
+	TArray<FOpen> Open;
+	auto Reach = [&](int32 Node, int32 Via, double Cost)
+	{
+		if (Cost >= Costs[Node]) return;
+		Costs[Node] = Cost;
+		CameFrom[Node] = Via;
+		const FVector2D& Location = Node == EndNode ? To : Nodes[Node];
+		Open.HeapPush({ Node, Cost + FVector2D::Distance(Location, To) }, Cheaper);
+	};
+
+	Costs[StartNode] = 0.0;
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		if (IsVisible(From, Nodes[i])) Reach(i, StartNode, FVector2D::Distance(From, Nodes[i]));
+		if (IsVisible(Nodes[i], To)) CostsToEnd[i] = FVector2D::Distance(Nodes[i], To);
+	}
+
+	while (!Open.IsEmpty())
+	{
+		FOpen Current;
+		Open.HeapPop(Current, Cheaper, EAllowShrinking::No);
+		if (Current.Node == EndNode) break;
+		if (Closed[Current.Node]) continue;
+		Closed[Current.Node] = true;
+
+		const double Cost = Costs[Current.Node];
+		if (CostsToEnd[Current.Node] >= 0.0) Reach(EndNode, Current.Node, Cost + CostsToEnd[Current.Node]);
+		for (const FLink& Link : Links[Current.Node])
+		{
+			if (!Closed[Link.Node]) Reach(Link.Node, Current.Node, Cost + Link.Cost);
+		}
+	}
+	if (CameFrom[EndNode] == INDEX_NONE) return false;
+
+	OutPoints.Add(To);
+	for (int32 Node = CameFrom[EndNode]; Node != StartNode; Node = CameFrom[Node])
+	{
+		OutPoints.Add(Nodes[Node]);
+	}
+	OutPoints.Add(From);
+	Algo::Reverse(OutPoints);
+	return true;
+}
+
+int32 FWalkArea::GetLinkCount() const
+{
+	int32 Count = 0;
+	for (const TArray<FLink>& NodeLinks : Links)
+	{
+		Count += NodeLinks.Num();
+	}
+	return Count / 2;
+}
+
+SIZE_T FWalkArea::GetAllocatedSize() const
+{
+	SIZE_T Size = Polygons.GetAllocatedSize() + Nodes.GetAllocatedSize() + Links.GetAllocatedSize();
+	for (const TArray<FVector2D>& Polygon : Polygons)
+	{
+		Size += Polygon.GetAllocatedSize();
+	}
+	for (const TArray<FLink>& NodeLinks : Links)
+	{
+		Size += NodeLinks.GetAllocatedSize();
+	}
+	return Size;
+}
+
+bool FWalkArea::IsInPolygon(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+{
+	bool bInside = false;
+	for (int32 i = 0, j = Polygon.Num() - 1; i < Polygon.Num(); j = i++)
+	{
+		const FVector2D& A = Polygon[i];
+		const FVector2D& B = Polygon[j];
+		if ((A.Y > Point.Y) != (B.Y > Point.Y)
+			&& Point.X < (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y) + A.X)
+		{
+			bInside = !bInside;
+		}
+	}
+	return bInside;
+}
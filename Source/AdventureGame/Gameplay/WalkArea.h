@@ -0,0 +1,69 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The floor of a flat room as a polygon, with polygons for the holes in it
+ * where the player cannot walk, eg around a table. Paths are found with A*
+ * over a visibility graph: the corners that a shortest path can bend round,
+ * with a link between each pair that can see each other. As the links are
+ * straight lines between those corners, the path A* finds is already pulled
+ * taut, and needs no smoothing afterwards.
+ *
+ * The start and end of a query are linked into the graph as it runs, so only
+ * the corners and the links between them are kept. Everything is in the XY
+ * plane, in world units.
+ */
+class ADVENTUREGAME_API FWalkArea
+{
+public:
+	/// Outline of the area and of each hole, as points in order round them,
+	/// either way round. Corners are moved NodeOffset into the walkable area,
+	/// so paths keep off the walls rather than grazing them.
+	void Build(const TArray<FVector2D>& Outline, const TArray<TArray<FVector2D>>& Holes, double InNodeOffset = 2.0);
+
+	bool IsEmpty() const { return Polygons.IsEmpty(); }
+
+	FBox2D GetBounds() const { return Polygons.IsEmpty() ? FBox2D(ForceInit) : FBox2D(Polygons[0]); }
+
+	/// Inside the outline and outside all the holes.
+	bool Contains(const FVector2D& Point) const;
+
+	/// The point, or if it is outside the area the nearest point that is inside it.
+	FVector2D ClampToArea(const FVector2D& Point) const;
+
+	/// Can the player walk straight from A to B without crossing a wall.
+	bool IsVisible(const FVector2D& A, const FVector2D& B) const;
+
+	/// Shortest path from Start to End, including both. Either end outside the
+	/// area is moved to the nearest point inside it first. Returns false if
+	/// there is no path, eg to the inside of a hole in a hole.
+	bool FindPath(const FVector2D& Start, const FVector2D& End, TArray<FVector2D>& OutPoints) const;
+
+	int32 GetNodeCount() const { return Nodes.Num(); }
+
+	int32 GetLinkCount() const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FLink
+	{
+		int32 Node = INDEX_NONE;
+		double Cost = 0.0;
+	};
+
+	static bool IsInPolygon(const TArray<FVector2D>& Polygon, const FVector2D& Point);
+
+	/// The outline first, then the holes, each ordered so the walkable area is on the left.
+	TArray<TArray<FVector2D>> Polygons;
+
+	/// Corners a path can bend round, moved a little into the walkable area.
+	TArray<FVector2D> Nodes;
+
+	TArray<TArray<FLink>> Links;
+
+	double NodeOffset = 2.0;
+};
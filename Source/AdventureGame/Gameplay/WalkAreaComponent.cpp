@@ -0,0 +1,69 @@
+// (c) 2025 Sarah Smith
+
+
+#include "WalkAreaComponent.h"
+
+#include "AdventureWorldRegistry.h"
+
+#include "AdventureGame/AdventureGame.h"
+
+bool UWalkAreaComponent::FindPath(const FVector& Start, const FVector& End, TArray<FVector>& OutPoints) const
+{
+	TArray<FVector2D> Points;
+	if (!WalkArea.FindPath(FVector2D(Start), FVector2D(End), Points)) return false;
+	OutPoints.Reset(Points.Num());
+	for (const FVector2D& Point : Points)
+	{
+		OutPoints.Add(FVector(Point, Start.Z));
+	}
+	return true;
+}
+
+void UWalkAreaComponent::Rebuild()
+{
+	const FTransform& Transform = GetComponentTransform();
+	auto ToWorld = [&Transform](const TArray<FVector2D>& Points)
+	{
+		TArray<FVector2D> WorldPoints;
+		WorldPoints.Reserve(Points.Num());
+		for (const FVector2D& Point : Points)
+		{
+			WorldPoints.Add(FVector2D(Transform.TransformPosition(FVector(Point, 0.0))));
+		}
+		return WorldPoints;
+	};
+	TArray<TArray<FVector2D>> WorldHoles;
+	for (const FWalkAreaHole& Hole : Holes)
+	{
+		WorldHoles.Add(ToWorld(Hole.Points));
+	}
+	WalkArea.Build(ToWorld(Outline), WorldHoles, CornerClearance);
+	UE_LOG(LogAdventureGame, Verbose, TEXT("UWalkAreaComponent::Rebuild - %s, %d corners, %d links, %llu bytes"),
+		*GetPathName(), WalkArea.GetNodeCount(), WalkArea.GetLinkCount(),
+		static_cast<uint64>(WalkArea.GetAllocatedSize()));
+}
+
+void UWalkAreaComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Rebuild();
+	if (WalkArea.IsEmpty())
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("UWalkAreaComponent::BeginPlay - %s has no outline"), *GetPathName());
+		return;
+	}
+	if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+	{
+		Registry->RegisterWalkArea(this);
+	}
+}
+
+void UWalkAreaComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+	{
+		Registry->UnregisterWalkArea(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
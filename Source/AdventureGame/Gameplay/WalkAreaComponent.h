@@ -0,0 +1,63 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WalkArea.h"
+#include "Components/SceneComponent.h"
+
+#include "WalkAreaComponent.generated.h"
+
+/// Points round a hole in a walk area. A struct as an array of arrays cannot be a property.
+USTRUCT()
+struct FWalkAreaHole
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Walk Area")
+	TArray<FVector2D> Points;
+};
+
+/**
+ * Where the player can walk in a room, drawn as a polygon with holes, for
+ * rooms that would rather not have a navigation mesh. Put one on any actor in
+ * the room's level. While the room is in play the player's walks follow paths
+ * from it, straight to the character, instead of going through the AI
+ * controller and the navigation system.
+ *
+ * The points are relative to the component, in its XY plane, and should be
+ * where the middle of the character can go, ie in from the walls by its radius.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class ADVENTUREGAME_API UWalkAreaComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Walk Area")
+	TArray<FVector2D> Outline;
+
+	UPROPERTY(EditAnywhere, Category = "Walk Area")
+	TArray<FWalkAreaHole> Holes;
+
+	/// How far paths keep off the corners they go round.
+	UPROPERTY(EditAnywhere, Category = "Walk Area")
+	float CornerClearance = 2.0f;
+
+	/// Shortest path in world space, from Start to End or the nearest point to
+	/// it in the area. All the points are at the height of Start.
+	bool FindPath(const FVector& Start, const FVector& End, TArray<FVector>& OutPoints) const;
+
+	const FWalkArea& GetWalkArea() const { return WalkArea; }
+
+	/// Make the graph again from the outline and holes, eg after moving the component.
+	void Rebuild();
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/// In world space
+	FWalkArea WalkArea;
+};
@@ -0,0 +1,222 @@
+// (c) 2025 Sarah Smith
+
+
+#include "WalkPathManager.h"
+
+#include "AdventureGameInstance.h"
+#include "AdventureWorldRegistry.h"
+#include "RoomStreamingManager.h"
+#include "WalkAreaComponent.h"
+
+#include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/HotSpots/HotSpot.h"
+#include "AdventureGame/Player/AdventureCharacter.h"
+#include "AdventureGame/Player/CommandManager.h"
+
+#include "AIController.h"
+#include "Engine/Engine.h"
+#include "NavigationSystem.h"
+#include "NavFilters/NavigationQueryFilter.h"
+
+/// The navigation system's path for the query, as points.
+static bool FindNavigationPath(UNavigationSystemV1& NavigationSystem, const FPathFindingQuery& Query,
+	TArray<FVector>& OutPoints)
+{
+	const FPathFindingResult Result = NavigationSystem.FindPathSync(Query);
+	if (!Result.IsSuccessful() || !Result.Path.IsValid()) return false;
+	OutPoints.Reset(Result.Path->GetPathPoints().Num());
+	for (const FNavPathPoint& Point : Result.Path->GetPathPoints())
+	{
+		OutPoints.Add(Point.Location);
+	}
+	return true;
+}
+
+/// The navigation data the player character walks on, and its controller.
+static ANavigationData* FindPlayerNavData(UNavigationSystemV1* NavigationSystem,
+	const UAdventureWorldRegistry* Registry, const AAIController*& OutController)
+{
+	const ACommandManager* CommandManager = Registry ? Registry->GetCommandManager() : nullptr;
+	const AAdventureCharacter* PlayerCharacter = CommandManager ? CommandManager->PlayerCharacter : nullptr;
+	OutController = PlayerCharacter ? Cast<AAIController>(PlayerCharacter->GetController()) : nullptr;
+	return NavigationSystem && OutController
+		? NavigationSystem->GetNavDataForProps(OutController->GetNavAgentPropertiesRef(), PlayerCharacter->GetNavAgentLocation())
+		: nullptr;
+}
+
+UWalkPathManager* UWalkPathManager::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	return World ? World->GetSubsystem<UWalkPathManager>() : nullptr;
+}
+
+void UWalkPathManager::BuildWalkGraph(FName LevelName)
+{
+	CurrentLevelName = LevelName;
+
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+	const AAIController* Controller = nullptr;
+	const ANavigationData* NavData = FindPlayerNavData(NavigationSystem, Registry, Controller);
+	if (!NavData) return;
+
+	TArray<AHotSpot*> HotSpots;
+	Registry->GetHotSpotsInLevel(LevelName, HotSpots);
+	TArray<FVector> Nodes;
+	for (const AHotSpot* HotSpot : HotSpots)
+	{
+		FNavLocation Projected;
+		if (NavigationSystem->ProjectPointToNavigation(HotSpot->WalkToPosition, Projected, INVALID_NAVEXTENT, NavData))
+		{
+			Nodes.Add(Projected.Location);
+		}
+	}
+
+	const FSharedConstNavQueryFilter Filter = UNavigationQueryFilter::GetQueryFilter(*NavData, Controller,
+		Controller->GetDefaultNavigationFilterClass());
+	const double GraphSeconds = Cache.GetStats().GraphBuildSeconds;
+	Cache.BuildGraph(LevelName, Nodes, [&](const FVector& Start, const FVector& End, TArray<FVector>& OutPoints)
+	{
+		return FindNavigationPath(*NavigationSystem, FPathFindingQuery(Controller, *NavData, Start, End, Filter), OutPoints);
+	});
+	UE_LOG(LogAdventureGame, Log, TEXT("UWalkPathManager::BuildWalkGraph - %s, %d walk-to positions, %d paths in %.3f ms"),
+		*LevelName.ToString(), Nodes.Num(), Cache.GetGraphPathCount(LevelName),
+		(Cache.GetStats().GraphBuildSeconds - GraphSeconds) * 1000.0);
+}
+
+FNavPathSharedPtr UWalkPathManager::FindPath(const FPathFindingQuery& Query)
+{
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = Query.NavData.Get();
+	if (!NavigationSystem || !NavData) return nullptr;
+
+	TArray<FVector> Points;
+	const bool bFound = Cache.FindPath(CurrentLevelName, Query.StartLocation, Query.EndLocation,
+		[&](const FVector& Start, const FVector& End, TArray<FVector>& OutPoints)
+		{
+			FPathFindingQuery SolverQuery(Query);
+			SolverQuery.StartLocation = Start;
+			SolverQuery.EndLocation = End;
+			return FindNavigationPath(*NavigationSystem, SolverQuery, OutPoints);
+		}, Points);
+	if (!bFound) return nullptr;
+
+	FNavPathSharedPtr Path = MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Points);
+	Path->SetNavigationDataUsed(NavData);
+	Path->SetQuerier(Query.Owner.Get());
+	return Path;
+}
+
+void UWalkPathManager::CompareWalkArea(int32 Queries) const
+{
+	UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+	const UWalkAreaComponent* WalkAreaComponent = Registry ? Registry->FindWalkArea(CurrentLevelName) : nullptr;
+	if (!WalkAreaComponent)
+	{
+		UE_LOG(LogAdventureGame, Display, TEXT("UWalkPathManager::CompareWalkArea - %s has no walk area"),
+			*CurrentLevelName.ToString());
+		return;
+	}
+	const FWalkArea& WalkArea = WalkAreaComponent->GetWalkArea();
+	const AAIController* Controller = nullptr;
+	ANavigationData* NavData = FindPlayerNavData(NavigationSystem, Registry, Controller);
+
+	// The same pairs of points for both, inside the walk area and at the character's height
+	const double Z = Controller && Controller->GetPawn() ? Controller->GetPawn()->GetNavAgentLocation().Z
+		: WalkAreaComponent->GetComponentLocation().Z;
+	const FBox2D Bounds = WalkArea.GetBounds();
+	FRandomStream Random(Queries);
+	TArray<FVector> Points;
+	while (Points.Num() < Queries * 2)
+	{
+		const FVector2D Point(Random.FRandRange(Bounds.Min.X, Bounds.Max.X), Random.FRandRange(Bounds.Min.Y, Bounds.Max.Y));
+		if (WalkArea.Contains(Point)) Points.Add(FVector(Point, Z));
+	}
+
+	TArray<FVector2D> WalkAreaPath;
+	int32 WalkAreaFound = 0;
+	double Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Points.Num(); i += 2)
+	{
+		WalkAreaFound += WalkArea.FindPath(FVector2D(Points[i]), FVector2D(Points[i + 1]), WalkAreaPath);
+	}
+	const double WalkAreaMs = (FPlatformTime::Seconds() - Start) * 1000.0 / Queries;
+
+	if (!NavData)
+	{
+		UE_LOG(LogAdventureGame, Display, TEXT("UWalkPathManager::CompareWalkArea - %s walk area %d/%d paths, %.4f ms per path, %llu bytes, no navigation data to compare with"),
+			*CurrentLevelName.ToString(), WalkAreaFound, Queries, WalkAreaMs, static_cast<uint64>(WalkArea.GetAllocatedSize()));
+		return;
+	}
+	const FSharedConstNavQueryFilter Filter = UNavigationQueryFilter::GetQueryFilter(*NavData, Controller,
+		Controller->GetDefaultNavigationFilterClass());
+	TArray<FVector> NavigationPath;
+	int32 NavigationFound = 0;
+	Start = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Points.Num(); i += 2)
+	{
+		NavigationFound += FindNavigationPath(*NavigationSystem,
+			FPathFindingQuery(Controller, *NavData, Points[i], Points[i + 1], Filter), NavigationPath);
+	}
+	const double NavigationMs = (FPlatformTime::Seconds() - Start) * 1000.0 / Queries;
+
+	// The navigation data is for every room loaded, not just this one
+	UE_LOG(LogAdventureGame, Display, TEXT("UWalkPathManager::CompareWalkArea - %s, %d queries: walk area %d paths, %.4f ms per path, %llu bytes (%d corners, %d links); navigation %d paths, %.4f ms per path, %llu bytes for the loaded rooms"),
+		*CurrentLevelName.ToString(), Queries,
+		WalkAreaFound, WalkAreaMs, static_cast<uint64>(WalkArea.GetAllocatedSize()), WalkArea.GetNodeCount(), WalkArea.GetLinkCount(),
+		NavigationFound, NavigationMs, static_cast<uint64>(NavData->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal)));
+}
+
+void UWalkPathManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	NavigationDirtyHandle = UNavigationSystemV1::NavigationDirtyEvent.AddUObject(this, &UWalkPathManager::OnNavigationDirty);
+}
+
+void UWalkPathManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// The streaming manager outlives the world, so this is removed again in Deinitialize
+	if (URoomStreamingManager* RoomStreaming = GetRoomStreaming())
+	{
+		RoomEvictedHandle = RoomStreaming->RoomEvicted.AddUObject(this, &UWalkPathManager::ReleaseWalkGraph);
+	}
+}
+
+void UWalkPathManager::Deinitialize()
+{
+	UNavigationSystemV1::NavigationDirtyEvent.Remove(NavigationDirtyHandle);
+	if (URoomStreamingManager* RoomStreaming = GetRoomStreaming())
+	{
+		RoomStreaming->RoomEvicted.Remove(RoomEvictedHandle);
+	}
+	UE_LOG(LogAdventureGame, Log, TEXT("UWalkPathManager::Deinitialize - %s"), *Cache.GetStats().ToString());
+	Super::Deinitialize();
+}
+
+bool UWalkPathManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWalkPathManager::OnNavigationDirty(const FBox& Bounds)
+{
+	Cache.Invalidate(Bounds);
+}
+
+void UWalkPathManager::ReleaseWalkGraph(FName LevelName)
+{
+	Cache.ReleaseGraph(LevelName);
+	if (LevelName == CurrentLevelName)
+	{
+		CurrentLevelName = NAME_None;
+	}
+}
+
+URoomStreamingManager* UWalkPathManager::GetRoomStreaming() const
+{
+	const UAdventureGameInstance* AdventureGameInstance = Cast<UAdventureGameInstance>(GetWorld()->GetGameInstance());
+	return AdventureGameInstance ? AdventureGameInstance->GetRoomStreaming() : nullptr;
+}
@@ -0,0 +1,69 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PathQueryCache.h"
+#include "NavigationData.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "WalkPathManager.generated.h"
+
+class URoomStreamingManager;
+
+/**
+ * Paths for the player's walks, from the current room's walk graph or a cache
+ * of recent queries, before going to the navigation system. The AI controller
+ * asks here in place of making its own path query, so walks still go through
+ * MoveToLocation and path following as before.
+ *
+ * Cached paths are dropped when the navigation under them is dirtied, eg by a
+ * nav modifier or an obstacle being moved, and a room's paths and walk graph
+ * when the room streaming manager unloads it.
+ */
+UCLASS()
+class ADVENTUREGAME_API UWalkPathManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	static UWalkPathManager* Get(const UObject* WorldContextObject);
+
+	/// Find the paths between the walk-to positions of all the room's hotspots,
+	/// doors included, for the player character. Called when play starts in the
+	/// room, and makes it the room later queries are for.
+	void BuildWalkGraph(FName LevelName);
+
+	/// The path for a move request, or null if there is none.
+	FNavPathSharedPtr FindPath(const FPathFindingQuery& Query);
+
+	const FPathQueryCache& GetCache() const { return Cache; }
+
+	/// Log the time for paths between random points in the current room's walk
+	/// area, found by it and by the navigation system, and the memory each uses.
+	void CompareWalkArea(int32 Queries) const;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void OnNavigationDirty(const FBox& Bounds);
+
+	void ReleaseWalkGraph(FName LevelName);
+
+	URoomStreamingManager* GetRoomStreaming() const;
+
+	FPathQueryCache Cache;
+
+	/// The room queries are for, from the last walk graph built.
+	FName CurrentLevelName;
+
+	FDelegateHandle NavigationDirtyHandle;
+
+	FDelegateHandle RoomEvictedHandle;
+};
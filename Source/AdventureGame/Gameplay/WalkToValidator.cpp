@@ -0,0 +1,298 @@
+// (c) 2025 Sarah Smith
+
+
+#include "WalkToValidator.h"
+
+#include "WalkAreaComponent.h"
+
+#include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/HotSpots/Door.h"
+#include "AdventureGame/HotSpots/HotSpot.h"
+
+#include "Async/ParallelFor.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "NavigationData.h"
+
+/// Walk-to positions are moved to the player's height in play, so look well
+/// above and below them for the floor.
+static const FVector ProjectionExtent(16.0, 16.0, 512.0);
+
+static double PathLength(const TArray<FVector>& Points)
+{
+	double Length = 0.0;
+	for (int32 i = 1; i < Points.Num(); ++i)
+	{
+		Length += FVector::Distance(Points[i - 1], Points[i]);
+	}
+	return Length;
+}
+
+int32 FWalkToReport::NumUnreachable() const
+{
+	int32 Count = 0;
+	for (const FWalkToResult& Result : Results)
+	{
+		Count += !Result.IsReachable();
+	}
+	return Count;
+}
+
+void FWalkToValidator::Validate(const TArray<FWalkToTarget>& Targets, FProjector Project, FSolver Solve,
+	FWalkToReport& OutReport) const
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const FString LevelName = OutReport.LevelName.ToString();
+	OutReport.Results.SetNum(Targets.Num());
+
+	TArray<FVector> Projected;
+	Projected.SetNum(Targets.Num());
+	ParallelFor(Targets.Num(), [&](int32 Index)
+	{
+		const FWalkToTarget& Target = Targets[Index];
+		FWalkToResult& Result = OutReport.Results[Index];
+		Result.ActorName = Target.ActorName;
+		Result.bIsDoor = Target.bIsDoor;
+		if (Project(Target.WalkToPosition, Projected[Index]))
+		{
+			Result.OffWalkableDistance = FVector2D::Distance(FVector2D(Target.WalkToPosition), FVector2D(Projected[Index]));
+			Result.bOnWalkable = Result.OffWalkableDistance <= MaxOffWalkableDistance;
+		}
+		// Doors face the way the player comes in, not at the door
+		if (!Target.bIsDoor)
+		{
+			const double Offset = Target.Location.X - Target.WalkToPosition.X;
+			Result.bFacingAway = (Target.FacingDirection == EWalkDirection::Left && Offset >= FacingTolerance)
+				|| (Target.FacingDirection == EWalkDirection::Right && Offset <= -FacingTolerance);
+		}
+	});
+
+	TArray<int32> Doors;
+	for (int32 Index = 0; Index < Targets.Num(); ++Index)
+	{
+		if (Targets[Index].bIsDoor && OutReport.Results[Index].bOnWalkable) Doors.Add(Index);
+	}
+	if (Doors.IsEmpty())
+	{
+		// Eg the starting room of a game with one room, so walk from the first hotspot instead
+		const int32 First = OutReport.Results.IndexOfByPredicate([](const FWalkToResult& Result) { return Result.bOnWalkable; });
+		if (First != INDEX_NONE) Doors.Add(First);
+		OutReport.Warnings.Add(FString::Printf(TEXT("%s: no doors on the walkable area, walks checked from %s"),
+			*LevelName, First != INDEX_NONE ? *Targets[First].ActorName.ToString() : TEXT("nowhere")));
+	}
+
+	// Every walk from a door to a target, found in parallel
+	TArray<TPair<int32, int32>> Walks;
+	for (const int32 Door : Doors)
+	{
+		for (int32 Index = 0; Index < Targets.Num(); ++Index)
+		{
+			if (Index != Door && OutReport.Results[Index].bOnWalkable) Walks.Emplace(Door, Index);
+		}
+	}
+	TArray<double> WalkLengths;
+	WalkLengths.Init(-1.0, Walks.Num());
+	ParallelFor(Walks.Num(), [&](int32 Walk)
+	{
+		TArray<FVector> Points;
+		if (Solve(Projected[Walks[Walk].Key], Projected[Walks[Walk].Value], Points))
+		{
+			WalkLengths[Walk] = PathLength(Points);
+		}
+	});
+	for (int32 Walk = 0; Walk < Walks.Num(); ++Walk)
+	{
+		FWalkToResult& Result = OutReport.Results[Walks[Walk].Value];
+		if (WalkLengths[Walk] < 0.0)
+		{
+			Result.UnreachableFrom.Add(Targets[Walks[Walk].Key].ActorName);
+		}
+		else
+		{
+			Result.LongestWalk = FMath::Max(Result.LongestWalk, WalkLengths[Walk]);
+		}
+	}
+
+	for (int32 Index = 0; Index < Targets.Num(); ++Index)
+	{
+		const FWalkToTarget& Target = Targets[Index];
+		const FWalkToResult& Result = OutReport.Results[Index];
+		if (!Result.bOnWalkable)
+		{
+			OutReport.Errors.Add(Result.OffWalkableDistance < 0.0
+				? FString::Printf(TEXT("%s: %s walk to position %s is not near anywhere walkable"),
+					*LevelName, *Target.ActorName.ToString(), *Target.WalkToPosition.ToCompactString())
+				: FString::Printf(TEXT("%s: %s walk to position %s is %.1f off the walkable area"),
+					*LevelName, *Target.ActorName.ToString(), *Target.WalkToPosition.ToCompactString(),
+					Result.OffWalkableDistance));
+		}
+		else if (!Result.UnreachableFrom.IsEmpty())
+		{
+			OutReport.Errors.Add(FString::Printf(TEXT("%s: %s walk to position %s cannot be reached from %s"),
+				*LevelName, *Target.ActorName.ToString(), *Target.WalkToPosition.ToCompactString(),
+				*FString::JoinBy(Result.UnreachableFrom, TEXT(", "), [](const FName& Name) { return Name.ToString(); })));
+		}
+		if (Result.bFacingAway)
+		{
+			OutReport.Warnings.Add(FString::Printf(TEXT("%s: %s faces %s, away from the hotspot at %s"),
+				*LevelName, *Target.ActorName.ToString(), *UEnum::GetDisplayValueAsText(Target.FacingDirection).ToString(),
+				*Target.Location.ToCompactString()));
+		}
+	}
+	OutReport.Seconds = FPlatformTime::Seconds() - StartTime;
+}
+
+bool FWalkToValidator::LoadNavigation(const FString& PersistentLevelPackageName)
+{
+	PersistentNavData.Reset();
+	UPackage* Package = LoadPackage(nullptr, *PersistentLevelPackageName, LOAD_None);
+	const UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (World && World->PersistentLevel)
+	{
+		for (AActor* Actor : World->PersistentLevel->Actors)
+		{
+			if (ANavigationData* NavData = Cast<ANavigationData>(Actor))
+			{
+				PersistentNavData.Reset(NavData);
+				break;
+			}
+		}
+	}
+	if (!PersistentNavData)
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("FWalkToValidator::LoadNavigation - no navigation data in %s"), *PersistentLevelPackageName);
+		return false;
+	}
+	return true;
+}
+
+bool FWalkToValidator::ValidateLevel(const FString& LevelPackageName, FWalkToReport& OutReport) const
+{
+	UPackage* Package = LoadPackage(nullptr, *LevelPackageName, LOAD_None);
+	const UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	OutReport.LevelName = FName(FPackageName::GetShortName(LevelPackageName));
+	if (!World || !World->PersistentLevel)
+	{
+		OutReport.Errors.Add(FString::Printf(TEXT("%s: could not be loaded"), *LevelPackageName));
+		return false;
+	}
+
+	// Components of a level that is not in a world are not registered, so work
+	// out their world transforms from the relative ones before reading them
+	TArray<FWalkToTarget> Targets;
+	UWalkAreaComponent* WalkArea = nullptr;
+	const ANavigationData* NavData = nullptr;
+	for (AActor* Actor : World->PersistentLevel->Actors)
+	{
+		if (!Actor) continue;
+		if (const AHotSpot* HotSpot = Cast<AHotSpot>(Actor))
+		{
+			HotSpot->WalkToPoint->UpdateComponentToWorld();
+			FWalkToTarget& Target = Targets.AddDefaulted_GetRef();
+			Target.ActorName = FName(HotSpot->GetActorNameOrLabel());
+			Target.Location = HotSpot->GetRootComponent()->GetComponentLocation();
+			Target.WalkToPosition = HotSpot->WalkToPoint->GetComponentLocation();
+			Target.FacingDirection = HotSpot->FacingDirection;
+			Target.bIsDoor = Actor->IsA<ADoor>();
+		}
+		else if (const ANavigationData* ActorNavData = Cast<ANavigationData>(Actor))
+		{
+			if (!NavData) NavData = ActorNavData;
+		}
+		if (UWalkAreaComponent* ActorWalkArea = Actor->FindComponentByClass<UWalkAreaComponent>())
+		{
+			ActorWalkArea->UpdateComponentToWorld();
+			ActorWalkArea->Rebuild();
+			WalkArea = ActorWalkArea;
+		}
+	}
+
+	if (!NavData)
+	{
+		// Rooms are streamed into the persistent level, which has the navigation data
+		NavData = PersistentNavData.Get();
+	}
+
+	if (WalkArea && !WalkArea->GetWalkArea().IsEmpty())
+	{
+		// The player walks on the walk area in rooms that have one
+		OutReport.WalkableSource = TEXT("walk area");
+		const FWalkArea& Area = WalkArea->GetWalkArea();
+		Validate(Targets,
+			[&Area](const FVector& Point, FVector& OutProjected)
+			{
+				OutProjected = FVector(Area.ClampToArea(FVector2D(Point)), Point.Z);
+				return true;
+			},
+			[WalkArea](const FVector& Start, const FVector& End, TArray<FVector>& OutPoints)
+			{
+				return WalkArea->FindPath(Start, End, OutPoints);
+			}, OutReport);
+	}
+	else if (NavData)
+	{
+		OutReport.WalkableSource = NavData->GetName();
+		Validate(Targets,
+			[NavData](const FVector& Point, FVector& OutProjected)
+			{
+				FNavLocation Location;
+				if (!NavData->ProjectPoint(Point, Location, ProjectionExtent)) return false;
+				OutProjected = Location.Location;
+				return true;
+			},
+			[NavData](const FVector& Start, const FVector& End, TArray<FVector>& OutPoints)
+			{
+				FPathFindingQuery Query(nullptr, *NavData, Start, End);
+				// A partial path stops short of the hotspot, which is what is being looked for
+				Query.SetAllowPartialPaths(false);
+				const FPathFindingResult Result = NavData->FindPath(NavData->GetConfig(), Query);
+				if (!Result.IsSuccessful() || Result.IsPartial() || !Result.Path.IsValid()) return false;
+				OutPoints.Reset(Result.Path->GetPathPoints().Num());
+				for (const FNavPathPoint& Point : Result.Path->GetPathPoints())
+				{
+					OutPoints.Add(Point.Location);
+				}
+				return true;
+			}, OutReport);
+	}
+	else if (!Targets.IsEmpty())
+	{
+		OutReport.Errors.Add(FString::Printf(TEXT("%s: %d hotspots but no walk area, and no navigation data in it or the persistent level"),
+			*OutReport.LevelName.ToString(), Targets.Num()));
+		return false;
+	}
+	UE_LOG(LogAdventureGame, Display, TEXT("FWalkToValidator - %s: %d hotspots and doors on %s, %d unreachable, %d warnings in %.1f ms"),
+		*OutReport.LevelName.ToString(), Targets.Num(), *OutReport.WalkableSource, OutReport.NumUnreachable(),
+		OutReport.Warnings.Num(), OutReport.Seconds * 1000.0);
+	return true;
+}
+
+FString FWalkToValidator::ToCsv(const TArray<FWalkToReport>& Reports)
+{
+	FString Csv = TEXT("Level,Walkable,Actor,Door,OffWalkable,Reachable,LongestWalk,UnreachableFrom,FacingAway\n");
+	for (const FWalkToReport& Report : Reports)
+	{
+		for (const FWalkToResult& Result : Report.Results)
+		{
+			Csv += FString::Printf(TEXT("%s,%s,%s,%d,%.1f,%d,%.1f,%s,%d\n"),
+				*Report.LevelName.ToString(), *Report.WalkableSource, *Result.ActorName.ToString(),
+				Result.bIsDoor ? 1 : 0, Result.OffWalkableDistance, Result.IsReachable() ? 1 : 0, Result.LongestWalk,
+				*FString::JoinBy(Result.UnreachableFrom, TEXT(" "), [](const FName& Name) { return Name.ToString(); }),
+				Result.bFacingAway ? 1 : 0);
+		}
+	}
+	return Csv;
+}
+
+bool FWalkToValidator::SaveCsv(const TArray<FWalkToReport>& Reports, const FString& FilePath)
+{
+	if (!FFileHelper::SaveStringToFile(ToCsv(Reports), *FilePath))
+	{
+		UE_LOG(LogAdventureGame, Warning, TEXT("FWalkToValidator::SaveCsv - could not write %s"), *FilePath);
+		return false;
+	}
+	UE_LOG(LogAdventureGame, Display, TEXT("FWalkToValidator::SaveCsv - %d rooms written to %s"), Reports.Num(), *FilePath);
+	return true;
+}
@@ -0,0 +1,127 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AdventureGame/Enums/WalkDirection.h"
+#include "UObject/StrongObjectPtr.h"
+
+class ANavigationData;
+
+/// A hotspot or door as placed in a room.
+struct FWalkToTarget
+{
+	/// Name of the actor in its level, for reports.
+	FName ActorName;
+
+	/// Where the hotspot itself is, to check the player faces it on arrival.
+	FVector Location = FVector::ZeroVector;
+
+	FVector WalkToPosition = FVector::ZeroVector;
+
+	EWalkDirection FacingDirection = EWalkDirection::Down;
+
+	/// Doors are where the player comes into the room, so every other target is
+	/// walked to from each of them.
+	bool bIsDoor = false;
+};
+
+/// What was found for one target.
+struct FWalkToResult
+{
+	FName ActorName;
+
+	bool bIsDoor = false;
+
+	/// How far the walk-to position is from the nearest walkable point, across
+	/// the floor, or -1 if there is none.
+	double OffWalkableDistance = -1.0;
+
+	/// Near enough the walkable area to be walked to.
+	bool bOnWalkable = false;
+
+	/// Length of the longest walk to it from a door.
+	double LongestWalk = 0.0;
+
+	/// Doors it cannot be walked to from.
+	TArray<FName> UnreachableFrom;
+
+	/// The facing direction turns the player's back on the hotspot.
+	bool bFacingAway = false;
+
+	bool IsReachable() const { return bOnWalkable && UnreachableFrom.IsEmpty(); }
+};
+
+/// Everything found for one room.
+struct ADVENTUREGAME_API FWalkToReport
+{
+	FName LevelName;
+
+	/// What walks were checked against, the navigation data or a walk area.
+	FString WalkableSource;
+
+	TArray<FWalkToResult> Results;
+
+	/// Targets that cannot be walked to.
+	TArray<FString> Errors;
+
+	/// Targets that can be walked to but look wrong, eg facing away.
+	TArray<FString> Warnings;
+
+	double Seconds = 0.0;
+
+	int32 NumUnreachable() const;
+};
+
+/**
+ * Checks that the player can walk to every hotspot in a room, rather than finding
+ * out in play from a failed move. Every walk-to position, doors included, is
+ * projected onto the walkable area, and walked to from each door the player can
+ * enter the room by. The facing direction of each hotspot is checked against
+ * where the hotspot is.
+ *
+ * ValidateLevel loads a level headlessly and checks it against its UWalkAreaComponent
+ * if it has one, or else the navigation data. Rooms only have bounds volumes, the
+ * navigation data is built into the persistent level, so load that first with
+ * LoadNavigation. Run over every room by the
+ * AdventureGame.Gameplay.WalkToLevels automation test, or
+ * <code>UnrealEditor-Cmd AdventureGame.uproject -run=RoomGraph -CheckWalkTo</code>
+ */
+class ADVENTUREGAME_API FWalkToValidator
+{
+public:
+	/// The nearest walkable point to a point, false if there is none near it.
+	using FProjector = TFunctionRef<bool(const FVector& Point, FVector& OutProjected)>;
+
+	/// The path between two walkable points, false if there is none.
+	using FSolver = TFunctionRef<bool(const FVector& Start, const FVector& End, TArray<FVector>& OutPoints)>;
+
+	/// Further than this from the walkable area and a walk-to position cannot be reached.
+	double MaxOffWalkableDistance = 16.0;
+
+	/// A hotspot this far or more the other side of the player to the way they
+	/// face on arrival has their back to it.
+	double FacingTolerance = 8.0;
+
+	/// Check the targets of a room. The projector and solver are called from
+	/// several threads at once, so must only read what they are checking against.
+	void Validate(const TArray<FWalkToTarget>& Targets, FProjector Project, FSolver Solve, FWalkToReport& OutReport) const;
+
+	/// Load the navigation data of the persistent level the rooms are streamed into,
+	/// and keep it for the rooms that have none of their own. False if it has none.
+	bool LoadNavigation(const FString& PersistentLevelPackageName);
+
+	/// Load the level with the long package name and check its hotspots and doors.
+	/// Returns false if the level could not be loaded, or has nothing to walk on.
+	bool ValidateLevel(const FString& LevelPackageName, FWalkToReport& OutReport) const;
+
+	/// One row per target of each report.
+	static FString ToCsv(const TArray<FWalkToReport>& Reports);
+
+	/// Write ToCsv to a file. Returns false if it could not be written.
+	static bool SaveCsv(const TArray<FWalkToReport>& Reports, const FString& FilePath);
+
+private:
+	/// Navigation data of the persistent level, kept loaded while rooms are loaded and collected.
+	TStrongObjectPtr<ANavigationData> PersistentNavData;
+};
@@ -0,0 +1,103 @@
+#include "ActorStateTestActor.h"
+#include "AdventureGame/Gameplay/ActorStateBaseline.h"
+#include "AdventureGame/Gameplay/DataSaveRecord.h"
+
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(ActorStateTest, "AdventureGame.Gameplay.ActorStateTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// A busy room - well above what any of the current rooms have.
+constexpr int32 GActorsPerRoom = 500;
+
+/// Spawn the room's actors and give them per placement values, as the level
+/// would when it is streamed in. These differ from the class defaults.
+static void SpawnRoom(UWorld* World, TArray<AActorStateTestActor*>& Actors)
+{
+    Actors.Reset(GActorsPerRoom);
+    for (int32 i = 0; i < GActorsPerRoom; ++i)
+    {
+        AActorStateTestActor* Actor = World->SpawnActor<AActorStateTestActor>(FVector(i * 10.0f, 0.0f, 0.0f),
+            FRotator::ZeroRotator);
+        Actor->Inscription = FString::Printf(TEXT("Placed %d"), i);
+        Actor->FlipbookFrame = i % 4;
+        Actors.Add(Actor);
+    }
+}
+
+bool ActorStateTest::RunTest(const FString& Parameters)
+{
+    // This will get cleaned up when it leaves scope
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+
+    if (!World) return false;
+    WorldWrapper.BeginPlayInTestWorld();
+
+    TArray<AActorStateTestActor*> Actors;
+    SpawnRoom(World, Actors);
+
+    TArray<TUniquePtr<FActorStateBaseline>> Baselines;
+    for (const AActorStateTestActor* Actor : Actors)
+    {
+        Baselines.Add(MakeUnique<FActorStateBaseline>(Actor));
+    }
+
+    // Gameplay changes every other actor, and moves every tenth one
+    for (int32 i = 0; i < GActorsPerRoom; i += 2)
+    {
+        Actors[i]->bLeverPulled = true;
+        Actors[i]->FlipbookFrame = 7;
+        Actors[i]->TransientCounter = 99;
+        if (i % 10 == 0)
+        {
+            Actors[i]->SetActorLocation(FVector(i * 10.0f, 50.0f, 0.0f));
+        }
+    }
+
+    TArray<FDataSaveRecord> Records;
+    Records.SetNum(GActorsPerRoom);
+    for (int32 i = 0; i < GActorsPerRoom; ++i)
+    {
+        Baselines[i]->CaptureDelta(Actors[i], Records[i]);
+        if (i % 2 == 1)
+        {
+            TestTrue(TEXT("Unchanged actor stores no properties"), Records[i].PropertyValues.IsEmpty());
+            TestFalse(TEXT("Unchanged actor stores no transform"), Records[i].bTransformChanged);
+        }
+        else
+        {
+            TestEqual(TEXT("Changed actor stores only the changed properties"), Records[i].PropertyValues.Num(), 2);
+            TestEqual(TEXT("Moved actor stores transform"), Records[i].bTransformChanged, i % 10 == 0);
+        }
+    }
+
+    // Unload the room and stream it back in again
+    for (AActorStateTestActor* Actor : Actors)
+    {
+        Actor->Destroy();
+    }
+    Baselines.Reset();
+    SpawnRoom(World, Actors);
+
+    for (int32 i = 0; i < GActorsPerRoom; ++i)
+    {
+        Baselines.Add(MakeUnique<FActorStateBaseline>(Actors[i]));
+        FActorStateBaseline::RestoreDelta(Actors[i], Records[i]);
+    }
+
+    for (int32 i = 0; i < GActorsPerRoom; ++i)
+    {
+        const bool bChanged = i % 2 == 0;
+        TestEqual(TEXT("Lever restored"), Actors[i]->bLeverPulled, bChanged);
+        TestEqual(TEXT("Frame restored"), Actors[i]->FlipbookFrame, bChanged ? 7 : i % 4);
+        TestEqual(TEXT("Level placed value kept"), Actors[i]->Inscription, FString::Printf(TEXT("Placed %d"), i));
+        TestEqual(TEXT("Non SaveGame property not restored"), Actors[i]->TransientCounter, 0);
+        const float ExpectedY = bChanged && i % 10 == 0 ? 50.0f : 0.0f;
+        TestEqual(TEXT("Position restored"), static_cast<float>(Actors[i]->GetActorLocation().Y), ExpectedY);
+    }
+
+    return true;
+}
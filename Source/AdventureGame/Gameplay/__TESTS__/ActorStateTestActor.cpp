@@ -0,0 +1,12 @@
+// (c) 2025 Sarah Smith
+
+
+#include "ActorStateTestActor.h"
+
+#include "Components/SceneComponent.h"
+
+AActorStateTestActor::AActorStateTestActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
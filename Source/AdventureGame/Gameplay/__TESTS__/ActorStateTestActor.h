@@ -0,0 +1,37 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+
+#include "ActorStateTestActor.generated.h"
+
+/**
+ * Stand in for a hotspot blueprint with some custom variables marked SaveGame,
+ * and one that is not, so the actor state capture can be tested without needing
+ * a streamed level, player pawn and game instance.
+ */
+UCLASS(NotBlueprintable)
+class AActorStateTestActor : public AActor
+{
+    GENERATED_BODY()
+public:
+    AActorStateTestActor();
+
+    UPROPERTY(SaveGame)
+    int32 FlipbookFrame = 0;
+
+    UPROPERTY(SaveGame)
+    bool bLeverPulled = false;
+
+    UPROPERTY(SaveGame)
+    FString Inscription = TEXT("Level default");
+
+    UPROPERTY(SaveGame)
+    FVector Offset = FVector::ZeroVector;
+
+    /// Not flagged SaveGame so must never be captured.
+    UPROPERTY()
+    int32 TransientCounter = 0;
+};
@@ -0,0 +1,134 @@
+#include "AdventureGame/Gameplay/HotSpotSpatialIndex.h"
+#include "AdventureGame/HotSpots/HotSpotHitMask.h"
+
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HotSpotSpatialIndexTest, "AdventureGame.Gameplay.HotSpotSpatialIndex",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// Rows, and columns, of hotspots in a dense room - far more than any of the current rooms have.
+constexpr int32 GHotSpotRows = 20;
+
+constexpr int32 GHotSpotsPerRoom = GHotSpotRows * GHotSpotRows;
+
+/// Points along each side of the room that the mouse is moved to, resolved with
+/// both the index and the trace.
+constexpr int32 GQueryRows = 70;
+
+/// Room is this big in X and Y.
+constexpr double GRoomSize = 2000.0;
+
+static AStaticMeshActor* SpawnHotSpot(UWorld* World, UStaticMesh* Cube, const FVector& Location, const FVector& Scale)
+{
+    // Static, like the hotspots placed in a level, so given its transform as it is spawned
+    AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(),
+        FTransform(FRotator::ZeroRotator, Location, Scale));
+    UStaticMeshComponent* Mesh = Actor->GetStaticMeshComponent();
+    Mesh->SetStaticMesh(Cube);
+    Mesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    Mesh->SetCollisionResponseToAllChannels(ECR_Block);
+    return Actor;
+}
+
+static AStaticMeshActor* SpawnHotSpot(UWorld* World, UStaticMesh* Cube, int32 Index)
+{
+    // In rows, each overlapping the ones next to it but for the narrow ones that leave
+    // gaps between them, and each a little higher than the last, so that the one on top
+    // is never a tie. The engine cube is 100 units across, the same as the spacing.
+    const double Spacing = GRoomSize / GHotSpotRows;
+    const FVector Location((Index % GHotSpotRows + 0.5) * Spacing, (Index / GHotSpotRows + 0.5) * Spacing, Index * 2.0);
+    const FVector Scale(Index % 3 == 0 ? 0.6 : 1.6, Index % 4 == 0 ? 0.6 : 1.6, 0.01);
+    return SpawnHotSpot(World, Cube, Location, Scale);
+}
+
+static AActor* TraceAt(const UWorld* World, const FVector2D& Point)
+{
+    FHitResult Hit;
+    World->LineTraceSingleByChannel(Hit, FVector(Point, 10000.0), FVector(Point, -10000.0), ECC_Visibility);
+    return Hit.IsValidBlockingHit() ? Hit.GetActor() : nullptr;
+}
+
+static AActor* IndexAt(const FHotSpotSpatialIndex& Index, const FVector2D& Point)
+{
+    FHotSpotHit Hit;
+    return Index.FindAt(Point, [](UPrimitiveComponent*) { return true; }, Hit) ? Hit.Component->GetOwner() : nullptr;
+}
+
+bool HotSpotSpatialIndexTest::RunTest(const FString& Parameters)
+{
+    // Masks are worked out without a world
+    FHotSpotHitMask Mask;
+    Mask.Init(2, 2, FBox2D(FVector2D(-1.0, -1.0), FVector2D(1.0, 1.0)));
+    Mask.Set(0, 0);
+    TestTrue(TEXT("Mask top left is set"), Mask.Contains(FVector2D(-0.5, 0.5)));
+    TestFalse(TEXT("Mask bottom left is clear"), Mask.Contains(FVector2D(-0.5, -0.5)));
+    TestFalse(TEXT("Mask outside its bounds"), Mask.Contains(FVector2D(2.0, 0.5)));
+
+    UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+    if (!TestNotNull(TEXT("Engine cube mesh"), Cube)) return false;
+
+    // This will get cleaned up when it leaves scope
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+
+    if (!World) return false;
+    WorldWrapper.BeginPlayInTestWorld();
+
+    FHotSpotSpatialIndex Index;
+    TArray<AStaticMeshActor*> HotSpots;
+    for (int32 i = 0; i < GHotSpotsPerRoom; ++i)
+    {
+        HotSpots.Add(SpawnHotSpot(World, Cube, i));
+        Index.Add(HotSpots.Last()->GetStaticMeshComponent());
+    }
+    // Let the physics scene take up the new bodies before tracing against it
+    WorldWrapper.TickTestWorld(0.016f);
+    TestEqual(TEXT("All indexed"), Index.Num(), GHotSpotsPerRoom);
+
+    // Points over the whole room, in overlaps, on single hotspots and in the gaps
+    TArray<FVector2D> Points;
+    const double QuerySpacing = GRoomSize / GQueryRows;
+    for (int32 Row = 0; Row < GQueryRows; ++Row)
+    {
+        for (int32 Column = 0; Column < GQueryRows; ++Column)
+        {
+            Points.Add(FVector2D((Column + 0.5) * QuerySpacing, (Row + 0.5) * QuerySpacing));
+        }
+    }
+
+    int32 Mismatches = 0;
+    int32 Hits = 0;
+    for (const FVector2D& Point : Points)
+    {
+        const AActor* Indexed = IndexAt(Index, Point);
+        Mismatches += TraceAt(World, Point) != Indexed;
+        Hits += Indexed != nullptr;
+    }
+    TestEqual(TEXT("Index finds the same hotspot as the trace"), Mismatches, 0);
+    TestTrue(TEXT("Some points are between hotspots"), Hits > 0 && Hits < Points.Num());
+
+    // Priority beats height, and removed or non blocking hotspots are not found
+    const FVector2D Point(GRoomSize / 2.0, GRoomSize / 2.0);
+    AStaticMeshActor* Low = SpawnHotSpot(World, Cube, FVector(Point, -20.0), FVector(1.0, 1.0, 0.01));
+    Index.Add(Low->GetStaticMeshComponent(), 1);
+    TestEqual(TEXT("Higher priority wins"), IndexAt(Index, Point), static_cast<AActor*>(Low));
+    Low->GetStaticMeshComponent()->SetCollisionResponseToChannel(ECC_Visibility, ECR_Ignore);
+    TestNotEqual(TEXT("Not blocking visibility"), IndexAt(Index, Point), static_cast<AActor*>(Low));
+    Low->GetStaticMeshComponent()->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
+    Index.Remove(Low->GetStaticMeshComponent());
+    TestNotEqual(TEXT("Removed"), IndexAt(Index, Point), static_cast<AActor*>(Low));
+
+    // A hotspot destroyed before its component is removed is still removed by its key
+    const int32 IndexedCount = Index.Num();
+    const TObjectKey<UPrimitiveComponent> Destroyed(Low->GetStaticMeshComponent());
+    Index.Add(Low->GetStaticMeshComponent(), 1);
+    Low->Destroy();
+    Index.Remove(Destroyed);
+    TestEqual(TEXT("Destroyed component removed"), Index.Num(), IndexedCount);
+
+    return true;
+}
@@ -0,0 +1,157 @@
+#include "AdventureGame/Gameplay/PathQueryCache.h"
+
+#include "Algo/Reverse.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(PathQueryCacheTest, "AdventureGame.Gameplay.PathQueryCache",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// Room is this big in X and Y, walked on a grid of this many cells each way.
+constexpr double GRoomSize = 2048.0;
+
+constexpr int32 GGridSize = 128;
+
+constexpr int32 GHotSpotsPerRoom = 12;
+
+/// Commands in the scripted session, each a walk from wherever the player is.
+constexpr int32 GCommands = 1000;
+
+/// Breadth first search over the grid, with a wall across the middle of the
+/// room that has a gap at one end, standing in for the navigation system.
+static bool SolveOnGrid(const FVector& Start, const FVector& End, TArray<FVector>& OutPoints)
+{
+    const double CellSize = GRoomSize / GGridSize;
+    auto ToCell = [CellSize](const FVector& Location)
+    {
+        return FIntPoint(FMath::Clamp(FMath::FloorToInt32(Location.X / CellSize), 0, GGridSize - 1),
+            FMath::Clamp(FMath::FloorToInt32(Location.Y / CellSize), 0, GGridSize - 1));
+    };
+    auto IsBlocked = [](const FIntPoint& Cell) { return Cell.Y == GGridSize / 2 && Cell.X > GGridSize / 8; };
+
+    const FIntPoint From = ToCell(Start);
+    const FIntPoint To = ToCell(End);
+    if (IsBlocked(From) || IsBlocked(To)) return false;
+
+    TArray<int32> Previous;
+    Previous.Init(INDEX_NONE, GGridSize * GGridSize);
+    TArray<FIntPoint> Frontier = { From };
+    Previous[From.Y * GGridSize + From.X] = From.Y * GGridSize + From.X;
+    for (int32 Next = 0; Next < Frontier.Num() && Frontier[Next] != To; ++Next)
+    {
+        const FIntPoint Cell = Frontier[Next];
+        for (const FIntPoint Step : { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) })
+        {
+            const FIntPoint Neighbour = Cell + Step;
+            if (Neighbour.X < 0 || Neighbour.Y < 0 || Neighbour.X >= GGridSize || Neighbour.Y >= GGridSize) continue;
+            int32& Visited = Previous[Neighbour.Y * GGridSize + Neighbour.X];
+            if (Visited != INDEX_NONE || IsBlocked(Neighbour)) continue;
+            Visited = Cell.Y * GGridSize + Cell.X;
+            Frontier.Add(Neighbour);
+        }
+    }
+    if (Previous[To.Y * GGridSize + To.X] == INDEX_NONE) return false;
+
+    OutPoints.Reset();
+    for (int32 Index = To.Y * GGridSize + To.X; ; Index = Previous[Index])
+    {
+        OutPoints.Add(FVector((Index % GGridSize + 0.5) * CellSize, (Index / GGridSize + 0.5) * CellSize, 0.0));
+        if (Previous[Index] == Index) break;
+    }
+    Algo::Reverse(OutPoints);
+    OutPoints[0] = Start;
+    OutPoints.Last() = End;
+    return true;
+}
+
+bool PathQueryCacheTest::RunTest(const FString& Parameters)
+{
+    const FName Room(TEXT("TestRoom"));
+
+    // Hotspots in two rows, one each side of the wall, so half the walks between
+    // them go round through the gap
+    TArray<FVector> WalkToPositions;
+    for (int32 i = 0; i < GHotSpotsPerRoom; ++i)
+    {
+        WalkToPositions.Add(FVector((i / 2 + 0.5) * GRoomSize * 2.0 / GHotSpotsPerRoom,
+            (i % 2 ? 0.75 : 0.25) * GRoomSize, 0.0));
+    }
+    // A few places on the floor the player keeps going back to
+    const TArray<FVector> FavouriteSpots = {
+        FVector(100.0, 100.0, 0.0), FVector(1900.0, 300.0, 0.0),
+        FVector(1000.0, 1500.0, 0.0), FVector(300.0, 1800.0, 0.0)
+    };
+
+    // A scripted session going round the hotspots in turn, back to a favourite spot
+    // every fifth command, and clicking somewhere new on the floor every twentieth
+    TArray<FVector> Targets;
+    for (int32 i = 0; i < GCommands; ++i)
+    {
+        if (i % 20 == 19)
+        {
+            FVector Location(FMath::Fmod(i * 37.0, GRoomSize), FMath::Fmod(i * 53.0, GRoomSize), 0.0);
+            // Keep off the wall
+            if (FMath::Abs(Location.Y - GRoomSize / 2.0) < 32.0) Location.Y += 64.0;
+            Targets.Add(Location);
+        }
+        else if (i % 5 == 4)
+        {
+            Targets.Add(FavouriteSpots[i / 5 % FavouriteSpots.Num()]);
+        }
+        else
+        {
+            Targets.Add(WalkToPositions[i * 5 % GHotSpotsPerRoom]);
+        }
+    }
+
+    // Every walk found by the solver, as now
+    TArray<FVector> Points;
+    FVector Position = WalkToPositions[0];
+    int32 Solved = 0;
+    for (const FVector& Target : Targets)
+    {
+        Solved += SolveOnGrid(Position, Target, Points);
+        Position = Target;
+    }
+
+    FPathQueryCache Cache;
+    Cache.BuildGraph(Room, WalkToPositions, SolveOnGrid);
+    TestEqual(TEXT("Graph has a path each way between each pair"), Cache.GetGraphPathCount(Room),
+        GHotSpotsPerRoom * (GHotSpotsPerRoom - 1));
+
+    Position = WalkToPositions[0];
+    int32 Found = 0;
+    int32 Mismatches = 0;
+    TArray<FVector> Expected;
+    for (const FVector& Target : Targets)
+    {
+        Found += Cache.FindPath(Room, Position, Target, SolveOnGrid, Points);
+        // Ends are exact, and the path is the same length as the solver's, give or take a cell
+        SolveOnGrid(Position, Target, Expected);
+        Mismatches += !Points[0].Equals(Position) || !Points.Last().Equals(Target)
+            || FMath::Abs(Points.Num() - Expected.Num()) > 2;
+        Position = Target;
+    }
+    const FPathQueryStats& Stats = Cache.GetStats();
+    TestEqual(TEXT("Same walks found as with the solver"), Found, Solved);
+    TestEqual(TEXT("Cached paths match the solver"), Mismatches, 0);
+    TestTrue(TEXT("Most walks come from the graph or cache"), Stats.GetHitRate() > 0.5f);
+    TestTrue(TEXT("Cache stays within its limit"), Cache.Num() <= 128);
+
+    // Dirtying the navigation around one hotspot drops the paths through it, and only those
+    const int32 GraphPaths = Cache.GetGraphPathCount(Room);
+    Cache.Invalidate(FBox(WalkToPositions[1] - FVector(8.0), WalkToPositions[1] + FVector(8.0)));
+    TestTrue(TEXT("Paths through the dirty area dropped"), Cache.GetGraphPathCount(Room) <= GraphPaths - 2 * (GHotSpotsPerRoom - 1));
+    TestTrue(TEXT("Paths elsewhere kept"), Cache.GetGraphPathCount(Room) > 0);
+    const int32 Misses = Cache.GetStats().Misses;
+    TestTrue(TEXT("Dropped graph path found again"), Cache.FindPath(Room, WalkToPositions[0], WalkToPositions[1], SolveOnGrid, Points));
+    TestEqual(TEXT("by the solver"), Cache.GetStats().Misses, Misses + 1);
+    Cache.FindPath(Room, WalkToPositions[0], WalkToPositions[1], SolveOnGrid, Points);
+    TestEqual(TEXT("and kept in the graph"), Cache.GetStats().Misses, Misses + 1);
+
+    // Unloading the room drops its graph and its cached paths
+    Cache.ReleaseGraph(Room);
+    TestEqual(TEXT("Released room has no graph"), Cache.GetGraphPathCount(Room), 0);
+    TestEqual(TEXT("or cached paths"), Cache.Num(), 0);
+
+    return true;
+}
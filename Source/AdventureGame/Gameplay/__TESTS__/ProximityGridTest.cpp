@@ -0,0 +1,142 @@
+#include "AdventureGame/Gameplay/ProximityGrid.h"
+
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(ProximityGridTest, "AdventureGame.Gameplay.ProximityGrid",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// Triggers along each side of a dense room - far more than any of the current rooms have.
+constexpr int32 GTriggerRows = 20;
+
+constexpr int32 GTriggersPerRoom = GTriggerRows * GTriggerRows;
+
+/// Triggers are a cube's width apart, so the larger ones overlap their neighbours.
+constexpr double GTriggerSpacing = 100.0;
+
+constexpr double GRoomSize = GTriggerRows * GTriggerSpacing;
+
+/// How far the player walks in a frame.
+constexpr double GStepLength = 4.0;
+
+static AStaticMeshActor* SpawnCube(UWorld* World, UStaticMesh* Cube, const FVector& Location, const FVector& Scale)
+{
+    AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(),
+        FTransform(FRotator::ZeroRotator, Location, Scale));
+    Actor->GetStaticMeshComponent()->SetStaticMesh(Cube);
+    return Actor;
+}
+
+bool ProximityGridTest::RunTest(const FString& Parameters)
+{
+    // Enter and exit are reported once, when the point crosses the edge
+    {
+        FProximityGrid Grid(100.0);
+        const int32 Circle = Grid.AddCircle(nullptr, FVector2D(50.0, 50.0), 40.0);
+        const int32 Region = Grid.AddRegion(nullptr, FBox2D(FVector2D(80.0, 0.0), FVector2D(300.0, 100.0)));
+        TArray<int32> Entered, Exited;
+
+        Grid.Update(FVector2D(-100.0, 50.0), Entered, Exited);
+        TestTrue(TEXT("Starting outside enters nothing"), Entered.IsEmpty() && Exited.IsEmpty());
+        Grid.Update(FVector2D(50.0, 50.0), Entered, Exited);
+        TestTrue(TEXT("Circle entered"), Entered.Num() == 1 && Entered[0] == Circle);
+        Entered.Reset();
+        Grid.Update(FVector2D(60.0, 50.0), Entered, Exited);
+        TestTrue(TEXT("Moving inside enters nothing again"), Entered.IsEmpty() && Exited.IsEmpty());
+        Grid.Update(FVector2D(85.0, 50.0), Entered, Exited);
+        TestTrue(TEXT("Overlapping triggers, region entered"), Entered.Num() == 1 && Entered[0] == Region);
+        Entered.Reset();
+        Grid.Update(FVector2D(250.0, 50.0), Entered, Exited);
+        TestTrue(TEXT("Circle left from another cell"), Exited.Num() == 1 && Exited[0] == Circle);
+        TestTrue(TEXT("Still in the region across cells"), Grid.IsInside(Region));
+        Exited.Reset();
+        Grid.Remove(Region);
+        Grid.Update(FVector2D(250.0, 50.0), Entered, Exited);
+        TestTrue(TEXT("Removed trigger is not left"), Entered.IsEmpty() && Exited.IsEmpty());
+        TestEqual(TEXT("One trigger left"), Grid.Num(), 1);
+    }
+
+    UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+    if (!TestNotNull(TEXT("Engine cube mesh"), Cube)) return false;
+
+    // This will get cleaned up when it leaves scope
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+
+    if (!World) return false;
+    WorldWrapper.BeginPlayInTestWorld();
+
+    FProximityGrid Grid;
+    for (int32 i = 0; i < GTriggersPerRoom; ++i)
+    {
+        // The engine cube is 100 units across, so some are smaller than the spacing and some spill over
+        const FVector Location((i % GTriggerRows + 0.5) * GTriggerSpacing, (i / GTriggerRows + 0.5) * GTriggerSpacing, 0.0);
+        AStaticMeshActor* HotSpot = SpawnCube(World, Cube, Location,
+            FVector(i % 3 ? 0.4 : 1.6, i % 5 ? 0.7 : 2.2, 1.0));
+
+        // Every other one a radius around its walk to point, the rest its bounds
+        if (i % 2)
+        {
+            Grid.AddCircle(HotSpot, FVector2D(Location), 20.0 + (i % 7) * 20.0);
+        }
+        else
+        {
+            const FBox Box = HotSpot->GetStaticMeshComponent()->Bounds.GetBox();
+            Grid.AddRegion(HotSpot, FBox2D(FVector2D(Box.Min), FVector2D(Box.Max)));
+        }
+    }
+    TestEqual(TEXT("All added"), Grid.Num(), GTriggersPerRoom);
+
+    // The player walks from the middle of the room back and forth between every other
+    // pair of rows, crossing the edges of the triggers either side, then diagonally back
+    TArray<FVector> Waypoints;
+    for (int32 Row = 0; Row < GTriggerRows; Row += 2)
+    {
+        const double Y = (Row + 1) * GTriggerSpacing;
+        Waypoints.Add(FVector(Row % 4 ? GRoomSize : 0.0, Y, 0.0));
+        Waypoints.Add(FVector(Row % 4 ? 0.0 : GRoomSize, Y, 0.0));
+    }
+    Waypoints.Add(FVector(GRoomSize / 2.0, 0.0, 0.0));
+
+    TArray<FVector> Walk;
+    FVector Position(GRoomSize / 2.0, GRoomSize / 2.0, 0.0);
+    for (const FVector& Waypoint : Waypoints)
+    {
+        while (FVector::Dist2D(Position, Waypoint) > UE_KINDA_SMALL_NUMBER)
+        {
+            Position += (Waypoint - Position).GetSafeNormal2D() * FMath::Min(GStepLength, FVector::Dist2D(Position, Waypoint));
+            Walk.Add(Position);
+        }
+    }
+
+    // Brute force over every trigger is the reference for the grid's events
+    TArray<bool> Expected;
+    Expected.SetNumZeroed(GTriggersPerRoom);
+    TArray<int32> Entered, Exited;
+    int32 Mismatches = 0;
+    int32 Enters = 0;
+    for (const FVector& Step : Walk)
+    {
+        Entered.Reset();
+        Exited.Reset();
+        Grid.Update(FVector2D(Step), Entered, Exited);
+
+        Enters += Entered.Num();
+        for (int32 Handle = 0; Handle < GTriggersPerRoom; ++Handle)
+        {
+            const bool bInside = Grid.Find(Handle)->Contains(FVector2D(Step));
+            const bool bChanged = bInside != Expected[Handle];
+            Mismatches += bChanged != (bInside ? Entered.Contains(Handle) : Exited.Contains(Handle));
+            Mismatches += bInside != Grid.IsInside(Handle);
+            Expected[Handle] = bInside;
+        }
+    }
+    TestEqual(TEXT("Grid events match testing every trigger"), Mismatches, 0);
+    TestTrue(TEXT("Walk crossed into triggers along every row"), Enters > GTriggerRows * GTriggerRows / 4);
+    TestTrue(TEXT("and across cells"), Grid.GetCellChangeCount() > Waypoints.Num());
+
+    return true;
+}
@@ -0,0 +1,57 @@
+#include "AdventureGame/Gameplay/RoomGraph.h"
+
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(RoomGraphTest, "AdventureGame.Gameplay.RoomGraphTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+static void AddDoor(URoomGraph* Graph, FName LevelName, FName DoorLabel, FName LevelToLoad)
+{
+    FRoomGraphDoor& Door = Graph->Doors.AddDefaulted_GetRef();
+    Door.LevelName = LevelName;
+    Door.DoorLabel = DoorLabel;
+    Door.LevelToLoad = LevelToLoad;
+    Door.ActorName = FName(FString::Printf(TEXT("Door_%s_%s"), *LevelName.ToString(), *DoorLabel.ToString()));
+}
+
+bool RoomGraphTest::RunTest(const FString& Parameters)
+{
+    URoomGraph* Graph = NewObject<URoomGraph>();
+
+    // Exterior <-> Interior is a good pair, Interior -> Cellar has no door back
+    // labelled B1, and Attic can only be left, never entered.
+    AddDoor(Graph, "Exterior", "A1", "Interior");
+    AddDoor(Graph, "Interior", "A1", "Exterior");
+    AddDoor(Graph, "Interior", "B1", "Cellar");
+    AddDoor(Graph, "Cellar", "B2", "Interior");
+    AddDoor(Graph, "Cellar", "B2", "Interior");
+    AddDoor(Graph, "Attic", "A1", "Exterior");
+
+    TArray<FString> Errors;
+    TArray<FString> Warnings;
+    Graph->Build("Exterior", Errors, Warnings);
+
+    TestEqual(TEXT("Rooms"), Graph->Rooms.Num(), 4);
+    TestNotNull(TEXT("Door pair resolves"), Graph->FindDoor("Interior", "A1"));
+    TestEqual(TEXT("Destination of exterior door"), Graph->FindDestination(*Graph->FindDoor("Exterior", "A1"))->LevelName,
+        FName("Interior"));
+    TestNull(TEXT("Unknown label"), Graph->FindDoor("Exterior", "Z9"));
+
+    // Cellar B1 is missing (dangling), both of the cellar's B2 doors lead to a
+    // missing Interior B2, and B2 is used twice in the cellar.
+    TestEqual(TEXT("Errors"), Errors.Num(), 4);
+    TestTrue(TEXT("Duplicate label reported"), Errors.ContainsByPredicate([](const FString& Error)
+    {
+        return Error.Contains(TEXT("both have label B2"));
+    }));
+    TestTrue(TEXT("Dangling door reported"), Errors.ContainsByPredicate([](const FString& Error)
+    {
+        return Error.Contains(TEXT("no door labelled B1"));
+    }));
+
+    TestEqual(TEXT("Warnings"), Warnings.Num(), 1);
+    TestFalse(TEXT("Attic unreachable"), Graph->FindRoom("Attic")->bReachable);
+    TestTrue(TEXT("Cellar reachable"), Graph->FindRoom("Cellar")->bReachable);
+
+    return true;
+}
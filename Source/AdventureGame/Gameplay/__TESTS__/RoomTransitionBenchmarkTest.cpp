@@ -0,0 +1,183 @@
+#include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/Gameplay/AdventureGameInstance.h"
+#include "AdventureGame/Gameplay/AdventureWorldRegistry.h"
+#include "AdventureGame/Gameplay/RoomTransitionStats.h"
+#include "AdventureGame/HotSpots/Door.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(RoomTransitionBenchmarkTest, "AdventureGame.Gameplay.RoomTransitionBenchmark",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// Persistent map the rooms are streamed into, as in the packaged game.
+static const TCHAR* GBenchmarkMap = TEXT("/Game/PointAndClick/Levels/AdventureData");
+
+/// Rooms to walk through, in order. Each hop uses a door in the current room that
+/// leads to the next room, and an entry that is the current room is skipped.
+static const FName GDoorCircuit[] = {
+    "TowerInterior", "TowerExterior", "TowerInterior", "TowerExterior", "TowerInterior", "TowerExterior"
+};
+
+/// How far a step's median can go over its baseline before the test fails.
+constexpr double GBaselineTolerance = 1.5;
+
+/// Longest to wait for the game to start, or for any one transition to complete.
+constexpr double GTransitionTimeout = 30.0;
+
+static UAdventureGameInstance* GetGameInstance()
+{
+    for (const FWorldContext& Context : GEngine->GetWorldContexts())
+    {
+        if ((Context.WorldType == EWorldType::PIE || Context.WorldType == EWorldType::Game) && Context.World())
+        {
+            return Cast<UAdventureGameInstance>(Context.World()->GetGameInstance());
+        }
+    }
+    return nullptr;
+}
+
+static double Median(TArray<double> Values)
+{
+    if (Values.IsEmpty()) return 0.0;
+    Values.Sort();
+    return Values[Values.Num() / 2];
+}
+
+/// Steps to check, and the baseline milliseconds of those that have been measured,
+/// from the CSV stored next to this test.
+static bool LoadBaselines(TArray<FName>& Steps, TMap<FName, double>& Baselines)
+{
+    const FString BaselinePath = FPaths::Combine(FPaths::GameSourceDir(),
+        TEXT("AdventureGame/Gameplay/__TESTS__/RoomTransitionBaseline.csv"));
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *BaselinePath)) return false;
+    for (const FString& Line : Lines)
+    {
+        FString Step, Milliseconds;
+        if (Line.StartsWith(TEXT("#")) || !Line.Split(TEXT(","), &Step, &Milliseconds)) continue;
+        if (Step == TEXT("Step")) continue;
+        Steps.Add(FName(Step.TrimStartAndEnd()));
+        Milliseconds.TrimStartAndEndInline();
+        if (!Milliseconds.IsEmpty() && Milliseconds.IsNumeric())
+        {
+            Baselines.Add(Steps.Last(), FCString::Atod(*Milliseconds));
+        }
+    }
+    return !Steps.IsEmpty();
+}
+
+/// Walks the door circuit one hop at a time, waiting for each transition to be
+/// logged (which includes the unload of the old room) before the next one.
+class FRoomCircuitCommand : public IAutomationLatentCommand
+{
+public:
+    explicit FRoomCircuitCommand(FAutomationTestBase* InTest) : Test(InTest) {}
+
+    virtual bool Update() override
+    {
+        const UAdventureGameInstance* GameInstance = GetGameInstance();
+        const bool bRoomCurrent = GameInstance
+            && GameInstance->GetRoomTransitionPhase() == ERoomTransitionPhase::RoomCurrent
+            && GameInstance->GetRoomTransitionLog().Num() == HopsTaken;
+        if (!bRoomCurrent)
+        {
+            if (FPlatformTime::Seconds() - WaitStartTime > GTransitionTimeout)
+            {
+                Test->AddError(FString::Printf(TEXT("Timed out waiting for hop %d of the door circuit"), HopsTaken));
+                return true;
+            }
+            return false;
+        }
+
+        while (NextRoom < UE_ARRAY_COUNT(GDoorCircuit) && GDoorCircuit[NextRoom] == GameInstance->CurrentLevelName)
+        {
+            ++NextRoom;
+        }
+        if (NextRoom == UE_ARRAY_COUNT(GDoorCircuit))
+        {
+            CheckAgainstBaselines(GameInstance->GetRoomTransitionLog());
+            return true;
+        }
+
+        ADoor* Door = FindDoorTo(GameInstance, GDoorCircuit[NextRoom]);
+        if (!Door)
+        {
+            Test->AddError(FString::Printf(TEXT("No door in %s leads to %s"),
+                *GameInstance->CurrentLevelName.ToString(), *GDoorCircuit[NextRoom].ToString()));
+            return true;
+        }
+        ++NextRoom;
+        ++HopsTaken;
+        WaitStartTime = FPlatformTime::Seconds();
+        UAdventureGameInstance::LoadRoom(Door);
+        return false;
+    }
+
+private:
+    static ADoor* FindDoorTo(const UAdventureGameInstance* GameInstance, FName LevelName)
+    {
+        const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(GameInstance->GetWorld());
+        if (!Registry) return nullptr;
+        TArray<ADoor*> Doors;
+        Registry->GetDoorsInLevel(GameInstance->CurrentLevelName, Doors);
+        ADoor** Found = Doors.FindByPredicate([LevelName](const ADoor* Door) { return Door->LevelToLoad == LevelName; });
+        return Found ? *Found : nullptr;
+    }
+
+    void CheckAgainstBaselines(const FRoomTransitionLog& Log) const
+    {
+        Log.SaveCsv(FPaths::Combine(FPaths::AutomationDir(), TEXT("RoomTransitionBenchmark.csv")));
+
+        TArray<FName> Steps;
+        TMap<FName, double> Baselines;
+        if (!LoadBaselines(Steps, Baselines))
+        {
+            Test->AddError(TEXT("Could not read RoomTransitionBaseline.csv"));
+            return;
+        }
+        for (const FName Step : Steps)
+        {
+            TArray<double> Milliseconds;
+            for (const FRoomTransitionStats& Stats : Log.GetTransitions())
+            {
+                Milliseconds.Add(1000.0 * (Step == "DoorLatency" ? Stats.DoorLatency : Stats.GetStepSeconds(Step)));
+            }
+            const double Measured = Median(Milliseconds);
+            const double* Baseline = Baselines.Find(Step);
+            if (!Baseline)
+            {
+                Test->AddWarning(FString::Printf(TEXT("%s median %.3f ms has no baseline to check against, record it in RoomTransitionBaseline.csv"),
+                    *Step.ToString(), Measured));
+                continue;
+            }
+            UE_LOG(LogAdventureGame, Display, TEXT("RoomTransitionBenchmark - %s median %.3f ms, baseline %.3f ms"),
+                *Step.ToString(), Measured, *Baseline);
+            if (Measured > *Baseline * GBaselineTolerance)
+            {
+                Test->AddError(FString::Printf(TEXT("%s median %.3f ms is over its %.3f ms baseline"),
+                    *Step.ToString(), Measured, *Baseline));
+            }
+        }
+    }
+
+    FAutomationTestBase* Test;
+
+    int32 NextRoom = 0;
+
+    int32 HopsTaken = 0;
+
+    double WaitStartTime = FPlatformTime::Seconds();
+};
+
+bool RoomTransitionBenchmarkTest::RunTest(const FString& Parameters)
+{
+    // Run headless with -nullrhi, eg from the command line with
+    // -ExecCmds="Automation RunTests AdventureGame.Gameplay.RoomTransitionBenchmark;Quit"
+    AutomationOpenMap(GBenchmarkMap);
+    ADD_LATENT_AUTOMATION_COMMAND(FRoomCircuitCommand(this));
+    ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+    return true;
+}
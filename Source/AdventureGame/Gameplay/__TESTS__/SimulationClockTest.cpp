@@ -0,0 +1,46 @@
+#include "AdventureGame/Gameplay/SimulationClock.h"
+
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(SimulationClockTest, "AdventureGame.Gameplay.SimulationClockTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool SimulationClockTest::RunTest(const FString& Parameters)
+{
+    if (FSimulationClock::IsFastForward())
+    {
+        AddInfo(TEXT("Already running in fast forward, skipped"));
+        return true;
+    }
+    const bool bUseFixedTimeStep = FApp::UseFixedTimeStep();
+    const double FixedDeltaTime = FApp::GetFixedDeltaTime();
+
+    TestEqual(TEXT("Waits are real time in normal play"), FSimulationClock::GetWait(5.0f), 5.0f);
+
+    FSimulationClock::SetFastForward(true);
+    TestTrue(TEXT("Fast forward runs at a fixed time step"), FApp::UseFixedTimeStep());
+
+    // Bark lines, the user interaction debounce, a fake interaction and an item timeout
+    const TArray<float> Waits = { 0.1f, 0.6f, 1.0f, 5.0f, 20.0f };
+    float Previous = 0.0f;
+    for (const float Seconds : Waits)
+    {
+        const float Wait = FSimulationClock::GetWait(Seconds);
+        TestTrue(FString::Printf(TEXT("Wait of %.1f s is not zero"), Seconds), Wait > 0.0f);
+        TestTrue(FString::Printf(TEXT("Wait of %.1f s is over within a frame"), Seconds),
+            Wait < FSimulationClock::GetFixedStep());
+        TestTrue(FString::Printf(TEXT("Wait of %.1f s ends after the shorter ones"), Seconds), Wait > Previous);
+        Previous = Wait;
+    }
+    TestEqual(TEXT("No wait stays no wait"), FSimulationClock::GetWait(0.0f), 0.0f);
+
+    // Waits shorter than a frame, eg a few ms between two lines, still end in order
+    TestTrue(TEXT("Short waits keep their order"), FSimulationClock::GetWait(0.001f) < FSimulationClock::GetWait(0.005f));
+    TestTrue(TEXT("Very short waits too"), FSimulationClock::GetWait(0.0001f) < FSimulationClock::GetWait(0.001f));
+
+    FSimulationClock::SetFastForward(false);
+    TestEqual(TEXT("Time step put back"), FApp::UseFixedTimeStep(), bUseFixedTimeStep);
+    TestEqual(TEXT("Fixed delta time put back"), FApp::GetFixedDeltaTime(), FixedDeltaTime);
+    return true;
+}
@@ -0,0 +1,86 @@
+#include "AdventureGame/Gameplay/WalkArea.h"
+
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(WalkAreaTest, "AdventureGame.Gameplay.WalkArea",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+static double PathLength(const TArray<FVector2D>& Points)
+{
+    double Length = 0.0;
+    for (int32 i = 1; i < Points.Num(); ++i)
+    {
+        Length += FVector2D::Distance(Points[i - 1], Points[i]);
+    }
+    return Length;
+}
+
+bool WalkAreaTest::RunTest(const FString& Parameters)
+{
+    // A room with a wall sticking down into it from the back, between x 400
+    // and 600, and a table and a chest to walk round
+    const TArray<FVector2D> Outline = {
+        { 0.0, 0.0 }, { 1000.0, 0.0 }, { 1000.0, 600.0 }, { 600.0, 600.0 },
+        { 600.0, 300.0 }, { 400.0, 300.0 }, { 400.0, 600.0 }, { 0.0, 600.0 }
+    };
+    const TArray<TArray<FVector2D>> Holes = {
+        { { 150.0, 100.0 }, { 250.0, 100.0 }, { 250.0, 200.0 }, { 150.0, 200.0 } },
+        { { 750.0, 100.0 }, { 750.0, 250.0 }, { 850.0, 250.0 }, { 850.0, 100.0 } }
+    };
+    FWalkArea WalkArea;
+    WalkArea.Build(Outline, Holes);
+    TestEqual(TEXT("Corners of the wall and the holes only"), WalkArea.GetNodeCount(), 10);
+    TestTrue(TEXT("Table is not walkable"), !WalkArea.Contains(FVector2D(200.0, 150.0)));
+    TestTrue(TEXT("Behind the wall is not walkable"), !WalkArea.Contains(FVector2D(500.0, 500.0)));
+
+    TArray<FVector2D> Points;
+    TestTrue(TEXT("Path along the front"), WalkArea.FindPath(FVector2D(50.0, 50.0), FVector2D(950.0, 50.0), Points));
+    TestEqual(TEXT("is a straight line"), Points.Num(), 2);
+
+    const FVector2D Left(100.0, 500.0);
+    const FVector2D Right(900.0, 500.0);
+    TestTrue(TEXT("Cannot see through the wall"), !WalkArea.IsVisible(Left, Right));
+    TestTrue(TEXT("Path round the wall"), WalkArea.FindPath(Left, Right, Points));
+    TestTrue(TEXT("bends round it"), Points.Num() > 2);
+    TestTrue(TEXT("starts and ends at the ends"), Points[0].Equals(Left) && Points.Last().Equals(Right));
+    for (int32 i = 1; i < Points.Num(); ++i)
+    {
+        TestTrue(FString::Printf(TEXT("Path line %d is walkable"), i), WalkArea.IsVisible(Points[i - 1], Points[i]));
+    }
+    // Down to the end of the wall, along it and back up again, keeping close to its corners
+    const double Shortest = 2.0 * FVector2D::Distance(Left, FVector2D(400.0, 300.0)) + 200.0;
+    TestTrue(TEXT("is the shortest way round"), PathLength(Points) < Shortest + 10.0);
+
+    TestTrue(TEXT("Path to behind the wall"), WalkArea.FindPath(Left, FVector2D(500.0, 500.0), Points));
+    TestTrue(TEXT("ends at the nearest walkable point"), WalkArea.Contains(Points.Last())
+        && FVector2D::Distance(Points.Last(), FVector2D(500.0, 500.0)) < 105.0);
+
+    // Every pair of points on a grid over the room, off the edges of the wall and
+    // the holes, has a path that is walkable all the way and no shorter than a
+    // straight line between them
+    TArray<FVector2D> Grid;
+    for (double X = 75.0; X < 1000.0; X += 100.0)
+    {
+        for (double Y = 75.0; Y < 600.0; Y += 100.0)
+        {
+            if (WalkArea.Contains(FVector2D(X, Y))) Grid.Emplace(X, Y);
+        }
+    }
+    int32 Unwalkable = 0;
+    for (int32 From = 0; From < Grid.Num(); ++From)
+    {
+        for (int32 To = From + 1; To < Grid.Num(); ++To)
+        {
+            const bool bFound = WalkArea.FindPath(Grid[From], Grid[To], Points);
+            bool bWalkable = bFound && PathLength(Points) >= FVector2D::Distance(Grid[From], Grid[To]) - 0.001;
+            for (int32 i = 1; bWalkable && i < Points.Num(); ++i)
+            {
+                bWalkable = WalkArea.IsVisible(Points[i - 1], Points[i]);
+            }
+            Unwalkable += !bWalkable;
+        }
+    }
+    TestEqual(TEXT("Walkable path between every two grid points"), Unwalkable, 0);
+
+    return true;
+}
@@ -0,0 +1,104 @@
+#include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/Commandlets/RoomGraphCommandlet.h"
+#include "AdventureGame/Gameplay/WalkToValidator.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(WalkToValidatorTest, "AdventureGame.Gameplay.WalkToValidator",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(WalkToLevelsTest, "AdventureGame.Gameplay.WalkToLevels",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+static FWalkToTarget MakeTarget(const TCHAR* Name, const FVector& Location, const FVector& WalkToPosition,
+    EWalkDirection FacingDirection = EWalkDirection::Down, bool bIsDoor = false)
+{
+    FWalkToTarget Target;
+    Target.ActorName = FName(Name);
+    Target.Location = Location;
+    Target.WalkToPosition = WalkToPosition;
+    Target.FacingDirection = FacingDirection;
+    Target.bIsDoor = bIsDoor;
+    return Target;
+}
+
+bool WalkToValidatorTest::RunTest(const FString& Parameters)
+{
+    // A room 1000 by 600, cut in two by a wall at x 500 with no way through
+    auto Project = [](const FVector& Point, FVector& OutProjected)
+    {
+        OutProjected = FVector(FMath::Clamp(Point.X, 0.0, 1000.0), FMath::Clamp(Point.Y, 0.0, 600.0), Point.Z);
+        return true;
+    };
+    auto Solve = [](const FVector& Start, const FVector& End, TArray<FVector>& OutPoints)
+    {
+        if ((Start.X < 500.0) != (End.X < 500.0)) return false;
+        OutPoints = { Start, End };
+        return true;
+    };
+
+    TArray<FWalkToTarget> Targets = {
+        MakeTarget(TEXT("FrontDoor"), FVector(0.0, 300.0, 0.0), FVector(50.0, 300.0, 0.0), EWalkDirection::Right, true),
+        MakeTarget(TEXT("BackDoor"), FVector(200.0, 600.0, 0.0), FVector(200.0, 550.0, 0.0), EWalkDirection::Down, true),
+        MakeTarget(TEXT("Table"), FVector(300.0, 200.0, 0.0), FVector(250.0, 200.0, 0.0), EWalkDirection::Right),
+        MakeTarget(TEXT("Cupboard"), FVector(800.0, 200.0, 0.0), FVector(750.0, 200.0, 0.0), EWalkDirection::Right),
+        MakeTarget(TEXT("Window"), FVector(200.0, 850.0, 0.0), FVector(200.0, 800.0, 0.0), EWalkDirection::Up),
+        MakeTarget(TEXT("Clock"), FVector(300.0, 400.0, 0.0), FVector(350.0, 400.0, 0.0), EWalkDirection::Right),
+    };
+    FWalkToReport Report;
+    Report.LevelName = FName(TEXT("TestRoom"));
+    const FWalkToValidator Validator;
+    Validator.Validate(Targets, Project, Solve, Report);
+
+    TestEqual(TEXT("Result for each target"), Report.Results.Num(), Targets.Num());
+    TestTrue(TEXT("Table can be walked to"), Report.Results[2].IsReachable());
+    TestEqual(TEXT("from the farthest door"), Report.Results[2].LongestWalk, FVector::Distance(Targets[1].WalkToPosition, Targets[2].WalkToPosition));
+    TestEqual(TEXT("Cupboard is behind the wall from both doors"), Report.Results[3].UnreachableFrom.Num(), 2);
+    TestFalse(TEXT("Window is off the floor"), Report.Results[4].bOnWalkable);
+    TestEqual(TEXT("by"), Report.Results[4].OffWalkableDistance, 200.0);
+    TestTrue(TEXT("Clock has its back to the player"), Report.Results[5].bFacingAway);
+    TestFalse(TEXT("Table does not"), Report.Results[2].bFacingAway);
+    TestEqual(TEXT("Unreachable"), Report.NumUnreachable(), 2);
+    TestEqual(TEXT("Error for each unreachable"), Report.Errors.Num(), 2);
+    TestEqual(TEXT("Warning for facing away"), Report.Warnings.Num(), 1);
+
+    const FString Csv = FWalkToValidator::ToCsv({ Report });
+    TestTrue(TEXT("Report has the failing actors"), Csv.Contains(TEXT("TestRoom,,Cupboard,0,0.0,0,0.0,FrontDoor BackDoor,0")));
+
+    return true;
+}
+
+bool WalkToLevelsTest::RunTest(const FString& Parameters)
+{
+    TArray<FString> Levels;
+    URoomGraphCommandlet::FindLevels(URoomGraphCommandlet::DefaultLevelsPath, false, Levels);
+
+    FWalkToValidator Validator;
+    TestTrue(TEXT("Persistent level has navigation"), Validator.LoadNavigation(URoomGraphCommandlet::GetPersistentLevel()));
+    TestFalse(TEXT("Persistent level is not a room"), Levels.Contains(URoomGraphCommandlet::GetPersistentLevel()));
+    TArray<FWalkToReport> Reports;
+    for (const FString& Level : Levels)
+    {
+        FWalkToReport& Report = Reports.AddDefaulted_GetRef();
+        Validator.ValidateLevel(Level, Report);
+        for (const FString& Error : Report.Errors)
+        {
+            AddError(Error);
+        }
+        for (const FString& Warning : Report.Warnings)
+        {
+            AddWarning(Warning);
+        }
+    }
+    FWalkToValidator::SaveCsv(Reports, FPaths::Combine(FPaths::ProfilingDir(), TEXT("WalkToLevelsTest.csv")));
+
+    int32 Unreachable = 0;
+    for (const FWalkToReport& Report : Reports)
+    {
+        Unreachable += Report.NumUnreachable();
+    }
+    AddInfo(FString::Printf(TEXT("%d rooms checked, %d hotspots unreachable"), Reports.Num(), Unreachable));
+
+    return true;
+}
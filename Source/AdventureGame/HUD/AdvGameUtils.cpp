@@ -3,6 +3,8 @@
 #include "AdventureGame/Constants.h"
 #include "AdventureGame/HotSpots/HotSpot.h"
 #include "AdventureGame/Items/InventoryItem.h"
+#include "TextLayoutCache.h"
+#include "Engine/AssetManager.h"
 #include "Misc/Guid.h"
 
 #include "AdventureGame/AdventureGame.h"
@@ -92,6 +94,23 @@ FText AdvGameUtils::GetVerbWithHotSpotText(const AHotSpot* HotSpot, const EVerbT
     return FText::Format(LOCTABLE(ITEM_DESCRIPTIONS_KEY, G_VERB_SUBJECT_KEY), VerbArgs);
 }
 
+FText AdvGameUtils::GetHotSpotInteractionText(const AHotSpot* HotSpot, const EVerbType Verb,
+                                              const UInventoryItem* SourceItem)
+{
+    switch (Verb)
+    {
+    case EVerbType::UseItem:
+        return GetUsingItemText(SourceItem, nullptr, HotSpot);
+    case EVerbType::Give:
+        // Can't just give a hotspot - have to give _something_ to the hotspot - eg GiveItem
+        return LOCTABLE(ITEM_STRINGS_KEY, "GiveDefaultText");
+    case EVerbType::GiveItem:
+        return GetGivingItemText(SourceItem, nullptr, HotSpot);
+    default:
+        return GetVerbWithHotSpotText(HotSpot, Verb);
+    }
+}
+
 TArray<FText> AdvGameUtils::NewLineSeperatedToArrayText(const FText& NewText)
 {
     FString Line = NewText.ToString();
@@ -122,15 +141,15 @@ TArray<FString> AdvGameUtils::NewLineSeperatedToArrayString(const FString& NewSt
 TArray<FText> AdvGameUtils::WrapTextLinesToMaxCharacters(const FText& NewText, const int32 MaxLength)
 {
     TArray<FText> WrappedLines;
-    FString CurrentLine = NewText.ToString();
-    while (CurrentLine.Len() > MaxLength)
-    {
-        int32 SplitPoint = MaxLength;
-        while (CurrentLine[--SplitPoint] != ' ' && SplitPoint > 0) {}
-        if (SplitPoint < 0) SplitPoint = MaxLength; // Did not find a space to split at
-        WrappedLines.Add(FText::FromString(CurrentLine.Left(SplitPoint)));
-        CurrentLine = CurrentLine.Mid(SplitPoint).TrimStartAndEnd();
-    }
-    WrappedLines.Add(FText::FromString(CurrentLine));
+    FTextLayoutCache::WrapLine(NewText.ToString(), MaxLength, WrappedLines);
     return WrappedLines;
 }
+
+void AdvGameUtils::RequestMissingRoomAsset(const FSoftObjectPath& Path)
+{
+    if (Path.IsNull()) return;
+    UE_LOG(LogAdventureGame, Error, TEXT("%s is not in its room's manifest, rebuild the room graph with -run=RoomGraph"),
+        *Path.ToString());
+    UAssetManager::GetStreamableManager().RequestAsyncLoad(Path, FStreamableDelegate(),
+        FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("MissingRoomAsset"));
+}
@@ -99,6 +99,22 @@ struct AdvGameUtils
         const EVerbType Verb
     );
 
+    /**
+     * The interaction text for clicking a hotspot with the current verb, and
+     * the item held for UseItem and GiveItem, as the interaction UI shows it.
+     *
+     * Example: "Open door", "Use pen on brick wall"
+     * @param HotSpot HotSpot under the cursor, must be non-null
+     * @param Verb EVerbType  - what action is being performed
+     * @param SourceItem Item held by the player character, non-null for UseItem and GiveItem
+     * @return FText text to display
+     */
+    static FText GetHotSpotInteractionText(
+        const AHotSpot* HotSpot,
+        const EVerbType Verb,
+        const UInventoryItem* SourceItem
+    );
+
     /**
      * Create an array of texts, by splitting the given text on the
      * newline character "\n"
@@ -122,4 +138,23 @@ struct AdvGameUtils
      * @return Array of lines, all less than or equal to MaxLength
      */
     static TArray<FText> WrapTextLinesToMaxCharacters(const FText& NewText, const int32 MaxLength = 30);
+
+    /**
+     * Get a soft referenced asset used by a room. These are loaded along with the
+     * room from its manifest in the room graph, so the asset should already be in
+     * memory. If it was missed out of the manifest that is an error: it is logged so
+     * the manifest can be rebuilt, and the asset is requested at high priority, but
+     * nothing is loaded synchronously, so this call still returns null.
+     * @param Asset Soft reference to the asset
+     * @return The asset, or null if the reference is empty or the asset is not loaded
+     */
+    template <typename T>
+    static T* GetRoomAsset(const TSoftObjectPtr<T>& Asset)
+    {
+        if (T* Loaded = Asset.Get()) return Loaded;
+        RequestMissingRoomAsset(Asset.ToSoftObjectPath());
+        return nullptr;
+    }
+
+    static void RequestMissingRoomAsset(const FSoftObjectPath& Path);
 };
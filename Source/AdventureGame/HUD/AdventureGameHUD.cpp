@@ -10,6 +10,7 @@
 #include "AdvGameUtils.h"
 #include "AdventureGame/Gameplay/AdventureGameInstance.h"
 #include "AdventureGame/Gameplay/AdventureGameModeBase.h"
+#include "AdventureGame/Gameplay/AdventureWorldRegistry.h"
 #include "AdventureGame/HotSpots/HotSpot.h"
 #include "AdventureGame/Items/InventoryItem.h"
 
@@ -25,6 +26,11 @@ void UAdventureGameHUD::NativeOnInitialized()
         IsMobileTouch = true;
     }
 
+    if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+    {
+        Registry->RegisterHUD(this);
+    }
+
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("UAdventureGameHUD::NativeOnInitialized"));
 }
 
@@ -87,7 +93,7 @@ void UAdventureGameHUD::HideBlackScreen()
 
 void UAdventureGameHUD::SetInteractionText()
 {
-    const ACommandManager *Command = GetCommandManager();
+    ACommandManager *Command = GetCommandManager();
     const UItemManager *ItemManager = GetItemManager();
     if (!Command || !ItemManager) return;
     auto Verb = Command->CurrentVerb;
@@ -100,21 +106,11 @@ void UAdventureGameHUD::SetInteractionText()
     }
     if (AHotSpot *CurrentHotspot = Command->CurrentHotSpot)
     {
+        // A click on the hotspot the cursor rested on has its text formatted already
         FText InteractionText;
-        switch (Verb)
+        if (!Command->GetHoverPrefetch().FindClaimedText(CurrentHotspot, Verb, SourceItem, InteractionText))
         {
-        case EVerbType::UseItem:
-            InteractionText = AdvGameUtils::GetUsingItemText(SourceItem, nullptr, CurrentHotspot);
-            break;
-        case EVerbType::Give:
-            // Can't just give a hotspot - have to give _something_ to the hotspot - eg GiveItem
-            InteractionText = LOCTABLE(ITEM_STRINGS_KEY, "GiveDefaultText");
-            break;
-        case EVerbType::GiveItem:
-            InteractionText = AdvGameUtils::GetGivingItemText(SourceItem, nullptr, CurrentHotspot);
-            break;
-        default:
-            InteractionText = AdvGameUtils::GetVerbWithHotSpotText(CurrentHotspot, Verb);
+            InteractionText = AdvGameUtils::GetHotSpotInteractionText(CurrentHotspot, Verb, SourceItem);
         }
         InteractionUI->SetText(InteractionText);
         UE_LOG(LogAdventureGame, Log, TEXT("Set interaction text to: %s"), *InteractionText.ToString());
@@ -265,16 +261,22 @@ void UAdventureGameHUD::OnUserInteracted()
     Bark->OnUserInteracted();
 }
 
-void UAdventureGameHUD::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UAdventureGameHUD::NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    Super::NativeOnMouseEnter(InGeometry, InMouseEvent);
+    if (IsMobileTouch) return;
+    if (ACommandManager *Command = GetCommandManager())
+    {
+        Command->UpdateMouseOverUI(true);
+    }
+}
 
-    if (!IsMobileTouch)
+void UAdventureGameHUD::NativeOnMouseLeave(const FPointerEvent& InMouseEvent)
+{
+    Super::NativeOnMouseLeave(InMouseEvent);
+    if (IsMobileTouch) return;
+    if (ACommandManager *Command = GetCommandManager())
     {
-        if (ACommandManager *Command = GetCommandManager())
-        {
-            bool MouseIsOverUI = IsHovered();
-            Command->UpdateMouseOverUI(MouseIsOverUI);
-        }
+        Command->UpdateMouseOverUI(false);
     }
 }
@@ -28,7 +28,11 @@ class ADVENTUREGAME_API UAdventureGameHUD : public UUserWidget, public IItemMana
 {
 	GENERATED_BODY()
 public:
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	/// Tell the command manager when the mouse goes over or leaves the UI, so it can
+	/// switch the default verb between walking and looking.
+	virtual void NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+
+	virtual void NativeOnMouseLeave(const FPointerEvent& InMouseEvent) override;
 	
 	virtual void NativeOnInitialized() override;
 
@@ -4,6 +4,7 @@
 #include "DialogPrompt.h"
 
 #include "AdventureGame/Constants.h"
+#include "AdventureGame/HUD/TextLayoutCache.h"
 #include "AdventureGame/Player/AdventurePlayerController.h"
 #include "Components/Image.h"
 #include "Kismet/GameplayStatics.h"
@@ -16,7 +17,7 @@ void UDialogPrompt::NativeOnInitialized()
 void UDialogPrompt::SetText(const FText &TextToSet)
 {
     SetVisibility(ESlateVisibility::Visible);
-    PromptText->SetText(TextToSet);
+    FTextLayoutCache::Get().SetText(PromptText, TextToSet);
 }
 
 void UDialogPrompt::HighlightText()
@@ -33,7 +34,7 @@ void UDialogPrompt::UnhighlightText()
 
 void UDialogPrompt::HidePrompt()
 {
-    PromptText->SetText(FText::GetEmpty());
+    // The text is left, so the same prompt shown again is not laid out again
     SetVisibility(ESlateVisibility::Hidden);
 }
 
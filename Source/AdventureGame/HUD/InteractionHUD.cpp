@@ -4,6 +4,7 @@
 #include "InteractionHUD.h"
 
 #include "AdventureGame/Constants.h"
+#include "AdventureGame/HUD/TextLayoutCache.h"
 #include "Components/Image.h"
 #include "Internationalization/StringTableRegistry.h"
 
@@ -11,7 +12,7 @@ void UInteractionHUD::SetText(const FText NewText)
 {
     if (!TextLocked)
     {
-        InteractionDescription->SetText(NewText);
+        FTextLayoutCache::Get().SetText(InteractionDescription, NewText);
     }
 }
 
@@ -0,0 +1,124 @@
+// (c) 2025 Sarah Smith
+
+
+#include "TextLayoutCache.h"
+
+#include "AdventureGame/AdventureGame.h"
+#include "Components/TextBlock.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Internationalization/Culture.h"
+#include "Rendering/SlateRenderer.h"
+
+FTextLayoutKey::FTextLayoutKey(const FText& Text, const FSlateFontInfo* Font, const int32 WrapWidth)
+    : TextId(FTextInspector::GetTextId(Text))
+      , Culture(FInternationalization::Get().GetCurrentLanguage()->GetName())
+      , FontHash(Font ? GetTypeHash(*Font) : 0)
+      , WrapWidth(WrapWidth)
+{
+    if (TextId.IsEmpty())
+    {
+        Source = Text.ToString();
+    }
+}
+
+FString FTextLayoutCacheStats::ToString() const
+{
+    return FString::Printf(TEXT("%d hits, %d misses, %.1f%% hit rate, %d evicted"),
+        Hits, Misses, GetHitRate() * 100.0f, Evictions);
+}
+
+FTextLayoutCache::FTextLayoutCache(const int32 Capacity)
+    : Layouts(FMath::Max(Capacity, 1))
+{
+    //
+}
+
+FTextLayoutCache& FTextLayoutCache::Get()
+{
+    static FTextLayoutCache Cache;
+    return Cache;
+}
+
+const FTextLayout& FTextLayoutCache::GetLayout(const FText& Text, const int32 WrapWidth, const FSlateFontInfo* Font)
+{
+    const FTextLayoutKey Key(Text, Font, WrapWidth);
+    if (const FTextLayout* Cached = Layouts.FindAndTouch(Key))
+    {
+        ++Stats.Hits;
+        return *Cached;
+    }
+    ++Stats.Misses;
+
+    FTextLayout Layout;
+    const FString& Line = Text.ToString();
+    if (WrapWidth > 0 && Line.Len() > WrapWidth)
+    {
+        WrapLine(Line, WrapWidth, Layout.Lines);
+    }
+    else
+    {
+        Layout.Lines.Add(Text);
+    }
+    if (Font)
+    {
+        Measure(Layout, *Font);
+    }
+
+    if (Layouts.Num() == Layouts.Max())
+    {
+        ++Stats.Evictions;
+    }
+    Layouts.Add(Key, MoveTemp(Layout));
+    return *Layouts.FindAndTouch(Key);
+}
+
+void FTextLayoutCache::SetText(UTextBlock* TextBlock, const FText& NewText)
+{
+    if (!TextBlock) return;
+    const FText OldText = TextBlock->GetText();
+    if (OldText.IdenticalTo(NewText) || OldText.ToString().Equals(NewText.ToString(), ESearchCase::CaseSensitive))
+    {
+        return;
+    }
+    const FTextLayout& Layout = GetLayout(NewText, 0, &TextBlock->GetFont());
+    TextBlock->SetMinDesiredWidth(Layout.Size.X);
+    TextBlock->SetText(NewText);
+}
+
+void FTextLayoutCache::Empty()
+{
+    Layouts.Empty(Layouts.Max());
+    Stats = FTextLayoutCacheStats();
+}
+
+void FTextLayoutCache::WrapLine(const FString& Line, const int32 MaxLength, TArray<FText>& OutLines)
+{
+    FString CurrentLine = Line;
+    while (CurrentLine.Len() > MaxLength)
+    {
+        int32 SplitPoint = MaxLength;
+        while (SplitPoint > 0 && CurrentLine[SplitPoint] != ' ') { --SplitPoint; }
+        if (SplitPoint == 0) SplitPoint = MaxLength; // Did not find a space to split at
+        OutLines.Add(FText::FromString(CurrentLine.Left(SplitPoint)));
+        CurrentLine = CurrentLine.Mid(SplitPoint).TrimStartAndEnd();
+    }
+    OutLines.Add(FText::FromString(CurrentLine));
+}
+
+void FTextLayoutCache::Measure(FTextLayout& Layout, const FSlateFontInfo& Font)
+{
+    if (!FSlateApplication::IsInitialized()) return;
+    const FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer();
+    if (!Renderer) return;
+    const TSharedRef<FSlateFontMeasure> FontMeasure = Renderer->GetFontMeasureService();
+    Layout.LineSizes.Reset(Layout.Lines.Num());
+    Layout.Size = FVector2D::ZeroVector;
+    for (const FText& Line : Layout.Lines)
+    {
+        const FVector2D LineSize = FontMeasure->Measure(Line, Font);
+        Layout.LineSizes.Add(LineSize);
+        Layout.Size.X = FMath::Max(Layout.Size.X, LineSize.X);
+        Layout.Size.Y += LineSize.Y;
+    }
+}
@@ -0,0 +1,123 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "Fonts/SlateFontInfo.h"
+#include "Internationalization/TextKey.h"
+
+#include "AdventureGame/Constants.h"
+
+class UTextBlock;
+
+/// A text wrapped into lines, with the size of each line in the font it was measured in.
+struct ADVENTUREGAME_API FTextLayout
+{
+    TArray<FText> Lines;
+
+    /// Size of each line, or zero if there was no font, or no Slate to measure with.
+    TArray<FVector2D> LineSizes;
+
+    /// Widest line by the lines' total height.
+    FVector2D Size = FVector2D::ZeroVector;
+};
+
+/// What a layout depends on: the text, by its localization id when it has one, the
+/// culture it is shown in, the font and the wrap width.
+struct ADVENTUREGAME_API FTextLayoutKey
+{
+    FTextId TextId;
+
+    /// The displayed string, only for texts without a localization id.
+    FString Source;
+
+    FName Culture;
+
+    uint32 FontHash = 0;
+
+    int32 WrapWidth = 0;
+
+    FTextLayoutKey() = default;
+
+    FTextLayoutKey(const FText& Text, const FSlateFontInfo* Font, int32 WrapWidth);
+
+    bool operator==(const FTextLayoutKey& Other) const
+    {
+        return WrapWidth == Other.WrapWidth && FontHash == Other.FontHash && Culture == Other.Culture
+            && TextId == Other.TextId && Source.Equals(Other.Source, ESearchCase::CaseSensitive);
+    }
+
+    friend uint32 GetTypeHash(const FTextLayoutKey& Key)
+    {
+        uint32 Hash = HashCombine(GetTypeHash(Key.TextId), GetTypeHash(Key.Source));
+        Hash = HashCombine(Hash, GetTypeHash(Key.Culture));
+        return HashCombine(Hash, HashCombine(Key.FontHash, GetTypeHash(Key.WrapWidth)));
+    }
+};
+
+struct ADVENTUREGAME_API FTextLayoutCacheStats
+{
+    int32 Hits = 0;
+
+    int32 Misses = 0;
+
+    /// Layouts dropped, least recently used first, to make room.
+    int32 Evictions = 0;
+
+    float GetHitRate() const { return Hits + Misses > 0 ? static_cast<float>(Hits) / (Hits + Misses) : 0.0f; }
+
+    FString ToString() const;
+};
+
+/**
+ * Wrapped lines, and measured sizes when asked for, of the texts shown in barks, prompts
+ * and the interaction text, so a line shown again is not wrapped or measured again. The
+ * least recently used layouts are evicted when it is full. Slate still shapes the glyphs,
+ * through its own shaped text cache, when a text block's text does change. Game thread only.
+ */
+class ADVENTUREGAME_API FTextLayoutCache
+{
+public:
+    explicit FTextLayoutCache(int32 Capacity = TEXT_LAYOUT_CACHE_SIZE);
+
+    /// The cache the HUD and barks share.
+    static FTextLayoutCache& Get();
+
+    /**
+     * Get the layout of a text, wrapping and measuring it if it is not cached.
+     * @param Text Text to lay out, with no newline characters
+     * @param WrapWidth Most characters in a line, or 0 to leave it as one line
+     * @param Font Font to measure the lines in, or null to only wrap them
+     * @return The layout, which is only good until the next call, which may evict it
+     */
+    const FTextLayout& GetLayout(const FText& Text, int32 WrapWidth, const FSlateFontInfo* Font = nullptr);
+
+    /**
+     * Set the text of a text block unless it is already showing it, so it is not laid out
+     * again by Slate. A new text is measured in the block's font, through the cache, and the
+     * block is given that as its least width, so a prompt list or the interaction line
+     * refilled with texts it has shown before gets their sizes without measuring them again.
+     * @param TextBlock Block to set, may be null
+     * @param NewText Text to show, with no newline characters
+     */
+    void SetText(UTextBlock* TextBlock, const FText& NewText);
+
+    void Empty();
+
+    int32 Num() const { return Layouts.Num(); }
+
+    int32 GetCapacity() const { return Layouts.Max(); }
+
+    const FTextLayoutCacheStats& GetStats() const { return Stats; }
+
+    /// Wrap a line of text to at most MaxLength characters, at spaces where there are any.
+    static void WrapLine(const FString& Line, int32 MaxLength, TArray<FText>& OutLines);
+
+private:
+    static void Measure(FTextLayout& Layout, const FSlateFontInfo& Font);
+
+    TLruCache<FTextLayoutKey, FTextLayout> Layouts;
+
+    FTextLayoutCacheStats Stats;
+};
@@ -0,0 +1,101 @@
+#include "AdventureGame/Constants.h"
+#include "AdventureGame/HUD/AdvGameUtils.h"
+#include "AdventureGame/HUD/TextLayoutCache.h"
+
+#include "Components/TextBlock.h"
+#include "Misc/AutomationTest.h"
+#include "Styling/CoreStyle.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(TextLayoutCacheTest, "AdventureGame.HUD.TextLayoutCacheTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// Lines said in a long conversation, going round the same few topics.
+constexpr int32 GReplayLines = 5000;
+
+/// Different lines in the conversation.
+constexpr int32 GDistinctLines = 60;
+
+bool TextLayoutCacheTest::RunTest(const FString& Parameters)
+{
+    TArray<FText> Conversation;
+    for (int32 Index = 0; Index < GDistinctLines; ++Index)
+    {
+        Conversation.Add(FText::FromString(FString::Printf(
+            TEXT("Line %d of what the innkeeper has to say%s"), Index,
+            Index % 2 ? TEXT(" about the stranger who came in from the rain last night") : TEXT(""))));
+    }
+    const FSlateFontInfo Font = FCoreStyle::GetDefaultFontStyle("Regular", 12);
+
+    // Lines wrap as AdvGameUtils wraps them, including a word too long to split at a space
+    FTextLayoutCache Cache(GDistinctLines);
+    const FText NoSpaces = FText::FromString(FString::ChrN(BARK_LINE_WIDTH * 2 + 5, 'a'));
+    TestEqual(TEXT("Line with no spaces split at the width"), Cache.GetLayout(NoSpaces, BARK_LINE_WIDTH).Lines.Num(), 3);
+    const FText& Long = Conversation[1];
+    const TArray<FText> Wrapped = AdvGameUtils::WrapTextLinesToMaxCharacters(Long, BARK_LINE_WIDTH);
+    const FTextLayout& Layout = Cache.GetLayout(Long, BARK_LINE_WIDTH);
+    TestEqual(TEXT("Same number of lines"), Layout.Lines.Num(), Wrapped.Num());
+    for (int32 Line = 0; Line < FMath::Min(Layout.Lines.Num(), Wrapped.Num()); ++Line)
+    {
+        TestEqual(TEXT("Same lines"), Layout.Lines[Line].ToString(), Wrapped[Line].ToString());
+        TestTrue(TEXT("within the width"), Layout.Lines[Line].ToString().Len() <= BARK_LINE_WIDTH);
+    }
+    TestEqual(TEXT("Short line left as it is"), Cache.GetLayout(Conversation[0], BARK_LINE_WIDTH).Lines.Num(), 1);
+
+    // The same text in another font, or at another width, is laid out again
+    Cache.Empty();
+    Cache.GetLayout(Long, BARK_LINE_WIDTH);
+    Cache.GetLayout(Long, BARK_LINE_WIDTH, &Font);
+    Cache.GetLayout(Long, BARK_LINE_WIDTH * 2);
+    Cache.GetLayout(Long, BARK_LINE_WIDTH);
+    TestEqual(TEXT("Font and width are part of the key"), Cache.GetStats().Misses, 3);
+    TestEqual(TEXT("Text is found again"), Cache.GetStats().Hits, 1);
+
+    // The least recently used layout is the one evicted
+    FTextLayoutCache Small(2);
+    Small.GetLayout(Conversation[0], BARK_LINE_WIDTH);
+    Small.GetLayout(Conversation[1], BARK_LINE_WIDTH);
+    Small.GetLayout(Conversation[0], BARK_LINE_WIDTH);
+    Small.GetLayout(Conversation[2], BARK_LINE_WIDTH);
+    TestEqual(TEXT("Full"), Small.Num(), 2);
+    TestEqual(TEXT("One evicted"), Small.GetStats().Evictions, 1);
+    Small.GetLayout(Conversation[0], BARK_LINE_WIDTH);
+    TestEqual(TEXT("Most recent kept"), Small.GetStats().Hits, 2);
+
+    // A text block already showing the same words keeps the text it has, and a text it
+    // showed before is measured from the cache
+    Cache.Empty();
+    UTextBlock* TextBlock = NewObject<UTextBlock>();
+    Cache.SetText(TextBlock, Conversation[0]);
+    Cache.SetText(TextBlock, FText::FromString(Conversation[0].ToString()));
+    TestTrue(TEXT("Same words not set again"), TextBlock->GetText().IdenticalTo(Conversation[0]));
+    TestEqual(TEXT("nor measured again"), Cache.GetStats().Misses, 1);
+    Cache.SetText(TextBlock, Conversation[1]);
+    TestTrue(TEXT("Other words set"), TextBlock->GetText().IdenticalTo(Conversation[1]));
+    Cache.SetText(TextBlock, Conversation[0]);
+    TestEqual(TEXT("Words shown before measured from the cache"), Cache.GetStats().Hits, 1);
+    Cache.SetText(nullptr, Conversation[2]);
+
+    // Replay a long conversation, mostly going back over the same lines
+    TArray<int32> Replay;
+    for (int32 Said = 0; Said < GReplayLines; ++Said)
+    {
+        Replay.Add((Said * 7 + Said / GDistinctLines) % GDistinctLines);
+    }
+
+    Cache.Empty();
+    int32 UncachedLines = 0;
+    int32 CachedLines = 0;
+    for (const int32 Line : Replay)
+    {
+        UncachedLines += AdvGameUtils::WrapTextLinesToMaxCharacters(Conversation[Line], BARK_LINE_WIDTH).Num();
+        CachedLines += Cache.GetLayout(Conversation[Line], BARK_LINE_WIDTH, &Font).Lines.Num();
+    }
+
+    const FTextLayoutCacheStats& Stats = Cache.GetStats();
+    TestEqual(TEXT("Same lines from the cache"), CachedLines, UncachedLines);
+    TestEqual(TEXT("Each line laid out once"), Stats.Misses, GDistinctLines);
+    TestEqual(TEXT("Nothing evicted"), Stats.Evictions, 0);
+    TestTrue(TEXT("Mostly hits"), Stats.GetHitRate() > 0.9f);
+
+    return true;
+}
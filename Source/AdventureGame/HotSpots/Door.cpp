@@ -111,7 +111,7 @@ void ADoor::OnUse_Implementation()
         BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "Locked"));
         return;
     }
-    BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "UseDefaultText"));
+    BarkAndEnd(GetDefaultBarkText(EVerbType::Use));
 }
 
 void ADoor::OnOpen_Implementation()
@@ -133,6 +133,12 @@ void ADoor::OnOpen_Implementation()
     }
 }
 
+bool ADoor::PredictBarkText(EVerbType Verb, const UInventoryItem* SourceItem, FText& OutText) const
+{
+    if (Verb == EVerbType::Use || Verb == EVerbType::Open) return false;
+    return Super::PredictBarkText(Verb, SourceItem, OutText);
+}
+
 void ADoor::DoorErrors(const FString& Reason)
 {
 #if WITH_EDITOR
@@ -51,6 +51,9 @@ public:
 
 	virtual void OnOpen_Implementation() override;
 
+	/// Using and opening a door depend on whether it is locked when clicked.
+	virtual bool PredictBarkText(EVerbType Verb, const UInventoryItem* SourceItem, FText& OutText) const override;
+
 private:
 	void DoorErrors(const FString& Reason);
 };
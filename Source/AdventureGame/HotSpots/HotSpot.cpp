@@ -10,6 +10,8 @@
 #include "AdventureGame/Player/AdventurePlayerController.h"
 #include "AdventureGame/Enums/AdventureGameplayTags.h"
 #include "AdventureGame/Gameplay/AdventureGameInstance.h"
+#include "AdventureGame/Gameplay/AdventureWorldRegistry.h"
+#include "AdventureGame/HUD/AdvGameUtils.h"
 #include "AdventureGame/Player/ItemManager.h"
 
 #include "Kismet/GameplayStatics.h"
@@ -21,6 +23,8 @@ AHotSpot::AHotSpot()
 	WalkToPoint = CreateDefaultSubobject<USphereComponent>(TEXT("PlayerDetectorSphere"));
 	WalkToPoint->SetupAttachment(RootComponent);
 	WalkToPoint->SetSphereRadius(4.0f);
+	WalkToPoint->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	WalkToPoint->SetGenerateOverlapEvents(false);
 }
 
 void AHotSpot::BeginPlay()
@@ -30,9 +34,9 @@ void AHotSpot::BeginPlay()
 	const UStaticMeshComponent* AStaticMeshComponent = GetStaticMeshComponent();
 	if (AStaticMeshComponent && AStaticMeshComponent->GetStaticMesh())
 	{
+		// The cursor is hit tested against the world registry's spatial index by
+		// the player controller, which calls OnBeginCursorOver and OnEndCursorOver.
 		SetEnableMeshComponent(true);
-		Super::OnBeginCursorOver.AddDynamic(this, &AHotSpot::OnBeginCursorOver);
-		Super::OnEndCursorOver.AddDynamic(this, &AHotSpot::OnEndCursorOver);
 	}
 	else
 	{
@@ -43,6 +47,10 @@ void AHotSpot::BeginPlay()
 	WalkToPosition = WalkToPoint->GetComponentLocation();
 	WalkToPosition.Z = PlayerPawn->GetActorLocation().Z;
 
+	if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+	{
+		Registry->RegisterHotSpot(this);
+	}
 	RegisterForSaveAndLoad();
 	DataLoad.ExecuteIfBound(this);
 }
@@ -51,6 +59,10 @@ void AHotSpot::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	RegisteredForSaveAndLoad = false;
 	DataSave.ExecuteIfBound(this);
+	if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+	{
+		Registry->UnregisterHotSpot(this);
+	}
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -90,7 +102,7 @@ UItemDataAsset* AHotSpot::ItemDataAssetForAction(EVerbType Verb) const
 	// TODO - remove this bit of code once the deprecated OnUseSuccessItem and OnGiveSuccessItem are gone
 	if (Verb == EVerbType::Use)
 	{
-		if (UItemDataAsset *UseItem = OnUseSuccessItem.LoadSynchronous())
+		if (UItemDataAsset *UseItem = AdvGameUtils::GetRoomAsset(OnUseSuccessItem))
 		{
 			UE_LOG(LogAdventureGame, Warning, TEXT("OnUseSuccessItem is deprecated in %s - use OnItemActivated instead"),
 				*(ShortDescription.ToString()));
@@ -99,7 +111,7 @@ UItemDataAsset* AHotSpot::ItemDataAssetForAction(EVerbType Verb) const
 	}
 	else if (Verb == EVerbType::Give)
 	{
-		if (UItemDataAsset *UseItem = OnGiveSuccessItem.LoadSynchronous())
+		if (UItemDataAsset *UseItem = AdvGameUtils::GetRoomAsset(OnGiveSuccessItem))
 		{
 			UE_LOG(LogAdventureGame, Warning, TEXT("OnGiveSuccessItem is deprecated in %s - use OnItemActivated instead"),
 				*(ShortDescription.ToString()));
@@ -109,6 +121,115 @@ UItemDataAsset* AHotSpot::ItemDataAssetForAction(EVerbType Verb) const
 	return OnItemActivated.GetItemDataAssetForAction(Verb);
 }
 
+const TSoftObjectPtr<UItemDataAsset>* AHotSpot::FindItemDataAssetForAction(EVerbType Verb) const
+{
+	// Looked up the same way as OnItemGiven and OnItemUsed do
+	switch (Verb)
+	{
+	case EVerbType::GiveItem:
+		return OnGiveSuccessItem.IsNull() ? nullptr : &OnGiveSuccessItem;
+	case EVerbType::UseItem:
+		{
+			const FItemDataWrapper* Wrapper = OnItemActivated.ItemDataRecords.FindByPredicate(
+				[Verb](const FItemDataWrapper& Record) { return Record.ActiveVerb == Verb; });
+			return Wrapper && !Wrapper->ItemDataAsset.IsNull() ? &Wrapper->ItemDataAsset : nullptr;
+		}
+	default:
+		return nullptr;
+	}
+}
+
+bool AHotSpot::FindPrefetchedItemDataAsset(EVerbType Verb, UItemDataAsset*& OutItemDataAsset)
+{
+	ACommandManager *Command = GetCommandManager();
+	return Command && Command->GetHoverPrefetch().FindClaimedItemDataAsset(this, Verb, OutItemDataAsset);
+}
+
+void AHotSpot::GetAssetsForAction(EVerbType Verb, TArray<FSoftObjectPath>& OutAssets) const
+{
+	if (const TSoftObjectPtr<UItemDataAsset>* ItemDataAsset = FindItemDataAssetForAction(Verb))
+	{
+		OutAssets.Add(ItemDataAsset->ToSoftObjectPath());
+	}
+}
+
+bool AHotSpot::FindLoadedItemDataAssetForAction(EVerbType Verb, UItemDataAsset*& OutItemDataAsset) const
+{
+	const TSoftObjectPtr<UItemDataAsset>* ItemDataAsset = FindItemDataAssetForAction(Verb);
+	OutItemDataAsset = ItemDataAsset ? ItemDataAsset->Get() : nullptr;
+	return !ItemDataAsset || OutItemDataAsset;
+}
+
+/// The event for each verb, to tell whether a blueprint implements it.
+static FName VerbEventName(EVerbType Verb)
+{
+	switch (Verb)
+	{
+	case EVerbType::Close: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnClose);
+	case EVerbType::Open: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnOpen);
+	case EVerbType::Give: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnGive);
+	case EVerbType::PickUp: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnPickUp);
+	case EVerbType::TalkTo: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnTalkTo);
+	case EVerbType::LookAt: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnLookAt);
+	case EVerbType::Pull: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnPull);
+	case EVerbType::Push: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnPush);
+	case EVerbType::Use: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnUse);
+	case EVerbType::UseItem: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnItemUsed);
+	case EVerbType::GiveItem: return GET_FUNCTION_NAME_CHECKED(IVerbInteractions, OnItemGiven);
+	default: return NAME_None;
+	}
+}
+
+FText AHotSpot::GetDefaultBarkText(EVerbType Verb) const
+{
+	switch (Verb)
+	{
+	case EVerbType::Close: return LOCTABLE(ITEM_STRINGS_KEY, "CloseDefaultText");
+	case EVerbType::Open: return LOCTABLE(ITEM_STRINGS_KEY, "OpenDefaultText");
+	case EVerbType::Give: return LOCTABLE(ITEM_STRINGS_KEY, "GiveDefaultText");
+	case EVerbType::PickUp: return LOCTABLE(ITEM_STRINGS_KEY, "PickUpDefaultText");
+	case EVerbType::TalkTo: return LOCTABLE(ITEM_STRINGS_KEY, "TalkToDefaultText");
+	case EVerbType::LookAt: return Description.IsEmpty() ? LOCTABLE(ITEM_STRINGS_KEY, "LookAtDefaultText") : Description;
+	case EVerbType::Pull: return LOCTABLE(ITEM_STRINGS_KEY, "PullDefaultText");
+	case EVerbType::Push: return LOCTABLE(ITEM_STRINGS_KEY, "PushDefaultText");
+	case EVerbType::Use: return LOCTABLE(ITEM_STRINGS_KEY, "UseDefaultText");
+	case EVerbType::UseItem: return LOCTABLE(ITEM_STRINGS_KEY, "ItemUsedDefaultText");
+	case EVerbType::GiveItem: return LOCTABLE(ITEM_STRINGS_KEY, "ItemGivenDefaultText");
+	default: return FText::GetEmpty();
+	}
+}
+
+bool AHotSpot::PredictBarkText(EVerbType Verb, const UInventoryItem* SourceItem, FText& OutText) const
+{
+	const FName Event = VerbEventName(Verb);
+	if (Event.IsNone() || GetClass()->IsFunctionImplementedInScript(Event)) return false;
+	if (Verb == EVerbType::UseItem || Verb == EVerbType::GiveItem)
+	{
+		UItemDataAsset* ItemDataAsset = nullptr;
+		if (!SourceItem || !FindLoadedItemDataAssetForAction(Verb, ItemDataAsset)) return false;
+		// An item that matches the recipe runs it instead of barking
+		if (ItemDataAsset && SourceItem->ItemKind == ItemDataAsset->SourceItem) return false;
+	}
+	OutText = GetDefaultBarkText(Verb);
+	return true;
+}
+
+void AHotSpot::RegisterProximityTrigger(UAdventureWorldRegistry* Registry)
+{
+	if (bProximityUsesMeshBounds)
+	{
+		if (const UPrimitiveComponent* Component = GetHitTestComponent())
+		{
+			const FBox Box = Component->Bounds.GetBox();
+			Registry->RegisterProximityRegion(this, FBox2D(FVector2D(Box.Min), FVector2D(Box.Max)));
+		}
+	}
+	else if (ProximityRadius > 0.0f)
+	{
+		Registry->RegisterProximityCircle(this, FVector2D(WalkToPosition), ProximityRadius);
+	}
+}
+
 void AHotSpot::OnBeginCursorOver(AActor *TouchedActor)
 {
 	if (ACommandManager *Command = GetCommandManager())
@@ -134,56 +255,56 @@ void AHotSpot::OnClose_Implementation()
 {
 	IVerbInteractions::OnClose_Implementation();
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On close"));
-	BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "CloseDefaultText"));
+	BarkAndEnd(GetDefaultBarkText(EVerbType::Close));
 }
 
 void AHotSpot::OnOpen_Implementation()
 {
 	IVerbInteractions::OnOpen_Implementation();
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On open"));
-	BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "OpenDefaultText"));
+	BarkAndEnd(GetDefaultBarkText(EVerbType::Open));
 }
 
 void AHotSpot::OnGive_Implementation()
 {
 	IVerbInteractions::OnGive_Implementation();
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On give"));
-	BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "GiveDefaultText"));
+	BarkAndEnd(GetDefaultBarkText(EVerbType::Give));
 }
 
 void AHotSpot::OnPickUp_Implementation()
 {
 	IVerbInteractions::OnPickUp_Implementation();
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On Pickup"));
-	BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "PickUpDefaultText"));
+	BarkAndEnd(GetDefaultBarkText(EVerbType::PickUp));
 }
 
 void AHotSpot::OnTalkTo_Implementation()
 {
 	IVerbInteractions::OnTalkTo_Implementation();
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On talk to"));
-	BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "TalkToDefaultText"));
+	BarkAndEnd(GetDefaultBarkText(EVerbType::TalkTo));
 }
 
 void AHotSpot::OnLookAt_Implementation()
 {
 	IVerbInteractions::OnLookAt_Implementation();
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On look at"));
-	BarkAndEnd(Description.IsEmpty() ? LOCTABLE(ITEM_STRINGS_KEY, "LookAtDefaultText") : Description);
+	BarkAndEnd(GetDefaultBarkText(EVerbType::LookAt));
 }
 
 void AHotSpot::OnPull_Implementation()
 {
 	IVerbInteractions::OnPull_Implementation();
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On pull"));
-	BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "PullDefaultText"));
+	BarkAndEnd(GetDefaultBarkText(EVerbType::Pull));
 }
 
 void AHotSpot::OnPush_Implementation()
 {
 	IVerbInteractions::OnPush_Implementation();
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On push"));
-	BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "PushDefaultText"));
+	BarkAndEnd(GetDefaultBarkText(EVerbType::Push));
 }
 
 void AHotSpot::OnUse_Implementation()
@@ -194,7 +315,7 @@ void AHotSpot::OnUse_Implementation()
 	// terminal or a water-fountain then a custom script would need to be done.
 	IVerbInteractions::OnUse_Implementation();
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On use from AHotSpot default implement."));
-	BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "UseDefaultText"));
+	BarkAndEnd(GetDefaultBarkText(EVerbType::Use));
 }
 
 void AHotSpot::OnWalkTo_Implementation()
@@ -219,7 +340,12 @@ void AHotSpot::OnWalkTo_Implementation()
 void AHotSpot::OnItemUsed_Implementation()
 {
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On Item Used"));
-	if (UItemDataAsset *ItemDataAsset = ItemDataAssetForAction(EVerbType::UseItem))
+	UItemDataAsset *ItemDataAsset = nullptr;
+	if (!FindPrefetchedItemDataAsset(EVerbType::UseItem, ItemDataAsset))
+	{
+		ItemDataAsset = ItemDataAssetForAction(EVerbType::UseItem);
+	}
+	if (ItemDataAsset)
 	{
 		if (const UItemManager *ItemManager = GetItemManager())
 		{
@@ -240,13 +366,18 @@ void AHotSpot::OnItemUsed_Implementation()
 			UE_LOG(LogAdventureGame, Warning, TEXT("AHotSpot::OnItemUsed_Implementation - APC was invalid!"));
 		}
 	}
-	BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "ItemUsedDefaultText"));
+	BarkAndEnd(GetDefaultBarkText(EVerbType::UseItem));
 }
 
 void AHotSpot::OnItemGiven_Implementation()
 {
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("On Item Given"));
-	if (UItemDataAsset *ItemDataAsset = OnGiveSuccessItem.LoadSynchronous())
+	UItemDataAsset *ItemDataAsset = nullptr;
+	if (!FindPrefetchedItemDataAsset(EVerbType::GiveItem, ItemDataAsset))
+	{
+		ItemDataAsset = AdvGameUtils::GetRoomAsset(OnGiveSuccessItem);
+	}
+	if (ItemDataAsset)
 	{
 		if (const UItemManager *ItemManager = GetItemManager())
 		{
@@ -261,7 +392,7 @@ void AHotSpot::OnItemGiven_Implementation()
 			UE_LOG(LogAdventureGame, Warning, TEXT("AHotSpot::OnItemUsed_Implementation - APC was invalid!"));
 		}
 	}
-	BarkAndEnd(LOCTABLE(ITEM_STRINGS_KEY, "ItemGivenDefaultText"));
+	BarkAndEnd(GetDefaultBarkText(EVerbType::GiveItem));
 }
 
 AActor *AHotSpot::SpawnAtPlayerLocation(TSubclassOf<AActor> SpawnClass, float Scale, float Lifetime) const
@@ -307,8 +438,11 @@ void AHotSpot::SetEnableMeshComponent(bool Enabled) const
 			UE_LOG(LogAdventureGame, Verbose, TEXT("%s %s static mesh is valid & enabled."), *HotSpotType, *HotSpotName);
 			// StaticMeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 			AStaticMeshComponent->SetCollisionEnabled(ECollisionEnabled::Type::QueryOnly);
-			AStaticMeshComponent->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
-			AStaticMeshComponent->SetGenerateOverlapEvents(true);
+			// Nothing is bound to overlaps, and the player coming near is tracked by
+			// the world registry's proximity grid, so the pawn is not tested against
+			// the mesh each time it moves
+			AStaticMeshComponent->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Ignore);
+			AStaticMeshComponent->SetGenerateOverlapEvents(false);
 		}
 	}
 	else
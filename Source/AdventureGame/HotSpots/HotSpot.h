@@ -16,6 +16,8 @@
 #include "HotSpot.generated.h"
 
 enum class EVerbType : uint8;
+class UAdventureWorldRegistry;
+class UInventoryItem;
 
 DECLARE_DYNAMIC_DELEGATE_OneParam(FHotSpotDataSave, AHotSpot *, HotSpot);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FHotSpotDataLoad, AHotSpot *, HotSpot);
@@ -85,6 +87,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HotSpot")
 	EWalkDirection FacingDirection;
 
+	/// Where hotspots overlap, the one with the highest priority is clicked. Of
+	/// those with the same priority the one on top is clicked.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HotSpot")
+	int32 HitPriority = 0;
+
 	/// Data Asset for determining results of the player interacting via the Use verb with this hotspot.
 	/// This should be an <b>instance</b> of the <code>ItemDataAsset</code> sub-class, not the
 	/// class itself. Right-click in the content drawer, and choose <i>Miscellaneous > Data Asset</i>
@@ -110,7 +117,58 @@ public:
 
 private:
 	UItemDataAsset* ItemDataAssetForAction(EVerbType Verb) const;
-	
+
+	/// The recipe OnItemUsed or OnItemGiven looks up for the verb, without loading it.
+	const TSoftObjectPtr<UItemDataAsset>* FindItemDataAssetForAction(EVerbType Verb) const;
+
+	/// The recipe the click on this hotspot worked out while the cursor rested on it.
+	bool FindPrefetchedItemDataAsset(EVerbType Verb, UItemDataAsset*& OutItemDataAsset);
+
+public:
+	//////////////////////////////////
+	///
+	/// PREFETCH
+	///
+
+	/// Soft assets doing the verb on this hotspot will load, so they can be
+	/// streamed in while the cursor rests on it rather than loaded on the click.
+	void GetAssetsForAction(EVerbType Verb, TArray<FSoftObjectPath>& OutAssets) const;
+
+	/// The recipe doing the verb on this hotspot uses, or null if it has none.
+	/// False if it has one that is not loaded yet.
+	bool FindLoadedItemDataAssetForAction(EVerbType Verb, UItemDataAsset*& OutItemDataAsset) const;
+
+	/// What doing the verb, with the item held, will bark when that is the default
+	/// text. False if a blueprint or a subclass handles the verb, or a recipe runs
+	/// instead, so the bark cannot be known ahead.
+	virtual bool PredictBarkText(EVerbType Verb, const UInventoryItem* SourceItem, FText& OutText) const;
+
+	/// What the default implementation of the verb barks, or empty if it has none.
+	FText GetDefaultBarkText(EVerbType Verb) const;
+
+	//////////////////////////////////
+	///
+	/// PROXIMITY
+	///
+
+	/// Distance from the walk to position within which the player is near this
+	/// hotspot, firing OnPlayerProximity. Zero for no proximity trigger.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Proximity")
+	float ProximityRadius = 0.0f;
+
+	/// The player is near while inside the bounds of the mesh, rather than within
+	/// the proximity radius of the walk to position.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Proximity")
+	bool bProximityUsesMeshBounds = false;
+
+	/// Called by the world registry when the player comes near this hotspot and
+	/// when they leave. Tracked by the registry's proximity grid, not physics overlaps.
+	UFUNCTION(BlueprintImplementableEvent, Category = "Proximity")
+	void OnPlayerProximity(bool bIsNear);
+
+	/// Add this hotspot's proximity trigger, if it has one, to the registry.
+	void RegisterProximityTrigger(UAdventureWorldRegistry* Registry);
+
 	//////////////////////////////////
 	///
 	/// USER INPUT EVENTS
@@ -123,6 +181,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "HotSpot")
 	void OnEndCursorOver(AActor *TouchedActor);
 
+	/// Component whose bounds are clicked on, which is the static mesh.
+	UPrimitiveComponent* GetHitTestComponent() const { return GetStaticMeshComponent(); }
+
+	/// Finer test than the bounds of the hit test component, for a point in the
+	/// XY plane that is inside them. True unless a subclass has a hit mask.
+	virtual bool HitTestMask(const FVector2D& Point) const { return true; }
+
 	//////////////////////////////////
 	///
 	/// VERB TRIGGER EVENTS
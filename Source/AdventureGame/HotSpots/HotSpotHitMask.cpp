@@ -0,0 +1,64 @@
+// (c) 2025 Sarah Smith
+
+
+#include "HotSpotHitMask.h"
+
+#include "PaperSprite.h"
+#include "Engine/Texture2D.h"
+
+void FHotSpotHitMask::Init(int32 InWidth, int32 InHeight, const FBox2D& InLocalBounds)
+{
+	Width = InWidth;
+	Height = InHeight;
+	LocalBounds = InLocalBounds;
+	Bits.Reset();
+	Bits.SetNumZeroed((Width * Height + 31) / 32);
+}
+
+bool FHotSpotHitMask::Contains(const FVector2D& LocalPoint) const
+{
+	if (!IsValid() || !LocalBounds.IsInside(LocalPoint)) return false;
+	const FVector2D Size = LocalBounds.GetSize();
+	const int32 X = FMath::Clamp(FMath::FloorToInt32((LocalPoint.X - LocalBounds.Min.X) / Size.X * Width), 0, Width - 1);
+	const int32 Y = FMath::Clamp(FMath::FloorToInt32((LocalBounds.Max.Y - LocalPoint.Y) / Size.Y * Height), 0, Height - 1);
+	return IsSet(X, Y);
+}
+
+#if WITH_EDITOR
+FHotSpotHitMask FHotSpotHitMask::FromSprite(const UPaperSprite* Sprite, uint8 AlphaThreshold)
+{
+	FHotSpotHitMask Mask;
+	UTexture2D* Texture = Sprite ? Sprite->GetSourceTexture() : nullptr;
+	if (!Texture || !Texture->Source.IsValid() || Texture->Source.GetFormat() != TSF_BGRA8) return Mask;
+
+	TArray64<uint8> Pixels;
+	if (!Texture->Source.GetMipData(Pixels, 0)) return Mask;
+
+	const FVector2D SourceUV = Sprite->GetSourceUV();
+	const FVector2D SourceSize = Sprite->GetSourceSize();
+	const FVector2D Pivot = Sprite->GetPivotPosition();
+	const float PixelsPerUnit = Sprite->GetPixelsPerUnrealUnit();
+	if (SourceSize.X < 1.0 || SourceSize.Y < 1.0 || PixelsPerUnit <= 0.0f) return Mask;
+
+	// Texture Y runs down, sprite Z runs up, both from the pivot
+	const FBox2D LocalBounds(
+		FVector2D(SourceUV.X - Pivot.X, Pivot.Y - (SourceUV.Y + SourceSize.Y)) / PixelsPerUnit,
+		FVector2D(SourceUV.X + SourceSize.X - Pivot.X, Pivot.Y - SourceUV.Y) / PixelsPerUnit);
+	Mask.Init(FMath::FloorToInt32(SourceSize.X), FMath::FloorToInt32(SourceSize.Y), LocalBounds);
+
+	const int64 TextureWidth = Texture->Source.GetSizeX();
+	for (int32 Y = 0; Y < Mask.Height; ++Y)
+	{
+		const int64 Row = (static_cast<int64>(SourceUV.Y) + Y) * TextureWidth + static_cast<int64>(SourceUV.X);
+		for (int32 X = 0; X < Mask.Width; ++X)
+		{
+			// BGRA, so alpha is the fourth byte
+			if (Pixels[(Row + X) * 4 + 3] > AlphaThreshold)
+			{
+				Mask.Set(X, Y);
+			}
+		}
+	}
+	return Mask;
+}
+#endif
@@ -0,0 +1,60 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "HotSpotHitMask.generated.h"
+
+class UPaperSprite;
+
+/**
+ * One bit per pixel of a sprite, set where the sprite is not transparent, so
+ * that clicks on a hotspot can follow the outline of its graphic rather than
+ * its rectangular bounds. Baked from the sprite's source texture in the editor,
+ * as the texture data is not readable in a packaged game.
+ */
+USTRUCT()
+struct ADVENTUREGAME_API FHotSpotHitMask
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Width = 0;
+
+	UPROPERTY()
+	int32 Height = 0;
+
+	/// Area the sprite covers in its component's space, X across and Z up.
+	UPROPERTY()
+	FBox2D LocalBounds = FBox2D(ForceInit);
+
+	/// Row by row from the top of the sprite, 32 pixels to an entry.
+	UPROPERTY()
+	TArray<uint32> Bits;
+
+	bool IsValid() const { return Width > 0 && Height > 0; }
+
+	/// Is the pixel under the point, in the sprite component's X and Z, opaque.
+	bool Contains(const FVector2D& LocalPoint) const;
+
+	bool IsSet(int32 X, int32 Y) const
+	{
+		const int32 Bit = Y * Width + X;
+		return (Bits[Bit >> 5] & (1u << (Bit & 31))) != 0;
+	}
+
+	void Set(int32 X, int32 Y)
+	{
+		const int32 Bit = Y * Width + X;
+		Bits[Bit >> 5] |= 1u << (Bit & 31);
+	}
+
+	void Init(int32 InWidth, int32 InHeight, const FBox2D& InLocalBounds);
+
+#if WITH_EDITOR
+	/// Build from the alpha of the sprite's source texture. Leaves the mask empty
+	/// if the sprite has no texture, or its source is not 8 bit BGRA.
+	static FHotSpotHitMask FromSprite(const UPaperSprite* Sprite, uint8 AlphaThreshold = 8);
+#endif
+};
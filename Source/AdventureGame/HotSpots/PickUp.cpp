@@ -6,11 +6,15 @@
 #include "AdventureGame/Enums/AdventureGameplayTags.h"
 #include "AdventureGame/Enums/VerbType.h"
 
+#include "UObject/ObjectSaveContext.h"
+
 // Sets default values
 APickUp::APickUp()
 {
-    // Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+    // Showing and hiding the sprite are the only changes, and both are events,
+    // so only tick for a blueprint that has a Tick event, see BeginPlay
     PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
 
     SpriteComponent = CreateDefaultSubobject<UPaperSpriteComponent>(TEXT("SpriteComponent"));
     SpriteComponent->SetupAttachment(RootComponent);
@@ -25,7 +29,11 @@ APickUp::APickUp()
 void APickUp::BeginPlay()
 {
     Super::BeginPlay();
-    
+
+    if (GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(APickUp, ReceiveTick)))
+    {
+        SetActorTickEnabled(true);
+    }
 }
 
 FGameplayTagContainer APickUp::GetTags() const
@@ -57,10 +65,47 @@ EVerbType APickUp::CheckForDefaultCommand() const
     return Super::CheckForDefaultCommand();
 }
 
-// Called every frame
-void APickUp::Tick(float DeltaTime)
+bool APickUp::HitTestMask(const FVector2D& Point) const
+{
+    if (SpriteHidden || !HitMask.IsValid() || !SpriteComponent->IsVisible()) return true;
+    // The sprite is turned to lie in the XY plane, so its X and Z are across the room
+    const FVector SpriteLocation = SpriteComponent->GetComponentLocation();
+    const FVector LocalPoint = SpriteComponent->GetComponentTransform().InverseTransformPosition(
+        FVector(Point.X, Point.Y, SpriteLocation.Z));
+    return HitMask.Contains(FVector2D(LocalPoint.X, LocalPoint.Z));
+}
+
+void APickUp::PreSave(FObjectPreSaveContext SaveContext)
+{
+    Super::PreSave(SaveContext);
+    BakeHitMask();
+}
+
+void APickUp::PostLoad()
 {
-    Super::Tick(DeltaTime);
+    Super::PostLoad();
+    if (!HitMask.IsValid())
+    {
+        BakeHitMask();
+    }
+}
+
+void APickUp::OnConstruction(const FTransform& Transform)
+{
+    Super::OnConstruction(Transform);
+    BakeHitMask();
+}
+
+void APickUp::BakeHitMask()
+{
+#if WITH_EDITOR
+    // The sprite's texture data is only readable in the editor, so a cooked game
+    // keeps the mask it was saved with
+    if (GIsEditor && SpriteComponent && !IsTemplate())
+    {
+        HitMask = FHotSpotHitMask::FromSprite(SpriteComponent->GetSprite());
+    }
+#endif
 }
 
 void APickUp::HideSprite()
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "HotSpot.h"
+#include "HotSpotHitMask.h"
 #include "PaperSpriteComponent.h"
 #include "PickUp.generated.h"
 
@@ -25,9 +26,18 @@ public:
     virtual void SetTags(const FGameplayTagContainer& Tags) override;
 
     virtual EVerbType CheckForDefaultCommand() const override;
-    
-    // Called every frame
-    virtual void Tick(float DeltaTime) override;
+
+    /// While the sprite is showing, only its opaque pixels can be clicked.
+    virtual bool HitTestMask(const FVector2D& Point) const override;
+
+    /// Bakes HitMask from the sprite.
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+
+    /// Bakes HitMask for a pickup saved before it had one.
+    virtual void PostLoad() override;
+
+    /// Bakes HitMask again when the pickup is placed, or its sprite changed.
+    virtual void OnConstruction(const FTransform& Transform) override;
 
     /// Show the sprite, the visible 2D graphic for this hotspot. Some hotspots
     /// may not have a sprite, in which case this function will do nothing.
@@ -43,7 +53,14 @@ public:
     /// the hotspot is just representing a spot on the background.
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PickUp")
     UPaperSpriteComponent *SpriteComponent;
+
+    /// Opaque pixels of the sprite, made in the editor, and kept when the level is saved.
+    /// Without one clicks fall back to the hotspot's bounds.
+    UPROPERTY()
+    FHotSpotHitMask HitMask;
     
 private:
+    void BakeHitMask();
+
     bool SpriteHidden = false;
 };
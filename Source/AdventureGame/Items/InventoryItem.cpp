@@ -7,6 +7,7 @@
 #include "AdventureGame/AdventureGame.h"
 
 #include "AdventureGame/Enums/VerbType.h"
+#include "AdventureGame/HUD/AdvGameUtils.h"
 #include "AdventureGame/Player/AdventurePlayerController.h"
 #include "AdventureGame/Player/ItemManager.h"
 
@@ -54,7 +55,7 @@ UItemDataAsset* UInventoryItem::ItemDataAssetForAction(const EVerbType Verb) con
     // TODO - remove this bit of code once the deprecated OnUseSuccessItem and OnGiveSuccessItem are gone
     if (Verb == EVerbType::UseItem)
     {
-        if (UItemDataAsset *UseItem = OnUseSuccessItem.LoadSynchronous())
+        if (UItemDataAsset *UseItem = AdvGameUtils::GetRoomAsset(OnUseSuccessItem))
         {
             UE_LOG(LogAdventureGame, Warning, TEXT("OnUseSuccessItem is deprecated in %s - use OnItemActivated instead"),
                 *(ShortDescription.ToString()));
@@ -63,7 +64,7 @@ UItemDataAsset* UInventoryItem::ItemDataAssetForAction(const EVerbType Verb) con
     }
     else if (Verb == EVerbType::GiveItem)
     {
-        if (UItemDataAsset *UseItem = OnGiveSuccessItem.LoadSynchronous())
+        if (UItemDataAsset *UseItem = AdvGameUtils::GetRoomAsset(OnGiveSuccessItem))
         {
             UE_LOG(LogAdventureGame, Warning, TEXT("OnGiveSuccessItem is deprecated in %s - use OnItemActivated instead"),
                 *(ShortDescription.ToString()));
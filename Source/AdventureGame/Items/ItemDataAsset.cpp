@@ -9,6 +9,7 @@
 #include "AdventureGame/Constants.h"
 #include "AdventureGame/Player/AdventurePlayerController.h"
 #include "AdventureGame/Enums/AdventureGameplayTags.h"
+#include "AdventureGame/Gameplay/SimulationClock.h"
 #include "AdventureGame/HotSpots/Door.h"
 #include "AdventureGame/Player/ItemManager.h"
 
@@ -129,7 +130,7 @@ void UItemDataAsset::StartTimer()
         GetWorld()->GetTimerManager().SetTimer(
             ActionHighlightTimerHandle, this,
             &UItemDataAsset::OnInteractionTimeout,
-            InteractionTimeout, false);
+            FSimulationClock::GetWait(InteractionTimeout), false);
     }
 }
 
@@ -5,10 +5,11 @@
 
 #include "ItemDataAsset.h"
 #include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/HUD/AdvGameUtils.h"
 
 UItemDataAsset *FItemDataWrapper::UnwrapItemDataAsset() const
 {
-    if (UItemDataAsset *UnwrappedItemDataAsset = ItemDataAsset.LoadSynchronous())
+    if (UItemDataAsset *UnwrappedItemDataAsset = AdvGameUtils::GetRoomAsset(ItemDataAsset))
         return UnwrappedItemDataAsset;
     UE_LOG(LogAdventureGame, Warning, TEXT("ItemDataAsset for %s is not loaded"), *ItemDataTitle);
     return nullptr;
@@ -4,8 +4,8 @@
 #include "ItemManagerProvider.h"
 
 #include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/Gameplay/AdvBlueprintFunctionLibrary.h"
 #include "AdventureGame/Player/CommandManager.h"
-#include "Kismet/GameplayStatics.h"
 
 
 // Add default functionality here for any IItemManagerProvider functions that are not pure virtual.
@@ -19,8 +19,7 @@ ACommandManager* IItemManagerProvider::GetCommandManager()
     if (ACommandManager* CommandManager = CachedCommandManager.Get()) return CommandManager;
     if (UObject *WorldContextObject = dynamic_cast<UObject *>(this))
     {
-        AActor* Actor = UGameplayStatics::GetActorOfClass(WorldContextObject, ACommandManager::StaticClass());
-        ACommandManager* CommandManager = Cast<ACommandManager>(Actor);
+        ACommandManager* CommandManager = UAdvBlueprintFunctionLibrary::GetCommandManager(WorldContextObject);
         if (!IsValid(CommandManager))
         {
             // Could happen if the level is being torn down or a loading of a save game is in progress
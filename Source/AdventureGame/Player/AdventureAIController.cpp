@@ -4,6 +4,7 @@
 #include "AdventureAIController.h"
 
 #include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/Gameplay/WalkPathManager.h"
 #include "Navigation/PathFollowingComponent.h"
 
 void AAdventureAIController::OnPossess(APawn* InPawn)
@@ -25,3 +26,19 @@ void AAdventureAIController::OnMoveCompleted(FAIRequestID RequestID, const FPath
 	UE_LOG(LogAdventureGame, Display, TEXT("OnMoveCompleted %s - %s"), *RequestID.ToString(), *Result.ToString());
 	MoveCompletedDelegate.Broadcast(Result.Code);
 }
+
+void AAdventureAIController::FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query,
+	FNavPathSharedPtr& OutPath) const
+{
+	UWalkPathManager* WalkPaths = UWalkPathManager::Get(this);
+	if (!WalkPaths || MoveRequest.IsMoveToActorRequest())
+	{
+		Super::FindPathForMoveRequest(MoveRequest, Query, OutPath);
+		return;
+	}
+	OutPath = WalkPaths->FindPath(Query);
+	if (OutPath.IsValid())
+	{
+		OutPath->EnableRecalculationOnInvalidation(true);
+	}
+}
@@ -22,5 +22,10 @@ public:
 	
 	virtual void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
 
+	/// Walks to a location take their path from the walk path manager, which
+	/// only asks the navigation system for a path it has not found before.
+	virtual void FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query,
+		FNavPathSharedPtr& OutPath) const override;
+
 	FMoveCompletedDelegate MoveCompletedDelegate;
 };
@@ -3,6 +3,7 @@
 #include "AdventureCharacter.h"
 
 #include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/Gameplay/AdventureWorldRegistry.h"
 #include "AdventureGame/HUD/AdvGameUtils.h"
 #include "AdventureGame/Enums/WalkDirection.h"
 #include "FollowCamera.h"
@@ -21,6 +22,12 @@ AAdventureCharacter::AAdventureCharacter()
 	Sphere->SetupAttachment(RootComponent);
 	Sphere->SetSphereRadius(4.0);
 	Sphere->SetRelativeLocation(FVector(0, -20, 0));
+	Sphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Sphere->SetGenerateOverlapEvents(false);
+
+	// What the player walks near is found by the world registry's proximity grid,
+	// so moving does not gather overlaps
+	GetCapsuleComponent()->SetGenerateOverlapEvents(false);
 	
 	OnClimbOverrideEndDelegate.BindUObject(this, &AAdventureCharacter::OnInteractAnimOverrideEnd);
 	OnInteractOverrideEndDelegate.BindUObject(this, &AAdventureCharacter::OnInteractAnimOverrideEnd);
@@ -45,13 +52,35 @@ void AAdventureCharacter::BeginPlay()
 	UE_LOG(LogAdventureGame, VeryVerbose, TEXT("AAdventureCharacter::BeginPlay"));
 }
 
+void AAdventureCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopPathMotion();
+	Super::EndPlay(EndPlayReason);
+}
+
 void AAdventureCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (IsFollowingPath())
+	{
+		TickFollowPath(DeltaTime);
+	}
+
 	// This is used just to feed in the PaperZD Set direction for the sprite facing
 	const UCharacterMovementComponent* MovementComponent = GetCharacterMovement();
 	FVector2D Velocity = FVector2D(MovementComponent->Velocity.X, MovementComponent->Velocity.Y);
+	const bool bIsMoving = !Velocity.IsNearlyZero();
+	if (bIsMoving && !bWasMoving)
+	{
+		StartedMovingDelegate.Broadcast();
+	}
+	bWasMoving = bIsMoving;
+	if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+	{
+		// Returns straight away when the player has not moved
+		Registry->UpdateProximity(GetActorLocation());
+	}
 	if (AdvGameUtils::HasChangedMuch(Velocity, LastVelocity))
 	{
 		LastVelocity = Velocity;
@@ -194,6 +223,154 @@ void AAdventureCharacter::TeleportToLocation(FVector NewLocation)
 	SetActorLocation(FVector(NewLocation.X, NewLocation.Y, ZValue));
 }
 
+void AAdventureCharacter::FollowPath(const TArray<FVector>& Points)
+{
+	if (Points.IsEmpty()) return;
+	StopPathMotion();
+	if (bAnalyticPathMovement)
+	{
+		PathPoint = INDEX_NONE;
+		PathPoints.Reset();
+		StartPathMotion(Points);
+		return;
+	}
+	PathPoints = Points;
+	// The first point is where the character is now
+	PathPoint = FMath::Min(1, Points.Num() - 1);
+	PathClosestDistance = TNumericLimits<double>::Max();
+	PathStuckSeconds = 0.0f;
+}
+
+void AAdventureCharacter::StopFollowingPath()
+{
+	if (!IsFollowingPath()) return;
+	if (PathMotion.IsActive())
+	{
+		// Stop where the character would be now, not where it was last drawn
+		ApplyPathMotion(GetWorld()->GetTimeSeconds());
+		StopPathMotion();
+		return;
+	}
+	PathPoint = INDEX_NONE;
+	PathPoints.Reset();
+	GetCharacterMovement()->StopMovementImmediately();
+}
+
+void AAdventureCharacter::TickFollowPath(float DeltaTime)
+{
+	const FVector2D ToPoint(PathPoints[PathPoint] - GetActorLocation());
+	const double Distance = ToPoint.Size();
+	if (Distance <= FMath::Max(GetCharacterMovement()->GetMaxSpeed() * DeltaTime, 1.0))
+	{
+		// Within a frame's walk of the point, so on to the next one
+		if (++PathPoint < PathPoints.Num())
+		{
+			PathClosestDistance = TNumericLimits<double>::Max();
+			PathStuckSeconds = 0.0f;
+			return;
+		}
+		StopFollowingPath();
+		PathFollowedDelegate.Broadcast(true);
+		return;
+	}
+	if (Distance < PathClosestDistance - 0.5)
+	{
+		PathClosestDistance = Distance;
+		PathStuckSeconds = 0.0f;
+	}
+	else if ((PathStuckSeconds += DeltaTime) > PathStuckTime)
+	{
+		UE_LOG(LogAdventureGame, Verbose, TEXT("AAdventureCharacter::TickFollowPath - stuck %.1f from %s"),
+			Distance, *PathPoints[PathPoint].ToString());
+		StopFollowingPath();
+		PathFollowedDelegate.Broadcast(false);
+		return;
+	}
+	AddMovementInput(FVector(ToPoint / Distance, 0.0));
+}
+
+void AAdventureCharacter::StartPathMotion(const TArray<FVector>& Points)
+{
+	const UWorld* World = GetWorld();
+	UCharacterMovementComponent* MovementComponent = GetCharacterMovement();
+	MovementComponent->StopMovementImmediately();
+	PathMotion.Start(Points, MovementComponent->GetMaxSpeed(), World->GetTimeSeconds());
+
+	// Nothing needs stepping until the end of the walk, which the timer catches
+	MovementComponent->SetComponentTickEnabled(false);
+	SetActorTickEnabled(false);
+	PathMotionSampleHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &AAdventureCharacter::SamplePathMotion);
+	GetWorldTimerManager().SetTimer(PathMotionTimer, this, &AAdventureCharacter::OnPathMotionFinished,
+		FMath::Max(PathMotion.GetDuration(), UE_KINDA_SMALL_NUMBER), false);
+
+	ApplyPathMotion(PathMotion.GetStartTime());
+	if (PathMotion.GetLength() > 0.0)
+	{
+		StartedMovingDelegate.Broadcast();
+	}
+}
+
+void AAdventureCharacter::ApplyPathMotion(double Time)
+{
+	FVector2D Direction;
+	const FVector Location = PathMotion.Sample(Time, Direction);
+	SetActorLocation(Location);
+
+	// The animation blueprint picks walking and the sprite's facing from the
+	// velocity, which the movement component is not ticking to set
+	const FVector2D Velocity = PathMotion.IsFinished(Time) ? FVector2D::ZeroVector : Direction * PathMotion.GetSpeed();
+	GetCharacterMovement()->Velocity = FVector(Velocity, 0.0);
+	LastVelocity = Velocity;
+	if (!Velocity.IsNearlyZero())
+	{
+		LastNonZeroMovement = Velocity;
+	}
+	if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+	{
+		Registry->UpdateProximity(Location);
+	}
+}
+
+void AAdventureCharacter::SamplePathMotion(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld()) return;
+	if (WasRecentlyRendered())
+	{
+		ApplyPathMotion(World->GetTimeSeconds());
+		return;
+	}
+	// Off screen nothing sees where the character is until the walk ends, but the
+	// proximity triggers it walks through still fire
+	if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+	{
+		FVector2D Direction;
+		Registry->UpdateProximity(PathMotion.Sample(World->GetTimeSeconds(), Direction));
+	}
+}
+
+void AAdventureCharacter::OnPathMotionFinished()
+{
+	ApplyPathMotion(PathMotion.GetEndTime());
+	StopPathMotion();
+	PathFollowedDelegate.Broadcast(true);
+}
+
+void AAdventureCharacter::StopPathMotion()
+{
+	if (!PathMotion.IsActive()) return;
+	PathMotion.Reset();
+	FWorldDelegates::OnWorldPreActorTick.Remove(PathMotionSampleHandle);
+	PathMotionSampleHandle.Reset();
+	GetWorldTimerManager().ClearTimer(PathMotionTimer);
+
+	UCharacterMovementComponent* MovementComponent = GetCharacterMovement();
+	MovementComponent->Velocity = FVector::ZeroVector;
+	LastVelocity = FVector2D::ZeroVector;
+	bWasMoving = false;
+	MovementComponent->SetComponentTickEnabled(true);
+	SetActorTickEnabled(true);
+}
+
 void AAdventureCharacter::SetFacingDirection(EWalkDirection Direction)
 {
 	switch (Direction)
@@ -234,8 +411,8 @@ void AAdventureCharacter::SetupCamera()
 	UCapsuleComponent* CapsuleComp = GetCapsuleComponent();
 	check(CapsuleComp);
 
-	AActor *CameraActor = UGameplayStatics::GetActorOfClass(GetWorld(), AFollowCamera::StaticClass());
-	AFollowCamera *Camera = Cast<AFollowCamera>(CameraActor);
+	const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+	AFollowCamera *Camera = Registry ? Registry->GetFollowCamera() : nullptr;
 	if (IsValid(Camera))
 	{
 		Camera->PlayerCharacter = this;
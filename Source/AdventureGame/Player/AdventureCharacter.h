@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "AdventurePlayerController.h"
 #include "AdventureGame/Dialog/BarkText.h"
+#include "PathMotion.h"
 #include "PaperZDCharacter.h"
 #include "PaperZDAnimInstance.h"
 #include "AdventureCharacter.generated.h"
@@ -13,6 +14,7 @@ enum class EWalkDirection : uint8;
 class UWidgetComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FCharacterAnimComplete, EInteractionType, Interaction, bool, Complete);
+DECLARE_MULTICAST_DELEGATE_OneParam(FPathFollowed, bool /* bReached */);
 
 /**
  * 
@@ -29,6 +31,8 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void Tick(float DeltaTime) override;
 
 	//////////////////////////////////
@@ -118,7 +122,74 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Movement, meta=(AllowPrivateAccess=true))
 	float MinZValue = 5.0f;
 
+	void TickFollowPath(float DeltaTime);
+
+	TArray<FVector> PathPoints;
+
+	/// Index of the point being walked to, or none if not following a path.
+	int32 PathPoint = INDEX_NONE;
+
+	/// Closest the character has been to the point, and how long since it got any closer.
+	double PathClosestDistance = 0.0;
+
+	float PathStuckSeconds = 0.0f;
+
+	bool bWasMoving = false;
+
+	/// The path being walked as a function of time, when the movement component is not used.
+	FPathMotion PathMotion;
+
+	/// Fires when the path motion reaches its end, whether or not the character is on screen.
+	FTimerHandle PathMotionTimer;
+
+	FDelegateHandle PathMotionSampleHandle;
+
+	void StartPathMotion(const TArray<FVector>& Points);
+
+	/// Place the character where the path motion has it at the time, with the
+	/// velocity and facing of the segment it is on for the animation.
+	void ApplyPathMotion(double Time);
+
+	/// Once a frame before the actors tick, so the camera follows where the
+	/// character is placed, while walking a path motion. Off screen only the
+	/// proximity triggers are updated, the character is not moved.
+	void SamplePathMotion(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void OnPathMotionFinished();
+
+	/// End the path motion, leaving the character where it was last placed, and
+	/// turn its tick and the movement component's back on.
+	void StopPathMotion();
+
 public:
+	/// Walk along the straight lines between the points, eg from a walk area,
+	/// steering the movement component directly instead of through the AI
+	/// controller's path following. PathFollowedDelegate is fired at the end.
+	void FollowPath(const TArray<FVector>& Points);
+
+	/// Stop following the path where the character is, without firing PathFollowedDelegate.
+	void StopFollowingPath();
+
+	bool IsFollowingPath() const { return PathPoint != INDEX_NONE || PathMotion.IsActive(); }
+
+	const FPathMotion& GetPathMotion() const { return PathMotion; }
+
+	/// Walk paths as a function of the time since setting off, with the movement
+	/// component and this character's tick off until the end. The character is
+	/// only placed on frames it is rendered. Otherwise paths are walked by
+	/// steering the movement component every tick.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Movement)
+	bool bAnalyticPathMovement = true;
+
+	FPathFollowed PathFollowedDelegate;
+
+	/// Fired on the tick the character goes from standing still to moving.
+	FSimpleMulticastDelegate StartedMovingDelegate;
+
+	/// Seconds a path can go without getting any closer to its next point, eg
+	/// when walking into an NPC, before it is given up on.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Movement)
+	float PathStuckTime = 1.0f;
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Gameplay)
 	FVector2D LastNonZeroMovement = FVector2D::ZeroVector;
@@ -0,0 +1,179 @@
+// (c) 2025 Sarah Smith
+
+
+#include "AdventureCheatManager.h"
+
+#include "CommandManager.h"
+#include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/Gameplay/AdventureGameInstance.h"
+#include "AdventureGame/Gameplay/AdventureWorldRegistry.h"
+#include "AdventureGame/Gameplay/CommandRecorder.h"
+#include "AdventureGame/Gameplay/SimulationClock.h"
+#include "AdventureGame/Gameplay/WalkPathManager.h"
+
+#include "Engine/Engine.h"
+#include "EngineUtils.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "UnrealEngine.h"
+
+void UAdventureCheatManager::ExportRoomTransitions()
+{
+    const UAdventureGameInstance* GameInstance = GetAdventureGameInstance();
+    if (!GameInstance) return;
+
+    const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(),
+        FString::Printf(TEXT("RoomTransitions-%s.csv"), *FDateTime::Now().ToString()));
+    GameInstance->GetRoomTransitionLog().SaveCsv(FilePath);
+}
+
+void UAdventureCheatManager::ReportTicks()
+{
+    const UWorld* World = GetWorld();
+    if (!World) return;
+
+    int32 Registered = 0;
+    int32 Enabled = 0;
+    int32 EnabledByGroup[TG_MAX] = {};
+    TMap<FName, int32> EnabledByClass;
+    auto Count = [&](const FTickFunction& TickFunction, const UObject* Owner)
+    {
+        if (!TickFunction.IsTickFunctionRegistered()) return;
+        ++Registered;
+        if (!TickFunction.IsTickFunctionEnabled()) return;
+        ++Enabled;
+        ++EnabledByGroup[TickFunction.TickGroup];
+        ++EnabledByClass.FindOrAdd(Owner->GetClass()->GetFName());
+    };
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        Count(It->PrimaryActorTick, *It);
+        for (const UActorComponent* Component : It->GetComponents())
+        {
+            Count(Component->PrimaryComponentTick, Component);
+        }
+    }
+
+    UE_LOG(LogAdventureGame, Display, TEXT("ReportTicks - %d tick functions registered, %d enabled, average frame %.3f ms"),
+        Registered, Enabled, GAverageMS);
+    for (int32 Group = 0; Group < TG_MAX; ++Group)
+    {
+        if (EnabledByGroup[Group] == 0) continue;
+        UE_LOG(LogAdventureGame, Display, TEXT("    %s: %d"),
+            *StaticEnum<ETickingGroup>()->GetNameStringByValue(Group), EnabledByGroup[Group]);
+    }
+    EnabledByClass.ValueSort(TGreater<int32>());
+    for (const TPair<FName, int32>& Class : EnabledByClass)
+    {
+        UE_LOG(LogAdventureGame, Display, TEXT("    %s: %d"), *Class.Key.ToString(), Class.Value);
+    }
+}
+
+void UAdventureCheatManager::RecordCommands()
+{
+    if (UCommandRecorder* Recorder = UCommandRecorder::Get(GetWorld()))
+    {
+        Recorder->StartRecording();
+    }
+}
+
+void UAdventureCheatManager::StopRecordingCommands(const FString& SlotName)
+{
+    if (UCommandRecorder* Recorder = UCommandRecorder::Get(GetWorld()))
+    {
+        Recorder->StopRecording(SlotName);
+    }
+}
+
+void UAdventureCheatManager::ReplayCommands(const FString& SlotName)
+{
+    if (UCommandRecorder* Recorder = UCommandRecorder::Get(GetWorld()))
+    {
+        Recorder->StartReplay(SlotName);
+    }
+}
+
+void UAdventureCheatManager::ReportSimulation()
+{
+    if (!FSimulationClock::IsFastForward())
+    {
+        UE_LOG(LogAdventureGame, Display, TEXT("UAdventureCheatManager::ReportSimulation - not in fast forward, start with -FastForward"));
+        return;
+    }
+    FSimulationClock::ReportThroughput(TEXT("UAdventureCheatManager::ReportSimulation"));
+}
+
+void UAdventureCheatManager::ReportPathing()
+{
+    const UAdventureGameInstance* GameInstance = GetAdventureGameInstance();
+    const UWalkPathManager* WalkPaths = UWalkPathManager::Get(GetWorld());
+    if (!GameInstance || !WalkPaths) return;
+
+    const FName LevelName = GameInstance->CurrentLevelName;
+    const FPathQueryCache& Cache = WalkPaths->GetCache();
+    UE_LOG(LogAdventureGame, Display, TEXT("UAdventureCheatManager::ReportPathing - %d cached paths, %d in the %s walk graph, %s"),
+        Cache.Num(), Cache.GetGraphPathCount(LevelName), *LevelName.ToString(), *Cache.GetStats().ToString());
+}
+
+void UAdventureCheatManager::CompareWalkArea(int32 Queries)
+{
+    if (const UWalkPathManager* WalkPaths = UWalkPathManager::Get(GetWorld()))
+    {
+        WalkPaths->CompareWalkArea(Queries > 0 ? Queries : 1000);
+    }
+}
+
+void UAdventureCheatManager::ReportLatency()
+{
+    const ACommandManager* CommandManager = GetCommandManager();
+    if (!CommandManager) return;
+
+    const TArray<FString> Lines = CommandManager->GetCommandLatency().ToLines();
+    for (const FString& Line : Lines)
+    {
+        UE_LOG(LogAdventureGame, Display, TEXT("UAdventureCheatManager::ReportLatency - %s"), *Line);
+    }
+    ShowOnScreen(Lines);
+}
+
+void UAdventureCheatManager::ExportLatency()
+{
+    const ACommandManager* CommandManager = GetCommandManager();
+    if (!CommandManager) return;
+
+    CommandManager->GetCommandLatency().SaveCsv(FPaths::Combine(FPaths::ProfilingDir(),
+        FString::Printf(TEXT("CommandLatency-%s.csv"), *FDateTime::Now().ToString())));
+}
+
+void UAdventureCheatManager::ReportPrefetch()
+{
+    const ACommandManager* CommandManager = GetCommandManager();
+    if (!CommandManager) return;
+
+    const FString Report = CommandManager->GetHoverPrefetch().GetStats().ToString();
+    UE_LOG(LogAdventureGame, Display, TEXT("UAdventureCheatManager::ReportPrefetch - %s"), *Report);
+    ShowOnScreen({ Report });
+}
+
+UAdventureGameInstance* UAdventureCheatManager::GetAdventureGameInstance() const
+{
+    const UWorld* World = GetWorld();
+    return World ? Cast<UAdventureGameInstance>(World->GetGameInstance()) : nullptr;
+}
+
+const ACommandManager* UAdventureCheatManager::GetCommandManager() const
+{
+    const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(GetWorld());
+    return Registry ? Registry->GetCommandManager() : nullptr;
+}
+
+void UAdventureCheatManager::ShowOnScreen(const TArray<FString>& Lines)
+{
+#if !UE_BUILD_SHIPPING
+    // Messages without a key are drawn newest first, so add the last line first
+    for (int32 Index = Lines.Num() - 1; Index >= 0 && GEngine; --Index)
+    {
+        GEngine->AddOnScreenDebugMessage(INDEX_NONE, 10.0f, FColor::Cyan, Lines[Index]);
+    }
+#endif
+}
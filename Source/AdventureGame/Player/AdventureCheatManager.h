@@ -0,0 +1,77 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CheatManager.h"
+
+#include "AdventureCheatManager.generated.h"
+
+class ACommandManager;
+class UAdventureGameInstance;
+
+/**
+ * Console commands for profiling and diagnosing the game, kept out of the game
+ * instance and the subsystems they report on. A cheat manager is only made for
+ * the player controller in builds with cheats, so none of these are in shipping.
+ */
+UCLASS()
+class ADVENTUREGAME_API UAdventureCheatManager : public UCheatManager
+{
+    GENERATED_BODY()
+public:
+    /// Write the room transition log as CSV to the Saved/Profiling folder.
+    UFUNCTION(Exec)
+    void ExportRoomTransitions();
+
+    /// Log how many tick functions are registered and enabled, by tick group and
+    /// by class, with the average frame time, to see what an idle room costs.
+    UFUNCTION(Exec)
+    void ReportTicks();
+
+    /// Record the player's commands from the next frame of play, write them to a
+    /// save game slot, and replay them. See UCommandRecorder.
+    UFUNCTION(Exec)
+    void RecordCommands();
+
+    UFUNCTION(Exec)
+    void StopRecordingCommands(const FString& SlotName);
+
+    UFUNCTION(Exec)
+    void ReplayCommands(const FString& SlotName);
+
+    /// Log the throughput of a fast forward run so far. See FSimulationClock.
+    UFUNCTION(Exec)
+    void ReportSimulation();
+
+    /// Log the walk path cache's hit rate and time per path query. See UWalkPathManager.
+    UFUNCTION(Exec)
+    void ReportPathing();
+
+    /// Time paths in the current room's walk area against the navigation system,
+    /// and compare their memory. See UWalkAreaComponent.
+    UFUNCTION(Exec)
+    void CompareWalkArea(int32 Queries);
+
+    /// Show the p50, p95 and p99 latency of each stage of the player's commands,
+    /// from click to interaction, on screen and in the log, and write them as CSV
+    /// to the Saved/Profiling folder. See FCommandLatencyTracker.
+    UFUNCTION(Exec)
+    void ReportLatency();
+
+    UFUNCTION(Exec)
+    void ExportLatency();
+
+    /// Log how often clicks found the interaction text, recipe and bark worked out
+    /// while the cursor rested on a hotspot. See FHoverPrefetchCache.
+    UFUNCTION(Exec)
+    void ReportPrefetch();
+
+private:
+    UAdventureGameInstance* GetAdventureGameInstance() const;
+
+    const ACommandManager* GetCommandManager() const;
+
+    /// Show lines on screen, newest at the bottom, in builds with debug output.
+    static void ShowOnScreen(const TArray<FString>& Lines);
+};
@@ -5,11 +5,13 @@
 
 #include "AdventureAIController.h"
 #include "AdventureCharacter.h"
+#include "AdventureCheatManager.h"
 #include "Puck.h"
 
 #include "AdventureGame/AdventureGame.h"
 #include "AdventureGame/Gameplay/AdventureSave.h"
 #include "AdventureGame/Gameplay/AdventureGameInstance.h"
+#include "AdventureGame/Gameplay/AdventureWorldRegistry.h"
 #include "AdventureGame/HUD/AdvGameUtils.h"
 #include "AdventureGame/HUD/AdventureGameHUD.h"
 #include "AdventureGame/HUD/ItemSlot.h"
@@ -27,7 +29,9 @@ AAdventurePlayerController::AAdventurePlayerController()
 {
     SetShowMouseCursor(true);
     DefaultMouseCursor = EMouseCursor::Crosshairs;
-    bEnableMouseOverEvents = true;
+    CheatClass = UAdventureCheatManager::StaticClass();
+    // Hover is hit tested against the spatial index in UpdateHoveredHotSpot
+    bEnableMouseOverEvents = false;
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("Construct: AAdventurePlayerController"));
 }
 
@@ -62,6 +66,12 @@ void AAdventurePlayerController::BeginPlay()
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("<<<< BeginPlay: AAdventurePlayerController"));
 }
 
+void AAdventurePlayerController::PlayerTick(float DeltaTime)
+{
+    Super::PlayerTick(DeltaTime);
+    UpdateHoveredHotSpot();
+}
+
 void AAdventurePlayerController::OnSaveGameComplete(const FString& SlotName, const int32 UserIndex, bool Success)
 {
     Command->SetInputLocked(false);
@@ -123,8 +133,8 @@ void AAdventurePlayerController::SetupAnimationDelegates()
 
 void AAdventurePlayerController::SetupCommandManager()
 {
-    AActor* Actor = UGameplayStatics::GetActorOfClass(GetWorld(), ACommandManager::StaticClass());
-    if (ACommandManager* CommandManager = Cast<ACommandManager>(Actor))
+    const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+    if (ACommandManager* CommandManager = Registry ? Registry->GetCommandManager() : nullptr)
     {
         UE_LOG(LogAdventureGame, Display, TEXT("Found ACommandManager in scene, using it"));
         Command = CommandManager;
@@ -132,8 +142,7 @@ void AAdventurePlayerController::SetupCommandManager()
     else
     {
         UE_LOG(LogAdventureGame, Display, TEXT("Spawning %s - none found in scene"), *CommandManagerToSpawn->GetName());
-        Actor = GetWorld()->SpawnActor(CommandManagerToSpawn);
-        Command = Cast<ACommandManager>(Actor);
+        Command = Cast<ACommandManager>(GetWorld()->SpawnActor(CommandManagerToSpawn));
     }
 }
 
@@ -220,11 +229,9 @@ void AAdventurePlayerController::EndTaskAction(EInteractionType InteractionType,
 
 AHotSpot* AAdventurePlayerController::HotSpotClicked()
 {
-    FHitResult HitResult;
-    GetHitResultUnderCursor(ECC_Visibility, true, HitResult);
-    if (!HitResult.IsValidBlockingHit()) return nullptr;
-    AActor* HitActor = HitResult.GetActor();
-    if (AHotSpot* HotSpot = Cast<AHotSpot>(HitActor))
+    float LocationX, LocationY;
+    if (!GetMousePosition(LocationX, LocationY)) return nullptr;
+    if (AHotSpot* HotSpot = HotSpotAt(LocationX, LocationY))
     {
 #if WITH_EDITOR
         FString HotSpotMessage = FString::Printf(TEXT("Got HotSpot: %s"), *HotSpot->GetName());
@@ -239,11 +246,7 @@ AHotSpot* AAdventurePlayerController::HotSpotClicked()
 
 AHotSpot* AAdventurePlayerController::HotSpotTapped(float X, float Y)
 {
-    FHitResult HitResult;
-    GetHitResultUnderFinger(ETouchIndex::Type::Touch1, ECC_Visibility, true, HitResult);
-    if (!HitResult.IsValidBlockingHit()) return nullptr;
-    AActor* HitActor = HitResult.GetActor();
-    if (AHotSpot* HotSpot = Cast<AHotSpot>(HitActor))
+    if (AHotSpot* HotSpot = HotSpotAt(X, Y))
     {
         UE_LOG(LogAdventureGame, VeryVerbose, TEXT("Got HotSpot: %s"), *HotSpot->GetName());
         return HotSpot;
@@ -251,6 +254,60 @@ AHotSpot* AAdventurePlayerController::HotSpotTapped(float X, float Y)
     return nullptr;
 }
 
+AHotSpot* AAdventurePlayerController::HotSpotAt(float LocationX, float LocationY) const
+{
+    FVector WorldLocation;
+    if (!GetWorldPosition(LocationX, LocationY, WorldLocation)) return nullptr;
+    const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+    return Registry ? Registry->FindHotSpotAt(FVector2D(WorldLocation)) : nullptr;
+}
+
+bool AAdventurePlayerController::GetWorldPosition(float LocationX, float LocationY, FVector& OutWorldLocation) const
+{
+    FVector WorldDirection;
+    if (!DeprojectScreenPositionToWorld(LocationX, LocationY, OutWorldLocation, WorldDirection)) return false;
+    // Looking down on the room the ray is straight down, but follow it to the
+    // player's height in case the camera is tilted.
+    if (PlayerCharacter && !FMath::IsNearlyZero(WorldDirection.Z))
+    {
+        const double PlayerZ = PlayerCharacter->GetActorLocation().Z;
+        OutWorldLocation += WorldDirection * ((PlayerZ - OutWorldLocation.Z) / WorldDirection.Z);
+    }
+    return true;
+}
+
+void AAdventurePlayerController::UpdateHoveredHotSpot()
+{
+    float LocationX, LocationY;
+    FVector WorldLocation;
+    if (!GetMousePosition(LocationX, LocationY) || !GetWorldPosition(LocationX, LocationY, WorldLocation)) return;
+    if (!WorldLocation.Equals(LastHoverLocation, 0.5))
+    {
+        LastHoverLocation = WorldLocation;
+        const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+        AHotSpot* HotSpot = Registry ? Registry->FindHotSpotAt(FVector2D(WorldLocation)) : nullptr;
+        if (HotSpot != HoveredHotSpot.Get())
+        {
+            if (AHotSpot* Previous = HoveredHotSpot.Get())
+            {
+                Previous->OnEndCursorOver(Previous);
+            }
+            HoveredHotSpot = HotSpot;
+            if (HotSpot)
+            {
+                HotSpot->OnBeginCursorOver(HotSpot);
+            }
+        }
+    }
+
+    // Dwell is timed while the cursor is still, so this is checked every frame
+    if (HoverIntent.Update(HoveredHotSpot.Get(), FVector2D(LocationX, LocationY), GetWorld()->GetRealTimeSeconds())
+        && Command)
+    {
+        Command->PrefetchHotSpot(HoveredHotSpot.Get());
+    }
+}
+
 void AAdventurePlayerController::PlayerClimb(int32 UID, EInteractTimeDirection InteractDirection)
 {
     PlayerClimbUID = UID;
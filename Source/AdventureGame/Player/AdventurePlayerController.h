@@ -55,6 +55,8 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void PlayerTick(float DeltaTime) override;
+
 	//////////////////////////////////
 	///
 	/// SAVE AND LOAD GAME
@@ -173,7 +175,26 @@ public:
 
 	/// Get the Hotspot under the tap location, or null if no hotspot was found
 	AHotSpot *HotSpotTapped(float LocationX, float LocationY);
-	
+
+	/// Get the Hotspot under a screen position from the world registry's spatial
+	/// index, without tracing against the physics scene.
+	AHotSpot *HotSpotAt(float LocationX, float LocationY) const;
+
+private:
+	/// Where the cursor is in the room, projected to the player's height.
+	bool GetWorldPosition(float LocationX, float LocationY, FVector& OutWorldLocation) const;
+
+	/// Send cursor enter and leave to hotspots as the cursor, or the camera, moves,
+	/// and have the command manager prefetch for the click when the cursor rests.
+	void UpdateHoveredHotSpot();
+
+	TWeakObjectPtr<AHotSpot> HoveredHotSpot;
+
+	FHoverIntent HoverIntent;
+
+	FVector LastHoverLocation = FVector(std::numeric_limits<float>::max());
+
+public:
 	//////////////////////////////////
 	///
 	/// INITIALISATION
@@ -4,6 +4,7 @@
 #include "BarkProvider.h"
 
 #include "AdventurePlayerController.h"
+#include "AdventureGame/Gameplay/AdvBlueprintFunctionLibrary.h"
 
 
 // Add default functionality here for any IBarkProvider functions that are not pure virtual.
@@ -22,9 +23,8 @@ ACommandManager *Local_GetCommandManager(IBarkProvider *ContextObject)
     if (const UObject *Context = dynamic_cast<UObject *>(ContextObject))
     {
         // Don't bother caching the dynamic_cast x 2 above as they're fast compared to
-        // get actor of class, and likely faster even than TWeakObjectPtr.Get
-        AActor* Actor = UGameplayStatics::GetActorOfClass(Context, ACommandManager::StaticClass());
-        if (ACommandManager* CommandManager = Cast<ACommandManager>(Actor))
+        // the registry lookup, and likely faster even than TWeakObjectPtr.Get
+        if (ACommandManager* CommandManager = UAdvBlueprintFunctionLibrary::GetCommandManager(Context))
         {
             CachedCommandManager = CommandManager;
             return CommandManager;
@@ -0,0 +1,194 @@
+// (c) 2025 Sarah Smith
+
+
+#include "CommandLatency.h"
+
+#include "AdventureGame/AdventureGame.h"
+
+#include "Misc/FileHelper.h"
+
+const TCHAR* CommandStageName(ECommandStage Stage)
+{
+    switch (Stage)
+    {
+    case ECommandStage::Input:
+        return TEXT("Input");
+    case ECommandStage::Dispatched:
+        return TEXT("Dispatched");
+    case ECommandStage::PathRequested:
+        return TEXT("PathRequested");
+    case ECommandStage::MoveStarted:
+        return TEXT("MoveStarted");
+    case ECommandStage::Arrived:
+        return TEXT("Arrived");
+    case ECommandStage::MovementComplete:
+        return TEXT("MovementComplete");
+    case ECommandStage::Interaction:
+        return TEXT("Interaction");
+    default:
+        return TEXT("Unknown");
+    }
+}
+
+FLatencyHistogram::FLatencyHistogram()
+{
+    Buckets.SetNumZeroed(GetBucketIndex((1ull << MaxMicrosecondBits) - 1) + 1);
+}
+
+int32 FLatencyHistogram::GetBucketIndex(uint64 Microseconds)
+{
+    // The first SubBucketCount buckets are a microsecond wide, after that each
+    // power of two is split into SubBucketCount buckets
+    if (Microseconds < SubBucketCount) return static_cast<int32>(Microseconds);
+    const int32 Shift = static_cast<int32>(FPlatformMath::FloorLog2_64(Microseconds)) - SubBucketBits;
+    return (Shift + 1) * SubBucketCount + static_cast<int32>((Microseconds >> Shift) - SubBucketCount);
+}
+
+uint64 FLatencyHistogram::GetBucketUpperBound(int32 Index)
+{
+    if (Index < SubBucketCount) return Index;
+    const int32 Shift = Index / SubBucketCount - 1;
+    const uint64 SubBucket = Index % SubBucketCount + SubBucketCount;
+    return ((SubBucket + 1) << Shift) - 1;
+}
+
+void FLatencyHistogram::Record(double Seconds)
+{
+    Seconds = FMath::Max(Seconds, 0.0);
+    const uint64 Microseconds = FMath::Min(static_cast<uint64>(Seconds * 1e6), (1ull << MaxMicrosecondBits) - 1);
+    ++Buckets[GetBucketIndex(Microseconds)];
+    ++Count;
+    TotalSeconds += Seconds;
+    MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+void FLatencyHistogram::Reset()
+{
+    FMemory::Memzero(Buckets.GetData(), Buckets.Num() * sizeof(uint32));
+    Count = 0;
+    TotalSeconds = 0.0;
+    MaxSeconds = 0.0;
+}
+
+double FLatencyHistogram::GetPercentile(double Percentile) const
+{
+    if (Count == 0) return 0.0;
+    const int64 Rank = FMath::Max<int64>(1, FMath::CeilToInt64(Percentile / 100.0 * Count));
+    int64 Seen = 0;
+    for (int32 Index = 0; Index < Buckets.Num(); ++Index)
+    {
+        Seen += Buckets[Index];
+        if (Seen >= Rank)
+        {
+            // No more than the longest recorded, which the top bucket can overstate
+            return FMath::Min(GetBucketUpperBound(Index) * 1e-6, MaxSeconds);
+        }
+    }
+    return MaxSeconds;
+}
+
+FString FLatencyHistogram::ToString() const
+{
+    return FString::Printf(TEXT("count %lld, p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms"), Count,
+        GetPercentile(50.0) * 1000.0, GetPercentile(95.0) * 1000.0, GetPercentile(99.0) * 1000.0,
+        MaxSeconds * 1000.0);
+}
+
+void FCommandLatencyTracker::BeginCommand()
+{
+    bIsTiming = true;
+    LastStage = static_cast<int32>(ECommandStage::Input);
+    InputTime = LastTime = FPlatformTime::Seconds();
+    InputFrame = LastFrame = GFrameCounter;
+}
+
+bool FCommandLatencyTracker::HasBegunThisFrame() const
+{
+    return bIsTiming && InputFrame == GFrameCounter;
+}
+
+void FCommandLatencyTracker::Stamp(ECommandStage Stage)
+{
+    const int32 Index = static_cast<int32>(Stage);
+    if (!bIsTiming || Index <= LastStage) return;
+
+    const double Now = FPlatformTime::Seconds();
+    FromPrevious[Index].Record(Now - LastTime);
+    FromInput[Index].Record(Now - InputTime);
+    TotalFrames[Index] += GFrameCounter - LastFrame;
+    LastStage = Index;
+    LastTime = Now;
+    LastFrame = GFrameCounter;
+}
+
+void FCommandLatencyTracker::EndCommand()
+{
+    if (!bIsTiming) return;
+    bIsTiming = false;
+    ++Completed;
+}
+
+void FCommandLatencyTracker::Reset()
+{
+    bIsTiming = false;
+    Completed = 0;
+    for (int32 Index = 0; Index < StageCount; ++Index)
+    {
+        FromPrevious[Index].Reset();
+        FromInput[Index].Reset();
+        TotalFrames[Index] = 0;
+    }
+}
+
+double FCommandLatencyTracker::GetMeanFrames(ECommandStage Stage) const
+{
+    const int32 Index = static_cast<int32>(Stage);
+    return FromPrevious[Index].GetCount() > 0
+        ? static_cast<double>(TotalFrames[Index]) / FromPrevious[Index].GetCount() : 0.0;
+}
+
+TArray<FString> FCommandLatencyTracker::ToLines() const
+{
+    TArray<FString> Lines;
+    Lines.Add(FString::Printf(TEXT("%lld commands completed"), Completed));
+    // Input is where the timing starts, so has no latency of its own
+    for (int32 Index = 1; Index < StageCount; ++Index)
+    {
+        const ECommandStage Stage = static_cast<ECommandStage>(Index);
+        if (FromPrevious[Index].GetCount() == 0) continue;
+        Lines.Add(FString::Printf(TEXT("%s: %s, %.1f frames; from input p50 %.2f ms, p95 %.2f ms, p99 %.2f ms"),
+            CommandStageName(Stage), *FromPrevious[Index].ToString(), GetMeanFrames(Stage),
+            FromInput[Index].GetPercentile(50.0) * 1000.0, FromInput[Index].GetPercentile(95.0) * 1000.0,
+            FromInput[Index].GetPercentile(99.0) * 1000.0));
+    }
+    return Lines;
+}
+
+FString FCommandLatencyTracker::ToCsv() const
+{
+    FString Csv = TEXT("Stage,Count,P50Ms,P95Ms,P99Ms,MeanMs,MaxMs,MeanFrames,FromInputP50Ms,FromInputP95Ms,FromInputP99Ms,FromInputMaxMs\n");
+    for (int32 Index = 1; Index < StageCount; ++Index)
+    {
+        const FLatencyHistogram& Stage = FromPrevious[Index];
+        const FLatencyHistogram& Total = FromInput[Index];
+        Csv += FString::Printf(TEXT("%s,%lld,%.3f,%.3f,%.3f,%.3f,%.3f,%.2f,%.3f,%.3f,%.3f,%.3f\n"),
+            CommandStageName(static_cast<ECommandStage>(Index)), Stage.GetCount(),
+            Stage.GetPercentile(50.0) * 1000.0, Stage.GetPercentile(95.0) * 1000.0, Stage.GetPercentile(99.0) * 1000.0,
+            Stage.GetMean() * 1000.0, Stage.GetMax() * 1000.0, GetMeanFrames(static_cast<ECommandStage>(Index)),
+            Total.GetPercentile(50.0) * 1000.0, Total.GetPercentile(95.0) * 1000.0, Total.GetPercentile(99.0) * 1000.0,
+            Total.GetMax() * 1000.0);
+    }
+    return Csv;
+}
+
+bool FCommandLatencyTracker::SaveCsv(const FString& FilePath) const
+{
+    if (!FFileHelper::SaveStringToFile(ToCsv(), *FilePath))
+    {
+        UE_LOG(LogAdventureGame, Warning, TEXT("FCommandLatencyTracker::SaveCsv - could not write %s"), *FilePath);
+        return false;
+    }
+    UE_LOG(LogAdventureGame, Display, TEXT("FCommandLatencyTracker::SaveCsv - %lld commands written to %s"),
+        Completed, *FilePath);
+    return true;
+}
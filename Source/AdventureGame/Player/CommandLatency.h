@@ -0,0 +1,146 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// Points a command passes on its way from the player's click to the
+/// interaction it asks for, in the order they are normally reached.
+enum class ECommandStage : uint8
+{
+    /// Click or tap handled, or a queued command started
+    Input,
+    /// Hit tested and passed to the command manager's click handling
+    Dispatched,
+    /// Path asked for, from the walk area or the AI controller
+    PathRequested,
+    /// The character's velocity went from zero to moving
+    MoveStarted,
+    /// Path following reported the end of the walk
+    Arrived,
+    /// The walk's end handled, on the tick after arrival
+    MovementComplete,
+    /// The verb sent to the hotspot
+    Interaction,
+    Num
+};
+
+const TCHAR* CommandStageName(ECommandStage Stage);
+
+///
+/// Histogram of durations in the style of HdrHistogram: buckets with the same
+/// relative width, so about 6% precision from a microsecond to hours, in a fixed
+/// 2KB with no allocation when recording.
+class ADVENTUREGAME_API FLatencyHistogram
+{
+public:
+    FLatencyHistogram();
+
+    void Record(double Seconds);
+
+    void Reset();
+
+    int64 GetCount() const { return Count; }
+
+    /// Duration that Percentile percent of those recorded are no longer than,
+    /// to within the width of its bucket, in seconds.
+    double GetPercentile(double Percentile) const;
+
+    double GetMean() const { return Count > 0 ? TotalSeconds / Count : 0.0; }
+
+    double GetMax() const { return MaxSeconds; }
+
+    /// "count 12, p50 1.20 ms, ..." for logs.
+    FString ToString() const;
+
+    /// Bucket a duration in microseconds is counted in.
+    static int32 GetBucketIndex(uint64 Microseconds);
+
+    /// Longest duration in microseconds counted in the bucket.
+    static uint64 GetBucketUpperBound(int32 Index);
+
+    static constexpr int32 SubBucketBits = 4;
+
+    static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+
+private:
+    /// Longest duration in microseconds kept apart from the rest, about 19 hours
+    static constexpr int32 MaxMicrosecondBits = 36;
+
+    TArray<uint32> Buckets;
+
+    int64 Count = 0;
+
+    double TotalSeconds = 0.0;
+
+    double MaxSeconds = 0.0;
+};
+
+///
+/// Times each command through the command manager by stamping it at each stage
+/// it reaches with the monotonic platform clock and the frame number. The time
+/// and frames since the stage before, and the time since input, are added to a
+/// histogram per stage, so waits for the next tick show up as well as walks.
+/// Stages are optional, eg a walk to a location has no interaction, and one
+/// that is already at its target never starts moving.
+class ADVENTUREGAME_API FCommandLatencyTracker
+{
+public:
+    /// Start timing a new command from now, dropping any that is running.
+    void BeginCommand();
+
+    /// Is a command being timed that began in this frame.
+    bool HasBegunThisFrame() const;
+
+    /// Record reaching the stage, if a command is being timed and has not
+    /// reached it or any later stage yet.
+    void Stamp(ECommandStage Stage);
+
+    /// Stop timing the command, eg after its interaction.
+    void EndCommand();
+
+    void Reset();
+
+    int64 GetCompletedCount() const { return Completed; }
+
+    /// Time from the stage before it that the command reached.
+    const FLatencyHistogram& GetStageLatency(ECommandStage Stage) const { return FromPrevious[static_cast<int32>(Stage)]; }
+
+    /// Time from input to the stage.
+    const FLatencyHistogram& GetLatencyFromInput(ECommandStage Stage) const { return FromInput[static_cast<int32>(Stage)]; }
+
+    /// Average frames from the stage before, to show waits for the next tick.
+    double GetMeanFrames(ECommandStage Stage) const;
+
+    /// A line per stage, for the log or the screen.
+    TArray<FString> ToLines() const;
+
+    /// One row per stage with the percentiles in milliseconds.
+    FString ToCsv() const;
+
+    /// Write ToCsv to a file. Returns false if it could not be written.
+    bool SaveCsv(const FString& FilePath) const;
+
+private:
+    static constexpr int32 StageCount = static_cast<int32>(ECommandStage::Num);
+
+    bool bIsTiming = false;
+
+    int32 LastStage = INDEX_NONE;
+
+    double InputTime = 0.0;
+
+    uint64 InputFrame = 0;
+
+    double LastTime = 0.0;
+
+    uint64 LastFrame = 0;
+
+    int64 Completed = 0;
+
+    FLatencyHistogram FromPrevious[StageCount];
+
+    FLatencyHistogram FromInput[StageCount];
+
+    uint64 TotalFrames[StageCount] = {};
+};
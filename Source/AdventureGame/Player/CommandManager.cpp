@@ -5,7 +5,16 @@
 
 #include "AdventureGame/HUD/AdventureGameHUD.h"
 #include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/HotSpots/Door.h"
 #include "AdventureGame/HotSpots/HotSpot.h"
+#include "AdventureGame/Gameplay/AdventureGameInstance.h"
+#include "AdventureGame/Gameplay/AdventureWorldRegistry.h"
+#include "AdventureGame/Gameplay/CommandRecorder.h"
+#include "AdventureGame/Gameplay/RoomStreamingManager.h"
+#include "AdventureGame/Gameplay/SimulationClock.h"
+#include "AdventureGame/Gameplay/WalkAreaComponent.h"
+#include "AdventureGame/HUD/AdvGameUtils.h"
+#include "AdventureGame/Items/InventoryItem.h"
 
 #include "AdventureAIController.h"
 #include "AdventureCharacter.h"
@@ -17,6 +26,7 @@
 #include "AdventureGame/Gameplay/AdventureGameMode.h"
 #include "AdventureGame/Gameplay/AdventureGameModeBase.h"
 
+#include "Engine/AssetManager.h"
 #include "GameFramework/PawnMovementComponent.h"
 #include "Components/CapsuleComponent.h"
 
@@ -33,8 +43,11 @@ void ShowLocationDebug(float LocationX, float LocationY, const FString& Location
 // Sets default values
 ACommandManager::ACommandManager()
 {
-    // Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+    // Only ticks when work has been scheduled for the end of the frame, see
+    // ScheduleInterruptCurrentAction and ScheduleMovementComplete.
     PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
+    PrimaryActorTick.TickGroup = TG_PostUpdateWork;
 
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("Construct: ACommandManager"));
 
@@ -43,6 +56,17 @@ ACommandManager::ACommandManager()
     PlayerBarkManager = CreateDefaultSubobject<UPlayerBarkManager>(TEXT("PlayerBark"));
 }
 
+// Registered before any actor in the level begins play, so they can all find it
+void ACommandManager::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+    {
+        Registry->RegisterActor(this);
+    }
+}
+
 // Called when the game starts or when spawned
 void ACommandManager::BeginPlay()
 {
@@ -50,12 +74,24 @@ void ACommandManager::BeginPlay()
 
     ConnectToMoveCompletedDelegate();
     SetupHUD();
+    CommandQueue = FPlayerCommandQueue(MaxQueuedCommands);
+    if (FSimulationClock::IsFastForward()) bTeleportInsteadOfWalk = true;
     
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("BeginPlay: ACommandManager"));
     if (!bDisableHUDUpdates) UpdateInteractionTextDelegate.Broadcast();
 }
 
-// Called every frame
+void ACommandManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    CancelDeferredPath();
+    if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+    {
+        Registry->UnregisterActor(this);
+    }
+    Super::EndPlay(EndPlayReason);
+}
+
+// Called at the end of a frame in which work was scheduled
 void ACommandManager::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
@@ -70,11 +106,45 @@ void ACommandManager::Tick(float DeltaTime)
         HandleMovementComplete();
         ShouldCompleteMovementNextTick = false;
     }
+    if (bShouldRunNextQueuedCommandOnNextTick)
+    {
+        bShouldRunNextQueuedCommandOnNextTick = false;
+        // If something else got started this frame the queue carries on when it ends
+        if (!IsBusy()) RunNextQueuedCommand();
+    }
+    // An interrupt waiting for a bark to finish is woken again by the bark manager
+    if (!ShouldInterruptCurrentActionOnNextTick() && !ShouldCompleteMovementNextTick
+        && !bShouldRunNextQueuedCommandOnNextTick)
+    {
+        SetActorTickEnabled(false);
+    }
+}
+
+void ACommandManager::ScheduleInterruptCurrentAction()
+{
+    bShouldInterruptCurrentActionOnNextTick = true;
+    WakeForPendingWork();
+}
+
+void ACommandManager::ScheduleMovementComplete()
+{
+    ShouldCompleteMovementNextTick = true;
+    WakeForPendingWork();
+}
+
+void ACommandManager::WakeForPendingWork()
+{
+    // The tick checks again whether a bark is holding up the interrupt
+    if (HasPendingWork())
+    {
+        SetActorTickEnabled(true);
+    }
 }
 
 void ACommandManager::SetInputLocked(bool bLocked)
 {
     bInputLocked = bLocked;
+    if (bLocked) CancelQueuedCommands();
 }
 
 bool ACommandManager::IsInputLocked() const
@@ -95,6 +165,9 @@ void ACommandManager::HandleTouchInput()
 
     if (IsInputLocked()) return;
 
+    CommandLatency.BeginCommand();
+    RecordCommand(FRecordedCommand());
+
     float LocationX, LocationY;
     AAdventurePlayerController* AdventurePlayerController = GetAdventurePlayerController();
     if (!AdventurePlayerController) return;
@@ -104,7 +177,7 @@ void ACommandManager::HandleTouchInput()
 
     if (AHotSpot* HotSpot = AdventurePlayerController->HotSpotTapped(LocationX, LocationY))
     {
-        HandleHotSpotClicked(HotSpot);
+        PerformClick(FRecordedCommand::HotSpotCommand(ERecordedCommandType::TapHotSpot, HotSpot), HotSpot);
     }
     else
     {
@@ -117,7 +190,7 @@ void ACommandManager::HandleTouchInput()
             const FVector PlayerLocation = APlayerCharacter->GetCapsuleComponent()->GetComponentLocation();
             MouseWorldLocation.Z = PlayerLocation.Z;
         }
-        HandleLocationClicked(MouseWorldLocation);
+        PerformClick(FRecordedCommand::LocationCommand(ERecordedCommandType::TapLocation, MouseWorldLocation));
     }
 }
 
@@ -131,10 +204,14 @@ void ACommandManager::HandlePointAndClickInput()
     AAdventurePlayerController* AdventurePlayerController = GetAdventurePlayerController();
     if (IsInputLocked() || !AdventurePlayerController) return;
 
+    CommandLatency.BeginCommand();
+    RecordCommand(FRecordedCommand());
+
+    const bool bQueueClick = ShouldQueueClick();
     if (AHotSpot* HotSpot = AdventurePlayerController->HotSpotClicked())
     {
-        SetVerbAndCommandFromHotSpot(HotSpot);
-        HandleHotSpotClicked(HotSpot);
+        PerformClick(FRecordedCommand::HotSpotCommand(
+            bQueueClick ? ERecordedCommandType::QueueHotSpot : ERecordedCommandType::ClickHotSpot, HotSpot), HotSpot);
     }
     else
     {
@@ -152,7 +229,117 @@ void ACommandManager::HandlePointAndClickInput()
             const FVector PlayerLocation = APlayerCharacter->GetCapsuleComponent()->GetComponentLocation();
             MouseWorldLocation.Z = PlayerLocation.Z;
         }
-        HandleLocationClicked(MouseWorldLocation);
+        PerformClick(FRecordedCommand::LocationCommand(
+            bQueueClick ? ERecordedCommandType::QueueLocation : ERecordedCommandType::ClickLocation, MouseWorldLocation));
+    }
+}
+
+void ACommandManager::PerformClick(const FRecordedCommand& Command, AHotSpot* HotSpot)
+{
+    RecordCommand(Command);
+    if (Command.Type != ERecordedCommandType::QueueHotSpot && Command.Type != ERecordedCommandType::QueueLocation)
+    {
+        // Replayed and test clicks come straight here
+        if (!CommandLatency.HasBegunThisFrame()) CommandLatency.BeginCommand();
+        CommandLatency.Stamp(ECommandStage::Dispatched);
+        // Queued clicks are counted when they come off the queue
+        FSimulationClock::CountCommand();
+    }
+    switch (Command.Type)
+    {
+    case ERecordedCommandType::QueueHotSpot:
+        QueueInteraction(HotSpot, HotSpot->CheckForDefaultCommand());
+        break;
+    case ERecordedCommandType::QueueLocation:
+        QueueWalkTo(Command.Location);
+        break;
+    case ERecordedCommandType::ClickHotSpot:
+        // A click that is not queued replaces whatever was queued
+        CancelQueuedCommands();
+        SetVerbAndCommandFromHotSpot(HotSpot);
+        HandleHotSpotClicked(HotSpot);
+        break;
+    case ERecordedCommandType::TapHotSpot:
+        // There is no way to queue a tap, so it replaces whatever was queued
+        CancelQueuedCommands();
+        HandleHotSpotClicked(HotSpot);
+        break;
+    case ERecordedCommandType::ClickLocation:
+    case ERecordedCommandType::TapLocation:
+        CancelQueuedCommands();
+        HandleLocationClicked(Command.Location);
+        break;
+    default:
+        break;
+    }
+}
+
+void ACommandManager::ReplayCommand(const FRecordedCommand& Command)
+{
+    UE_LOG(LogAdventureGame, Verbose, TEXT("ReplayCommand - %s"), *Command.ToString());
+    switch (Command.Type)
+    {
+    case ERecordedCommandType::UserInteraction:
+        InteractionNotifier->NotifyUserInteraction();
+        break;
+    case ERecordedCommandType::ClickHotSpot:
+    case ERecordedCommandType::TapHotSpot:
+    case ERecordedCommandType::QueueHotSpot:
+        {
+            const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+            AHotSpot* HotSpot = Registry ? Registry->FindHotSpot(Command.HotSpotLevel, Command.HotSpotName) : nullptr;
+            if (!HotSpot)
+            {
+                UE_LOG(LogAdventureGame, Warning, TEXT("ReplayCommand - no hotspot for %s, replay has diverged"),
+                       *Command.ToString());
+                break;
+            }
+            PerformClick(Command, HotSpot);
+        }
+        break;
+    case ERecordedCommandType::ClickLocation:
+    case ERecordedCommandType::TapLocation:
+    case ERecordedCommandType::QueueLocation:
+        PerformClick(Command);
+        break;
+    case ERecordedCommandType::AssignVerb:
+        AssignVerb(Command.Verb);
+        break;
+    case ERecordedCommandType::ClickInventoryItem:
+        if (Command.Item == EItemKind::None)
+        {
+            // Same as a click on an empty slot
+            InterruptCurrentAction();
+        }
+        else if (UItemSlot* ItemSlot = AdventureGameHUD ? AdventureGameHUD->InventoryUI->GetFromInventory(Command.Item) : nullptr)
+        {
+            HandleInventoryItemClicked(ItemSlot);
+        }
+        else
+        {
+            UE_LOG(LogAdventureGame, Warning, TEXT("ReplayCommand - no inventory slot for %s, replay has diverged"),
+                   *Command.ToString());
+        }
+        break;
+    case ERecordedCommandType::ChoosePrompt:
+        if (AdventureGameHUD) AdventureGameHUD->PromptList->PromptClickedEvent.Broadcast(Command.Prompt);
+        break;
+    }
+}
+
+void ACommandManager::RecordPromptClicked(int PromptIndex)
+{
+    FRecordedCommand Command;
+    Command.Type = ERecordedCommandType::ChoosePrompt;
+    Command.Prompt = PromptIndex;
+    RecordCommand(Command);
+}
+
+void ACommandManager::RecordCommand(const FRecordedCommand& Command) const
+{
+    if (UCommandRecorder* Recorder = UCommandRecorder::Get(this))
+    {
+        Recorder->Record(Command);
     }
 }
 
@@ -175,6 +362,7 @@ void ACommandManager::HandleHotSpotClicked(AHotSpot* HotSpot)
         CurrentHotSpot = HotSpot;
         ItemManager->SourceItem = nullptr;
         ItemManager->TargetItem = nullptr;
+        ClaimHoverPrefetch(HotSpot);
         PerformInstantAction();
         break;
     case EPlayerCommand::VerbPending:
@@ -183,6 +371,7 @@ void ACommandManager::HandleHotSpotClicked(AHotSpot* HotSpot)
         CurrentHotSpot = HotSpot;
         ItemManager->ClearSourceItem();
         ItemManager->ClearTargetItem();
+        ClaimHoverPrefetch(HotSpot);
         if (!bDisableHUDUpdates) BeginAction.Broadcast();
         WalkToHotSpot(HotSpot);
         break;
@@ -190,6 +379,7 @@ void ACommandManager::HandleHotSpotClicked(AHotSpot* HotSpot)
         CurrentCommand = EPlayerCommand::Active;
         CurrentHotSpot = HotSpot;
         ItemManager->ClearTargetItem();
+        ClaimHoverPrefetch(HotSpot);
         if (!bDisableHUDUpdates) BeginAction.Broadcast();
         WalkToHotSpot(HotSpot);
         break;
@@ -249,6 +439,61 @@ void ACommandManager::MouseLeaveHotSpot()
     }
 }
 
+void ACommandManager::PrefetchHotSpot(AHotSpot* HotSpot)
+{
+    if (!IsValid(HotSpot) || !CanBrowseHotspot()) return;
+    const UInventoryItem* SourceItem = ItemManager->SourceItem;
+    if ((CurrentVerb == EVerbType::GiveItem || CurrentVerb == EVerbType::UseItem) && SourceItem == nullptr) return;
+    const double Now = GetWorld()->GetRealTimeSeconds();
+    if (HoverPrefetch.Find(HotSpot, CurrentVerb, SourceItem, Now)) return;
+
+    FHoverPrefetch Prefetch;
+    Prefetch.HotSpot = HotSpot;
+    Prefetch.Verb = CurrentVerb;
+    Prefetch.SourceItem = SourceItem;
+    Prefetch.InteractionText = AdvGameUtils::GetHotSpotInteractionText(HotSpot, CurrentVerb, SourceItem);
+    TArray<FSoftObjectPath> Assets;
+    HotSpot->GetAssetsForAction(CurrentVerb, Assets);
+    if (!Assets.IsEmpty())
+    {
+        // Streamed in now so the click does not load the recipe synchronously
+        const TWeakObjectPtr<AHotSpot> WeakHotSpot = HotSpot;
+        const TWeakObjectPtr<const UInventoryItem> WeakSourceItem = SourceItem;
+        const EVerbType Verb = CurrentVerb;
+        Prefetch.AssetHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Assets,
+            FStreamableDelegate::CreateWeakLambda(this, [this, WeakHotSpot, WeakSourceItem, Verb]
+            {
+                if (FHoverPrefetch* Loaded = HoverPrefetch.Find(WeakHotSpot.Get(), Verb, WeakSourceItem.Get(),
+                    GetWorld()->GetRealTimeSeconds()))
+                {
+                    ResolvePrefetch(*Loaded);
+                }
+            }),
+            FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("HoverPrefetch"));
+    }
+    ResolvePrefetch(HoverPrefetch.Add(MoveTemp(Prefetch), Now));
+}
+
+void ACommandManager::ResolvePrefetch(FHoverPrefetch& Prefetch) const
+{
+    const AHotSpot* HotSpot = Prefetch.HotSpot.Get();
+    UItemDataAsset* ItemDataAsset = nullptr;
+    if (!HotSpot || Prefetch.bResolved) return;
+    if (!HotSpot->FindLoadedItemDataAssetForAction(Prefetch.Verb, ItemDataAsset)) return;
+    Prefetch.bResolved = true;
+    Prefetch.ItemDataAsset = ItemDataAsset;
+    if (HotSpot->PredictBarkText(Prefetch.Verb, Prefetch.SourceItem.Get(), Prefetch.BarkText))
+    {
+        // Made now so the bark on the click does not have to wrap its lines
+        Prefetch.BarkRequest.Emplace(FBarkRequest::CreatePlayerRequest(Prefetch.BarkText));
+    }
+}
+
+void ACommandManager::ClaimHoverPrefetch(const AHotSpot* HotSpot)
+{
+    HoverPrefetch.Claim(HotSpot, CurrentVerb, ItemManager->SourceItem, GetWorld()->GetRealTimeSeconds());
+}
+
 void ACommandManager::PerformInstantAction()
 {
 #if WITH_EDITOR
@@ -287,6 +532,8 @@ void ACommandManager::PerformHotSpotInteraction()
     // The use of eg CurrentHotSpot->OnClose() does not work as BP's don't do
     // polymorphism and have to be dispatched in code.
     check(CurrentHotSpot);
+    CommandLatency.Stamp(ECommandStage::Interaction);
+    CommandLatency.EndCommand();
     switch (CurrentVerb)
     {
     case EVerbType::Close:
@@ -336,6 +583,21 @@ void ACommandManager::ConnectToMoveCompletedDelegate()
         AdventureAIController->MoveCompletedDelegate.AddDynamic(
             this, &ACommandManager::HandleAIMovementCompleteNotify);
     }
+    if (AAdventureCharacter* APlayerCharacter = GetPlayerCharacter())
+    {
+        APlayerCharacter->PathFollowedDelegate.AddUObject(this, &ACommandManager::HandlePathFollowed);
+        APlayerCharacter->StartedMovingDelegate.AddUObject(this, &ACommandManager::HandleStartedMoving);
+    }
+}
+
+void ACommandManager::HandlePathFollowed(bool bReached)
+{
+    HandleAIMovementCompleteNotify(bReached ? EPathFollowingResult::Success : EPathFollowingResult::Blocked);
+}
+
+void ACommandManager::HandleStartedMoving()
+{
+    CommandLatency.Stamp(ECommandStage::MoveStarted);
 }
 
 void ACommandManager::HandleAIMovementCompleteNotify(EPathFollowingResult::Type Result)
@@ -343,12 +605,13 @@ void ACommandManager::HandleAIMovementCompleteNotify(EPathFollowingResult::Type
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("HandleAIMovementCompleteNotify"));
     if (Result == EPathFollowingResult::Success)
     {
+        CommandLatency.Stamp(ECommandStage::Arrived);
         if (AIStatus == EAIStatus::MakingRequest)
         {
             AIStatus = EAIStatus::AlreadyThere;
         }
         LastPathResult = EAIMoveResult::Success;
-        ShouldCompleteMovementNextTick = true;
+        ScheduleMovementComplete();
     }
     else
     {
@@ -373,6 +636,7 @@ void ACommandManager::HandleMovementComplete()
     check(APlayerCharacter);
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("HandleMovementComplete"));
     AIStatus = EAIStatus::Idle;
+    CommandLatency.Stamp(ECommandStage::MovementComplete);
     if (CurrentHotSpot && LastPathResult == EAIMoveResult::Success)
     {
         UE_LOG(LogAdventureGame, VeryVerbose, TEXT("CurrentHotSpot && (LastPathResult == EAIMoveResult::Success)"));
@@ -385,11 +649,20 @@ void ACommandManager::HandleMovementComplete()
         UE_LOG(LogAdventureGame, VeryVerbose, TEXT("TargetLocationForAI && (LastPathResult == EAIMoveResult::Success)"));
         APlayerCharacter->TeleportToLocation(TargetLocationForAI);
     }
+    // A walk with no hotspot, or one that did not get there, is done
+    CommandLatency.EndCommand();
     InterruptCurrentAction();
 }
 
 void ACommandManager::WalkToLocation(const FVector& Location)
 {
+    if (AIStatus == EAIStatus::Moving && PathRequestThrottle.Coalesce(Location, MoveCoalesceDistance))
+    {
+        // A path there was asked for this frame already, eg by a click and a tap
+        // for the same press, and a new request would only find the same path
+        TargetLocationForAI = Location;
+        return;
+    }
     StopAIMovement();
     if (AIStatus != EAIStatus::Idle) return;
     TargetLocationForAI = Location;
@@ -399,6 +672,29 @@ void ACommandManager::WalkToLocation(const FVector& Location)
         TeleportToLocation(Location);
         return;
     }
+    RequestPath(Location);
+}
+
+void ACommandManager::RequestPath(const FVector& Location)
+{
+    PathRequestThrottle.BeginRequest(Location);
+    CommandLatency.Stamp(ECommandStage::PathRequested);
+    // Walk area paths are cheap enough to need no throttle
+    if (FollowWalkAreaPath(Location)) return;
+    const double Now = GetWorld()->GetRealTimeSeconds();
+    PathRequestThrottle.MaxPerSecond = FMath::Max(MaxPathRequestsPerSecond, 1.0f);
+    if (!PathRequestThrottle.TryAcquire(Now))
+    {
+        // Carry on as if moving, so the hotspot is kept for when the path is made.
+        // Any later walk before then replaces this one, see StopAIMovement.
+        UE_LOG(LogAdventureGame, VeryVerbose, TEXT("Path following request -> throttled: %f %f"), Location.X, Location.Y);
+        bHasDeferredPath = true;
+        AIStatus = EAIStatus::Moving;
+        LastPathResult = EAIMoveResult::Moving;
+        GetWorldTimerManager().SetTimer(DeferredPathTimer, this, &ACommandManager::RequestDeferredPath,
+                                        static_cast<float>(PathRequestThrottle.GetWaitTime(Now)), false);
+        return;
+    }
 
     if (AAdventureAIController* AI = GetAIController())
     {
@@ -422,6 +718,50 @@ void ACommandManager::WalkToLocation(const FVector& Location)
     }
 }
 
+bool ACommandManager::FollowWalkAreaPath(const FVector& Location)
+{
+    const UAdventureGameInstance* AdventureGameInstance = GetAdventureGameInstance();
+    const UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this);
+    AAdventureCharacter* APlayerCharacter = GetPlayerCharacter();
+    if (!AdventureGameInstance || !Registry || !IsValid(APlayerCharacter)) return false;
+    const UWalkAreaComponent* WalkArea = Registry->FindWalkArea(AdventureGameInstance->CurrentLevelName);
+    if (!WalkArea) return false;
+
+    PathRequestThrottle.CountUnthrottled();
+    TArray<FVector> Points;
+    if (!WalkArea->FindPath(APlayerCharacter->GetActorLocation(), Location, Points))
+    {
+        UE_LOG(LogAdventureGame, VeryVerbose, TEXT("Walk area path -> failed: %f %f"), Location.X, Location.Y);
+        LastPathResult = EAIMoveResult::Fail;
+        return true;
+    }
+    UE_LOG(LogAdventureGame, VeryVerbose, TEXT("Walk area path -> %d points: %f %f"), Points.Num(), Location.X, Location.Y);
+    APlayerCharacter->FollowPath(Points);
+    LastPathResult = EAIMoveResult::Moving;
+    AIStatus = EAIStatus::Moving;
+    return true;
+}
+
+void ACommandManager::RequestDeferredPath()
+{
+    if (!bHasDeferredPath) return;
+    bHasDeferredPath = false;
+    RequestPath(TargetLocationForAI);
+    if (LastPathResult == EAIMoveResult::Fail)
+    {
+        // The hotspot was kept on the understanding there would be a path
+        AIStatus = EAIStatus::Idle;
+        ScheduleMovementComplete();
+    }
+}
+
+void ACommandManager::CancelDeferredPath()
+{
+    if (!bHasDeferredPath) return;
+    bHasDeferredPath = false;
+    GetWorldTimerManager().ClearTimer(DeferredPathTimer);
+}
+
 void ACommandManager::WalkToHotSpot(AHotSpot* HotSpot)
 {
     const AAdventureCharacter* APlayerCharacter = GetPlayerCharacter();
@@ -447,11 +787,26 @@ void ACommandManager::WalkToHotSpot(AHotSpot* HotSpot)
     case EAIStatus::AlreadyThere:
         // Don't set the hotspot unless we know the player can reach it.
         CurrentHotSpot = HotSpot;
+        BeginDoorIntent(HotSpot);
     default:
         break;
     }
 }
 
+void ACommandManager::BeginDoorIntent(const AHotSpot* HotSpot) const
+{
+    if (CurrentVerb != EVerbType::Use) return;
+    const ADoor* Door = Cast<ADoor>(HotSpot);
+    if (!Door || Door->DoorState != EDoorState::Opened || Door->LevelToLoad.IsNone()) return;
+    if (const UAdventureGameInstance* AdventureGameInstance = GetAdventureGameInstance())
+    {
+        if (URoomStreamingManager* RoomStreaming = AdventureGameInstance->GetRoomStreaming())
+        {
+            RoomStreaming->BeginIntentPreload(Door->LevelToLoad);
+        }
+    }
+}
+
 void ACommandManager::CommenceConversation()
 {
     SetInputLocked(true);
@@ -466,6 +821,11 @@ void ACommandManager::EndConversation()
 
 void ACommandManager::AssignVerb(EVerbType NewVerb)
 {
+    FRecordedCommand Command;
+    Command.Type = ERecordedCommandType::AssignVerb;
+    Command.Verb = NewVerb;
+    RecordCommand(Command);
+
     ItemManager->ClearSourceItem();
     ItemManager->ClearTargetItem();
     CurrentVerb = NewVerb;
@@ -489,6 +849,7 @@ void ACommandManager::InterruptCurrentAction()
 {
     UE_LOG(LogAdventureGame, VeryVerbose, TEXT("InterruptCurrentAction"));
     SetInputLocked(false);
+    CancelDeferredPath();
     TargetLocationForAI = FVector::ZeroVector;
     if (AAdventureCharacter* APlayerCharacter = GetPlayerCharacter())
     {
@@ -498,7 +859,148 @@ void ACommandManager::InterruptCurrentAction()
     CurrentCommand = EPlayerCommand::None;
     CurrentHotSpot = nullptr;
     ItemManager->Reset();
+    HoverPrefetch.ReleaseClaimed();
+    if (const UAdventureGameInstance* AdventureGameInstance = GetAdventureGameInstance())
+    {
+        if (URoomStreamingManager* RoomStreaming = AdventureGameInstance->GetRoomStreaming())
+        {
+            RoomStreaming->EndIntentPreload();
+        }
+    }
     if (!bDisableHUDUpdates) InterruptAction.Broadcast();
+    if (!CommandQueue.IsEmpty()) ScheduleNextQueuedCommand();
+}
+
+void ACommandManager::QueueWalkTo(const FVector& Location)
+{
+    QueueCommand(FQueuedCommand::Walk(Location));
+}
+
+void ACommandManager::QueueInteraction(AHotSpot* HotSpot, EVerbType Verb)
+{
+    if (!IsValid(HotSpot)) return;
+    QueueCommand(FQueuedCommand::Interact(HotSpot, Verb));
+}
+
+void ACommandManager::QueueUseItemOn(UInventoryItem* Item, AHotSpot* HotSpot)
+{
+    if (!IsValid(Item) || !IsValid(HotSpot)) return;
+    QueueCommand(FQueuedCommand::Combine(Item, HotSpot));
+}
+
+void ACommandManager::QueueGiveItemTo(UInventoryItem* Item, AHotSpot* HotSpot)
+{
+    if (!IsValid(Item) || !IsValid(HotSpot)) return;
+    QueueCommand(FQueuedCommand::Give(Item, HotSpot));
+}
+
+void ACommandManager::QueueBark(const FText& BarkText)
+{
+    QueueCommand(FQueuedCommand::Bark(BarkText));
+}
+
+void ACommandManager::QueueCommand(FQueuedCommand&& Command)
+{
+    UE_LOG(LogAdventureGame, Verbose, TEXT("QueueCommand - %s"), *Command.ToString());
+    CommandQueue.Push(MoveTemp(Command));
+    if (!IsBusy()) ScheduleNextQueuedCommand();
+}
+
+void ACommandManager::CancelQueuedCommands()
+{
+    if (const int32 Cancelled = CommandQueue.Cancel())
+    {
+        UE_LOG(LogAdventureGame, Verbose, TEXT("CancelQueuedCommands - %d cancelled"), Cancelled);
+    }
+    bShouldRunNextQueuedCommandOnNextTick = false;
+}
+
+void ACommandManager::CancelAllCommands()
+{
+    CancelQueuedCommands();
+    InterruptCurrentAction();
+}
+
+FCommandQueueStats ACommandManager::GetCommandQueueStats() const
+{
+    FCommandQueueStats Stats = CommandQueue.GetStats();
+    const FPathRequestStats& PathStats = PathRequestThrottle.GetStats();
+    Stats.Coalesced += PathStats.Coalesced;
+    Stats.PathRequests = PathStats.Made;
+    Stats.PathRequestsThrottled = PathStats.Throttled;
+    return Stats;
+}
+
+bool ACommandManager::ShouldQueueClick()
+{
+    if (!IsBusy()) return false;
+    const AAdventurePlayerController* AdventurePlayerController = GetAdventurePlayerController();
+    return AdventurePlayerController && (AdventurePlayerController->IsInputKeyDown(EKeys::LeftShift)
+        || AdventurePlayerController->IsInputKeyDown(EKeys::RightShift));
+}
+
+void ACommandManager::ScheduleNextQueuedCommand()
+{
+    bShouldRunNextQueuedCommandOnNextTick = true;
+    WakeForPendingWork();
+}
+
+void ACommandManager::RunNextQueuedCommand()
+{
+    FQueuedCommand Command;
+    if (IsInputLocked() || !CommandQueue.Pop(Command)) return;
+    RunQueuedCommand(Command);
+}
+
+void ACommandManager::RunQueuedCommand(const FQueuedCommand& Command)
+{
+    UE_LOG(LogAdventureGame, Verbose, TEXT("RunQueuedCommand - %s"), *Command.ToString());
+    // Timed from when it comes off the queue, not from the click that queued it
+    CommandLatency.BeginCommand();
+    CommandLatency.Stamp(ECommandStage::Dispatched);
+    FSimulationClock::CountCommand();
+    ItemManager->Reset();
+    CurrentHotSpot = nullptr;
+    switch (Command.Type)
+    {
+    case EQueuedCommandType::Walk:
+        CurrentTargetLocation = Command.Location;
+        PerformInstantAction();
+        break;
+    case EQueuedCommandType::Interact:
+        if (Command.Verb == EVerbType::WalkTo)
+        {
+            CurrentHotSpot = Command.HotSpot.Get();
+            PerformInstantAction();
+            break;
+        }
+        CurrentVerb = Command.Verb;
+        CurrentCommand = EPlayerCommand::Active;
+        CurrentHotSpot = Command.HotSpot.Get();
+        if (!bDisableHUDUpdates) BeginAction.Broadcast();
+        WalkToHotSpot(Command.HotSpot.Get());
+        break;
+    case EQueuedCommandType::Combine:
+    case EQueuedCommandType::Give:
+        ItemManager->SetAndLockSourceItem(Command.Item.Get());
+        CurrentVerb = Command.Verb;
+        CurrentCommand = EPlayerCommand::Active;
+        CurrentHotSpot = Command.HotSpot.Get();
+        if (!bDisableHUDUpdates) BeginAction.Broadcast();
+        WalkToHotSpot(Command.HotSpot.Get());
+        break;
+    case EQueuedCommandType::Bark:
+        CurrentCommand = EPlayerCommand::InstantActive;
+        if (UPlayerBarkManager* BarkController = GetBarkController())
+        {
+            BarkController->PlayerBarkAndEnd(Command.BarkText);
+        }
+        else
+        {
+            ScheduleInterruptCurrentAction();
+        }
+        break;
+    }
 }
 
 void ACommandManager::ClearCurrentPath()
@@ -517,7 +1019,8 @@ void ACommandManager::TeleportToLocation(const FVector& Location)
     APlayerCharacter->TeleportToLocation(Dest);
     LastPathResult = EAIMoveResult::Success;
     AIStatus = EAIStatus::AlreadyThere;
-    ShouldCompleteMovementNextTick = true;
+    CommandLatency.Stamp(ECommandStage::Arrived);
+    ScheduleMovementComplete();
 }
 
 void ACommandManager::SetVerbAndCommandFromHotSpot(AHotSpot* HotSpot)
@@ -545,6 +1048,11 @@ void ACommandManager::StopAIMovement()
 {
     AAdventureCharacter* APlayerCharacter = GetPlayerCharacter();
     if (!IsValid(APlayerCharacter)) return;
+    if (APlayerCharacter->IsFollowingPath())
+    {
+        APlayerCharacter->StopFollowingPath();
+        AIStatus = EAIStatus::Idle;
+    }
     AAdventureAIController* AI = Cast<AAdventureAIController>(APlayerCharacter->GetController());
     if (!IsValid(AI))
     {
@@ -553,6 +1061,7 @@ void ACommandManager::StopAIMovement()
     }
     if (AIStatus == EAIStatus::Moving)
     {
+        CancelDeferredPath();
         AI->StopMovement();
         APlayerCharacter->GetMovementComponent()->StopActiveMovement();
         AIStatus = EAIStatus::Idle;
@@ -578,7 +1087,9 @@ void ACommandManager::ConnectToPlayerHUD(UAdventureGameHUD* AAdventureGameHUD)
 
 void ACommandManager::AddUIHandlers(UAdventureGameHUD *AAdventureGameHUD)
 {
-    if (!bDisableHUD) AAdventureGameHUD->VerbsUI->OnVerbChanged.BindDynamic(this, &ACommandManager::AssignVerb);
+    if (bDisableHUD) return;
+    AAdventureGameHUD->VerbsUI->OnVerbChanged.BindDynamic(this, &ACommandManager::AssignVerb);
+    AAdventureGameHUD->PromptList->PromptClickedEvent.AddUniqueDynamic(this, &ACommandManager::RecordPromptClicked);
 }
 
 void ACommandManager::SetupHUD()
@@ -693,6 +1204,11 @@ void ACommandManager::HandleInventoryItemClicked(UItemSlot* ItemSlot)
         UE_LOG(LogAdventureGame, Error, TEXT("HandleInventoryItemClicked: Item slot is NULL"));
         return;
     }
+    FRecordedCommand Command;
+    Command.Type = ERecordedCommandType::ClickInventoryItem;
+    Command.Item = ItemSlot->HasItem ? ItemSlot->InventoryItem->ItemKind : EItemKind::None;
+    RecordCommand(Command);
+
     if (!ItemSlot->HasItem)
     {
         // clicking an empty inventory slot clears everything out
@@ -6,6 +6,9 @@
 
 #include "AdventureControllerProvider.h"
 #include "BarkProvider.h"
+#include "CommandLatency.h"
+#include "HoverPrefetch.h"
+#include "PlayerCommandQueue.h"
 #include "TestBarkController.h"
 
 #include "AdventureGame/Dialog/PlayerBarkManager.h"
@@ -27,6 +30,7 @@ class APuck;
 class UItemManager;
 class AAdventureCharacter;
 class UInteractionNotifier;
+struct FRecordedCommand;
 
 DECLARE_MULTICAST_DELEGATE(FUpdateInteractionText);
 DECLARE_MULTICAST_DELEGATE(FBeginAction);
@@ -34,6 +38,7 @@ DECLARE_MULTICAST_DELEGATE(FBeginAction);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FInterruptAction);
 
 class UItemSlot;
+class UInventoryItem;
 class AHotSpot;
 
 ///
@@ -49,10 +54,14 @@ public:
     // Sets default values for this actor's properties
     ACommandManager();
 
+    virtual void PostInitializeComponents() override;
+
     // Called when the game starts or when spawned
     virtual void BeginPlay() override;
 
-    // Called every frame
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Called at the end of a frame in which work was scheduled
     virtual void Tick(float DeltaTime) override;
 
     //////////////////////////////////
@@ -109,6 +118,28 @@ public:
     UFUNCTION(BlueprintCallable, Category = "EventHandlers")
     void HandleInventoryItemClicked(UItemSlot* ItemSlot);
 
+    //////////////////////////////////
+    ///
+    /// RECORD AND REPLAY
+    ///
+
+    /// Put a recorded command back in by the entry point it was recorded at,
+    /// finding its hotspot or inventory slot by name. See UCommandRecorder.
+    void ReplayCommand(const FRecordedCommand& Command);
+
+private:
+    /// Record a click or tap that has been resolved to a hotspot or location,
+    /// then act on it. Replayed clicks come in here too.
+    void PerformClick(const FRecordedCommand& Command, AHotSpot* HotSpot = nullptr);
+
+    UFUNCTION()
+    void RecordPromptClicked(int PromptIndex);
+
+    /// Pass to the recorder, which ignores it unless a recording is running.
+    void RecordCommand(const FRecordedCommand& Command) const;
+
+public:
+
     //////////////////////////////////
     ///
     /// PERFORM COMMANDS
@@ -125,10 +156,113 @@ public:
 
     void WalkToHotSpot(AHotSpot* HotSpot);
 
+    /// If the player is about to use an open door, start streaming in the room
+    /// behind it now so the load overlaps the walk to the door.
+    void BeginDoorIntent(const AHotSpot* HotSpot) const;
+
     void CommenceConversation();
 
     void EndConversation();
 
+    //////////////////////////////////
+    ///
+    /// COMMAND QUEUE
+    ///
+
+    /// How many commands can wait behind the current one. Shift click a hotspot
+    /// or a location while an action is under way to queue it. A plain click
+    /// cancels anything queued and then acts as it always has. Locking input,
+    /// eg for a conversation, cancels the queue too.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Commands")
+    int32 MaxQueuedCommands = 4;
+
+    UFUNCTION(BlueprintCallable, Category = "Commands")
+    void QueueWalkTo(const FVector& Location);
+
+    UFUNCTION(BlueprintCallable, Category = "Commands")
+    void QueueInteraction(AHotSpot* HotSpot, EVerbType Verb);
+
+    UFUNCTION(BlueprintCallable, Category = "Commands")
+    void QueueUseItemOn(UInventoryItem* Item, AHotSpot* HotSpot);
+
+    UFUNCTION(BlueprintCallable, Category = "Commands")
+    void QueueGiveItemTo(UInventoryItem* Item, AHotSpot* HotSpot);
+
+    UFUNCTION(BlueprintCallable, Category = "Commands")
+    void QueueBark(const FText& BarkText);
+
+    /// Add a command to the queue. If nothing is under way it starts at the
+    /// end of the frame, otherwise when the current action ends.
+    void QueueCommand(FQueuedCommand&& Command);
+
+    /// Drop the waiting commands, but let the current one finish.
+    UFUNCTION(BlueprintCallable, Category = "Commands")
+    void CancelQueuedCommands();
+
+    /// Drop the waiting commands and stop the current one.
+    UFUNCTION(BlueprintCallable, Category = "Commands")
+    void CancelAllCommands();
+
+    UFUNCTION(BlueprintPure, Category = "Commands")
+    FCommandQueueStats GetCommandQueueStats() const;
+
+    int32 GetQueuedCommandCount() const { return CommandQueue.Num(); }
+
+    /// Time taken by commands through each stage from click to interaction.
+    const FCommandLatencyTracker& GetCommandLatency() const { return CommandLatency; }
+
+    FCommandLatencyTracker& GetCommandLatency() { return CommandLatency; }
+
+    /// Is a command being carried out, as opposed to waiting for the player.
+    bool IsBusy() const
+    {
+        return CurrentCommand == EPlayerCommand::Active || CurrentCommand == EPlayerCommand::InstantActive;
+    }
+
+private:
+    /// Queue the click rather than act on it now.
+    bool ShouldQueueClick();
+
+    /// Start the next queued command at the end of the frame.
+    void ScheduleNextQueuedCommand();
+
+    void RunNextQueuedCommand();
+
+    void RunQueuedCommand(const FQueuedCommand& Command);
+
+    FPlayerCommandQueue CommandQueue;
+
+    FCommandLatencyTracker CommandLatency;
+
+    bool bShouldRunNextQueuedCommandOnNextTick = false;
+
+public:
+    //////////////////////////////////
+    ///
+    /// HOVER PREFETCH
+    ///
+
+    /// Work out what clicking the hotspot with the current verb, and item, will
+    /// need: its interaction text, recipe, bark and soft assets. Called by the
+    /// player controller when the cursor rests on a hotspot.
+    void PrefetchHotSpot(AHotSpot* HotSpot);
+
+    /// What was worked out on hover, and how often clicks found it.
+    const FHoverPrefetchCache& GetHoverPrefetch() const { return HoverPrefetch; }
+
+    FHoverPrefetchCache& GetHoverPrefetch() { return HoverPrefetch; }
+
+private:
+    /// Look up the recipe and bark of an entry, once its assets have loaded.
+    void ResolvePrefetch(FHoverPrefetch& Prefetch) const;
+
+    /// The click on the hotspot takes what was worked out for it.
+    void ClaimHoverPrefetch(const AHotSpot* HotSpot);
+
+    FHoverPrefetchCache HoverPrefetch;
+
+public:
+
     //////////////////////////////////
     ///
     /// INTERRUPT COMMANDS
@@ -153,10 +287,25 @@ public:
     UFUNCTION(BlueprintCallable, Category="InterruptCommands", DisplayName="ClearAction")
     void InterruptCurrentAction();
 
-    /// Call InterruptCurrentAction async, in the next tick
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="InterruptCommands")
+    /// Call InterruptCurrentAction async, at the end of the frame, or once the
+    /// player has stopped barking. Only set it with ScheduleInterruptCurrentAction,
+    /// which wakes the tick that handles it.
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="InterruptCommands")
     bool bShouldInterruptCurrentActionOnNextTick = false;
 
+    UFUNCTION(BlueprintCallable, Category="InterruptCommands")
+    void ScheduleInterruptCurrentAction();
+
+    /// Enable the tick if there is scheduled work. The tick turns itself off when
+    /// there is none it can do, so this is called again when a bark finishes.
+    void WakeForPendingWork();
+
+    bool HasPendingWork() const
+    {
+        return bShouldInterruptCurrentActionOnNextTick || ShouldCompleteMovementNextTick
+            || bShouldRunNextQueuedCommandOnNextTick;
+    }
+
     FBeginAction BeginAction;
 
     /// Event fired when the current action is terminated/interrupted
@@ -204,6 +353,11 @@ public:
     UFUNCTION()
     void HandleAIMovementCompleteNotify(EPathFollowingResult::Type Result);
 
+    /// Called by the player character at the end of a walk area path.
+    void HandlePathFollowed(bool bReached);
+
+    void HandleStartedMoving();
+
     bool IsAlreadyAtHotspotClicked() const
     {
         return AIStatus == EAIStatus::AlreadyThere;
@@ -211,6 +365,9 @@ public:
 
     bool ShouldCompleteMovementNextTick = false;
 
+    /// Call HandleMovementComplete at the end of the frame.
+    void ScheduleMovementComplete();
+
     UFUNCTION()
     void HandleMovementComplete();
 
@@ -233,6 +390,39 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement")
     bool bTeleportInsteadOfWalk = false;
 
+    /// Cap on path requests to the AI controller. A burst of this many is let
+    /// through at once, after that they are held back and only the latest
+    /// target is walked to when the throttle allows.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement")
+    float MaxPathRequestsPerSecond = 8.0f;
+
+    /// A second walk in the same frame to within this distance of the first
+    /// carries on with the path already asked for rather than making another.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement")
+    float MoveCoalesceDistance = 10.0f;
+
+private:
+    /// Ask the AI controller for a path, or hold the request back if there
+    /// have been too many lately.
+    void RequestPath(const FVector& Location);
+
+    /// Walk the player along a path from the current room's walk area, if it
+    /// has one, instead of asking the AI controller. True if it has one.
+    bool FollowWalkAreaPath(const FVector& Location);
+
+    UFUNCTION()
+    void RequestDeferredPath();
+
+    void CancelDeferredPath();
+
+    FPathRequestThrottle PathRequestThrottle;
+
+    FTimerHandle DeferredPathTimer;
+
+    bool bHasDeferredPath = false;
+
+public:
+
     //////////////////////////////////
     ///
     /// HUD MESSAGES
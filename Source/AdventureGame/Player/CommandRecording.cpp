@@ -0,0 +1,54 @@
+// (c) 2025 Sarah Smith
+
+
+#include "CommandRecording.h"
+
+#include "AdventureGame/Gameplay/AdventureWorldRegistry.h"
+#include "AdventureGame/HotSpots/HotSpot.h"
+
+FRecordedCommand FRecordedCommand::HotSpotCommand(ERecordedCommandType Type, const AHotSpot* HotSpot)
+{
+    FRecordedCommand Command;
+    Command.Type = Type;
+    Command.HotSpotLevel = UAdventureWorldRegistry::GetActorLevelName(HotSpot);
+    Command.HotSpotName = HotSpot ? HotSpot->GetFName() : NAME_None;
+    return Command;
+}
+
+FRecordedCommand FRecordedCommand::LocationCommand(ERecordedCommandType Type, const FVector& Location)
+{
+    FRecordedCommand Command;
+    Command.Type = Type;
+    Command.Location = Location;
+    return Command;
+}
+
+FString FRecordedCommand::ToString() const
+{
+    FString Result = FString::Printf(TEXT("%d %s"), Frame, *UEnum::GetDisplayValueAsText(Type).ToString());
+    switch (Type)
+    {
+    case ERecordedCommandType::ClickHotSpot:
+    case ERecordedCommandType::TapHotSpot:
+    case ERecordedCommandType::QueueHotSpot:
+        Result += FString::Printf(TEXT(" %s.%s"), *HotSpotLevel.ToString(), *HotSpotName.ToString());
+        break;
+    case ERecordedCommandType::ClickLocation:
+    case ERecordedCommandType::TapLocation:
+    case ERecordedCommandType::QueueLocation:
+        Result += TEXT(" ") + Location.ToString();
+        break;
+    case ERecordedCommandType::AssignVerb:
+        Result += TEXT(" ") + UEnum::GetValueAsString(Verb);
+        break;
+    case ERecordedCommandType::ClickInventoryItem:
+        Result += TEXT(" ") + UEnum::GetValueAsString(Item);
+        break;
+    case ERecordedCommandType::ChoosePrompt:
+        Result += FString::Printf(TEXT(" %d"), Prompt);
+        break;
+    default:
+        break;
+    }
+    return Result;
+}
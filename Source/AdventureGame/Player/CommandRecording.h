@@ -0,0 +1,120 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AdventureGame/Enums/ItemKind.h"
+#include "AdventureGame/Enums/VerbType.h"
+
+#include "GameFramework/SaveGame.h"
+
+#include "CommandRecording.generated.h"
+
+class AHotSpot;
+
+/// Which of the command manager's entry points a recorded command went in by.
+UENUM()
+enum class ERecordedCommandType : uint8
+{
+    /// A click or tap anywhere in the game, before it is resolved. Skips barks.
+    UserInteraction,
+    /// Mouse click on a hotspot
+    ClickHotSpot,
+    /// Mouse click on the floor of the room
+    ClickLocation,
+    /// Touch on a hotspot
+    TapHotSpot,
+    /// Touch on the floor of the room
+    TapLocation,
+    /// Shift click on a hotspot while busy
+    QueueHotSpot,
+    /// Shift click on the floor while busy
+    QueueLocation,
+    /// Verb button in the HUD
+    AssignVerb,
+    /// Inventory slot in the HUD, the item is None for an empty slot
+    ClickInventoryItem,
+    /// Conversation prompt in the HUD
+    ChoosePrompt
+};
+
+///
+/// One command as the player issued it, with enough to find its hotspot or
+/// item again in a later run of the game.
+USTRUCT()
+struct ADVENTUREGAME_API FRecordedCommand
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    ERecordedCommandType Type = ERecordedCommandType::UserInteraction;
+
+    /// Frames of play from the start of the recording. Frames spent in a room
+    /// transition are not counted, as how long a room takes to load is not
+    /// repeatable from one run to the next.
+    UPROPERTY()
+    int32 Frame = 0;
+
+    UPROPERTY()
+    EVerbType Verb = EVerbType::WalkTo;
+
+    /// Level and actor name of the hotspot, as in the save game records.
+    UPROPERTY()
+    FName HotSpotLevel;
+
+    UPROPERTY()
+    FName HotSpotName;
+
+    UPROPERTY()
+    EItemKind Item = EItemKind::None;
+
+    /// World position of a click on the floor
+    UPROPERTY()
+    FVector Location = FVector::ZeroVector;
+
+    /// Conversation prompt number, from 1
+    UPROPERTY()
+    int32 Prompt = 0;
+
+    static FRecordedCommand HotSpotCommand(ERecordedCommandType Type, const AHotSpot* HotSpot);
+
+    static FRecordedCommand LocationCommand(ERecordedCommandType Type, const FVector& Location);
+
+    FString ToString() const;
+};
+
+///
+/// A play session recorded from the command manager's entry points, with
+/// what is needed to start a later run in the same state: the game as saved
+/// when the recording started, where the player stood, the random seed, and
+/// the length of every frame. Saved to a save game slot of its own.
+UCLASS()
+class ADVENTUREGAME_API UCommandRecording : public USaveGame
+{
+    GENERATED_BODY()
+
+public:
+    /// The save game at the start of the recording, see UGameplayStatics::SaveGameToMemory.
+    UPROPERTY()
+    TArray<uint8> StartingSave;
+
+    UPROPERTY()
+    FName StartingLevel;
+
+    UPROPERTY()
+    FVector StartingLocation = FVector::ZeroVector;
+
+    /// Global random seed, for FMath::Rand and the blueprint random nodes.
+    UPROPERTY()
+    int32 RandomSeed = 0;
+
+    /// Delta time of each frame of play, replayed as a fixed time step.
+    UPROPERTY()
+    TArray<float> FrameDeltas;
+
+    UPROPERTY()
+    TArray<FRecordedCommand> Commands;
+
+    int32 GetFrameCount() const { return FrameDeltas.Num(); }
+};
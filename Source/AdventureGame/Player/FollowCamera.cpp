@@ -3,6 +3,7 @@
 
 #include "FollowCamera.h"
 #include "AdventureCharacter.h"
+#include "AdventureGame/Gameplay/AdventureWorldRegistry.h"
 #include "Kismet/KismetMathLibrary.h"
 
 AFollowCamera::AFollowCamera()
@@ -25,6 +26,17 @@ AFollowCamera::AFollowCamera()
 	FollowCameraBase->SetCollisionProfileName(FName("NoCollision"));
 }
 
+// Registered before any actor in the level begins play, so the character finds it
+void AFollowCamera::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+	{
+		Registry->RegisterActor(this);
+	}
+}
+
 // Called when the game starts or when spawned
 void AFollowCamera::BeginPlay()
 {
@@ -33,6 +45,15 @@ void AFollowCamera::BeginPlay()
 	SetupCameraConfines();
 }
 
+void AFollowCamera::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAdventureWorldRegistry* Registry = UAdventureWorldRegistry::Get(this))
+	{
+		Registry->UnregisterActor(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void AFollowCamera::Tick(float DeltaTime)
 {
@@ -0,0 +1,161 @@
+// (c) 2025 Sarah Smith
+
+
+#include "HoverPrefetch.h"
+
+#include "AdventureGame/HotSpots/HotSpot.h"
+#include "AdventureGame/Items/InventoryItem.h"
+#include "AdventureGame/Items/ItemDataAsset.h"
+
+bool FHoverIntent::Update(const UObject* Target, const FVector2D& CursorPosition, double Now)
+{
+    const double DeltaTime = Now - LastTime;
+    if (bHasLastPosition && DeltaTime > 0.0)
+    {
+        const double Speed = FVector2D::Distance(CursorPosition, LastPosition) / DeltaTime;
+        const double Alpha = 1.0 - FMath::Exp(-DeltaTime / SpeedSmoothingTime);
+        SmoothedSpeed += (Speed - SmoothedSpeed) * Alpha;
+    }
+    bHasLastPosition = true;
+    LastPosition = CursorPosition;
+    LastTime = Now;
+
+    if (Target != HoveredTarget.Get())
+    {
+        HoveredTarget = Target;
+        EnteredTime = Now;
+        bFired = false;
+    }
+    if (!Target || bFired) return false;
+    if (Now - EnteredTime < DwellTime || SmoothedSpeed > MaxCursorSpeed) return false;
+    bFired = true;
+    return true;
+}
+
+void FHoverIntent::Reset()
+{
+    HoveredTarget.Reset();
+    bHasLastPosition = false;
+    SmoothedSpeed = 0.0;
+    bFired = false;
+}
+
+bool FHoverPrefetch::Matches(const AHotSpot* InHotSpot, EVerbType InVerb, const UInventoryItem* InSourceItem) const
+{
+    return InHotSpot && HotSpot.Get() == InHotSpot && Verb == InVerb && SourceItem.Get() == InSourceItem;
+}
+
+double FHoverPrefetchStats::GetHitRate() const
+{
+    const int32 Clicks = Hits + Misses;
+    return Clicks > 0 ? static_cast<double>(Hits) / Clicks : 0.0;
+}
+
+FString FHoverPrefetchStats::ToString() const
+{
+    return FString::Printf(TEXT("%d prefetched, %d hits, %d misses (%d expired), hit rate %.1f%%, %d unused; used %d texts, %d recipes, %d barks"),
+        Prefetched, Hits, Misses, Expired, GetHitRate() * 100.0, Unused, TextsUsed, RecipesUsed, BarksUsed);
+}
+
+FHoverPrefetch& FHoverPrefetchCache::Add(FHoverPrefetch&& Prefetch, double Now)
+{
+    Prune(Now);
+    Entries.RemoveAll([&Prefetch](const FHoverPrefetch& Entry)
+    {
+        return Entry.Matches(Prefetch.HotSpot.Get(), Prefetch.Verb, Prefetch.SourceItem.Get());
+    });
+    if (Entries.Num() >= Capacity && !Entries.IsEmpty())
+    {
+        // Entries are added in time order, so the first is the oldest
+        Entries.RemoveAt(0);
+        ++Stats.Unused;
+    }
+    ++Stats.Prefetched;
+    Prefetch.CreatedTime = Now;
+    return Entries.Add_GetRef(MoveTemp(Prefetch));
+}
+
+FHoverPrefetch* FHoverPrefetchCache::Find(const AHotSpot* HotSpot, EVerbType Verb, const UInventoryItem* SourceItem,
+    double Now)
+{
+    FHoverPrefetch* Prefetch = Entries.FindByPredicate([&](const FHoverPrefetch& Entry)
+    {
+        return Entry.Matches(HotSpot, Verb, SourceItem);
+    });
+    return Prefetch && !IsExpired(*Prefetch, Now) ? Prefetch : nullptr;
+}
+
+bool FHoverPrefetchCache::Claim(const AHotSpot* HotSpot, EVerbType Verb, const UInventoryItem* SourceItem, double Now)
+{
+    Claimed.Reset();
+    const int32 Index = Entries.IndexOfByPredicate([&](const FHoverPrefetch& Entry)
+    {
+        return Entry.Matches(HotSpot, Verb, SourceItem);
+    });
+    if (Index == INDEX_NONE)
+    {
+        ++Stats.Misses;
+        return false;
+    }
+    FHoverPrefetch Prefetch = MoveTemp(Entries[Index]);
+    Entries.RemoveAt(Index);
+    if (IsExpired(Prefetch, Now))
+    {
+        ++Stats.Misses;
+        ++Stats.Expired;
+        return false;
+    }
+    ++Stats.Hits;
+    Claimed.Emplace(MoveTemp(Prefetch));
+    return true;
+}
+
+void FHoverPrefetchCache::ReleaseClaimed()
+{
+    Claimed.Reset();
+}
+
+bool FHoverPrefetchCache::FindClaimedText(const AHotSpot* HotSpot, EVerbType Verb, const UInventoryItem* SourceItem,
+    FText& OutText)
+{
+    if (!Claimed.IsSet() || !Claimed->Matches(HotSpot, Verb, SourceItem)) return false;
+    OutText = Claimed->InteractionText;
+    ++Stats.TextsUsed;
+    return true;
+}
+
+bool FHoverPrefetchCache::FindClaimedItemDataAsset(const AHotSpot* HotSpot, EVerbType Verb,
+    UItemDataAsset*& OutItemDataAsset)
+{
+    if (!Claimed.IsSet() || !Claimed->bResolved || Claimed->HotSpot.Get() != HotSpot || Claimed->Verb != Verb)
+    {
+        return false;
+    }
+    OutItemDataAsset = Claimed->ItemDataAsset.Get();
+    ++Stats.RecipesUsed;
+    return true;
+}
+
+bool FHoverPrefetchCache::TakeBarkRequest(const FText& BarkText, FBarkRequest& OutRequest)
+{
+    if (!Claimed.IsSet() || !Claimed->BarkRequest.IsSet()) return false;
+    if (!Claimed->BarkText.ToString().Equals(BarkText.ToString(), ESearchCase::CaseSensitive)) return false;
+    ++Stats.BarksUsed;
+    OutRequest = MoveTemp(Claimed->BarkRequest.GetValue());
+    Claimed->BarkRequest.Reset();
+    return true;
+}
+
+void FHoverPrefetchCache::Prune(double Now)
+{
+    Stats.Unused += Entries.RemoveAll([this, Now](const FHoverPrefetch& Entry)
+    {
+        return IsExpired(Entry, Now) || !Entry.HotSpot.IsValid();
+    });
+}
+
+void FHoverPrefetchCache::Reset()
+{
+    Entries.Reset();
+    Claimed.Reset();
+}
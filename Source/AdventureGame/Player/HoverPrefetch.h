@@ -0,0 +1,173 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AdventureGame/Dialog/BarkRequest.h"
+#include "AdventureGame/Enums/VerbType.h"
+
+class AHotSpot;
+class UInventoryItem;
+class UItemDataAsset;
+struct FStreamableHandle;
+
+///
+/// Decides when the player means to click on what is under the cursor rather than
+/// pass over it: the cursor has stayed on it for the dwell time, and is moving
+/// slower than the speed limit. Fires once each time the cursor comes onto something.
+class ADVENTUREGAME_API FHoverIntent
+{
+public:
+    /// Seconds on the same target before it counts as intent.
+    double DwellTime = 0.15;
+
+    /// Faster than this, in pixels a second, and the cursor is passing over.
+    double MaxCursorSpeed = 400.0;
+
+    /// Seconds the cursor speed is smoothed over, so one jittery frame does not count.
+    double SpeedSmoothingTime = 0.05;
+
+    /// Call every frame with what is under the cursor, or null, and where the cursor
+    /// is on the screen. True on the frame intent is detected.
+    bool Update(const UObject* Target, const FVector2D& CursorPosition, double Now);
+
+    void Reset();
+
+    double GetCursorSpeed() const { return SmoothedSpeed; }
+
+private:
+    TWeakObjectPtr<const UObject> HoveredTarget;
+
+    double EnteredTime = 0.0;
+
+    bool bHasLastPosition = false;
+
+    FVector2D LastPosition = FVector2D::ZeroVector;
+
+    double LastTime = 0.0;
+
+    double SmoothedSpeed = 0.0;
+
+    bool bFired = false;
+};
+
+/// What a click on a hotspot with a verb, and the item held, will need, worked
+/// out while the cursor rests on it.
+struct ADVENTUREGAME_API FHoverPrefetch
+{
+    TWeakObjectPtr<const AHotSpot> HotSpot;
+
+    EVerbType Verb = EVerbType::WalkTo;
+
+    TWeakObjectPtr<const UInventoryItem> SourceItem;
+
+    /// As the interaction UI shows it, eg "Use pen on brick wall".
+    FText InteractionText;
+
+    /// The recipe has been looked up, once its asset finished loading.
+    bool bResolved = false;
+
+    /// The recipe the verb uses, or null if it has none.
+    TWeakObjectPtr<UItemDataAsset> ItemDataAsset;
+
+    /// What the verb will bark, when that can be known ahead, and the request
+    /// for it with its long lines already wrapped.
+    FText BarkText;
+
+    TOptional<FBarkRequest> BarkRequest;
+
+    /// Keeps the soft assets the verb loads in memory while the entry lives.
+    TSharedPtr<FStreamableHandle> AssetHandle;
+
+    double CreatedTime = 0.0;
+
+    bool Matches(const AHotSpot* InHotSpot, EVerbType InVerb, const UInventoryItem* InSourceItem) const;
+};
+
+struct ADVENTUREGAME_API FHoverPrefetchStats
+{
+    int32 Prefetched = 0;
+
+    /// Clicks that found what was worked out for them.
+    int32 Hits = 0;
+
+    /// Clicks that had to work it out themselves.
+    int32 Misses = 0;
+
+    /// Misses where an entry was found but was too old to trust.
+    int32 Expired = 0;
+
+    /// Entries dropped, for room or age, without being clicked.
+    int32 Unused = 0;
+
+    int32 TextsUsed = 0;
+
+    int32 RecipesUsed = 0;
+
+    int32 BarksUsed = 0;
+
+    double GetHitRate() const;
+
+    /// "12 prefetched, 9 hits, ..." for logs.
+    FString ToString() const;
+};
+
+///
+/// Short lived cache of FHoverPrefetch, filled by the command manager as hover
+/// intent is detected and consumed on the click. The click claims the entry for
+/// what it clicked, and the stages of the command after it, the interaction text,
+/// the recipe and the bark, take what they need from the claimed entry. Entries
+/// expire because the hotspot or the inventory can change while they wait.
+class ADVENTUREGAME_API FHoverPrefetchCache
+{
+public:
+    /// Most entries kept, the oldest goes to make room.
+    int32 Capacity = 8;
+
+    /// Seconds an entry can be used for after it is made.
+    double Lifetime = 3.0;
+
+    /// Add an entry, replacing any for the same hotspot, verb and item.
+    FHoverPrefetch& Add(FHoverPrefetch&& Prefetch, double Now);
+
+    /// The entry for the hotspot, verb and item if there is one still in date.
+    FHoverPrefetch* Find(const AHotSpot* HotSpot, EVerbType Verb, const UInventoryItem* SourceItem, double Now);
+
+    /// Take the entry for a click to use, counting a hit or a miss. Any entry
+    /// claimed by the click before is dropped. Returns true on a hit.
+    bool Claim(const AHotSpot* HotSpot, EVerbType Verb, const UInventoryItem* SourceItem, double Now);
+
+    /// Drop the claimed entry, eg when its command has finished.
+    void ReleaseClaimed();
+
+    /// The interaction text of the claimed entry, if it is for the hotspot, verb and item.
+    bool FindClaimedText(const AHotSpot* HotSpot, EVerbType Verb, const UInventoryItem* SourceItem, FText& OutText);
+
+    /// The recipe of the claimed entry, which may be null, if it is for the hotspot and
+    /// verb and was looked up.
+    bool FindClaimedItemDataAsset(const AHotSpot* HotSpot, EVerbType Verb, UItemDataAsset*& OutItemDataAsset);
+
+    /// Move the bark request of the claimed entry out, if it was made for the text.
+    bool TakeBarkRequest(const FText& BarkText, FBarkRequest& OutRequest);
+
+    /// Drop entries older than their lifetime.
+    void Prune(double Now);
+
+    void Reset();
+
+    int32 Num() const { return Entries.Num(); }
+
+    const FHoverPrefetchStats& GetStats() const { return Stats; }
+
+    void ResetStats() { Stats = FHoverPrefetchStats(); }
+
+private:
+    bool IsExpired(const FHoverPrefetch& Prefetch, double Now) const { return Now - Prefetch.CreatedTime > Lifetime; }
+
+    TArray<FHoverPrefetch> Entries;
+
+    TOptional<FHoverPrefetch> Claimed;
+
+    FHoverPrefetchStats Stats;
+};
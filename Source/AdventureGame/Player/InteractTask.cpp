@@ -4,6 +4,7 @@
 #include "InteractTask.h"
 
 #include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/Gameplay/SimulationClock.h"
 #include "AdventureGame/HUD/AdvGameUtils.h"
 #include "AdventurePlayerController.h"
 
@@ -56,7 +57,7 @@ void UInteractTask::Activate()
 			World->GetTimerManager().SetTimer(
 				FakeInteractTimer, this,
 				&UInteractTask::FakeInteractTimerTimeout,
-				FakeInteractTime, false);
+				FSimulationClock::GetWait(FakeInteractTime), false);
 		}
 		else
 		{
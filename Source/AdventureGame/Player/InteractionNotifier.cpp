@@ -3,6 +3,8 @@
 
 #include "InteractionNotifier.h"
 
+#include "AdventureGame/Gameplay/SimulationClock.h"
+
 void UInteractionNotifier::NotifyUserInteraction()
 {
     if (!bUserInteractionActive && UserInteraction.IsBound())
@@ -15,7 +17,8 @@ void UInteractionNotifier::NotifyUserInteraction()
 void UInteractionNotifier::StartUserInteractionTimer()
 {
     GetWorld()->GetTimerManager().SetTimer(UserInteractionBroadcastTimer, this,
-                                           &UInteractionNotifier::StopUserInteractionTimer, UserInteractionTime, false);
+                                           &UInteractionNotifier::StopUserInteractionTimer,
+                                           FSimulationClock::GetWait(UserInteractionTime), false);
     bUserInteractionActive = true;
 }
 
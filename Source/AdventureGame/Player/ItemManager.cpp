@@ -17,7 +17,10 @@ UItemManager::UItemManager()
     : SourceItem(nullptr)
     , TargetItem(nullptr)
 {
+    // Only ticks, at the end of the frame, when there are items to remove
     PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
 }
 
 void UItemManager::AddToScore(int32 ScoreIncrement)
@@ -114,11 +117,13 @@ void UItemManager::ItemsRemoveFromInventory(const TSet<EItemKind>& TItemsToRemov
 void UItemManager::ItemRemoveFromInventoryAsync(const EItemKind& ItemToRemoveNextTick)
 {
     ItemsToRemove.Add(ItemToRemoveNextTick);
+    SetComponentTickEnabled(true);
 }
 
 void UItemManager::ItemsRemoveFromInventoryAsync(const TSet<EItemKind>& ItemsToRemoveNextTick)
 {
     ItemsToRemove.Append(ItemsToRemoveNextTick);
+    SetComponentTickEnabled(!ItemsToRemove.IsEmpty());
 }
 
 UAdventureGameInstance* UItemManager::GetAdventureGameInstance()
@@ -268,7 +273,10 @@ void UItemManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorCom
 
     if (ItemsToRemove.Num() > 0)
     {
-        ItemsRemoveFromInventory(ItemsToRemove);
-        ItemsToRemove.Empty();
+        // Removing can schedule more, which will be done in the next frame
+        const TSet<EItemKind> Removing = MoveTemp(ItemsToRemove);
+        ItemsToRemove.Reset();
+        ItemsRemoveFromInventory(Removing);
     }
+    SetComponentTickEnabled(!ItemsToRemove.IsEmpty());
 }
@@ -154,7 +154,7 @@ public:
 
 	virtual void BeginPlay() override;
 	
-	// Called every frame
+	// Called at the end of a frame in which items were scheduled for removal
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
 							   FActorComponentTickFunction* ThisTickFunction) override;
 };
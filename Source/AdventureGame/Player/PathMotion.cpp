@@ -0,0 +1,49 @@
+// (c) 2025 Sarah Smith
+
+
+#include "PathMotion.h"
+
+#include "Algo/BinarySearch.h"
+
+void FPathMotion::Start(const TArray<FVector>& InPoints, double InSpeed, double InStartTime)
+{
+	Points = InPoints;
+	Speed = FMath::Max(InSpeed, UE_KINDA_SMALL_NUMBER);
+	StartTime = InStartTime;
+	Distances.Reset(Points.Num());
+	double Distance = 0.0;
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		if (Index > 0) Distance += FVector::Dist2D(Points[Index - 1], Points[Index]);
+		Distances.Add(Distance);
+	}
+}
+
+void FPathMotion::Reset()
+{
+	Points.Reset();
+	Distances.Reset();
+}
+
+double FPathMotion::GetDuration() const
+{
+	return GetLength() / Speed;
+}
+
+FVector FPathMotion::Sample(double Time, FVector2D& OutDirection) const
+{
+	OutDirection = FVector2D::ZeroVector;
+	if (Points.IsEmpty()) return FVector::ZeroVector;
+	if (Points.Num() == 1) return Points[0];
+
+	const double Distance = FMath::Clamp((Time - StartTime) * Speed, 0.0, GetLength());
+
+	// The segment ending at the first point beyond the distance, or the last
+	// segment at the end of the path. Zero length segments are never chosen
+	const int32 End = FMath::Clamp(Algo::UpperBound(Distances, Distance), 1, Points.Num() - 1);
+	const double Length = Distances[End] - Distances[End - 1];
+	if (Length <= 0.0) return Points[End];
+
+	OutDirection = FVector2D(Points[End] - Points[End - 1]) / Length;
+	return FMath::Lerp(Points[End - 1], Points[End], (Distance - Distances[End - 1]) / Length);
+}
@@ -0,0 +1,48 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Walk along a polyline at a constant speed, from a start time. Where the
+ * walker is, and which way it faces, is a function of the time only, so it
+ * can be worked out whenever it is needed instead of stepped every frame.
+ */
+class ADVENTUREGAME_API FPathMotion
+{
+public:
+	void Start(const TArray<FVector>& InPoints, double InSpeed, double InStartTime);
+
+	void Reset();
+
+	bool IsActive() const { return !Points.IsEmpty(); }
+
+	/// Seconds from the first point to the last.
+	double GetDuration() const;
+
+	double GetStartTime() const { return StartTime; }
+
+	double GetEndTime() const { return StartTime + GetDuration(); }
+
+	bool IsFinished(double Time) const { return Time >= GetEndTime(); }
+
+	double GetSpeed() const { return Speed; }
+
+	double GetLength() const { return Distances.IsEmpty() ? 0.0 : Distances.Last(); }
+
+	/// Where the walker is at the time, held at the first point before the start
+	/// and the last after the end. The direction is that of the segment it is
+	/// on, in the XY plane, or zero if the path has no length.
+	FVector Sample(double Time, FVector2D& OutDirection) const;
+
+private:
+	TArray<FVector> Points;
+
+	/// Distance along the path to each point, the first is zero.
+	TArray<double> Distances;
+
+	double Speed = 0.0;
+
+	double StartTime = 0.0;
+};
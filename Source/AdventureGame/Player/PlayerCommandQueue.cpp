@@ -0,0 +1,205 @@
+// (c) 2025 Sarah Smith
+
+
+#include "PlayerCommandQueue.h"
+
+#include "AdventureGame/AdventureGame.h"
+#include "AdventureGame/HotSpots/HotSpot.h"
+#include "AdventureGame/Items/InventoryItem.h"
+
+FQueuedCommand FQueuedCommand::Walk(const FVector& Location)
+{
+    FQueuedCommand Command;
+    Command.Type = EQueuedCommandType::Walk;
+    Command.Location = Location;
+    return Command;
+}
+
+FQueuedCommand FQueuedCommand::Interact(AHotSpot* HotSpot, EVerbType Verb)
+{
+    FQueuedCommand Command;
+    Command.Type = EQueuedCommandType::Interact;
+    Command.HotSpot = HotSpot;
+    Command.Verb = Verb;
+    return Command;
+}
+
+FQueuedCommand FQueuedCommand::Combine(UInventoryItem* Item, AHotSpot* HotSpot)
+{
+    FQueuedCommand Command;
+    Command.Type = EQueuedCommandType::Combine;
+    Command.Item = Item;
+    Command.HotSpot = HotSpot;
+    Command.Verb = EVerbType::UseItem;
+    return Command;
+}
+
+FQueuedCommand FQueuedCommand::Give(UInventoryItem* Item, AHotSpot* HotSpot)
+{
+    FQueuedCommand Command;
+    Command.Type = EQueuedCommandType::Give;
+    Command.Item = Item;
+    Command.HotSpot = HotSpot;
+    Command.Verb = EVerbType::GiveItem;
+    return Command;
+}
+
+FQueuedCommand FQueuedCommand::Bark(const FText& BarkText)
+{
+    FQueuedCommand Command;
+    Command.Type = EQueuedCommandType::Bark;
+    Command.BarkText = BarkText;
+    return Command;
+}
+
+bool FQueuedCommand::IsStillValid() const
+{
+    switch (Type)
+    {
+    case EQueuedCommandType::Interact:
+        return HotSpot.IsValid();
+    case EQueuedCommandType::Combine:
+    case EQueuedCommandType::Give:
+        return HotSpot.IsValid() && Item.IsValid();
+    default:
+        return true;
+    }
+}
+
+FString FQueuedCommand::ToString() const
+{
+    switch (Type)
+    {
+    case EQueuedCommandType::Walk:
+        return FString::Printf(TEXT("Walk to %s"), *Location.ToString());
+    case EQueuedCommandType::Bark:
+        return FString::Printf(TEXT("Bark \"%s\""), *BarkText.ToString());
+    default:
+        break;
+    }
+    return FString::Printf(TEXT("%s %s %s"), *VerbGetDescriptiveString(Verb).ToString(),
+                           Item.IsValid() ? *Item->ShortDescription.ToString() : TEXT(""),
+                           HotSpot.IsValid() ? *HotSpot->ShortDescription.ToString() : TEXT("(gone)"));
+}
+
+FPlayerCommandQueue::FPlayerCommandQueue(int32 InCapacity)
+{
+    Commands.SetNum(FMath::Max(InCapacity, 1));
+}
+
+void FPlayerCommandQueue::Push(FQueuedCommand&& Command)
+{
+    Command.Frame = GFrameCounter;
+    if (Command.Type == EQueuedCommandType::Walk && Count > 0)
+    {
+        FQueuedCommand& Last = At(Count - 1);
+        if (Last.Type == EQueuedCommandType::Walk && Last.Frame == Command.Frame)
+        {
+            Last = MoveTemp(Command);
+            ++Stats.Coalesced;
+            return;
+        }
+    }
+    if (Count == Commands.Num())
+    {
+        UE_LOG(LogAdventureGame, Verbose, TEXT("Command queue full, dropping: %s"), *At(0).ToString());
+        DropFront();
+    }
+    At(Count) = MoveTemp(Command);
+    ++Count;
+    ++Stats.Queued;
+    Stats.Depth = Count;
+    Stats.PeakDepth = FMath::Max(Stats.PeakDepth, Count);
+}
+
+bool FPlayerCommandQueue::Pop(FQueuedCommand& OutCommand)
+{
+    while (Count > 0)
+    {
+        if (At(0).IsStillValid())
+        {
+            OutCommand = MoveTemp(At(0));
+            At(0) = FQueuedCommand();
+            Head = (Head + 1) % Commands.Num();
+            --Count;
+            ++Stats.Run;
+            Stats.Depth = Count;
+            return true;
+        }
+        UE_LOG(LogAdventureGame, Verbose, TEXT("Command target has gone, dropping: %s"), *At(0).ToString());
+        DropFront();
+    }
+    return false;
+}
+
+int32 FPlayerCommandQueue::Cancel()
+{
+    const int32 Cancelled = Count;
+    for (int32 i = 0; i < Count; ++i)
+    {
+        At(i) = FQueuedCommand();
+    }
+    Head = 0;
+    Count = 0;
+    Stats.Cancelled += Cancelled;
+    Stats.Depth = 0;
+    return Cancelled;
+}
+
+void FPlayerCommandQueue::DropFront()
+{
+    At(0) = FQueuedCommand();
+    Head = (Head + 1) % Commands.Num();
+    --Count;
+    ++Stats.Dropped;
+    Stats.Depth = Count;
+}
+
+void FPathRequestThrottle::BeginRequest(const FVector& Location)
+{
+    LastRequestFrame = GFrameCounter;
+    LastRequestTarget = Location;
+}
+
+bool FPathRequestThrottle::Coalesce(const FVector& Location, float Distance)
+{
+    if (LastRequestFrame != GFrameCounter || FVector::DistSquared(LastRequestTarget, Location) >= FMath::Square(Distance))
+    {
+        return false;
+    }
+    ++Stats.Coalesced;
+    return true;
+}
+
+bool FPathRequestThrottle::TryAcquire(double Now)
+{
+    Refill(Now);
+    if (Tokens < 1.0f)
+    {
+        ++Stats.Throttled;
+        return false;
+    }
+    Tokens -= 1.0f;
+    ++Stats.Made;
+    return true;
+}
+
+double FPathRequestThrottle::GetWaitTime(double Now)
+{
+    Refill(Now);
+    return Tokens >= 1.0f ? 0.0 : (1.0f - Tokens) / MaxPerSecond;
+}
+
+void FPathRequestThrottle::Refill(double Now)
+{
+    // Starts full, so the first clicks of the game are not held back
+    if (Tokens < 0.0f)
+    {
+        Tokens = MaxPerSecond;
+    }
+    else
+    {
+        Tokens = FMath::Min(MaxPerSecond, Tokens + static_cast<float>(Now - LastRefill) * MaxPerSecond);
+    }
+    LastRefill = Now;
+}
@@ -0,0 +1,201 @@
+// (c) 2025 Sarah Smith
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AdventureGame/Enums/VerbType.h"
+
+#include "PlayerCommandQueue.generated.h"
+
+class AHotSpot;
+class UInventoryItem;
+
+enum class EQueuedCommandType : uint8
+{
+    /// Walk to a location in the room
+    Walk,
+    /// Walk to a hotspot and apply a verb to it
+    Interact,
+    /// Walk to a hotspot and use an inventory item on it
+    Combine,
+    /// Walk to a hotspot and give it an inventory item
+    Give,
+    /// Have the player say something
+    Bark
+};
+
+///
+/// A command the player has issued that is held until those ahead of it are
+/// done. Hotspots and items are held weakly, so a command whose target has
+/// gone away, eg with a room change, is dropped rather than carried out.
+struct ADVENTUREGAME_API FQueuedCommand
+{
+    EQueuedCommandType Type = EQueuedCommandType::Walk;
+
+    EVerbType Verb = EVerbType::WalkTo;
+
+    TWeakObjectPtr<AHotSpot> HotSpot;
+
+    TWeakObjectPtr<UInventoryItem> Item;
+
+    FVector Location = FVector::ZeroVector;
+
+    FText BarkText;
+
+    /// Frame the command was issued in, for coalescing.
+    uint64 Frame = 0;
+
+    static FQueuedCommand Walk(const FVector& Location);
+
+    static FQueuedCommand Interact(AHotSpot* HotSpot, EVerbType Verb);
+
+    static FQueuedCommand Combine(UInventoryItem* Item, AHotSpot* HotSpot);
+
+    static FQueuedCommand Give(UInventoryItem* Item, AHotSpot* HotSpot);
+
+    static FQueuedCommand Bark(const FText& BarkText);
+
+    /// Are the hotspot and item this command needs still around.
+    bool IsStillValid() const;
+
+    FString ToString() const;
+};
+
+/// Counters for the command queue, and for the path requests made on behalf of
+/// the commands it runs. All but Depth count up from the start of play.
+USTRUCT(BlueprintType)
+struct ADVENTUREGAME_API FCommandQueueStats
+{
+    GENERATED_BODY()
+
+    /// Commands waiting now
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Commands")
+    int32 Depth = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Commands")
+    int32 PeakDepth = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Commands")
+    int32 Queued = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Commands")
+    int32 Run = 0;
+
+    /// Pushed out of a full queue, or whose target went away before it ran
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Commands")
+    int32 Dropped = 0;
+
+    /// Removed by a new click that was not queued, or an explicit cancel
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Commands")
+    int32 Cancelled = 0;
+
+    /// Walks that replaced another walk issued in the same frame, and walks to
+    /// where the player was already going, that did not need a path request
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Commands")
+    int32 Coalesced = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Commands")
+    int32 PathRequests = 0;
+
+    /// Path requests held back by the throttle to be made later
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Commands")
+    int32 PathRequestsThrottled = 0;
+};
+
+///
+/// Fixed size first in first out queue of player commands. When it is full the
+/// oldest waiting command is dropped, as the latest click is the best guide to
+/// what the player wants.
+class ADVENTUREGAME_API FPlayerCommandQueue
+{
+public:
+    explicit FPlayerCommandQueue(int32 InCapacity = 4);
+
+    /// Add to the back of the queue. A walk issued in the same frame as a walk
+    /// at the back of the queue replaces it instead.
+    void Push(FQueuedCommand&& Command);
+
+    /// Take the command at the front of the queue, skipping any whose target
+    /// has gone. Returns false if there is none.
+    bool Pop(FQueuedCommand& OutCommand);
+
+    /// Remove all waiting commands. Returns how many there were.
+    int32 Cancel();
+
+    int32 Num() const { return Count; }
+
+    bool IsEmpty() const { return Count == 0; }
+
+    int32 GetCapacity() const { return Commands.Num(); }
+
+    /// Counts of the queue's own events. The path request counts are left at zero,
+    /// see FPathRequestThrottle.
+    const FCommandQueueStats& GetStats() const { return Stats; }
+
+private:
+    FQueuedCommand& At(int32 Index) { return Commands[(Head + Index) % Commands.Num()]; }
+
+    void DropFront();
+
+    /// Ring buffer, allocated once
+    TArray<FQueuedCommand> Commands;
+
+    int32 Head = 0;
+
+    int32 Count = 0;
+
+    FCommandQueueStats Stats;
+};
+
+/// Counters for the path requests that went through a FPathRequestThrottle.
+struct ADVENTUREGAME_API FPathRequestStats
+{
+    int32 Made = 0;
+
+    /// Held back to be made later
+    int32 Throttled = 0;
+
+    /// Not made, as a path to the same place was asked for in the same frame
+    int32 Coalesced = 0;
+};
+
+///
+/// Caps the rate of path requests with a token bucket, which lets a short burst
+/// of clicks through straight away, but no more than MaxPerSecond over time.
+struct ADVENTUREGAME_API FPathRequestThrottle
+{
+    float MaxPerSecond = 8.0f;
+
+    /// Note a path request to Location this frame, for Coalesce to compare with.
+    void BeginRequest(const FVector& Location);
+
+    /// Is Location within Distance of a path already asked for this frame, so
+    /// another request would only find the same path. Counted if so.
+    bool Coalesce(const FVector& Location, float Distance);
+
+    /// Take a token if there is one, counting the request as made or throttled.
+    /// Times are in seconds.
+    bool TryAcquire(double Now);
+
+    /// Count a request made without a token, for paths cheap enough to need no throttle.
+    void CountUnthrottled() { ++Stats.Made; }
+
+    /// How long until a token will be free.
+    double GetWaitTime(double Now);
+
+    const FPathRequestStats& GetStats() const { return Stats; }
+
+private:
+    void Refill(double Now);
+
+    float Tokens = -1.0f;
+
+    double LastRefill = 0.0;
+
+    uint64 LastRequestFrame = 0;
+
+    FVector LastRequestTarget = FVector::ZeroVector;
+
+    FPathRequestStats Stats;
+};
@@ -2,23 +2,20 @@
 
 void UTestBarkController::PlayerBark(const FText& BarkText, int32 BarkTaskUid)
 {
-    FBarkRequest* Request = FBarkRequest::CreatePlayerRequest(BarkText);
-    BarkRequests.Add(Request);
+    BarkRequests.Add(FBarkRequest::CreatePlayerRequest(BarkText));
     IsBarking = true;
 }
 
 void UTestBarkController::PlayerBarkAndEnd(const FText& BarkText)
 {
-    FBarkRequest* Request = FBarkRequest::CreatePlayerRequest(BarkText);
-    BarkRequests.Add(Request);
+    BarkRequests.Add(FBarkRequest::CreatePlayerRequest(BarkText));
     ShouldInterruptAction = true;
     IsBarking = true;
 }
 
 void UTestBarkController::PlayerBarkLines(const TArray<FText>& BarkTextArray, int32 BarkTaskUid)
 {
-    FBarkRequest* Request = FBarkRequest::CreatePlayerMultilineRequest(BarkTextArray);
-    BarkRequests.Add(Request);
+    BarkRequests.Add(FBarkRequest::CreatePlayerMultilineRequest(BarkTextArray));
     IsBarking = true;
 }
 
@@ -32,12 +29,10 @@ void UTestBarkController::ClearBark()
 TArray<FString> UTestBarkController::GetBarkRequests()
 {
     TArray<FString> Requests;
-    for (FBarkRequest* Request : BarkRequests)
+    for (const FBarkRequest& Request : BarkRequests)
     {
-        TArray<FText> BarkLines;
-        Request->GetBarkLines(BarkLines);
         FString BarkTextConcatenated = "";
-        for (FText& BarkText : BarkLines)
+        for (const FText& BarkText : Request.GetBarkLines())
         {
             BarkTextConcatenated += BarkText.ToString();
         }
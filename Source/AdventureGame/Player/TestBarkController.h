@@ -26,5 +26,5 @@ public:
     UFUNCTION(BlueprintCallable)
     TArray<FString> GetBarkRequests();
     
-    TArray<FBarkRequest*> BarkRequests;
+    TArray<FBarkRequest> BarkRequests;
 };
@@ -0,0 +1,74 @@
+#include "AdventureGame/Player/CommandLatency.h"
+
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(LatencyHistogramTest, "AdventureGame.Player.LatencyHistogramTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// Widest a bucket can be, relative to the durations in it.
+static constexpr double GBucketPrecision = 1.0 / FLatencyHistogram::SubBucketCount;
+
+/// Is the percentile no shorter than the duration it should be, and no more than a bucket over it.
+static bool IsWithinBucket(double Percentile, double Expected)
+{
+    return Percentile >= Expected && Percentile <= Expected * (1.0 + GBucketPrecision);
+}
+
+bool LatencyHistogramTest::RunTest(const FString& Parameters)
+{
+    // Under SubBucketCount microseconds each duration has a bucket of its own
+    for (uint64 Microseconds = 0; Microseconds < FLatencyHistogram::SubBucketCount; ++Microseconds)
+    {
+        const int32 Index = FLatencyHistogram::GetBucketIndex(Microseconds);
+        TestEqual(FString::Printf(TEXT("%llu us in its own bucket"), Microseconds), Index, static_cast<int32>(Microseconds));
+        TestEqual(FString::Printf(TEXT("%llu us exact"), Microseconds), FLatencyHistogram::GetBucketUpperBound(Index), Microseconds);
+    }
+
+    // Above that a bucket holds the duration, and is no more than 1/16 wider than it
+    int32 Previous = FLatencyHistogram::GetBucketIndex(FLatencyHistogram::SubBucketCount - 1);
+    int32 OutOfBounds = 0;
+    for (uint64 Microseconds = FLatencyHistogram::SubBucketCount; Microseconds < 60000000ull;
+         Microseconds += 1 + Microseconds / 97)
+    {
+        const int32 Index = FLatencyHistogram::GetBucketIndex(Microseconds);
+        const uint64 UpperBound = FLatencyHistogram::GetBucketUpperBound(Index);
+        if (Index < Previous || UpperBound < Microseconds || UpperBound > Microseconds * (1.0 + GBucketPrecision))
+        {
+            ++OutOfBounds;
+        }
+        Previous = Index;
+    }
+    TestEqual(TEXT("Every duration up to a minute in an ordered bucket within 6.25%"), OutOfBounds, 0);
+    TestEqual(TEXT("Buckets start exactly on powers of two"),
+        FLatencyHistogram::GetBucketUpperBound(FLatencyHistogram::GetBucketIndex(1024) - 1), 1023ull);
+
+    // Durations too short to be rounded keep their exact percentiles
+    FLatencyHistogram Short;
+    TestEqual(TEXT("Nothing recorded"), Short.GetPercentile(50.0), 0.0);
+    for (int32 Microseconds = 1; Microseconds <= 10; ++Microseconds)
+    {
+        Short.Record(Microseconds / 1e6);
+    }
+    TestEqual(TEXT("Short p50"), Short.GetPercentile(50.0), 5 * 1e-6, 1e-12);
+    TestEqual(TEXT("Short p95"), Short.GetPercentile(95.0), 10 * 1e-6, 1e-12);
+    TestEqual(TEXT("Short p0 is the shortest"), Short.GetPercentile(0.0), 1 * 1e-6, 1e-12);
+
+    // 1 to 100 ms, in reverse so the order recorded does not matter
+    FLatencyHistogram Latency;
+    for (int32 Milliseconds = 100; Milliseconds >= 1; --Milliseconds)
+    {
+        Latency.Record(Milliseconds / 1000.0);
+    }
+    TestEqual(TEXT("Count"), Latency.GetCount(), 100ll);
+    TestEqual(TEXT("Mean"), Latency.GetMean(), 0.0505, 1e-9);
+    TestTrue(TEXT("p50 is 50 ms to within its bucket"), IsWithinBucket(Latency.GetPercentile(50.0), 0.050));
+    TestTrue(TEXT("p95 is 95 ms to within its bucket"), IsWithinBucket(Latency.GetPercentile(95.0), 0.095));
+    TestTrue(TEXT("p99 is 99 ms to within its bucket"), IsWithinBucket(Latency.GetPercentile(99.0), 0.099));
+    TestEqual(TEXT("p99 no more than the longest"), Latency.GetPercentile(99.0), 0.100, 1e-12);
+    TestEqual(TEXT("p100 is the longest"), Latency.GetPercentile(100.0), Latency.GetMax());
+
+    Latency.Reset();
+    TestEqual(TEXT("Reset"), Latency.GetCount(), 0ll);
+    TestEqual(TEXT("Reset percentile"), Latency.GetPercentile(99.0), 0.0);
+    return true;
+}
@@ -0,0 +1,88 @@
+#include "AdventureGame/HotSpots/Door.h"
+#include "AdventureGame/HotSpots/HotSpot.h"
+#include "AdventureGame/Player/HoverPrefetch.h"
+
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(HoverPrefetchTest, "AdventureGame.Player.HoverPrefetch",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool HoverPrefetchTest::RunTest(const FString& Parameters)
+{
+    // Default objects stand in for two hotspots in a room
+    const AHotSpot* Table = GetDefault<AHotSpot>();
+    const AHotSpot* Door = GetDefault<ADoor>();
+    constexpr double FrameTime = 1.0 / 60.0;
+
+    // The cursor sweeps across the table at 1200 pixels a second and never stops
+    FHoverIntent Intent;
+    double Now = 1.0;
+    bool bSweepFired = false;
+    for (int32 Frame = 0; Frame < 30; ++Frame, Now += FrameTime)
+    {
+        bSweepFired |= Intent.Update(Table, FVector2D(Frame * 20.0, 100.0), Now);
+    }
+    TestFalse(TEXT("Passing over is not intent"), bSweepFired);
+
+    // Then rests on the door, drifting a pixel a frame
+    int32 FiredFrame = INDEX_NONE;
+    int32 TimesFired = 0;
+    for (int32 Frame = 0; Frame < 60; ++Frame, Now += FrameTime)
+    {
+        if (Intent.Update(Door, FVector2D(600.0 + Frame, 100.0), Now))
+        {
+            if (FiredFrame == INDEX_NONE) FiredFrame = Frame;
+            ++TimesFired;
+        }
+    }
+    TestTrue(TEXT("Resting is intent"), FiredFrame != INDEX_NONE);
+    TestTrue(TEXT("after the dwell time"), FiredFrame * FrameTime >= Intent.DwellTime - KINDA_SMALL_NUMBER);
+    TestEqual(TEXT("once"), TimesFired, 1);
+
+    FHoverPrefetchCache Cache;
+    FHoverPrefetch Prefetch;
+    Prefetch.HotSpot = Door;
+    Prefetch.Verb = EVerbType::Open;
+    Prefetch.InteractionText = FText::FromString(TEXT("Open door"));
+    Prefetch.bResolved = true;
+    Prefetch.BarkText = FText::FromString(TEXT("It's locked."));
+    Prefetch.BarkRequest.Emplace(FBarkRequest::CreatePlayerRequest(Prefetch.BarkText));
+    Cache.Add(MoveTemp(Prefetch), Now);
+
+    TestFalse(TEXT("Another verb misses"), Cache.Claim(Door, EVerbType::LookAt, nullptr, Now));
+    TestTrue(TEXT("The verb hovered hits"), Cache.Claim(Door, EVerbType::Open, nullptr, Now + 0.5));
+    FText Text;
+    TestTrue(TEXT("Claimed text found"), Cache.FindClaimedText(Door, EVerbType::Open, nullptr, Text));
+    TestEqual(TEXT("and is the one made on hover"), Text.ToString(), FString(TEXT("Open door")));
+    FBarkRequest Bark;
+    TestFalse(TEXT("Bark for other text not taken"), Cache.TakeBarkRequest(FText::FromString(TEXT("Hello")), Bark));
+    TestTrue(TEXT("Bark for its text taken"), Cache.TakeBarkRequest(FText::FromString(TEXT("It's locked.")), Bark));
+    TestEqual(TEXT("with its line"), Bark.GetLineCount(), 1);
+    TestFalse(TEXT("only once"), Cache.TakeBarkRequest(FText::FromString(TEXT("It's locked.")), Bark));
+    Cache.ReleaseClaimed();
+    TestFalse(TEXT("Released entry has no text"), Cache.FindClaimedText(Door, EVerbType::Open, nullptr, Text));
+
+    FHoverPrefetch Stale;
+    Stale.HotSpot = Table;
+    Stale.Verb = EVerbType::LookAt;
+    Cache.Add(MoveTemp(Stale), Now);
+    TestFalse(TEXT("An old entry misses"), Cache.Claim(Table, EVerbType::LookAt, nullptr, Now + Cache.Lifetime + 1.0));
+
+    for (int32 Index = 0; Index < Cache.Capacity + 4; ++Index)
+    {
+        FHoverPrefetch Entry;
+        Entry.HotSpot = Index % 2 ? Table : Door;
+        Entry.Verb = static_cast<EVerbType>(Index);
+        Cache.Add(MoveTemp(Entry), Now + Index * 0.01);
+    }
+    TestEqual(TEXT("No more entries than the capacity"), Cache.Num(), Cache.Capacity);
+
+    const FHoverPrefetchStats& Stats = Cache.GetStats();
+    TestEqual(TEXT("Hits"), Stats.Hits, 1);
+    TestEqual(TEXT("Misses"), Stats.Misses, 2);
+    TestEqual(TEXT("Expired"), Stats.Expired, 1);
+    TestEqual(TEXT("Oldest dropped unused"), Stats.Unused, 4);
+    TestEqual(TEXT("Barks used"), Stats.BarksUsed, 1);
+
+    return true;
+}
@@ -0,0 +1,32 @@
+#include "AdventureGame/Dialog/PlayerBarkManager.h"
+#include "AdventureGame/HotSpots/PickUp.h"
+#include "AdventureGame/Player/CommandManager.h"
+#include "AdventureGame/Player/ItemManager.h"
+
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(IdleTickTest, "AdventureGame.Player.IdleTick",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// An idle room must not tick the command manager, its components or the pickups.
+/// Each of them turns its tick on when work is scheduled, so none of them should
+/// start with it on.
+bool IdleTickTest::RunTest(const FString& Parameters)
+{
+    const ACommandManager* CommandManager = GetDefault<ACommandManager>();
+    TestTrue(TEXT("Command manager can tick for scheduled work"), CommandManager->PrimaryActorTick.bCanEverTick);
+    TestFalse(TEXT("Command manager starts idle"), CommandManager->PrimaryActorTick.bStartWithTickEnabled);
+    TestTrue(TEXT("Command manager work runs at the end of the frame"),
+        CommandManager->PrimaryActorTick.TickGroup == TG_PostUpdateWork);
+
+    const UItemManager* ItemManager = GetDefault<UItemManager>();
+    TestTrue(TEXT("Item manager can tick for removals"), ItemManager->PrimaryComponentTick.bCanEverTick);
+    TestFalse(TEXT("Item manager starts idle"), ItemManager->PrimaryComponentTick.bStartWithTickEnabled);
+    TestTrue(TEXT("Item removals run at the end of the frame"),
+        ItemManager->PrimaryComponentTick.TickGroup == TG_PostUpdateWork);
+
+    TestFalse(TEXT("Bark manager never ticks"), GetDefault<UPlayerBarkManager>()->PrimaryComponentTick.bCanEverTick);
+    TestFalse(TEXT("Pickups start idle"), GetDefault<APickUp>()->PrimaryActorTick.bStartWithTickEnabled);
+
+    return true;
+}
@@ -0,0 +1,121 @@
+#include "AdventureGame/Player/AdventureCharacter.h"
+#include "AdventureGame/Player/PathMotion.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(PathMotionTest, "AdventureGame.Player.PathMotion",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/// Far more characters walking at once than the game ever has.
+constexpr int32 GWalkers = 16;
+
+/// Frames ticked, long enough for every walk to end.
+constexpr int32 GFrames = 300;
+
+constexpr float GFrameTime = 1.0f / 60.0f;
+
+static TArray<FVector> MakeWalk(int32 Index, double Z)
+{
+    const double Y = Index * 150.0;
+    return { FVector(0.0, Y, Z), FVector(600.0, Y + 100.0, Z), FVector(1200.0, Y, Z) };
+}
+
+/// Walk each walker along its path on analytic motion for GFrames, counting how many walks
+/// ended at their last point.
+static void TickWalkers(FTestWorldWrapper& WorldWrapper, TArray<AAdventureCharacter*>& Walkers, int32& OutReached)
+{
+    OutReached = 0;
+    for (int32 Index = 0; Index < Walkers.Num(); ++Index)
+    {
+        AAdventureCharacter* Walker = Walkers[Index];
+        const TArray<FVector> Walk = MakeWalk(Index, Walker->GetActorLocation().Z);
+        Walker->TeleportToLocation(Walk[0]);
+        Walker->bAnalyticPathMovement = true;
+        Walker->PathFollowedDelegate.Clear();
+        Walker->PathFollowedDelegate.AddLambda([&OutReached](bool bReached) { OutReached += bReached; });
+        Walker->FollowPath(Walk);
+    }
+    for (int32 Frame = 0; Frame < GFrames; ++Frame)
+    {
+        WorldWrapper.TickTestWorld(GFrameTime);
+    }
+}
+
+bool PathMotionTest::RunTest(const FString& Parameters)
+{
+    // Sampling needs no world
+    FPathMotion Motion;
+    Motion.Start({ FVector(0.0, 0.0, 10.0), FVector(300.0, 0.0, 10.0), FVector(300.0, 0.0, 10.0),
+        FVector(300.0, 400.0, 10.0) }, 100.0, 2.0);
+    FVector2D Direction;
+    TestEqual(TEXT("Duration is length over speed"), Motion.GetDuration(), 7.0);
+    TestEqual(TEXT("Held at the start before it"), Motion.Sample(0.0, Direction), FVector(0.0, 0.0, 10.0));
+    TestEqual(TEXT("Along the first segment"), Motion.Sample(3.5, Direction), FVector(150.0, 0.0, 10.0));
+    TestEqual(TEXT("facing along it"), Direction, FVector2D(1.0, 0.0));
+    TestEqual(TEXT("Past the corner"), Motion.Sample(6.0, Direction), FVector(300.0, 100.0, 10.0));
+    TestEqual(TEXT("facing the next segment, not the empty one"), Direction, FVector2D(0.0, 1.0));
+    TestEqual(TEXT("Held at the end after it"), Motion.Sample(20.0, Direction), FVector(300.0, 400.0, 10.0));
+    TestTrue(TEXT("and finished"), Motion.IsFinished(20.0));
+
+    UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+    if (!TestNotNull(TEXT("Engine cube mesh"), Cube)) return false;
+
+    // This will get cleaned up when it leaves scope
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+
+    if (!World) return false;
+    WorldWrapper.BeginPlayInTestWorld();
+
+    // A floor for the movement component to walk on, its top at zero. The engine cube is 100 units across
+    AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(),
+        FTransform(FRotator::ZeroRotator, FVector(600.0, GWalkers * 75.0, -50.0), FVector(20.0, GWalkers * 2.0, 1.0)));
+    Floor->GetStaticMeshComponent()->SetStaticMesh(Cube);
+
+    TArray<AAdventureCharacter*> Walkers;
+    for (int32 Index = 0; Index < GWalkers; ++Index)
+    {
+        AAdventureCharacter* Walker = World->SpawnActor<AAdventureCharacter>(AAdventureCharacter::StaticClass(),
+            FTransform(FVector(0.0, Index * 150.0, 100.0)));
+        if (!TestNotNull(TEXT("Character spawned"), Walker)) return false;
+        Walker->TeleportToLocation(FVector(0.0, Index * 150.0, Walker->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + 1.0));
+        // No controller in the test world, so let the movement component run without one
+        Walker->GetCharacterMovement()->bRunPhysicsWithNoController = true;
+        Walker->GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+        Walkers.Add(Walker);
+    }
+    WorldWrapper.TickTestWorld(GFrameTime);
+
+    int32 AnalyticReached = 0;
+    TickWalkers(WorldWrapper, Walkers, AnalyticReached);
+    TestEqual(TEXT("Every analytic walk ended"), AnalyticReached, GWalkers);
+    for (int32 Index = 0; Index < GWalkers; ++Index)
+    {
+        const FVector End = MakeWalk(Index, Walkers[Index]->GetActorLocation().Z).Last();
+        TestTrue(TEXT("at its last point"), Walkers[Index]->GetActorLocation().Equals(End, 1.0));
+        TestTrue(TEXT("with its tick back on"), Walkers[Index]->IsActorTickEnabled());
+    }
+
+    // Part way along, the walker is not ticking but is still placed on its path every frame
+    AAdventureCharacter* Walker = Walkers[0];
+    const TArray<FVector> Walk = MakeWalk(0, Walker->GetActorLocation().Z);
+    Walker->TeleportToLocation(Walk[0]);
+    Walker->PathFollowedDelegate.Clear();
+    Walker->FollowPath(Walk);
+    for (int32 Frame = 0; Frame < 10; ++Frame)
+    {
+        WorldWrapper.TickTestWorld(GFrameTime);
+    }
+    TestFalse(TEXT("Not ticking while walking"), Walker->IsActorTickEnabled());
+    const FVector PartWay = Walker->GetActorLocation();
+    TestTrue(TEXT("Moved from the start"), PartWay.X > Walk[0].X);
+    TestTrue(TEXT("on the first segment"), FMath::PointDistToSegment(PartWay, Walk[0], Walk[1]) < 1.0);
+
+    return true;
+}
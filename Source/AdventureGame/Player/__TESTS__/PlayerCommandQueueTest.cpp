@@ -0,0 +1,115 @@
+#include "AdventureGame/Player/PlayerCommandQueue.h"
+
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(PlayerCommandQueueTest, "AdventureGame.Player.PlayerCommandQueueTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(PathRequestThrottleTest, "AdventureGame.Player.PathRequestThrottleTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+static FQueuedCommand NumberedBark(int32 Number)
+{
+    return FQueuedCommand::Bark(FText::AsNumber(Number));
+}
+
+static FString PopText(FPlayerCommandQueue& Queue)
+{
+    FQueuedCommand Command;
+    return Queue.Pop(Command) ? Command.BarkText.ToString() : TEXT("(empty)");
+}
+
+bool PlayerCommandQueueTest::RunTest(const FString& Parameters)
+{
+    // Barks are never coalesced, so each one pushed is its own command
+    FPlayerCommandQueue Queue(3);
+    Queue.Push(NumberedBark(1));
+    Queue.Push(NumberedBark(2));
+    Queue.Push(NumberedBark(3));
+    TestEqual(TEXT("First out"), PopText(Queue), TEXT("1"));
+    TestEqual(TEXT("Second out"), PopText(Queue), TEXT("2"));
+
+    // The head is now at the end of the ring, so these wrap round to the start
+    Queue.Push(NumberedBark(4));
+    Queue.Push(NumberedBark(5));
+    TestEqual(TEXT("Full after wrapping"), Queue.Num(), 3);
+    TestEqual(TEXT("Order kept across the wrap"), PopText(Queue), TEXT("3"));
+    TestEqual(TEXT("then the wrapped ones"), PopText(Queue), TEXT("4"));
+    TestEqual(TEXT("in the order pushed"), PopText(Queue), TEXT("5"));
+    TestTrue(TEXT("Empty"), Queue.IsEmpty());
+    TestEqual(TEXT("Nothing to pop"), PopText(Queue), TEXT("(empty)"));
+    TestEqual(TEXT("Peak depth"), Queue.GetStats().PeakDepth, 3);
+    TestEqual(TEXT("Every push queued"), Queue.GetStats().Queued, 5);
+    TestEqual(TEXT("Every pop run"), Queue.GetStats().Run, 5);
+
+    // Pushing onto a full queue drops the oldest
+    Queue.Push(NumberedBark(6));
+    Queue.Push(NumberedBark(7));
+    Queue.Push(NumberedBark(8));
+    Queue.Push(NumberedBark(9));
+    TestEqual(TEXT("Still at capacity"), Queue.Num(), Queue.GetCapacity());
+    TestEqual(TEXT("Overflow dropped"), Queue.GetStats().Dropped, 1);
+    TestEqual(TEXT("Oldest was the one dropped"), PopText(Queue), TEXT("7"));
+
+    // A command whose target has gone is dropped as it comes to the front
+    Queue.Cancel();
+    Queue.Push(FQueuedCommand::Interact(nullptr, EVerbType::LookAt));
+    Queue.Push(NumberedBark(10));
+    TestEqual(TEXT("Target gone, skipped"), PopText(Queue), TEXT("10"));
+    TestEqual(TEXT("and counted as dropped"), Queue.GetStats().Dropped, 2);
+    TestEqual(TEXT("Cancelled counted"), Queue.GetStats().Cancelled, 2);
+
+    // Walks pushed in the same frame coalesce into the last one, unless something is between them
+    FPlayerCommandQueue Walks(4);
+    Walks.Push(FQueuedCommand::Walk(FVector(1.0, 0.0, 0.0)));
+    Walks.Push(FQueuedCommand::Walk(FVector(2.0, 0.0, 0.0)));
+    TestEqual(TEXT("Second walk replaced the first"), Walks.Num(), 1);
+    TestEqual(TEXT("Coalesced counted"), Walks.GetStats().Coalesced, 1);
+    Walks.Push(NumberedBark(11));
+    Walks.Push(FQueuedCommand::Walk(FVector(3.0, 0.0, 0.0)));
+    TestEqual(TEXT("Walk after a bark is queued"), Walks.Num(), 3);
+    FQueuedCommand Walk;
+    Walks.Pop(Walk);
+    TestEqual(TEXT("The latest walk kept"), Walk.Location, FVector(2.0, 0.0, 0.0));
+    TestEqual(TEXT("Depth"), Walks.GetStats().Depth, 2);
+    return true;
+}
+
+bool PathRequestThrottleTest::RunTest(const FString& Parameters)
+{
+    FPathRequestThrottle Throttle;
+    Throttle.MaxPerSecond = 4.0f;
+
+    // Starts full, so a burst up to the rate goes straight through
+    for (int32 Request = 0; Request < 4; ++Request)
+    {
+        TestTrue(FString::Printf(TEXT("Request %d of the burst"), Request), Throttle.TryAcquire(0.0));
+    }
+    TestFalse(TEXT("Then throttled"), Throttle.TryAcquire(0.0));
+    TestEqual(TEXT("Wait for the next token"), Throttle.GetWaitTime(0.0), 0.25);
+
+    // Tokens come back at MaxPerSecond
+    TestFalse(TEXT("Not refilled yet"), Throttle.TryAcquire(0.1));
+    TestTrue(TEXT("Refilled once a quarter of a second has gone"), Throttle.TryAcquire(0.3));
+
+    // but never more than a second's worth
+    int32 Granted = 0;
+    while (Throttle.TryAcquire(10.0))
+    {
+        ++Granted;
+    }
+    TestEqual(TEXT("Refill capped at MaxPerSecond"), Granted, 4);
+
+    Throttle.CountUnthrottled();
+    TestEqual(TEXT("Made counted"), Throttle.GetStats().Made, 10);
+    TestEqual(TEXT("Throttled counted"), Throttle.GetStats().Throttled, 3);
+
+    // A second request to about the same place in the same frame is coalesced
+    const FVector Target(100.0, 200.0, 0.0);
+    TestFalse(TEXT("Nothing asked for yet"), Throttle.Coalesce(Target, 10.0f));
+    Throttle.BeginRequest(Target);
+    TestTrue(TEXT("Near the last request"), Throttle.Coalesce(Target + FVector(5.0, 0.0, 0.0), 10.0f));
+    TestFalse(TEXT("Too far from it"), Throttle.Coalesce(Target + FVector(50.0, 0.0, 0.0), 10.0f));
+    TestEqual(TEXT("Coalesced counted"), Throttle.GetStats().Coalesced, 1);
+    return true;
+}